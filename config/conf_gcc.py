@@ -19,6 +19,10 @@
 import os, glob
 
 def config(configuration, capability, debug, ipo):
+    # The instruction set extensions are not enabled globally, but by
+    # the functions using them (see src/libmathtext/fontsink.cc),
+    # which are selected at run time
+    configuration.env.Append(CPPDEFINES = capability)
     # System-wide local include and library path
     configuration.env.Append(CPPPATH = ['/usr/local/include'])
     if configuration.env['ARCH'] == 'x86_64':
@@ -83,4 +83,9 @@ def capability():
                 if cpuinfo['cpu family'] == '6':
                     # 64-bit Core 2
                     capability += ['HAVE_SSE3', 'HAVE_SSSE3']
+        if cpuinfo.has_key('flags') and \
+               'avx2' in cpuinfo['flags'].split() and \
+               'HAVE_SSE2' in capability:
+            # Haswell and later, Excavator and later
+            capability += ['HAVE_AVX2']
     return capability
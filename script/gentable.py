@@ -18,7 +18,7 @@
 # Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
 # 02110-1301 USA
 
-import os, sys, maputil
+import os, sys, re, maputil
 
 filename_list = [
     os.path.join(os.path.dirname(sys.argv[0]), '..', 'data', 'table',
@@ -36,6 +36,38 @@ filename_list_alias = [
     os.path.join(os.path.dirname(sys.argv[0]), '..', 'data', 'table',
                  'alias_map.txt')]
 
+filename_font_change = os.path.join(
+    os.path.dirname(sys.argv[0]), '..', 'data', 'table',
+    'fontchange.txt')
+
+# The operator table is generated by genop.py, and the descriptors
+# refer to it by index
+filename_operator = os.path.join(
+    os.path.dirname(sys.argv[0]), '..', 'src', 'libmathtext',
+    'table', 'mathopstd.h')
+
+# Control sequences interpreted by the parser itself, see
+# math_text_t::tex_token_t
+primitive_table = [
+    ['\\!', 'NEGATIVE_THIN_SPACE'],
+    ['\\,', 'THIN_SPACE'],
+    ['\\:', 'MEDIUM_SPACE'],
+    ['\\;', 'THICK_SPACE'],
+    ['\\atop', 'ATOP'],
+    ['\\hbox', 'HBOX'],
+    ['\\left', 'LEFT'],
+    ['\\of', 'OF'],
+    ['\\over', 'OVER'],
+    ['\\qquad', 'QQUAD'],
+    ['\\quad', 'QUAD'],
+    ['\\right', 'RIGHT'],
+    ['\\root', 'ROOT'],
+    ['\\sqrt', 'SQRT'],
+    ['\\text', 'TEXT']]
+
+# Control sequences that take an optional argument in brackets
+bracket_list = ['\\sqrt']
+
 def read_table(filename_list):
     table = []
     character_line = []
@@ -116,6 +148,150 @@ def print_c_form(table):
         print '    ' + maputil.ucs_c_form(slot) + ','
     print '};'
 
+def read_font_change(filename):
+    table = []
+    file = open(filename, 'r')
+    try:
+        content = file.read().split('\n')
+    finally:
+        file.close()
+    for line in content:
+        if line[:1] == '#':
+            continue
+        if line.find('\t') != -1:
+            code, family = line.split('\t')
+            table.append([code, family])
+    return table
+
+def read_operator(filename):
+    file = open(filename, 'r')
+    try:
+        content = file.read()
+    finally:
+        file.close()
+    array = re.search('operator_control_sequence\\[noperator\\] = ' +
+                      '\\{([^}]*)\\}', content).group(1)
+    return [code.replace('\\\\', '\\') for code in
+            re.findall('"((?:[^"\\\\]|\\\\.)*)"', array)]
+
+# FNV-1 variant used for the minimal perfect hash, over the name
+# without the escape character. Must agree with
+# math_text_t::control_sequence_hash().
+def hash_control_sequence(seed, code):
+    if seed == 0:
+        seed = 0x01000193
+    for c in code[1:]:
+        seed = ((seed * 0x01000193) ^ ord(c)) & 0xffffffff
+    return seed
+
+# Hash and displace: keys colliding in the first level hash are
+# moved together using a per-bucket seed, single keys are put into
+# the remaining free slots directly (stored as -slot - 1)
+def perfect_hash(key_list):
+    n = len(key_list)
+    bucket = [[] for i in range(n)]
+    for key in key_list:
+        bucket[hash_control_sequence(0, key) % n].append(key)
+    bucket_order = range(n)
+    bucket_order.sort(lambda u, v: cmp(len(bucket[v]), len(bucket[u])))
+    displacement = [0] * n
+    slot = [None] * n
+    for b in bucket_order:
+        if len(bucket[b]) <= 1:
+            break
+        seed = 1
+        while True:
+            candidate = [hash_control_sequence(seed, key) % n
+                         for key in bucket[b]]
+            if len(set(candidate)) == len(candidate) and \
+               all(slot[i] == None for i in candidate):
+                break
+            seed += 1
+        displacement[b] = seed
+        for key, i in zip(bucket[b], candidate):
+            slot[i] = key
+    free = [i for i in range(n) if slot[i] == None]
+    for b in bucket_order:
+        if len(bucket[b]) == 1:
+            i = free.pop()
+            displacement[b] = -i - 1
+            slot[i] = bucket[b][0]
+    return displacement, slot
+
+def print_c_form_control_sequence(table):
+    descriptor = {}
+    def lookup(code):
+        if not descriptor.has_key(code):
+            descriptor[code] = {
+                'primitive': 'UNKNOWN', 'bracket': False,
+                'glyph': None, 'family': None, 'operator': None}
+        return descriptor[code]
+    for code, primitive in primitive_table:
+        lookup(code)['primitive'] = primitive
+    for code in bracket_list:
+        lookup(code)['bracket'] = True
+    # The table is stably sorted by control sequence, and the first
+    # definition of a duplicated control sequence wins, as with the
+    # std::lower_bound lookup this table replaces
+    for slot, type, upright, code in table:
+        entry = lookup(code)
+        if entry['glyph'] != None:
+            continue
+        if type == 'Alpha':
+            type = 'Ord'
+        if type != '-':
+            entry['glyph'] = [slot, type.upper(), upright != '0']
+        else:
+            entry['glyph'] = [slot, 'ORD', True]
+    for code, family in read_font_change(filename_font_change):
+        lookup(code)['family'] = family
+    index = 0
+    for code in read_operator(filename_operator):
+        lookup(code)['operator'] = index
+        index += 1
+    displacement, slot = perfect_hash(descriptor.keys())
+    print 'static const unsigned long ncontrol_sequence = %d;' % \
+          len(slot)
+    print 'static const int ' + \
+          'control_sequence_displacement[ncontrol_sequence] = {'
+    for d in displacement:
+        print '    %d,' % d
+    print '};'
+    print
+    print 'static const control_sequence_t ' + \
+          'control_sequence[ncontrol_sequence] = {'
+    for code in slot:
+        entry = descriptor[code]
+        line = '    { "' + maputil.escape_c_form(code) + '", ' + \
+               'tex_token_t::CONTROL_SEQUENCE_' + entry['primitive'] + \
+               ', '
+        if entry['bracket']:
+            line += 'true,'
+        else:
+            line += 'false,'
+        print line
+        line = '      '
+        if entry['glyph'] != None:
+            glyph_slot, type, upright = entry['glyph']
+            line += maputil.ucs_c_form(glyph_slot) + ', atom_t::TYPE_' + \
+                    type + ', '
+            if upright:
+                line += 'true, '
+            else:
+                line += 'false, '
+        else:
+            line += "L'\\0', atom_t::TYPE_UNKNOWN, false, "
+        if entry['family'] != None:
+            line += 'math_symbol_t::' + entry['family'] + ', '
+        else:
+            line += '-1, '
+        if entry['operator'] != None:
+            line += '%d },' % entry['operator']
+        else:
+            line += '-1 },'
+        print line
+    print '};'
+
 table, character_line, uncoded_line = read_table(filename_list)
 table_alias = read_table_alias(filename_list_alias)
 for def_to, def_from in table_alias:
@@ -135,6 +311,8 @@ table.sort(lambda u, v: cmp(u[3], v[3]))
 
 if sys.argv[1] == '--table':
     print_c_form(table)
+elif sys.argv[1] == '--control-sequence':
+    print_c_form_control_sequence(table)
 elif sys.argv[1] == '--table-typeless':
     for slot, type, upright, code in table:
         if type == '-':
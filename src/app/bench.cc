@@ -0,0 +1,410 @@
+// mathtext - A TeX/LaTeX compatible rendering library. Copyright (C)
+// 2008-2016 Yue Shi Lai <ylai@users.sourceforge.net>
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2.1 of
+// the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// 02110-1301 USA
+
+// Time and allocations per formula of each stage from the TeX source
+// to an EPS file, over corpora of formulae, without a display:
+//
+//   tex_split     lexer only
+//   parse         math_text_t construction, i.e. tex_split and
+//                 parse_math_list
+//   layout_stub   layout with constant glyph metrics, i.e. the layout
+//                 engine alone
+//   layout        layout with the FreeType metrics of
+//                 postscript_surface_t
+//   eps           a complete EPS file per formula, including opening
+//                 the fonts and embedding their subsets, with the
+//                 layouts taken from math_text_cache_t::global() as
+//                 for repeated labels
+//
+// If built with MATHTEXT_STATISTICS, the eps results also have the
+// sum of the statistics of the formulae drawn while timing.
+//
+// Allocations are those through operator new. The result is written
+// as JSON to stdout, to be compared between releases.
+//
+// Usage: bench [font basename [EPS filename]]
+//
+// The defaults are data/font/Arimo, as for mathtest, and /dev/null.
+
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include <new>
+#include <string>
+#include <vector>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <gluon/surface.h>
+#include <mathtext/mathtext.h>
+#include <mathtext/mathrender.h>
+#include "symboltable.h"
+
+#if __cplusplus >= 201103L
+#define ALLOCATION_THROW
+#define ALLOCATION_NOTHROW noexcept
+#else // __cplusplus >= 201103L
+#define ALLOCATION_THROW throw (std::bad_alloc)
+#define ALLOCATION_NOTHROW throw ()
+#endif // __cplusplus >= 201103L
+
+namespace {
+
+	unsigned long allocation_count = 0;
+	unsigned long allocation_byte = 0;
+
+}
+
+// The array forms are implemented by the library in terms of these
+
+void *operator new(size_t size) ALLOCATION_THROW
+{
+	allocation_count++;
+	allocation_byte += size;
+
+	void *pointer = malloc(size == 0 ? 1 : size);
+
+	if (pointer == NULL)
+		throw std::bad_alloc();
+
+	return pointer;
+}
+
+void operator delete(void *pointer) ALLOCATION_NOTHROW
+{
+	free(pointer);
+}
+
+#ifdef __cpp_sized_deallocation
+void operator delete(void *pointer, size_t size) ALLOCATION_NOTHROW
+{
+	free(pointer);
+}
+#endif // __cpp_sized_deallocation
+
+namespace {
+
+	// Minimum duration of a measurement, repeating the corpus
+	const double minimum_time = 0.25;
+
+	const float default_font_size = 24;
+
+	/**
+	 * Renderer with constant glyph metrics, for timing the layout
+	 * engine without the font backend
+	 */
+	class stub_renderer_t : public mathtext::math_text_renderer_t {
+	private:
+		float _font_size[NFAMILY];
+	protected:
+		mathtext::affine_transform_t
+		transform_logical_to_pixel(void) const
+		{
+			return mathtext::affine_transform_t(1, 0, 0, 1, 0, 0);
+		}
+		mathtext::affine_transform_t
+		transform_pixel_to_logical(void) const
+		{
+			return mathtext::affine_transform_t(1, 0, 0, 1, 0, 0);
+		}
+	public:
+		stub_renderer_t(void)
+		{
+			set_font_size(default_font_size);
+		}
+		float font_size(const unsigned int family = FAMILY_PLAIN)
+			const
+		{
+			return _font_size[family];
+		}
+		void set_font_size(const float size, const unsigned int family)
+		{
+			_font_size[family] = size;
+		}
+		void set_font_size(const float size)
+		{
+			std::fill(_font_size, _font_size + NFAMILY, size);
+		}
+		void reset_font_size(const unsigned int family)
+		{
+		}
+		void point(const float x, const float y)
+		{
+		}
+		void filled_rectangle(const mathtext::bounding_box_t &
+							  bounding_box)
+		{
+		}
+		void rectangle(const mathtext::bounding_box_t &bounding_box)
+		{
+		}
+		mathtext::bounding_box_t
+		bounding_box(const std::wstring string,
+					 const unsigned int family = FAMILY_PLAIN)
+		{
+			return bounding_box(string, family, _font_size[family]);
+		}
+		// About the proportions of a Latin lowercase letter
+		mathtext::bounding_box_t
+		bounding_box(const std::wstring string,
+					 const unsigned int family, const float size) const
+		{
+			const float width = 0.5F * size * string.size();
+
+			return mathtext::bounding_box_t(
+				0, -0.2F * size, width, 0.7F * size, width, 0);
+		}
+		void text_raw(const float x, const float y,
+					  const std::wstring string,
+					  const unsigned int family = FAMILY_PLAIN)
+		{
+		}
+		void text_with_bounding_box(
+			const float x, const float y, const std::wstring string,
+			const unsigned int family = FAMILY_PLAIN)
+		{
+		}
+	};
+
+	enum {
+		STAGE_TEX_SPLIT = 0,
+		STAGE_PARSE,
+		STAGE_LAYOUT_STUB,
+		STAGE_LAYOUT,
+		STAGE_EPS,
+		NSTAGE
+	};
+
+	const char *stage_name[NSTAGE] = {
+		"tex_split", "parse", "layout_stub", "layout", "eps"
+	};
+
+	class corpus_t {
+	public:
+		std::string _name;
+		std::vector<std::string> _code;
+		std::vector<mathtext::math_text_t> _math_text;
+		corpus_t(const std::string &name)
+			: _name(name)
+		{
+		}
+		void push_back(const std::string &code)
+		{
+			_code.push_back(code);
+			_math_text.push_back(mathtext::math_text_t(code));
+		}
+	};
+
+	std::string nest(const std::string &prefix, const std::string &suffix,
+					 const std::string &inner, const unsigned int depth)
+	{
+		std::string ret = inner;
+
+		for (unsigned int i = 0; i < depth; i++)
+			ret = prefix + ret + suffix;
+
+		return ret;
+	}
+
+	std::vector<corpus_t> build_corpus(void)
+	{
+		std::vector<corpus_t> corpus;
+
+		corpus.push_back(corpus_t("mathtest"));
+		corpus.back().push_back(
+			"\\prod_{j\\ge0} \\left(\\sum_{k\\ge0} a_{jk}z^k\\right) = "
+			"\\sum_{n\\ge0} z^n \\left(\\sum_{k_0,k_1,\\ldots\\ge0\\atop "
+			"k_0+k_1+\\cdots=n} a_{0k_0}a_{1k_1} \\cdots \\right)");
+
+		corpus.push_back(corpus_t("symbol"));
+		for (size_t i = 0; i < nsymbol; i++)
+			corpus.back().push_back(symbol[i]);
+
+		corpus.push_back(corpus_t("nesting"));
+		for (unsigned int depth = 4; depth <= 16; depth *= 2) {
+			corpus.back().push_back(
+				nest("\\left(", "+y\\right)", "x", depth));
+			corpus.back().push_back(nest("{1\\over ", "}", "x", depth));
+			corpus.back().push_back(nest("x^{", "}", "x", depth));
+			corpus.back().push_back(nest("\\sqrt{", "}", "x", depth));
+			corpus.back().push_back(nest("\\^{", "}", "x", depth));
+		}
+
+		corpus.push_back(corpus_t("flat_sum"));
+		for (unsigned int length = 10; length <= 1000; length *= 10) {
+			std::string code;
+
+			for (unsigned int i = 0; i < length; i++) {
+				char term[32];
+
+				snprintf(term, 32, "a_{%u}+", i);
+				code.append(term);
+			}
+			code.append("b");
+			corpus.back().push_back(code);
+		}
+
+		return corpus;
+	}
+
+	double now(void)
+	{
+		struct timeval tv;
+
+		gettimeofday(&tv, NULL);
+
+		return tv.tv_sec + 1e-6 * tv.tv_usec;
+	}
+
+	class context_t {
+	public:
+		std::string _font_basename;
+		std::string _filename;
+		stub_renderer_t _stub;
+		gluon::postscript_surface_t *_surface;
+		// Keeps results alive, so that no stage can be optimized away
+		volatile size_t _sink;
+#ifdef MATHTEXT_STATISTICS
+		mathtext::statistics_t _statistics;
+#endif // MATHTEXT_STATISTICS
+	};
+
+	void run(context_t &context, const corpus_t &corpus,
+			 const unsigned int stage)
+	{
+		for (size_t i = 0; i < corpus._code.size(); i++) {
+			switch (stage) {
+			case STAGE_TEX_SPLIT:
+				context._sink += mathtext::math_text_t::
+					tex_token_count(corpus._code[i]);
+				break;
+			case STAGE_PARSE:
+				context._sink +=
+					mathtext::math_text_t(corpus._code[i]).empty();
+				break;
+			case STAGE_LAYOUT_STUB:
+				context._sink += context._stub.layout(
+					corpus._math_text[i], true).empty();
+				break;
+			case STAGE_LAYOUT:
+				context._sink += context._surface->layout(
+					corpus._math_text[i], true).empty();
+				break;
+			case STAGE_EPS:
+				{
+					gluon::postscript_surface_t
+						surface(context._filename, 1280, 360);
+
+					surface.open_font(context._font_basename);
+					surface.set_font_size(default_font_size);
+					surface.text(32, 180, 0, corpus._math_text[i], 0);
+#ifdef MATHTEXT_STATISTICS
+					context._statistics +=
+						surface.formula_statistics();
+#endif // MATHTEXT_STATISTICS
+				}
+				break;
+			}
+		}
+	}
+
+	void benchmark(context_t &context, const corpus_t &corpus,
+				   const unsigned int stage, const bool last)
+	{
+		// Warm up the glyph metrics caches and the font files
+		run(context, corpus, stage);
+#ifdef MATHTEXT_STATISTICS
+		context._statistics.clear();
+#endif // MATHTEXT_STATISTICS
+
+		const unsigned long count = allocation_count;
+		const unsigned long byte = allocation_byte;
+		const double start = now();
+		unsigned long repeat = 0;
+		double elapsed;
+
+		do {
+			run(context, corpus, stage);
+			repeat++;
+			elapsed = now() - start;
+		} while (elapsed < minimum_time);
+
+		const double nformula =
+			static_cast<double>(repeat) * corpus._code.size();
+
+		printf("    { \"corpus\": \"%s\", \"stage\": \"%s\", "
+			   "\"formulae\": %lu, \"ns_per_formula\": %.0f, "
+			   "\"allocations_per_formula\": %.1f, "
+			   "\"bytes_per_formula\": %.0f",
+			   corpus._name.c_str(), stage_name[stage],
+			   static_cast<unsigned long>(corpus._code.size()),
+			   elapsed * 1e+9 / nformula,
+			   (allocation_count - count) / nformula,
+			   (allocation_byte - byte) / nformula);
+#ifdef MATHTEXT_STATISTICS
+		if (stage == STAGE_EPS)
+			printf(", \"statistics\": %s",
+				   context._statistics.json().c_str());
+#endif // MATHTEXT_STATISTICS
+		printf(" }%s\n", last ? "" : ",");
+		fflush(stdout);
+	}
+
+	long peak_rss_kib(void)
+	{
+		struct rusage usage;
+
+		if (getrusage(RUSAGE_SELF, &usage) != 0)
+			return -1;
+#ifdef __APPLE__
+		// Bytes instead of KiB
+		return usage.ru_maxrss / 1024;
+#else // __APPLE__
+		return usage.ru_maxrss;
+#endif // __APPLE__
+	}
+
+}
+
+int main(int argc, char *argv[])
+{
+	context_t context;
+
+	context._font_basename = argc > 1 ? argv[1] : "data/font/Arimo";
+	context._filename = argc > 2 ? argv[2] : "/dev/null";
+	context._sink = 0;
+
+	const std::vector<corpus_t> corpus = build_corpus();
+
+	// Only measures, and writes an empty page when destroyed
+	gluon::postscript_surface_t surface(context._filename, 1280, 360);
+
+	surface.open_font(context._font_basename);
+	surface.set_font_size(default_font_size);
+	context._surface = &surface;
+
+	printf("{\n  \"font\": \"%s\",\n  \"result\": [\n",
+		   context._font_basename.c_str());
+	for (size_t i = 0; i < corpus.size(); i++)
+		for (unsigned int stage = STAGE_TEX_SPLIT; stage < NSTAGE;
+			 stage++)
+			benchmark(context, corpus[i], stage,
+					  i + 1 == corpus.size() && stage + 1 == NSTAGE);
+	printf("  ],\n  \"peak_rss_kib\": %ld\n}\n", peak_rss_kib());
+
+	return 0;
+}
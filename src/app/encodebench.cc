@@ -0,0 +1,197 @@
+// mathtext - A TeX/LaTeX compatible rendering library. Copyright (C)
+// 2008-2016 Yue Shi Lai <ylai@users.sourceforge.net>
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2.1 of
+// the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// 02110-1301 USA
+
+// Throughput of the ASCIIHex and ASCII85 encoders used for embedded
+// fonts and images, for each instruction set available, against the
+// former implementation that appends to a string one character at a
+// time. The input is random data, or the files given as arguments.
+//
+// Usage: encodebench [file...]
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <sys/time.h>
+#include <mathtext/fontsink.h>
+#include <mathtext/fontblob.h>
+
+namespace {
+
+	// Input encoded per measurement, to run long enough to time
+	const size_t total_length = 64 << 20;
+
+	void append_asciihex_reference(std::string &ascii,
+								   const uint8_t *buffer,
+								   const size_t length)
+	{
+		const int width = 64;
+		int column = 0;
+
+		for (size_t i = 0; i < length; i++) {
+			char str[3];
+
+			snprintf(str, 3, "%02hhX", buffer[i]);
+			ascii.append(str, 2);
+			column += 2;
+			if (column >= width) {
+				ascii.append(1, '\n');
+				column = 0;
+			}
+		}
+	}
+
+	void append_ascii85_reference(std::string &ascii,
+								  const uint8_t *buffer,
+								  const size_t length)
+	{
+		const int width = 64;
+		int column = 0;
+
+		for (size_t i = 0; i + 4 <= length; i += 4) {
+			unsigned int dword =
+				(buffer[i] << 24) | (buffer[i + 1] << 16) |
+				(buffer[i + 2] << 8) | buffer[i + 3];
+
+			if (dword == 0) {
+				ascii.append(1, 'z');
+				column++;
+				if (column == width - 1) {
+					ascii.append(1, '\n');
+					column = 0;
+				}
+			}
+			else {
+				char str[5];
+
+				for (int j = 4; j >= 0; j--) {
+					str[j] = static_cast<char>(dword % 85 + '!');
+					dword /= 85;
+				}
+				for (size_t j = 0; j < 5; j++) {
+					ascii.append(1, str[j]);
+					column++;
+					if (column == width) {
+						ascii.append(1, '\n');
+						column = 0;
+					}
+				}
+			}
+		}
+		ascii.append("~>");
+	}
+
+	double now(void)
+	{
+		struct timeval tv;
+
+		gettimeofday(&tv, NULL);
+
+		return tv.tv_sec + 1e-6 * tv.tv_usec;
+	}
+
+	// Returns MB/s of input, with the output kept in memory as the
+	// embedders do when returning strings
+	double throughput(const std::vector<uint8_t> &data,
+					  const bool ascii85, const bool reference)
+	{
+		const size_t repeat =
+			std::max(static_cast<size_t>(1), total_length / data.size());
+		std::string ascii;
+		const double start = now();
+
+		for (size_t i = 0; i < repeat; i++) {
+			ascii.clear();
+			if (reference) {
+				if (ascii85)
+					append_ascii85_reference(ascii, &data[0],
+											 data.size());
+				else
+					append_asciihex_reference(ascii, &data[0],
+											  data.size());
+			}
+			else {
+				mathtext::string_sink_t sink(ascii);
+
+				if (ascii85) {
+					mathtext::ascii85_sink_t encoder(sink);
+
+					encoder.write(&data[0], data.size());
+					encoder.finish();
+				}
+				else {
+					mathtext::asciihex_sink_t encoder(sink);
+
+					encoder.write(&data[0], data.size());
+				}
+			}
+		}
+
+		return repeat * data.size() / (now() - start) / 1e+6;
+	}
+
+	void benchmark(const char *name, const std::vector<uint8_t> &data)
+	{
+		static const char *instruction_set_name[] = {
+			"scalar", "SSE2", "AVX2"
+		};
+		const mathtext::encoder_instruction_set_t default_set =
+			mathtext::encoder_instruction_set();
+
+		printf("%s (%lu bytes)\n", name,
+			   static_cast<unsigned long>(data.size()));
+		printf("  %-10s %12s %12s\n", "", "ASCIIHex", "ASCII85");
+		printf("  %-10s %9.1f MB/s %7.1f MB/s\n", "reference",
+			   throughput(data, false, true),
+			   throughput(data, true, true));
+		for (int i = mathtext::ENCODER_SCALAR;
+			 i <= mathtext::ENCODER_AVX2; i++) {
+			if (mathtext::set_encoder_instruction_set(
+					static_cast<mathtext::encoder_instruction_set_t>(i)))
+				printf("  %-10s %9.1f MB/s %7.1f MB/s\n",
+					   instruction_set_name[i],
+					   throughput(data, false, false),
+					   throughput(data, true, false));
+		}
+		mathtext::set_encoder_instruction_set(default_set);
+	}
+
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc < 2) {
+		std::vector<uint8_t> data(1 << 20);
+
+		srand(1);
+		for (size_t i = 0; i < data.size(); i++)
+			data[i] = rand() >> 8;
+		benchmark("random", data);
+	}
+	for (int i = 1; i < argc; i++) {
+		const mathtext::font_blob_t blob =
+			mathtext::font_blob_t::open(argv[i]);
+
+		if (blob.empty())
+			continue;
+		benchmark(argv[i], std::vector<uint8_t>(blob.begin(),
+												blob.end()));
+	}
+
+	return 0;
+}
@@ -0,0 +1,70 @@
+// mathtext - A TeX/LaTeX compatible rendering library. Copyright (C)
+// 2008-2012 Yue Shi Lai <ylai@users.sourceforge.net>
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2.1 of
+// the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// 02110-1301 USA
+
+#include <cstdio>
+#include <string>
+#include <gluon/surface.h>
+#include <mathtext/mathtext.h>
+
+// Renders the formula of mathtest into an image file, without a
+// display. The output is PPM if the file name ends with .ppm, and
+// PNG otherwise.
+
+int main(int argc, char *argv[])
+{
+	const char *string = "\\prod_{j\\ge0} \\left(\\sum_{k\\ge0} a_{jk}z^k\\right) = \\sum_{n\\ge0} z^n \\left(\\sum_{k_0,k_1,\\ldots\\ge0\\atop k_0+k_1+\\cdots=n} a_{0k_0}a_{1k_1} \\cdots \\right)";
+	std::string filename = "mathtest.png";
+
+	if (argc > 1) {
+		string = argv[1];
+	}
+	if (argc > 2) {
+		filename = argv[2];
+	}
+
+	mathtext::math_text_t text(string);
+
+	text.render_structure() = true;
+
+	gluon::raster_surface_t surface(1280, 360);
+
+	surface.open_font("data/font/Arimo");
+	surface.set_font_size(64);
+	surface.set_point_size(2);
+	surface.set_rgb_color(0, 0, 0);
+
+	const float baseline = 180;
+
+	surface.line(32, baseline, surface.rect().right(), baseline);
+	surface.line(32, baseline + surface.default_axis_height(),
+				 surface.rect().right(),
+				 baseline + surface.default_axis_height());
+	surface.text(32, baseline, 0, text, 0);
+
+	const bool ppm = filename.size() >= 4 &&
+		filename.compare(filename.size() - 4, 4, ".ppm") == 0;
+
+	if (!(ppm ? surface.write_ppm(filename) :
+		  surface.write_png(filename))) {
+		fprintf(stderr, "%s:%d: error: cannot write `%s'\n",
+				__FILE__, __LINE__, filename.c_str());
+		return 1;
+	}
+
+	return 0;
+}
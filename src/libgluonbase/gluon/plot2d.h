@@ -22,7 +22,9 @@
 #define GLUON_PLOT2D_H_
 
 #include <stdint.h>
+#include <algorithm>
 #include <iostream>
+#include <vector>
 #include <gluon/geometry.h>
 #include <gluon/color.h>
 #include <gluon/rect.h>
@@ -144,6 +146,26 @@ namespace gluon {
 								 const float distance = 0)
 		{
 		}
+		/**
+		 * Draws many labels with the same alignment at once, e.g.
+		 * the tick labels of an axis
+		 *
+		 * The default implementation draws each label with text().
+		 * surface_t overrides it to group the glyphs of all labels
+		 * into runs.
+		 */
+		inline virtual void
+		text(const std::vector<point_t> &position,
+			 const std::vector<mathtext::math_text_t> &math_text,
+			 const unsigned int alignment, const float distance = 0)
+		{
+			const size_t size =
+				std::min(position.size(), math_text.size());
+
+			for (size_t i = 0; i < size; i++)
+				text(position[i][0], position[i][1], alignment,
+					 math_text[i], distance);
+		}
 		// Range
 		void set_range(const double u0, const double u1,
 					   const double v0, const double v1);
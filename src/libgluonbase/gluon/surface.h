@@ -22,6 +22,8 @@
 #define GLUON_SURFACE_H_
 
 #include <string>
+#include <vector>
+#include <map>
 #include <iostream>
 #include <sstream>
 #include <stdint.h>
@@ -44,6 +46,9 @@
 #include <gluon/rect.h>
 #include <gluon/color.h>
 #include <mathtext/mathrender.h>
+#include <mathtext/fontblob.h>
+#include <mathtext/fontsink.h>
+#include <mathtext/fontembed.h>
 #include <gluon/plot2d.h>
 
 namespace gluon {
@@ -85,6 +90,7 @@ namespace gluon {
 		float _current_font_size[NFAMILY];
 		void delete_subsurface(void);
 		bool delete_supersurface(void);
+		void reset_font_identity(void);
 		inline virtual void begin_coordinate_matrix(void)
 		{
 		}
@@ -101,6 +107,23 @@ namespace gluon {
 		{
 			begin_coordinate_matrix();
 		}
+		/**
+		 * Converts the RGBA densities of raster() into 8 bit RGB
+		 * values, dropping the alpha channel
+		 */
+		static void quantize_rgb(uint8_t rgb[], const float density[],
+								 const size_t npixel);
+#ifdef HAVE_ZLIB
+		/**
+		 * Writes 8 bit gray (nchannel = 1), RGB (3) or RGBA (4)
+		 * pixels as a PNG image, with the first row at the top
+		 */
+		static void write_png(mathtext::font_sink_t &sink,
+							  const uint8_t pixel[],
+							  const unsigned int width,
+							  const unsigned int height,
+							  const unsigned int nchannel);
+#endif // HAVE_ZLIB
 		void
 		text_with_bounding_box(const float x, const float y,
 							   const std::wstring string,
@@ -128,11 +151,13 @@ namespace gluon {
 		inline surface_t(const rect_t &rect, const bool master = false)
 			: plot_2d_t(rect), _master(master), _supersurface(NULL)
 		{
+			reset_font_identity();
 		}
 		inline surface_t(surface_t &surface)
 			: plot_2d_t(surface._rect), _master(false),
 			  _supersurface(&surface)
 		{
+			reset_font_identity();
 		}
 		~surface_t(void);
 		surface_t &surface(const rect_t &rect);
@@ -353,10 +378,23 @@ namespace gluon {
 			return _current_font_size[family];
 		}
 		/////////////////////////////////////////////////////////////
+		// Formulae are laid out through
+		// mathtext::math_text_cache_t::global(), so that repeated
+		// labels are laid out once for all surfaces with the same
+		// fonts
 		virtual void text(const float x, const float y,
 						  const unsigned int alignment,
 						  const mathtext::math_text_t &math_text,
 						  const float distance = 0.0F);
+		virtual void text(const float x, const float y,
+						  const unsigned int alignment,
+						  const math_layout_t &math_text_layout,
+						  const float distance = 0.0F);
+		virtual void
+		text(const std::vector<point_t> &position,
+			 const std::vector<mathtext::math_text_t> &math_text,
+			 const unsigned int alignment,
+			 const float distance = 0.0F);
 		using math_text_renderer_t::bounding_box;
 		using math_text_renderer_t::text_raw;
 	};
@@ -486,17 +524,73 @@ namespace gluon {
 #endif // defined(HAVE_SDL) && defined(HAVE_OPENGL)
 
 	class postscript_surface_t : public surface_t {
+	public:
+		enum {
+			RASTER_COMPRESSION_NONE = 0,
+			RASTER_COMPRESSION_RUN_LENGTH,
+			RASTER_COMPRESSION_FLATE,
+			NRASTER_COMPRESSION
+		};
 	private:
+		/**
+		 * Text state of the output file, shared by a surface and its
+		 * subsurfaces
+		 *
+		 * Glyphs are drawn with show/xshow through reencoded copies
+		 * of the embedded fonts. Glyph i of a font is at character
+		 * code 32 + i % nglyph_per_encoding of the reencoded font
+		 * i / nglyph_per_encoding, so that the first glyphs of each
+		 * reencoded font need no escaping in string literals.
+		 *
+		 * The glyphs drawn so far are also the glyph usage of each
+		 * font, and the font data is kept from the first glyph on,
+		 * so that the fonts are embedded as subsets when the output
+		 * file is closed.
+		 *
+		 * Glyphs drawn as outlines are instead numbered in the order
+		 * of their first use, across all fonts, and glyph n is
+		 * defined in the prolog as the procedure /mtg<n>.
+		 */
+		class text_state_t {
+		public:
+			std::map<std::string, std::vector<wchar_t> > _glyph;
+			std::map<std::string, std::map<wchar_t, unsigned int> >
+			_code;
+			std::map<std::string, mathtext::font_blob_t> _font_data;
+			std::map<std::string, std::map<uint16_t, unsigned int> >
+			_outline;
+			std::map<std::string, mathtext::font_blob_t>
+			_outline_font_data;
+			unsigned int _noutline;
+			std::string _current_font_name;
+			unsigned int _current_encoding;
+			float _current_size;
+			inline text_state_t(void)
+				: _noutline(0), _current_encoding(0), _current_size(0)
+			{
+			}
+		};
+		static const unsigned int nglyph_per_encoding = 224;
+		static const unsigned int nglyph_per_show = 32;
+		text_state_t *_text_state;
+		unsigned int _raster_compression;
+		bool _raster_binary;
+		bool _glyph_outline;
 		void open_output_file(void);
-		void write_dsc_preamble(void) const;
-		void write_dsc_trailer(void) const;
+		void write_dsc_preamble(FILE *fp) const;
+		void write_glyph_procedure(FILE *fp) const;
+		void write_dsc_prolog(FILE *fp,
+							  std::vector<std::string> &font_resource)
+			const;
+		void
+		write_dsc_trailer(FILE *fp,
+						  const std::vector<std::string> &font_resource)
+			const;
 		void close_output_file(void);
 #if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
 		void freetype_init(void);
-		void read_font_data(std::vector<FT_Byte> &font_data,
-							const std::string &filename) const;
-		FT_Glyph_Metrics &
-		freetype_metrics(const wchar_t character,
+		FT_Glyph_Metrics
+		freetype_metrics(const uint16_t glyph,
 						 const unsigned int family) const;
 		bool
 		parse_otf_cff_header(std::string &font_name,
@@ -505,25 +599,40 @@ namespace gluon {
 							 const std::vector<FT_Byte> font_data)
 			const;
 #endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
-		unsigned int ascii85_line_count(const uint8_t *buffer,
-										const size_t length) const;
-		void
-		append_ascii85(std::string &ascii, const uint8_t *buffer,
-					   const size_t length) const;
-#if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
-		std::string
-		font_embed_type_2(std::string &font_name,
-						  const std::vector<FT_Byte> &font_data)
-			const;
-#endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		uint16_t glyph_index(const wchar_t character,
+							 const unsigned int family) const;
+		bool glyph_metrics(float &advance, float bounding_box[4],
+						   const wchar_t character,
+						   const unsigned int family) const;
+		void write_glyph_name(const wchar_t glyph) const;
+		void encode(std::vector<unsigned int> &code,
+					const unsigned int family,
+					const std::wstring &string);
+		void encode_outline(std::vector<unsigned int> &procedure,
+							const unsigned int family,
+							const std::wstring &string);
+		void select_font(const unsigned int family,
+						 const unsigned int encoding,
+						 const float size);
+		void write_string(const std::vector<unsigned int> &code,
+						  const size_t begin, const size_t end) const;
 	protected:
 		std::string _filename;
 #if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		// Only needed for fonts without a metrics table, and for
+		// characters not in the parsed cmap
 		FT_Library _freetype_library;
 		FT_Face _font[NFAMILY];
-		std::vector<FT_Byte> _font_data[NFAMILY];
+		// Guards the glyph slots of _font, which FT_Load_Glyph()
+		// overwrites
+		mutable mathtext::mutex_t _freetype_mutex;
 #endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		mathtext::font_blob_t _font_data[NFAMILY];
+		// Shared by _font_data, NULL if no font is open
+		const mathtext::font_metrics_t *_font_metrics[NFAMILY];
 		std::string _font_name[NFAMILY];
+		// Spool of the page description, which is copied into
+		// _filename after the prolog when the output file is closed
 		FILE *_fp;
 		float _current_point_size;
 	public:
@@ -561,6 +670,370 @@ namespace gluon {
 		void
 		filled_rectangle(const mathtext::bounding_box_t &
 						 bounding_box) const;
+		/**
+		 * Selects the filter compressing the image data of raster(),
+		 * by default RASTER_COMPRESSION_NONE. Without zlib,
+		 * RASTER_COMPRESSION_RUN_LENGTH replaces
+		 * RASTER_COMPRESSION_FLATE. Subsurfaces created afterwards
+		 * inherit the selection.
+		 */
+		void set_raster_compression(const unsigned int compression);
+		/**
+		 * Selects whether raster() writes the image data as binary,
+		 * enclosed in %%BeginData/%%EndData, instead of ASCII85
+		 * encoded, which is the default. Subsurfaces created
+		 * afterwards inherit the selection.
+		 */
+		void set_raster_binary(const bool binary);
+		void
+		raster(const float x, const float y, const float width,
+			   const float height, const float density[],
+			   const int nhorizontal, const int nvertical) const;
+		/////////////////////////////////////////////////////////////
+		void open_font_overwrite(const std::string &filename,
+								 const unsigned int family =
+								 FAMILY_PLAIN);
+		void open_font_default(const std::string &filename,
+							   const unsigned int family =
+							   FAMILY_PLAIN);
+		/**
+		 * Selects whether glyphs are drawn as filled outlines instead
+		 * of text, which is the default. Each glyph drawn is decoded
+		 * once from the font data and defined as a procedure in the
+		 * prolog, and no fonts are embedded for them. Subsurfaces
+		 * created afterwards inherit the selection.
+		 */
+		void set_glyph_outline(const bool outline);
+		void text_raw(const float x, const float y,
+					  const std::wstring string,
+					  const unsigned int family);
+		mathtext::bounding_box_t
+		bounding_box(const std::wstring string,
+					 const unsigned int family);
+		mathtext::bounding_box_t
+		bounding_box(const std::wstring string,
+					 const unsigned int family,
+					 const float size) const;
+	protected:
+		void prepare_glyph_run(
+			const math_glyph_iterator_t &glyph_begin,
+			const math_glyph_iterator_t &glyph_end);
+		void glyph_run(const math_glyph_iterator_t &glyph_begin,
+					   const math_glyph_iterator_t &glyph_end);
+#ifdef MATHTEXT_STATISTICS
+	protected:
+		// Size of the page description spooled so far
+		unsigned long output_size(void) const;
+#endif // MATHTEXT_STATISTICS
+	};
+
+	/**
+	 * Surface that writes a PDF document directly
+	 *
+	 * Objects are written as soon as they are complete, and only the
+	 * content stream of the current page and the byte offsets of the
+	 * objects are held in memory, so that documents with many pages
+	 * can be written in constant memory. Each font is embedded once
+	 * per document, as soon as it is opened, and shared by all pages
+	 * and subsurfaces through a single resource dictionary. Content
+	 * streams are Flate compressed if zlib is available.
+	 */
+	class pdf_surface_t : public surface_t {
+	private:
+		/**
+		 * Document state, shared by a surface and its subsurfaces
+		 */
+		class document_t {
+		public:
+			FILE *_fp;
+			// Byte offset of each object, 0 if only reserved
+			std::vector<long> _object_offset;
+			unsigned int _catalog;
+			unsigned int _page_tree;
+			unsigned int _resource;
+			std::vector<unsigned int> _page;
+			// Fonts are written at the end of the document, subset
+			// to the characters drawn with them. Glyphs drawn as
+			// outlines are instead written as form XObjects /G<n>,
+			// numbered across all fonts.
+			class font_t {
+			public:
+				std::string _resource_name;
+				mathtext::font_blob_t _font_data;
+				std::map<wchar_t, bool> _glyph_usage;
+				std::map<uint16_t, unsigned int> _outline;
+			};
+			std::map<std::string, font_t> _font;
+			unsigned int _noutline;
+			// Content stream of the current page, and its text
+			// state
+			std::string _content;
+			std::string _current_font_resource;
+			float _current_size;
+			// Restored at each new page, negative if never set
+			float _line_width;
+			inline document_t(void)
+				: _fp(NULL), _catalog(0), _page_tree(0),
+				  _resource(0), _noutline(0), _current_size(0),
+				  _line_width(-1)
+			{
+			}
+			unsigned int reserve_object(void);
+			void begin_object(const unsigned int object);
+			void end_object(void);
+		};
+		/**
+		 * Stream object that is written as the data arrives. The
+		 * object is begun with the first byte written, and its
+		 * /Length written by finish() as a separate object.
+		 */
+		class stream_sink_t : public mathtext::font_sink_t {
+		private:
+			document_t *_document;
+			std::string _dictionary;
+			unsigned int _object;
+			unsigned int _length_object;
+			unsigned long _length;
+		public:
+			stream_sink_t(document_t *document,
+						  const std::string &dictionary);
+			virtual void write(const uint8_t *buffer,
+							   const size_t length);
+			void finish(void);
+			/**
+			 * Returns the object number, or 0 if nothing was
+			 * written
+			 */
+			inline unsigned int object(void) const
+			{
+				return _object;
+			}
+		};
+		document_t *_document;
+		bool _glyph_outline;
+		void open_output_file(const std::string &filename);
+		void write_header(void);
+		void write_page(void);
+		unsigned int write_font(const document_t::font_t &font);
+		void write_glyph_form(const document_t::font_t &font,
+							  std::map<unsigned int, unsigned int> &
+							  form_object);
+		void write_trailer(void);
+		void close_output_file(void);
+		void write_stream(const std::string &dictionary,
+						  const std::string &stream) const;
+		static std::string
+		object_reference(const std::string &format,
+						 const unsigned int object_0,
+						 const unsigned int object_1 = 0);
+		void append_content(const char *format, ...) const;
+		void append_path(const char *format,
+						 const point_t &point0,
+						 const point_t &point1) const;
+#if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		void freetype_init(void);
+		uint16_t glyph_index(const wchar_t character,
+							 const unsigned int family) const;
+		FT_Glyph_Metrics
+		freetype_metrics(const wchar_t character,
+						 const unsigned int family) const;
+		void embed_font(const unsigned int family);
+		static void append_utf16be(std::string &string,
+								   const wchar_t glyph);
+		document_t::font_t *select_font(const unsigned int family,
+										const float size) const;
+		void draw_outline(const unsigned int family, const float size,
+						  const std::wstring &string,
+						  const std::vector<point_t> &origin) const;
+#endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+	protected:
+#if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		FT_Library _freetype_library;
+		FT_Face _font[NFAMILY];
+		mathtext::font_blob_t _font_data[NFAMILY];
+		mutable mathtext::mutex_t _freetype_mutex;
+#endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		std::string _font_name[NFAMILY];
+		float _current_point_size;
+	public:
+		pdf_surface_t(const rect_t &rect, const bool master);
+		pdf_surface_t(const std::string &filename,
+					  const uint16_t width, const uint16_t height);
+		pdf_surface_t(pdf_surface_t &surface);
+		~pdf_surface_t(void);
+		pdf_surface_t &surface(const rect_t &rect);
+		pdf_surface_t &surface(const short x, const short y,
+							   const unsigned short width,
+							   const unsigned short height);
+		/**
+		 * Finishes the current page and starts a new one
+		 */
+		void new_page(void);
+		inline unsigned long npage(void) const
+		{
+			return _document->_page.size() + 1;
+		}
+		/////////////////////////////////////////////////////////////
+		// Color
+		void set_color(const color_t color);
+		void set_rgb_color(const float red, const float green,
+						   const float blue);
+		void set_rgba_color(const float red, const float green,
+							const float blue, const float alpha);
+		/////////////////////////////////////////////////////////////
+		// Graphics primitives
+		void set_point_size(const float size);
+		void point(const float x, const float y) const;
+		void set_line_width(const float width);
+		void line(const float x0, const float y0,
+				  const float x1, const float y1) const;
+		void rectangle(const float x, const float y,
+					   const float width, const float height) const;
+		void rectangle(const mathtext::bounding_box_t &bounding_box)
+			const;
+		void
+		filled_rectangle(const float x, const float y,
+						 const float width, const float height) const;
+		void
+		filled_rectangle(const mathtext::bounding_box_t &
+						 bounding_box) const;
+		void
+		raster(const float x, const float y, const float width,
+			   const float height, const float density[],
+			   const int nhorizontal, const int nvertical) const;
+		/////////////////////////////////////////////////////////////
+#if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		void open_font_overwrite(const std::string &filename,
+								 const unsigned int family =
+								 FAMILY_PLAIN);
+		void open_font_default(const std::string &filename,
+							   const unsigned int family =
+							   FAMILY_PLAIN);
+		/**
+		 * Selects whether glyphs are drawn as filled outlines instead
+		 * of text, which is the default. Each glyph drawn is decoded
+		 * once from the font data and written as a form XObject, and
+		 * no fonts are embedded for them. Subsurfaces created
+		 * afterwards inherit the selection.
+		 */
+		void set_glyph_outline(const bool outline);
+		void text_raw(const float x, const float y,
+					  const std::wstring string,
+					  const unsigned int family);
+		mathtext::bounding_box_t
+		bounding_box(const std::wstring string,
+					 const unsigned int family);
+		mathtext::bounding_box_t
+		bounding_box(const std::wstring string,
+					 const unsigned int family,
+					 const float size) const;
+	protected:
+		void glyph_run(const math_glyph_iterator_t &glyph_begin,
+					   const math_glyph_iterator_t &glyph_end);
+#endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+	};
+
+	/**
+	 * Surface writing an SVG document
+	 *
+	 * The document is written as it is drawn. Each glyph is defined
+	 * once per document, as a <path> decoded from the CFF or glyf
+	 * data of the font when the glyph is first drawn, and every
+	 * occurrence is a <use> element referring to it, so that the
+	 * size of the document grows with the text drawn by a few bytes
+	 * per glyph rather than by its outline.
+	 */
+	class svg_surface_t : public surface_t {
+	private:
+		/**
+		 * Document state, shared by a surface and its subsurfaces
+		 */
+		class document_t {
+		public:
+			FILE *_fp;
+			class font_t {
+			public:
+				// Prefix of the XML ids of the glyphs
+				std::string _resource_name;
+				mathtext::font_outline_t _outline;
+				// Glyphs with their <path> written, or without
+				// contours
+				std::vector<bool> _defined;
+				std::vector<bool> _empty;
+			};
+			std::map<std::string, font_t> _font;
+			float _line_width;
+			inline document_t(void)
+				: _fp(NULL), _line_width(1)
+			{
+			}
+		};
+		document_t *_document;
+		void open_output_file(const std::string &filename);
+		void write_header(void);
+		void write_trailer(void);
+		void close_output_file(void);
+		void append_element(const char *format, ...) const;
+		// Presentation attributes of the current color
+		std::string fill(void) const;
+		std::string stroke(void) const;
+		point_t pixel(const float x, const float y) const;
+#if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		void freetype_init(void);
+		FT_Glyph_Metrics
+		freetype_metrics(const wchar_t character,
+						 const unsigned int family) const;
+		uint16_t glyph_index(const wchar_t character,
+							 const unsigned int family) const;
+		void embed_font(const unsigned int family);
+		void draw_glyph(const unsigned int family, const float size,
+						const std::vector<wchar_t> &character,
+						const std::vector<point_t> &origin) const;
+#endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+	protected:
+#if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		FT_Library _freetype_library;
+		FT_Face _font[NFAMILY];
+		mathtext::font_blob_t _font_data[NFAMILY];
+		mutable mathtext::mutex_t _freetype_mutex;
+#endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		std::string _font_name[NFAMILY];
+		float _current_point_size;
+	public:
+		svg_surface_t(const rect_t &rect, const bool master);
+		svg_surface_t(const std::string &filename,
+					  const uint16_t width, const uint16_t height);
+		svg_surface_t(svg_surface_t &surface);
+		~svg_surface_t(void);
+		svg_surface_t &surface(const rect_t &rect);
+		svg_surface_t &surface(const short x, const short y,
+							   const unsigned short width,
+							   const unsigned short height);
+		/////////////////////////////////////////////////////////////
+		// Color
+		void set_color(const color_t color);
+		void set_rgb_color(const float red, const float green,
+						   const float blue);
+		void set_rgba_color(const float red, const float green,
+							const float blue, const float alpha);
+		/////////////////////////////////////////////////////////////
+		// Graphics primitives
+		void set_point_size(const float size);
+		void point(const float x, const float y) const;
+		void set_line_width(const float width);
+		void line(const float x0, const float y0,
+				  const float x1, const float y1) const;
+		void rectangle(const float x, const float y,
+					   const float width, const float height) const;
+		void rectangle(const mathtext::bounding_box_t &bounding_box)
+			const;
+		void
+		filled_rectangle(const float x, const float y,
+						 const float width, const float height) const;
+		void
+		filled_rectangle(const mathtext::bounding_box_t &
+						 bounding_box) const;
+		void filled_polygon(const polygon_t &p) const;
 		void
 		raster(const float x, const float y, const float width,
 			   const float height, const float density[],
@@ -579,6 +1052,223 @@ namespace gluon {
 		mathtext::bounding_box_t
 		bounding_box(const std::wstring string,
 					 const unsigned int family);
+		mathtext::bounding_box_t
+		bounding_box(const std::wstring string,
+					 const unsigned int family,
+					 const float size) const;
+	protected:
+		void glyph_run(const math_glyph_iterator_t &glyph_begin,
+					   const math_glyph_iterator_t &glyph_end);
+#endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+	};
+
+	/**
+	 * Surface rendering into an RGBA framebuffer in memory, which
+	 * requires neither a display nor OpenGL
+	 *
+	 * Shapes are anti-aliased by the exact area of each pixel they
+	 * cover. Glyphs are rendered by FreeType once per font and size
+	 * into a glyph atlas, from which each occurrence is composited.
+	 * The framebuffer holds 8 bit, non-premultiplied RGBA with the
+	 * first row at the top, is shared by a surface and its
+	 * subsurfaces, and can be written as PNG or PPM.
+	 */
+	class raster_surface_t : public surface_t {
+	private:
+		/**
+		 * Glyph coverage bitmaps packed in rows of shelves into one
+		 * 8 bit bitmap
+		 */
+		class glyph_atlas_t {
+		public:
+			class entry_t {
+			public:
+				uint16_t _x;
+				uint16_t _y;
+				uint16_t _width;
+				uint16_t _height;
+				// Offset of the upper left corner from the origin,
+				// with y pointing up
+				int16_t _left;
+				int16_t _top;
+			};
+			static const unsigned int width = 1024;
+			std::vector<uint8_t> _bitmap;
+			unsigned int _shelf_x;
+			unsigned int _shelf_y;
+			unsigned int _shelf_height;
+			std::map<uint16_t, entry_t> _entry;
+			glyph_atlas_t(void);
+			/**
+			 * Copies a glyph bitmap into the atlas
+			 *
+			 * @return the new entry, which is empty if the bitmap
+			 * is wider than the atlas
+			 */
+			const entry_t &insert(const uint16_t glyph,
+								  const uint8_t *buffer,
+								  const unsigned int width,
+								  const unsigned int height,
+								  const int pitch,
+								  const int left, const int top);
+			inline const uint8_t *row(const unsigned int y) const
+			{
+				return &_bitmap[y * width];
+			}
+		};
+		/**
+		 * Framebuffer, shared by a surface and its subsurfaces
+		 */
+		class framebuffer_t {
+		public:
+			unsigned int _width;
+			unsigned int _height;
+			std::vector<uint8_t> _pixel;
+			float _line_width;
+			// Keyed by the PostScript name of the font and the size
+			std::map<std::pair<std::string, float>, glyph_atlas_t>
+			_glyph_atlas;
+			inline framebuffer_t(const unsigned int width,
+								 const unsigned int height)
+				: _width(width), _height(height),
+				  _pixel(4 * width * height, 255), _line_width(1)
+			{
+			}
+		};
+		framebuffer_t *_framebuffer;
+		point_t device_point(const float x, const float y) const;
+		void color(uint8_t rgba[4]) const;
+		static void blend_span(uint8_t rgba[], const uint8_t coverage[],
+							   const size_t npixel,
+							   const uint8_t color[4]);
+		void fill_path(const std::vector<std::vector<point_t> > &path)
+			const;
+		void stroke_line(std::vector<std::vector<point_t> > &path,
+						 const point_t &point0, const point_t &point1,
+						 const bool square_cap = false) const;
+#if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		void freetype_init(void);
+		uint16_t glyph_index(const wchar_t character,
+							 const unsigned int family) const;
+		FT_Glyph_Metrics
+		freetype_metrics(const wchar_t character,
+						 const unsigned int family) const;
+		const glyph_atlas_t::entry_t *
+		atlas_entry(glyph_atlas_t &atlas, const unsigned int family,
+					const float size, const uint16_t glyph) const;
+		void draw_glyph(const unsigned int family, const float size,
+						const std::vector<wchar_t> &character,
+						const std::vector<point_t> &origin) const;
+#endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+	protected:
+#if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		FT_Library _freetype_library;
+		FT_Face _font[NFAMILY];
+		mathtext::font_blob_t _font_data[NFAMILY];
+		mutable mathtext::mutex_t _freetype_mutex;
+#endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		std::string _font_name[NFAMILY];
+		float _current_point_size;
+	public:
+		raster_surface_t(const rect_t &rect, const bool master);
+		/**
+		 * Creates a framebuffer cleared to opaque white
+		 */
+		raster_surface_t(const uint16_t width, const uint16_t height);
+		raster_surface_t(raster_surface_t &surface);
+		~raster_surface_t(void);
+		raster_surface_t &surface(const rect_t &rect);
+		raster_surface_t &surface(const short x, const short y,
+								  const unsigned short width,
+								  const unsigned short height);
+		inline unsigned int width(void) const
+		{
+			return _framebuffer->_width;
+		}
+		inline unsigned int height(void) const
+		{
+			return _framebuffer->_height;
+		}
+		/**
+		 * Returns the RGBA framebuffer, row by row from the top
+		 */
+		inline const uint8_t *pixel(void) const
+		{
+			return &_framebuffer->_pixel[0];
+		}
+		/**
+		 * Fills the area of the surface with the current color,
+		 * replacing what was drawn
+		 */
+		void clear(void);
+		/**
+		 * Writes the framebuffer as a PNG image (requires zlib), or
+		 * as a binary PPM image without the alpha channel
+		 *
+		 * @return false if the file could not be written
+		 */
+		bool write_png(const std::string &filename) const;
+		bool write_ppm(const std::string &filename) const;
+		/////////////////////////////////////////////////////////////
+		// Color
+		void set_color(const color_t color);
+		void set_rgb_color(const float red, const float green,
+						   const float blue);
+		void set_rgba_color(const float red, const float green,
+							const float blue, const float alpha);
+		/////////////////////////////////////////////////////////////
+		// Graphics primitives
+		void set_point_size(const float size);
+		void point(const float x, const float y) const;
+		void set_line_width(const float width);
+		void line(const float x0, const float y0,
+				  const float x1, const float y1) const;
+		void rectangle(const float x, const float y,
+					   const float width, const float height) const;
+		void rectangle(const mathtext::bounding_box_t &bounding_box)
+			const;
+		void
+		filled_rectangle(const float x, const float y,
+						 const float width, const float height) const;
+		void
+		filled_rectangle(const mathtext::bounding_box_t &
+						 bounding_box) const;
+		void polygon(const polygon_t &p) const;
+		void filled_polygon(const polygon_t &p) const;
+		void
+		raster(const float x, const float y, const float width,
+			   const float height, const float density[],
+			   const int nhorizontal, const int nvertical) const;
+		/////////////////////////////////////////////////////////////
+#if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		void open_font_overwrite(const std::string &filename,
+								 const unsigned int family =
+								 FAMILY_PLAIN);
+		void open_font_default(const std::string &filename,
+							   const unsigned int family =
+							   FAMILY_PLAIN);
+		void text_raw(const float x, const float y,
+					  const std::wstring string,
+					  const unsigned int family);
+		mathtext::bounding_box_t
+		bounding_box(const std::wstring string,
+					 const unsigned int family);
+		mathtext::bounding_box_t
+		bounding_box(const std::wstring string,
+					 const unsigned int family,
+					 const float size) const;
+	protected:
+		void glyph_run(const math_glyph_iterator_t &glyph_begin,
+					   const math_glyph_iterator_t &glyph_end);
+#else // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		// There is no glyph rasterizer, and opening a font reports
+		// an error instead of silently drawing no text
+		void open_font_overwrite(const std::string &filename,
+								 const unsigned int family =
+								 FAMILY_PLAIN);
+		void open_font_default(const std::string &filename,
+							   const unsigned int family =
+							   FAMILY_PLAIN);
 #endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
 	};
 
@@ -19,12 +19,204 @@
 #include <cmath>
 #include <iostream>
 #include <algorithm>
+#include <cstring>
 #include <gluon/screen.h>
+#include <mathtext/mathtextcache.h>
+
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#ifdef HAVE_SSE2
+#define QUANTIZE_HAVE_SSE2
+#include <emmintrin.h>
+#endif // HAVE_SSE2
+#endif // defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
 
 /////////////////////////////////////////////////////////////////////
 
 namespace gluon {
 
+	namespace {
+
+		inline uint8_t quantize(const float density)
+		{
+#ifdef __INTEL_COMPILER
+#pragma warning(push)
+#pragma warning(disable: 810)
+#endif // __INTEL_COMPILER
+			return density < 0 ? 0U :
+				density < (255.0 / 256.0) ?
+				static_cast<uint8_t>(density * 256.0F) : 255U;
+#ifdef __INTEL_COMPILER
+#pragma warning(pop)
+#endif // __INTEL_COMPILER
+		}
+
+		void quantize_rgb_scalar(uint8_t rgb[], const float density[],
+								 const size_t npixel)
+		{
+			for (size_t i = 0; i < npixel; i++) {
+				for (size_t j = 0; j < 3; j++) {
+					rgb[i * 3 + j] = quantize(density[(i << 2) + j]);
+				}
+			}
+		}
+
+#ifdef QUANTIZE_HAVE_SSE2
+		// Quantizes 4 pixels per iteration. The clamping order makes
+		// NaN map to 255, as the comparisons in quantize() do. Each
+		// pixel is stored as 4 bytes 3 bytes apart, so that the
+		// alpha byte is overwritten by the next pixel, and the last
+		// 4 pixels are left to the scalar code.
+		__attribute__((target("sse2"))) void
+		quantize_rgb_sse2(uint8_t rgb[], const float density[],
+						  const size_t npixel)
+		{
+			const __m128 scale = _mm_set1_ps(256.0F);
+			const __m128 maximum = _mm_set1_ps(255.0F);
+			const __m128 zero = _mm_setzero_ps();
+			size_t i = 0;
+
+			for (; i + 4 < npixel; i += 4) {
+				__m128i q[4];
+
+				for (size_t j = 0; j < 4; j++) {
+					const __m128 d =
+						_mm_mul_ps(_mm_loadu_ps(density + 4 * (i + j)),
+								   scale);
+
+					q[j] = _mm_cvttps_epi32(
+						_mm_max_ps(_mm_min_ps(d, maximum), zero));
+				}
+
+				uint8_t rgba[16];
+
+				_mm_storeu_si128(
+					reinterpret_cast<__m128i *>(rgba),
+					_mm_packus_epi16(_mm_packs_epi32(q[0], q[1]),
+									 _mm_packs_epi32(q[2], q[3])));
+				for (size_t j = 0; j < 4; j++) {
+					memcpy(rgb + 3 * (i + j), rgba + 4 * j, 4);
+				}
+			}
+			quantize_rgb_scalar(rgb + 3 * i, density + 4 * i,
+								npixel - i);
+		}
+#endif // QUANTIZE_HAVE_SSE2
+
+#ifdef HAVE_ZLIB
+		void put_uint32_be(uint8_t *buffer, const uint32_t value)
+		{
+			buffer[0] = value >> 24;
+			buffer[1] = (value >> 16) & 0xff;
+			buffer[2] = (value >> 8) & 0xff;
+			buffer[3] = value & 0xff;
+		}
+
+		void put_png_chunk(mathtext::font_sink_t &sink, const char *type,
+						   const uint8_t *data, const size_t length)
+		{
+			uint8_t header[8];
+			uint8_t crc[4];
+			uLong checksum = crc32(0L, Z_NULL, 0);
+
+			put_uint32_be(header, length);
+			memcpy(header + 4, type, 4);
+			checksum = crc32(checksum, header + 4, 4);
+			if (length > 0) {
+				checksum = crc32(checksum, data, length);
+			}
+			put_uint32_be(crc, checksum);
+			sink.write(header, 8);
+			if (length > 0) {
+				sink.write(data, length);
+			}
+			sink.write(crc, 4);
+		}
+
+		// Writes each block of compressed data as it leaves the
+		// compressor as an IDAT chunk
+		class png_idat_sink_t : public mathtext::font_sink_t {
+		private:
+			mathtext::font_sink_t &_sink;
+		public:
+			png_idat_sink_t(mathtext::font_sink_t &sink)
+				: _sink(sink)
+			{
+			}
+			void write(const uint8_t *buffer, const size_t length)
+			{
+				if (length > 0)
+					put_png_chunk(_sink, "IDAT", buffer, length);
+			}
+		};
+#endif // HAVE_ZLIB
+
+	}
+
+#ifdef HAVE_ZLIB
+	// Rows are written without prediction (filter type 0), which for
+	// rendered text and plots compresses nearly as well as adaptive
+	// filtering at a fraction of the cost
+	void surface_t::write_png(mathtext::font_sink_t &sink,
+							  const uint8_t pixel[],
+							  const unsigned int width,
+							  const unsigned int height,
+							  const unsigned int nchannel)
+	{
+		static const uint8_t signature[8] = {
+			0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'
+		};
+		// Color types 0 (gray), 2 (RGB) and 6 (RGBA)
+		static const uint8_t color_type[5] = { 0, 0, 0, 2, 6 };
+
+		if (!(nchannel == 1 || nchannel == 3 || nchannel == 4)) {
+			std::cerr << __FILE__ << ':' << __LINE__
+					  << ": error: unsupported number of channels "
+					  << nchannel << std::endl;
+			return;
+		}
+
+		uint8_t header[13];
+
+		put_uint32_be(header, width);
+		put_uint32_be(header + 4, height);
+		header[8] = 8;
+		header[9] = color_type[nchannel];
+		// Deflate compression, adaptive filtering, no interlace
+		header[10] = 0;
+		header[11] = 0;
+		header[12] = 0;
+		sink.write(signature, sizeof(signature));
+		put_png_chunk(sink, "IHDR", header, sizeof(header));
+
+		png_idat_sink_t idat(sink);
+		mathtext::deflate_sink_t deflate(idat);
+		const size_t row_length = static_cast<size_t>(width) * nchannel;
+		const uint8_t filter_type = 0;
+
+		for (unsigned int i = 0; i < height; i++) {
+			deflate.write(&filter_type, 1);
+			deflate.write(pixel + i * row_length, row_length);
+		}
+		deflate.finish();
+		put_png_chunk(sink, "IEND", NULL, 0);
+	}
+#endif // HAVE_ZLIB
+
+	// The quantization follows the instruction set selection of the
+	// ASCIIHex and ASCII85 encoders, which the output passes through
+	void surface_t::quantize_rgb(uint8_t rgb[], const float density[],
+								 const size_t npixel)
+	{
+#ifdef QUANTIZE_HAVE_SSE2
+		if (mathtext::encoder_instruction_set() !=
+			mathtext::ENCODER_SCALAR) {
+			quantize_rgb_sse2(rgb, density, npixel);
+			return;
+		}
+#endif // QUANTIZE_HAVE_SSE2
+		quantize_rgb_scalar(rgb, density, npixel);
+	}
+
 	void surface_t::delete_subsurface(void)
 	{
 		for (std::vector<surface_t *>::iterator iterator =
@@ -117,6 +309,18 @@ namespace gluon {
 		y += displacement_transformed[1];
 	}
 
+	// Until a font is opened, a family has no glyphs and measures
+	// alike on all surfaces of the same type, which may therefore
+	// share layouts. A NUL character alone is neither a file name
+	// nor the identity of a font known only to one renderer
+	void surface_t::reset_font_identity(void)
+	{
+		const std::string no_font(1, '\0');
+
+		for (unsigned int family = 0; family < NFAMILY; family++)
+			reset_glyph_metrics(family, no_font);
+	}
+
 	surface_t::~surface_t(void)
 	{
 		delete_subsurface();
@@ -332,6 +536,9 @@ namespace gluon {
 	text(const float x, const float y, const std::wstring string,
 		 const unsigned int family)
 	{
+#ifdef MATHTEXT_STATISTICS
+		count(mathtext::statistics_t::COUNTER_TEXT_RAW);
+#endif // MATHTEXT_STATISTICS
 		text_raw(x, y, string, family);
 	}
 
@@ -340,16 +547,53 @@ namespace gluon {
 		 const mathtext::math_text_t &math_text,
 		 const float distance)
 	{
-		const mathtext::bounding_box_t math_text_bounding_box =
-			bounding_box(math_text);
+		text(x, y, alignment,
+			 mathtext::math_text_cache_t::global().layout(
+				*this, math_text),
+			 distance);
+	}
+
+	void surface_t::
+	text(const float x, const float y, const unsigned int alignment,
+		 const math_layout_t &math_text_layout,
+		 const float distance)
+	{
 		float x_transformed = x;
 		float y_transformed = y;
 
 		text_alignment_transform(x_transformed, y_transformed,
-								 math_text_bounding_box, alignment,
-								 distance);
+								 math_text_layout.bounding_box(),
+								 alignment, distance);
 		math_text_renderer_t::text(x_transformed, y_transformed,
-								   math_text);
+								   math_text_layout);
+	}
+
+	void surface_t::
+	text(const std::vector<point_t> &position,
+		 const std::vector<mathtext::math_text_t> &math_text,
+		 const unsigned int alignment, const float distance)
+	{
+		const size_t size = std::min(position.size(), math_text.size());
+		std::vector<mathtext::point_t> origin;
+		std::vector<math_layout_t> math_text_layout;
+
+		origin.reserve(size);
+		math_text_layout.reserve(size);
+		for (size_t i = 0; i < size; i++) {
+			float x_transformed = position[i][0];
+			float y_transformed = position[i][1];
+
+			math_text_layout.push_back(
+				mathtext::math_text_cache_t::global().layout(
+					*this, math_text[i]));
+			text_alignment_transform(x_transformed, y_transformed,
+									 math_text_layout.back().
+									 bounding_box(),
+									 alignment, distance);
+			origin.push_back(mathtext::point_t(x_transformed,
+											   y_transformed));
+		}
+		math_text_renderer_t::text(origin, math_text_layout);
 	}
 
 }
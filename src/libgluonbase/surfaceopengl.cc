@@ -343,6 +343,7 @@ namespace gluon {
 	open_font_overwrite(const std::string &filename,
 						const unsigned int family)
 	{
+		reset_glyph_metrics(family, filename);
 		if (_font[family] != NULL) {
 			delete _font[family];
 		}
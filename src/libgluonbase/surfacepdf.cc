@@ -0,0 +1,1100 @@
+// mathtext - A TeX/LaTeX compatible rendering library. Copyright (C)
+// 2008-2012 Yue Shi Lai <ylai@users.sourceforge.net>
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2.1 of
+// the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// 02110-1301 USA
+
+#include <cmath>
+#include <cstdarg>
+#include <iostream>
+#include <algorithm>
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif // HAVE_ZLIB
+#include <gluon/screen.h>
+#include <mathtext/fontembed.h>
+
+// References:
+//
+// Adobe Systems, Inc., PDF reference (Adobe Systems, Inc., San Jose,
+// CA, 2001), 3rd edition, version 1.4, sections 3.4, 3.6, 5.3 and
+// 4.8.6.
+
+/////////////////////////////////////////////////////////////////////
+
+namespace gluon {
+
+	unsigned int pdf_surface_t::document_t::reserve_object(void)
+	{
+		_object_offset.push_back(0);
+
+		return _object_offset.size();
+	}
+
+	void pdf_surface_t::document_t::
+	begin_object(const unsigned int object)
+	{
+		_object_offset[object - 1] = ftell(_fp);
+		fprintf(_fp, "%u 0 obj\n", object);
+	}
+
+	void pdf_surface_t::document_t::end_object(void)
+	{
+		fputs("endobj\n", _fp);
+	}
+
+	pdf_surface_t::stream_sink_t::
+	stream_sink_t(document_t *document, const std::string &dictionary)
+		: _document(document), _dictionary(dictionary), _object(0),
+		  _length_object(0), _length(0)
+	{
+	}
+
+	void pdf_surface_t::stream_sink_t::write(const uint8_t *buffer,
+											 const size_t length)
+	{
+		if (length == 0)
+			return;
+		if (_object == 0) {
+			_object = _document->reserve_object();
+			_length_object = _document->reserve_object();
+			_document->begin_object(_object);
+			fprintf(_document->_fp,
+					"<<\n%s/Length %u 0 R\n>>\nstream\n",
+					_dictionary.c_str(), _length_object);
+		}
+		fwrite(buffer, sizeof(uint8_t), length, _document->_fp);
+		_length += length;
+	}
+
+	void pdf_surface_t::stream_sink_t::finish(void)
+	{
+		if (_object == 0)
+			return;
+		fputs("\nendstream\n", _document->_fp);
+		_document->end_object();
+		_document->begin_object(_length_object);
+		fprintf(_document->_fp, "%lu\n", _length);
+		_document->end_object();
+	}
+
+	void pdf_surface_t::open_output_file(const std::string &filename)
+	{
+		_document->_fp = fopen(filename.c_str(), "wb");
+		if (_document->_fp == NULL)
+			perror("fopen");
+	}
+
+	void pdf_surface_t::write_header(void)
+	{
+		if (_document->_fp == NULL)
+			return;
+		// The comment with high-bit characters marks the file as
+		// binary for transfer programs
+		fputs("%PDF-1.4\n%\342\343\317\323\n", _document->_fp);
+		_document->_catalog = _document->reserve_object();
+		_document->_page_tree = _document->reserve_object();
+		_document->_resource = _document->reserve_object();
+	}
+
+	std::string pdf_surface_t::
+	object_reference(const std::string &format,
+					 const unsigned int object_0,
+					 const unsigned int object_1)
+	{
+		// Room for the two "%u %u" pairs of the fontembedpdf.cc
+		// objects to expand into
+		std::vector<char> buffer(format.size() + 64);
+
+		snprintf(&buffer[0], buffer.size(), format.c_str(),
+				 object_0, 0U, object_1, 0U);
+
+		return &buffer[0];
+	}
+
+	void pdf_surface_t::write_stream(const std::string &dictionary,
+									 const std::string &stream) const
+	{
+		FILE *fp = _document->_fp;
+
+#ifdef HAVE_ZLIB
+		uLongf length = compressBound(stream.size());
+		std::vector<Bytef> buffer(length);
+
+		if (compress2(&buffer[0], &length,
+					  reinterpret_cast<const Bytef *>(stream.data()),
+					  stream.size(), Z_DEFAULT_COMPRESSION) == Z_OK) {
+			fprintf(fp, "<<\n%s/Length %lu\n/Filter /FlateDecode\n"
+					">>\nstream\n", dictionary.c_str(),
+					static_cast<unsigned long>(length));
+			fwrite(&buffer[0], sizeof(Bytef), length, fp);
+			fputs("\nendstream\n", fp);
+			return;
+		}
+#endif // HAVE_ZLIB
+		fprintf(fp, "<<\n%s/Length %lu\n>>\nstream\n",
+				dictionary.c_str(),
+				static_cast<unsigned long>(stream.size()));
+		fwrite(stream.data(), sizeof(char), stream.size(), fp);
+		fputs("\nendstream\n", fp);
+	}
+
+	// The content stream and the page object are written as soon as
+	// the page is finished. Only the object number of the page is
+	// kept, for the page tree.
+	void pdf_surface_t::write_page(void)
+	{
+		if (_document->_fp == NULL)
+			return;
+
+		const unsigned int content = _document->reserve_object();
+		const unsigned int page = _document->reserve_object();
+
+		_document->begin_object(content);
+		write_stream("", _document->_content);
+		_document->end_object();
+		_document->begin_object(page);
+		fprintf(_document->_fp,
+				"<<\n"
+				"/Type /Page\n"
+				"/Parent %u 0 R\n"
+				"/MediaBox [%.3f %.3f %.3f %.3f]\n"
+				"/Resources %u 0 R\n"
+				"/Contents %u 0 R\n"
+				">>\n",
+				_document->_page_tree, _rect.left(), _rect.bottom(),
+				_rect.right(), _rect.top(), _document->_resource,
+				content);
+		_document->end_object();
+		_document->_page.push_back(page);
+		_document->_content.clear();
+		_document->_current_font_resource.clear();
+		_document->_current_size = 0;
+	}
+
+	// Returns the object number of the Type 0 font, or 0 if the font
+	// could not be embedded
+	unsigned int pdf_surface_t::write_font(const document_t::font_t &font)
+	{
+		const mathtext::font_blob_t &font_data = font._font_data;
+		const bool cff = font_data.size() >= 4 &&
+			std::equal(font_data.begin(), font_data.begin() + 4,
+					   "OTTO");
+		// The font program is the first object written, directly as
+		// it is embedded (and compressed)
+		std::string dictionary = cff ? "/Subtype /CIDFontType0C\n" : "";
+
+#ifdef HAVE_ZLIB
+		dictionary += "/Filter /FlateDecode\n";
+#endif // HAVE_ZLIB
+
+		stream_sink_t font_file(_document, dictionary);
+#ifdef HAVE_ZLIB
+		mathtext::deflate_sink_t deflate(font_file);
+		mathtext::font_sink_t &sink = deflate;
+#else // HAVE_ZLIB
+		mathtext::font_sink_t &sink = font_file;
+#endif // HAVE_ZLIB
+		std::string font_name;
+		std::map<std::string, std::string> pdf_object = cff ?
+			mathtext::font_embed_pdf_t::
+			font_embed_type_2(sink, font_name, font_data,
+							  font._glyph_usage) :
+			mathtext::font_embed_pdf_t::
+			font_embed_type_42(sink, font_name, font_data,
+							   font._glyph_usage);
+
+		if (pdf_object.empty()) {
+			std::cerr << __FILE__ << ':' << __LINE__
+					  << ": error: could not embed font `"
+					  << font_name << '\'' << std::endl;
+			return 0;
+		}
+#ifdef HAVE_ZLIB
+		deflate.finish();
+#endif // HAVE_ZLIB
+		font_file.finish();
+
+		FILE *fp = _document->_fp;
+		const unsigned int type_0_font = _document->reserve_object();
+		const unsigned int cid_font = _document->reserve_object();
+		const unsigned int font_descriptor =
+			_document->reserve_object();
+		const unsigned int cmap = _document->reserve_object();
+
+		_document->begin_object(type_0_font);
+		fputs(object_reference(pdf_object["/Font"], cmap,
+							   cid_font).c_str(), fp);
+		_document->end_object();
+		_document->begin_object(cid_font);
+		fputs(object_reference(pdf_object["/CIDFont"],
+							   font_descriptor).c_str(), fp);
+		_document->end_object();
+		_document->begin_object(font_descriptor);
+		fputs(object_reference(pdf_object["/FontDescriptor"],
+							   font_file.object()).c_str(), fp);
+		_document->end_object();
+		// The CMap contains no references, but "%" characters
+		_document->begin_object(cmap);
+		fwrite(pdf_object["/CMap"].data(), sizeof(char),
+			   pdf_object["/CMap"].size(), fp);
+		_document->end_object();
+
+		return type_0_font;
+	}
+
+	// Glyph outlines are in 1/1000 em, which the form matrix scales
+	// to text space, i.e. to the font size set by the content
+	// stream. Glyphs that could not be decoded, and those without
+	// contours, are empty forms.
+	void pdf_surface_t::
+	write_glyph_form(const document_t::font_t &font,
+					 std::map<unsigned int, unsigned int> &form_object)
+	{
+		static const char *const name[
+			mathtext::glyph_outline_t::NOPERATOR] = {
+			"m", "l", NULL, "c", "h"
+		};
+		const mathtext::font_outline_t font_outline(font._font_data);
+
+		if (!font_outline.valid())
+			std::cerr << __FILE__ << ':' << __LINE__
+					  << ": error: could not decode outlines of font `"
+					  << font._resource_name << '\'' << std::endl;
+		for (std::map<uint16_t, unsigned int>::const_iterator
+				 iterator = font._outline.begin();
+			iterator != font._outline.end(); iterator++) {
+			mathtext::glyph_outline_t outline;
+			std::string path;
+			float box[4] = { 0, 0, 0, 0 };
+
+			if (font_outline.valid() &&
+			   font_outline.glyph_outline(outline, iterator->first) &&
+			   outline.control_box(box)) {
+				outline.append_postfix(path, name);
+				path.append("f");
+			}
+
+			char dictionary[256];
+
+			snprintf(dictionary, sizeof(dictionary),
+					 "/Type /XObject\n"
+					 "/Subtype /Form\n"
+					 "/BBox [%.0f %.0f %.0f %.0f]\n"
+					 "/Matrix [0.001 0 0 0.001 0 0]\n",
+					 floor(box[0]), floor(box[1]), ceil(box[2]),
+					 ceil(box[3]));
+
+			const unsigned int object = _document->reserve_object();
+
+			_document->begin_object(object);
+			write_stream(dictionary, path);
+			_document->end_object();
+			form_object[iterator->second] = object;
+		}
+	}
+
+	void pdf_surface_t::write_trailer(void)
+	{
+		if (_document->_fp == NULL)
+			return;
+		write_page();
+
+		FILE *fp = _document->_fp;
+		// Fonts that were never drawn with are not written at all
+		std::map<std::string, unsigned int> font_object;
+
+		for (std::map<std::string, document_t::font_t>::const_iterator
+				 iterator = _document->_font.begin();
+			iterator != _document->_font.end(); iterator++)
+			if (!iterator->second._glyph_usage.empty()) {
+				const unsigned int object =
+					write_font(iterator->second);
+
+				if (object != 0)
+					font_object[iterator->second._resource_name] =
+						object;
+			}
+
+		std::map<unsigned int, unsigned int> form_object;
+
+		for (std::map<std::string, document_t::font_t>::const_iterator
+				 iterator = _document->_font.begin();
+			iterator != _document->_font.end(); iterator++)
+			if (!iterator->second._outline.empty())
+				write_glyph_form(iterator->second, form_object);
+
+		_document->begin_object(_document->_resource);
+		fputs("<<\n"
+			  "/ProcSet [/PDF /Text /ImageC]\n"
+			  "/Font <<\n", fp);
+		for (std::map<std::string, unsigned int>::const_iterator
+				 iterator = font_object.begin();
+			iterator != font_object.end(); iterator++)
+			fprintf(fp, "/%s %u 0 R\n", iterator->first.c_str(),
+					iterator->second);
+		fputs(">>\n", fp);
+		if (!form_object.empty()) {
+			fputs("/XObject <<\n", fp);
+			for (std::map<unsigned int, unsigned int>::const_iterator
+					 iterator = form_object.begin();
+				iterator != form_object.end(); iterator++)
+				fprintf(fp, "/G%u %u 0 R\n", iterator->first,
+						iterator->second);
+			fputs(">>\n", fp);
+		}
+		fputs(">>\n", fp);
+		_document->end_object();
+
+		_document->begin_object(_document->_page_tree);
+		fputs("<<\n"
+			  "/Type /Pages\n"
+			  "/Kids [", fp);
+		for (size_t i = 0; i < _document->_page.size(); i++)
+			fprintf(fp, i % 8 == 7 ? "%u 0 R\n" : "%u 0 R ",
+					_document->_page[i]);
+		fprintf(fp, "]\n"
+				"/Count %lu\n"
+				">>\n",
+				static_cast<unsigned long>(_document->_page.size()));
+		_document->end_object();
+
+		_document->begin_object(_document->_catalog);
+		fprintf(fp, "<<\n"
+				"/Type /Catalog\n"
+				"/Pages %u 0 R\n"
+				">>\n", _document->_page_tree);
+		_document->end_object();
+
+		const long xref_offset = ftell(fp);
+
+		fprintf(fp, "xref\n"
+				"0 %lu\n"
+				"0000000000 65535 f \n",
+				static_cast<unsigned long>(
+					_document->_object_offset.size() + 1));
+		for (std::vector<long>::const_iterator iterator =
+				_document->_object_offset.begin();
+			iterator != _document->_object_offset.end(); iterator++)
+			fprintf(fp, "%010ld 00000 n \n", *iterator);
+		fprintf(fp, "trailer\n"
+				"<<\n"
+				"/Size %lu\n"
+				"/Root %u 0 R\n"
+				">>\n"
+				"startxref\n"
+				"%ld\n"
+				"%%%%EOF\n",
+				static_cast<unsigned long>(
+					_document->_object_offset.size() + 1),
+				_document->_catalog, xref_offset);
+	}
+
+	void pdf_surface_t::close_output_file(void)
+	{
+		if (_document->_fp != NULL) {
+			fclose(_document->_fp);
+			_document->_fp = NULL;
+		}
+	}
+
+	void pdf_surface_t::append_content(const char *format, ...) const
+	{
+		char buffer[4096];
+		va_list ap;
+
+		va_start(ap, format);
+
+		const int length = vsnprintf(buffer, sizeof(buffer), format, ap);
+
+		va_end(ap);
+		if (length < 0)
+			return;
+		if (static_cast<size_t>(length) < sizeof(buffer)) {
+			_document->_content.append(buffer, length);
+			return;
+		}
+
+		std::vector<char> large_buffer(length + 1);
+
+		va_start(ap, format);
+		vsnprintf(&large_buffer[0], large_buffer.size(), format, ap);
+		va_end(ap);
+		_document->_content.append(&large_buffer[0], length);
+	}
+
+	// Append a path operator with the lower left corner, width and
+	// height of the rectangle spanned by two points. Pixel
+	// coordinates have y pointing down, PDF user space y pointing up
+	void pdf_surface_t::append_path(const char *format,
+									const point_t &point0,
+									const point_t &point1) const
+	{
+		const point_t transformed0 = _transform_logical_to_pixel *
+			point0;
+		const point_t transformed1 = _transform_logical_to_pixel *
+			point1;
+
+		append_content(format, transformed0[0],
+					   screen_rect().top() - transformed0[1],
+					   transformed1[0] - transformed0[0],
+					   transformed0[1] - transformed1[1]);
+	}
+
+#if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+	void pdf_surface_t::freetype_init(void)
+	{
+		const FT_Error error = FT_Init_FreeType(&_freetype_library);
+
+		if (error != 0) {
+			std::cerr << __FILE__ << ':' << __LINE__
+					  << ": error: FreeType initialization error"
+					  << std::endl;
+		}
+	}
+
+	// The glyph index is looked up in the parsed cmap, which is
+	// shared with the font embedding, and FreeType is consulted only
+	// for fonts or characters the parser does not map
+	uint16_t pdf_surface_t::glyph_index(const wchar_t character,
+										const unsigned int family) const
+	{
+		const mathtext::parsed_font_t &parsed_font =
+			_font_data[family].parsed_font();
+		FT_UInt glyph_index = parsed_font._valid ?
+			parsed_font._cid_map.find(character) : 0;
+
+		if (glyph_index == 0) {
+			mathtext::lock_t lock(_freetype_mutex);
+
+			glyph_index = FT_Get_Char_Index(_font[family], character);
+		}
+
+		return glyph_index;
+	}
+
+	FT_Glyph_Metrics pdf_surface_t::
+	freetype_metrics(const wchar_t character,
+					 const unsigned int family) const
+	{
+		const FT_UInt index = glyph_index(character, family);
+		mathtext::lock_t lock(_freetype_mutex);
+
+		FT_Load_Glyph(_font[family], index, FT_LOAD_NO_SCALE);
+
+		return _font[family]->glyph->metrics;
+	}
+
+	// Fonts are registered once per document, keyed by their
+	// PostScript name, and written by write_trailer()
+	void pdf_surface_t::embed_font(const unsigned int family)
+	{
+		const char *postscript_name =
+			FT_Get_Postscript_Name(_font[family]);
+
+		if (postscript_name == NULL) {
+			std::cerr << __FILE__ << ':' << __LINE__
+					  << ": error: font without a PostScript name"
+					  << std::endl;
+			return;
+		}
+		_font_name[family] = postscript_name;
+		if (_document == NULL ||
+		   _document->_font.find(_font_name[family]) !=
+		   _document->_font.end())
+			return;
+
+		document_t::font_t &font = _document->_font[_font_name[family]];
+		char resource_name[16];
+
+		snprintf(resource_name, sizeof(resource_name), "F%lu",
+				 static_cast<unsigned long>(_document->_font.size()));
+		font._resource_name = resource_name;
+		font._font_data = _font_data[family];
+	}
+
+	void pdf_surface_t::
+	open_font_overwrite(const std::string &filename,
+						const unsigned int family)
+	{
+		reset_glyph_metrics(family, filename);
+		if (_font[family] != NULL) {
+			FT_Done_Face(_font[family]);
+			_font[family] = NULL;
+		}
+		_font_data[family] =
+			mathtext::font_embed_t::read_font_data(filename);
+		if (_font_data[family].empty())
+			return;
+
+		const FT_Error error =
+			FT_New_Memory_Face(_freetype_library,
+							   _font_data[family].data(),
+							   _font_data[family].size(), 0,
+							   &_font[family]);
+
+		if (error != 0) {
+			_font[family] = NULL;
+			return;
+		}
+		embed_font(family);
+	}
+
+	void pdf_surface_t::
+	open_font_default(const std::string &filename,
+					  const unsigned int family)
+	{
+		if (_font[family] == NULL)
+			open_font_overwrite(filename, family);
+	}
+
+	void pdf_surface_t::set_glyph_outline(const bool outline)
+	{
+		_glyph_outline = outline;
+	}
+#endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+
+	pdf_surface_t::pdf_surface_t(const rect_t &rect, const bool master)
+		: surface_t(rect, master),
+		  _document(master ? new document_t : NULL),
+		  _glyph_outline(false), _current_point_size(0)
+	{
+#if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		freetype_init();
+		std::fill(_font, _font + NFAMILY,
+				  reinterpret_cast<FT_Face>(NULL));
+#endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+	}
+
+	pdf_surface_t::
+	pdf_surface_t(const std::string &filename,
+				  const uint16_t width, const uint16_t height)
+		: surface_t(rect_t(0, 0, width, height), true),
+		  _document(new document_t), _glyph_outline(false),
+		  _current_point_size(0)
+	{
+#if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		freetype_init();
+		std::fill(_font, _font + NFAMILY,
+				  reinterpret_cast<FT_Face>(NULL));
+#endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		open_output_file(filename);
+		write_header();
+	}
+
+	pdf_surface_t::pdf_surface_t(pdf_surface_t &surface)
+		: surface_t(surface), _document(surface._document),
+		  _glyph_outline(surface._glyph_outline),
+		  _current_point_size(0)
+	{
+#if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		freetype_init();
+		std::fill(_font, _font + NFAMILY,
+				  reinterpret_cast<FT_Face>(NULL));
+#endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		surface._subsurface.push_back(this);
+	}
+
+	pdf_surface_t::~pdf_surface_t(void)
+	{
+#if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		for (unsigned int family = 0; family < NFAMILY; family++)
+			if (_font[family] != NULL) {
+				FT_Done_Face(_font[family]);
+				_font[family] = NULL;
+			}
+#endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		if (_master && _document != NULL) {
+			write_trailer();
+			close_output_file();
+			delete _document;
+		}
+	}
+
+	pdf_surface_t &pdf_surface_t::surface(const rect_t &rect)
+	{
+		const rect_t scissored_rect = _rect.scissor(rect);
+		pdf_surface_t *ret = new pdf_surface_t(scissored_rect, false);
+
+		_subsurface.push_back(ret);
+		ret->_supersurface = this;
+		ret->_document = _document;
+		ret->_glyph_outline = _glyph_outline;
+#if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		ret->_freetype_library = _freetype_library;
+#endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+
+		return *ret;
+	}
+
+	pdf_surface_t &pdf_surface_t::
+	surface(const short x, const short y,
+			const unsigned short width,
+			const unsigned short height)
+	{
+		return surface(rect_t(x, y, width, height));
+	}
+
+	// A new page starts with the default graphics state, so the
+	// color and line width are set again
+	void pdf_surface_t::new_page(void)
+	{
+		write_page();
+		append_content("%.3f %.3f %.3f RG %.3f %.3f %.3f rg\n",
+					   _current_color.red(), _current_color.green(),
+					   _current_color.blue(), _current_color.red(),
+					   _current_color.green(), _current_color.blue());
+		if (_document->_line_width >= 0)
+			append_content("%.3f w\n", _document->_line_width);
+	}
+
+	void pdf_surface_t::set_color(const color_t color)
+	{
+		_current_color = color;
+
+		append_content("%.3f %.3f %.3f RG %.3f %.3f %.3f rg\n",
+					   color.red(), color.green(), color.blue(),
+					   color.red(), color.green(), color.blue());
+	}
+
+	void pdf_surface_t::set_rgb_color(const float red,
+									  const float green,
+									  const float blue)
+	{
+		set_color(color_t(color_t::COLOR_SPACE_RGB,
+						  red, green, blue));
+	}
+
+	void pdf_surface_t::set_rgba_color(const float red,
+									   const float green,
+									   const float blue,
+									   const float alpha)
+	{
+		set_color(color_t(color_t::COLOR_SPACE_RGB,
+						  red, green, blue));
+		_current_alpha = alpha;
+	}
+
+	void pdf_surface_t::set_point_size(const float size)
+	{
+		_current_point_size = size;
+	}
+
+	// A circle of four Bezier curves
+	void pdf_surface_t::point(const float x, const float y) const
+	{
+		if (_current_point_size != 0) {
+			const point_t transformed = _transform_logical_to_pixel *
+				point_t(x, y);
+			const float cx = transformed[0];
+			const float cy = screen_rect().top() - transformed[1];
+			const float r = 0.5F * _current_point_size;
+			const float k = 0.5523F * r;
+
+			append_content("%.3f %.3f m "
+						   "%.3f %.3f %.3f %.3f %.3f %.3f c "
+						   "%.3f %.3f %.3f %.3f %.3f %.3f c\n"
+						   "%.3f %.3f %.3f %.3f %.3f %.3f c "
+						   "%.3f %.3f %.3f %.3f %.3f %.3f c f\n",
+						   cx + r, cy,
+						   cx + r, cy + k, cx + k, cy + r, cx, cy + r,
+						   cx - k, cy + r, cx - r, cy + k, cx - r, cy,
+						   cx - r, cy - k, cx - k, cy - r, cx, cy - r,
+						   cx + k, cy - r, cx + r, cy - k, cx + r, cy);
+		}
+	}
+
+	void pdf_surface_t::set_line_width(const float width)
+	{
+		_document->_line_width = width;
+		append_content("%.3f w\n", width);
+	}
+
+	void pdf_surface_t::line(const float x0, const float y0,
+							 const float x1, const float y1) const
+	{
+		const point_t transformed0 = _transform_logical_to_pixel *
+			point_t(x0, y0);
+		const point_t transformed1 = _transform_logical_to_pixel *
+			point_t(x1, y1);
+
+		append_content("%.3f %.3f m %.3f %.3f l S\n",
+					   transformed0[0],
+					   screen_rect().top() - transformed0[1],
+					   transformed1[0],
+					   screen_rect().top() - transformed1[1]);
+	}
+
+	void pdf_surface_t::rectangle(const float x, const float y,
+								  const float width,
+								  const float height) const
+	{
+		append_path("%.3f %.3f %.3f %.3f re S\n", point_t(x, y),
+					point_t(x + width, y + height));
+	}
+
+	void pdf_surface_t::
+	rectangle(const mathtext::bounding_box_t &bounding_box) const
+	{
+		append_path("%.3f %.3f %.3f %.3f re S\n",
+					bounding_box.lower_left(),
+					bounding_box.upper_right());
+	}
+
+	void pdf_surface_t::
+	filled_rectangle(const float x, const float y,
+					 const float width, const float height) const
+	{
+		append_path("%.3f %.3f %.3f %.3f re f\n", point_t(x, y),
+					point_t(x + width, y + height));
+	}
+
+	void pdf_surface_t::
+	filled_rectangle(const mathtext::bounding_box_t &bounding_box)
+		const
+	{
+		append_path("%.3f %.3f %.3f %.3f re f\n",
+					bounding_box.lower_left(),
+					bounding_box.upper_right());
+	}
+
+	// Same placement as postscript_surface_t::raster(), where the
+	// first row of the image data is at the bottom, while PDF places
+	// it at the top of the unit square
+	void pdf_surface_t::
+	raster(const float x, const float y, const float width,
+		   const float height, const float density[],
+		   const int nhorizontal, const int nvertical) const
+	{
+		const point_t transformed0 = _transform_logical_to_pixel *
+			point_t(x, y);
+		const point_t transformed1 = _transform_logical_to_pixel *
+			point_t(x + width, y + height);
+		const float scale_y = transformed1[1] - transformed0[1];
+
+		append_content("q %.3f 0 0 %.3f %.3f %.3f cm\n"
+					   "BI /W %d /H %d /CS /RGB /BPC 8 /F /A85 ID\n",
+					   transformed1[0] - transformed0[0], -scale_y,
+					   transformed0[0],
+					   screen_rect().top() - transformed0[1] +
+					   scale_y, nhorizontal, nvertical);
+
+		const unsigned long npixel = nhorizontal * nvertical;
+		std::vector<uint8_t> buffer(npixel * 3);
+
+		quantize_rgb(&buffer[0], density, npixel);
+
+		mathtext::font_embed_postscript_t::
+			append_ascii85(_document->_content, &buffer[0],
+						   buffer.size());
+		_document->_content.append("\nEI Q\n");
+	}
+
+#if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+	mathtext::bounding_box_t pdf_surface_t::
+	bounding_box(const std::wstring string, const unsigned int family)
+	{
+		return bounding_box(string, family, _current_font_size[family]);
+	}
+
+	mathtext::bounding_box_t pdf_surface_t::
+	bounding_box(const std::wstring string, const unsigned int family,
+				 const float size) const
+	{
+		if (string.empty() || _font[family] == NULL ||
+		   _font[family]->units_per_EM == 0)
+			return mathtext::bounding_box_t(0, 0, 0, 0, 0, 0);
+
+		std::wstring::const_iterator iterator = string.begin();
+
+		const float scale = size / _font[family]->units_per_EM;
+		FT_Glyph_Metrics metrics;
+		mathtext::bounding_box_t ret;
+
+		metrics = freetype_metrics(*iterator, family);
+		ret = mathtext::bounding_box_t(
+			metrics.horiBearingX * scale,
+			(-metrics.horiBearingY) * scale,
+			(metrics.horiBearingX + metrics.width) * scale,
+			(-metrics.horiBearingY + metrics.height) * scale,
+			metrics.horiAdvance * scale, 0);
+		iterator++;
+
+		float current_x = metrics.horiAdvance;
+
+		for (; iterator != string.end(); iterator++) {
+			metrics = freetype_metrics(*iterator, family);
+			const mathtext::bounding_box_t glyph_bounding_box =
+				mathtext::point_t(0, current_x) +
+				mathtext::bounding_box_t(
+					metrics.horiBearingX * scale,
+					(-metrics.horiBearingY) * scale,
+					(metrics.horiBearingX + metrics.width) * scale,
+					(-metrics.horiBearingY + metrics.height) * scale,
+					metrics.horiAdvance * scale, 0);
+			ret = ret.merge(glyph_bounding_box);
+			current_x += metrics.horiAdvance;
+		}
+
+		return ret;
+	}
+
+	// The embedded fonts are encoded by the UTF-16BE CMap of
+	// fontembedpdf.cc
+	void pdf_surface_t::append_utf16be(std::string &string,
+									   const wchar_t glyph)
+	{
+		char buffer[16];
+
+		if (static_cast<uint32_t>(glyph) < 0x10000U)
+			snprintf(buffer, sizeof(buffer), "%04X",
+					 static_cast<unsigned int>(glyph));
+		else {
+			const uint32_t code = static_cast<uint32_t>(glyph) -
+				0x10000U;
+
+			snprintf(buffer, sizeof(buffer), "%04X%04X",
+					 0xd800U + (code >> 10), 0xdc00U + (code & 0x3ffU));
+		}
+		string.append(buffer);
+	}
+
+	pdf_surface_t::document_t::font_t *
+	pdf_surface_t::select_font(const unsigned int family,
+							   const float size) const
+	{
+		const std::map<std::string, document_t::font_t>::iterator
+			iterator = _document->_font.find(_font_name[family]);
+
+		if (iterator == _document->_font.end())
+			return NULL;
+		if (_document->_current_font_resource !=
+		   iterator->second._resource_name ||
+		   _document->_current_size != size) {
+			append_content("/%s %.3f Tf\n",
+						   iterator->second._resource_name.c_str(),
+						   size);
+			_document->_current_font_resource =
+				iterator->second._resource_name;
+			_document->_current_size = size;
+		}
+
+		return &iterator->second;
+	}
+
+	// Each glyph is drawn by its form, scaled to the font size
+	void pdf_surface_t::
+	draw_outline(const unsigned int family, const float size,
+				 const std::wstring &string,
+				 const std::vector<point_t> &origin) const
+	{
+		const std::map<std::string, document_t::font_t>::iterator
+			iterator = _document->_font.find(_font_name[family]);
+
+		if (iterator == _document->_font.end())
+			return;
+
+		std::map<uint16_t, unsigned int> &outline =
+			iterator->second._outline;
+
+		for (size_t i = 0; i < string.size(); i++) {
+			const uint16_t index = glyph_index(string[i], family);
+			const std::map<uint16_t, unsigned int>::const_iterator
+				outline_iterator = outline.find(index);
+			unsigned int form;
+
+			if (outline_iterator != outline.end())
+				form = outline_iterator->second;
+			else {
+				form = _document->_noutline++;
+				outline[index] = form;
+			}
+			append_content("q %.3f 0 0 %.3f %.3f %.3f cm /G%u Do Q\n",
+						   size, size, origin[i][0], origin[i][1], form);
+		}
+	}
+
+	void pdf_surface_t::
+	text_raw(const float x, const float y, const std::wstring string,
+			 const unsigned int family)
+	{
+		if (family >= NFAMILY || _font[family] == NULL) {
+			std::cerr << __FILE__ << ':' << __LINE__
+					  << ": error: font not initialized"
+					  << std::endl;
+			return;
+		}
+		if (_current_font_size[family] <= 0 || string.empty())
+			return;
+
+		const point_t transformed =
+			_transform_logical_to_pixel * point_t(x, y);
+
+		if (_glyph_outline) {
+			std::vector<point_t> origin;
+			float current_x = transformed[0];
+
+			origin.reserve(string.size());
+			for (size_t i = 0; i < string.size(); i++) {
+				origin.push_back(point_t(current_x, screen_rect().top() -
+										 transformed[1]));
+				current_x += math_bounding_box(
+					string[i], family,
+					_current_font_size[family]).advance();
+			}
+			draw_outline(family, _current_font_size[family], string,
+						 origin);
+			return;
+		}
+
+		document_t::font_t *font =
+			select_font(family, _current_font_size[family]);
+
+		if (font == NULL)
+			return;
+
+		std::string hex;
+
+		for (std::wstring::const_iterator iterator = string.begin();
+			iterator != string.end(); iterator++) {
+			append_utf16be(hex, *iterator);
+			font->_glyph_usage[*iterator] = true;
+		}
+		append_content("BT 1 0 0 1 %.3f %.3f Tm <", transformed[0],
+					   screen_rect().top() - transformed[1]);
+		_document->_content.append(hex);
+		_document->_content.append("> Tj ET\n");
+	}
+
+	// Glyphs of a run on the same baseline are drawn by a single Tj,
+	// or TJ with adjustments where they are not at their natural
+	// advances
+	void pdf_surface_t::
+	glyph_run(const math_glyph_iterator_t &glyph_begin,
+			  const math_glyph_iterator_t &glyph_end)
+	{
+		const unsigned int family = glyph_begin->_family;
+		const float size = glyph_begin->_size;
+
+		if (family >= NFAMILY || _font[family] == NULL) {
+			std::cerr << __FILE__ << ':' << __LINE__
+					  << ": error: font not initialized"
+					  << std::endl;
+			return;
+		}
+		if (size <= 0)
+			return;
+		if (_glyph_outline) {
+			std::wstring string;
+			std::vector<point_t> origin;
+
+			string.reserve(glyph_end - glyph_begin);
+			origin.reserve(glyph_end - glyph_begin);
+			for (math_glyph_iterator_t iterator = glyph_begin;
+				iterator != glyph_end; iterator++) {
+				const point_t transformed =
+					_transform_logical_to_pixel *
+					point_t(iterator->_origin[0], iterator->_origin[1]);
+
+				string.push_back(iterator->_glyph);
+				origin.push_back(point_t(transformed[0],
+										 screen_rect().top() -
+										 transformed[1]));
+			}
+			draw_outline(family, size, string, origin);
+			return;
+		}
+
+		document_t::font_t *font = select_font(family, size);
+
+		if (font == NULL)
+			return;
+
+		std::vector<point_t> origin;
+
+		origin.reserve(glyph_end - glyph_begin);
+		for (math_glyph_iterator_t iterator = glyph_begin;
+			iterator != glyph_end; iterator++) {
+			font->_glyph_usage[iterator->_glyph] = true;
+
+			const point_t transformed =
+				_transform_logical_to_pixel *
+				point_t(iterator->_origin[0], iterator->_origin[1]);
+
+			origin.push_back(point_t(transformed[0],
+									 screen_rect().top() -
+									 transformed[1]));
+		}
+		append_content("BT\n");
+
+		const size_t nglyph = origin.size();
+
+		for (size_t begin = 0; begin < nglyph;) {
+			size_t end = begin + 1;
+
+			while (end < nglyph &&
+				  fabs(origin[end][1] - origin[begin][1]) < 1e-3F)
+				end++;
+
+			std::string text;
+			bool natural_advance = true;
+
+			for (size_t i = begin; i < end; i++) {
+				std::string hex;
+
+				append_utf16be(hex, glyph_begin[i]._glyph);
+				text.append(1, '<');
+				text.append(hex);
+				text.append(1, '>');
+				if (i + 1 == end)
+					break;
+
+				// Adjustments are in thousandths of the font size,
+				// and subtracted from the advance
+				const float adjustment =
+					(math_bounding_box(glyph_begin[i]._glyph, family,
+									   size).advance() -
+					 (origin[i + 1][0] - origin[i][0])) *
+					1000.0F / size;
+
+				if (fabs(adjustment) >= 0.5F) {
+					char buffer[32];
+
+					snprintf(buffer, sizeof(buffer), " %.0f ",
+							 adjustment);
+					text.append(buffer);
+					natural_advance = false;
+				}
+			}
+			append_content("1 0 0 1 %.3f %.3f Tm ", origin[begin][0],
+						   origin[begin][1]);
+			if (natural_advance) {
+				// Adjacent hex strings are merged into one
+				std::string merged;
+
+				for (size_t i = 0; i < text.size(); i++)
+					if (text[i] != '<' && text[i] != '>')
+						merged.append(1, text[i]);
+				_document->_content.append("<" + merged + "> Tj\n");
+			}
+			else
+				_document->_content.append("[" + text + "] TJ\n");
+			begin = end;
+		}
+		append_content("ET\n");
+	}
+#endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+
+}
@@ -29,48 +29,210 @@
 
 namespace gluon {
 
+	// Fonts can only be embedded once the glyph usage is known, but
+	// have to precede the pages that use them. The page description
+	// is therefore spooled into a temporary file, and the output file
+	// is written as a whole when it is closed.
 	void postscript_surface_t::open_output_file(void)
 	{
-		_fp = fopen(_filename.c_str(), "w");
+		_fp = tmpfile();
+		if (_fp == NULL)
+			perror("tmpfile");
 	}
 
-	void postscript_surface_t::write_dsc_preamble(void) const
+	void postscript_surface_t::write_dsc_preamble(FILE *fp) const
 	{
 		static const std::string creator = "libgluon";
 
-		fputs("%!PS-Adobe-3.0 EPSF-3.0\n", _fp);
-		fprintf(_fp, "%%%%BoundingBox: %.0f %.0f %.0f %.0f\n",
+		fputs("%!PS-Adobe-3.0 EPSF-3.0\n", fp);
+		fprintf(fp, "%%%%BoundingBox: %.0f %.0f %.0f %.0f\n",
 				floor(_rect.left()),
 				floor(_rect.bottom()),
 				ceil(_rect.right()),
 				ceil(_rect.top()));
-		fprintf(_fp, "%%%%HiResBoundingBox: %.3f %.3f %.3f %.3f\n",
+		fprintf(fp, "%%%%HiResBoundingBox: %.3f %.3f %.3f %.3f\n",
 				_rect.left(), _rect.bottom(),
 				_rect.right(), _rect.top());
-		fprintf(_fp, "%%%%Creator: %s\n", creator.c_str());
-		fprintf(_fp, "%%%%Title: (%s)\n", _filename.c_str());
+		fprintf(fp, "%%%%Creator: %s\n", creator.c_str());
+		fprintf(fp, "%%%%Title: (%s)\n", _filename.c_str());
 
 		time_t creation_time = time(NULL);
 
-		fprintf(_fp, "%%%%CreationDate: %s",
+		fprintf(fp, "%%%%CreationDate: %s",
 				asctime(localtime(&creation_time)));
-		fputs("%%LanguageLevel: 3\n", _fp);
-		fputs("%%EndComments\n", _fp);
+		fputs("%%LanguageLevel: 3\n", fp);
+		fputs("%%DocumentSuppliedResources: (atend)\n", fp);
+		fputs("%%EndComments\n", fp);
 	}
 
-	void postscript_surface_t::write_dsc_trailer(void) const
+	// Embed the subset of each font that glyphs were drawn with.
+	// The subset carries a tagged font name, under which the page
+	// description, written before the glyph usage was known, does
+	// not find it, and a copy is therefore also defined under the
+	// original name.
+	void postscript_surface_t::
+	write_dsc_prolog(FILE *fp, std::vector<std::string> &font_resource)
+		const
 	{
-		fputs("%%EOF\n", _fp);
+		fputs("%%BeginProlog\n", fp);
+		if (!_text_state->_font_data.empty())
+			// /name /base-name [glyph-names] reencode_mathtext -
+			fputs("/reencode_mathtext {\n"
+				  "exch findfont dup length dict copy "
+				  "dup /FID undef\n"
+				  "exch 256 array 0 1 255 "
+				  "{ 1 index exch /.notdef put } for\n"
+				  "dup 32 4 -1 roll putinterval\n"
+				  "1 index exch /Encoding exch put definefont pop\n"
+				  "} bind def\n", fp);
+		for (std::map<std::string, mathtext::font_blob_t>::
+				const_iterator iterator =
+				_text_state->_font_data.begin();
+			iterator != _text_state->_font_data.end(); iterator++) {
+			const std::vector<wchar_t> &glyph =
+				_text_state->_glyph.find(iterator->first)->second;
+			std::map<wchar_t, bool> glyph_usage;
+
+			for (std::vector<wchar_t>::const_iterator
+					glyph_iterator = glyph.begin();
+				glyph_iterator != glyph.end(); glyph_iterator++)
+				glyph_usage[*glyph_iterator] = true;
+
+			// The font is written as it is encoded
+			mathtext::file_sink_t sink(fp);
+			std::string font_name;
+
+			if (!mathtext::font_embed_postscript_t::
+				font_embed_type_2(sink, font_name, iterator->second,
+								  glyph_usage) &&
+				// TrueType
+				!mathtext::font_embed_postscript_t::
+				font_embed_type_42(sink, font_name, iterator->second,
+								   glyph_usage)) {
+				std::cerr << __FILE__ << ':' << __LINE__
+						  << ": error: could not embed font `"
+						  << iterator->first << '\'' << std::endl;
+				continue;
+			}
+			font_resource.push_back(font_name);
+			if (font_name != iterator->first)
+				fprintf(fp, "/%s /%s findfont dup length dict copy "
+						"dup /FID undef definefont pop\n",
+						iterator->first.c_str(), font_name.c_str());
+		}
+		write_glyph_procedure(fp);
+		fputs("%%EndProlog\n", fp);
+	}
+
+	// Glyph outlines are in 1/1000 em, and each procedure takes the
+	// origin and the font size from the stack. Glyphs that could not
+	// be decoded, and those without contours, draw nothing.
+	void postscript_surface_t::write_glyph_procedure(FILE *fp) const
+	{
+		static const char *const name[
+			mathtext::glyph_outline_t::NOPERATOR] = {
+			"moveto", "lineto", NULL, "curveto", "closepath"
+		};
+
+		if (_text_state->_noutline == 0)
+			return;
+		// x y size glyph_mathtext -
+		fputs("/glyph_mathtext {\n"
+			  "gsave 3 1 roll translate 0.001 mul dup scale newpath\n"
+			  "} bind def\n", fp);
+		for (std::map<std::string, std::map<uint16_t, unsigned int> >::
+				const_iterator iterator =
+				_text_state->_outline.begin();
+			iterator != _text_state->_outline.end(); iterator++) {
+			const mathtext::font_outline_t font_outline(
+				_text_state->_outline_font_data.find(
+					iterator->first)->second);
+
+			if (!font_outline.valid())
+				std::cerr << __FILE__ << ':' << __LINE__
+						  << ": error: could not decode outlines of font `"
+						  << iterator->first << '\'' << std::endl;
+			for (std::map<uint16_t, unsigned int>::const_iterator
+					glyph_iterator = iterator->second.begin();
+				glyph_iterator != iterator->second.end();
+				glyph_iterator++) {
+				mathtext::glyph_outline_t outline;
+				std::string path;
+
+				if (font_outline.valid() &&
+				   font_outline.glyph_outline(outline,
+											  glyph_iterator->first))
+					outline.append_postfix(path, name);
+				if (path.empty())
+					fprintf(fp, "/mtg%u { pop pop pop } bind def\n",
+							glyph_iterator->second);
+				else
+					fprintf(fp, "/mtg%u { glyph_mathtext\n%s"
+							"fill grestore } bind def\n",
+							glyph_iterator->second, path.c_str());
+			}
+		}
+	}
+
+	void postscript_surface_t::
+	write_dsc_trailer(FILE *fp,
+					  const std::vector<std::string> &font_resource)
+		const
+	{
+		fputs("%%Trailer\n", fp);
+		for (std::vector<std::string>::const_iterator iterator =
+				font_resource.begin();
+			iterator != font_resource.end(); iterator++)
+			fprintf(fp, "%s font %s\n", iterator ==
+					font_resource.begin() ?
+					"%%DocumentSuppliedResources:" : "%%+",
+					iterator->c_str());
+		fputs("%%EOF\n", fp);
 	}
 
 	void postscript_surface_t::close_output_file(void)
 	{
-		if (_fp != NULL) {
-			fclose(_fp);
-			_fp = NULL;
+		if (_fp == NULL)
+			return;
+
+		FILE *fp = fopen(_filename.c_str(), "w");
+
+		if (fp == NULL)
+			perror("fopen");
+		else {
+			std::vector<std::string> font_resource;
+
+			write_dsc_preamble(fp);
+			write_dsc_prolog(fp, font_resource);
+			rewind(_fp);
+
+			char buffer[BUFSIZ];
+			size_t length;
+
+			while ((length = fread(buffer, 1, BUFSIZ, _fp)) > 0)
+				if (fwrite(buffer, 1, length, fp) != length) {
+					perror("fwrite");
+					break;
+				}
+			write_dsc_trailer(fp, font_resource);
+			fclose(fp);
 		}
+		fclose(_fp);
+		_fp = NULL;
 	}
 
+#ifdef MATHTEXT_STATISTICS
+	unsigned long postscript_surface_t::output_size(void) const
+	{
+		if (_fp == NULL)
+			return 0;
+
+		const long position = ftell(_fp);
+
+		return position < 0 ? 0 : position;
+	}
+#endif // MATHTEXT_STATISTICS
+
 #if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
 	void postscript_surface_t::freetype_init(void)
 	{
@@ -83,139 +245,193 @@ namespace gluon {
 		}
 	}
 
-	FT_Glyph_Metrics &postscript_surface_t::
-	freetype_metrics(const wchar_t character,
+	// Unscaled metrics do not depend on the font size, and are
+	// copied out while the glyph slot is locked
+	FT_Glyph_Metrics postscript_surface_t::
+	freetype_metrics(const uint16_t glyph,
 					 const unsigned int family) const
 	{
-		FT_Load_Glyph(_font[family],
-					  FT_Get_Char_Index(_font[family],
-										character),
-					  FT_LOAD_NO_SCALE);
+		mathtext::lock_t lock(_freetype_mutex);
+
+		FT_Load_Glyph(_font[family], glyph, FT_LOAD_NO_SCALE);
 
 		return _font[family]->glyph->metrics;
 	}
+#endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
 
-	void postscript_surface_t::
-	read_font_data(std::vector<FT_Byte> &font_data,
-				   const std::string &filename)
-		const
+	// The glyph index is looked up in the parsed cmap, which is
+	// shared with the font embedding, and FreeType is consulted only
+	// for fonts or characters the parser does not map
+	uint16_t postscript_surface_t::
+	glyph_index(const wchar_t character,
+				const unsigned int family) const
 	{
-		FILE *fp = fopen(filename.c_str(), "r");
+		const mathtext::parsed_font_t &parsed_font =
+			_font_data[family].parsed_font();
+		unsigned int glyph_index = parsed_font._valid ?
+			parsed_font._cid_map.find(character) : 0;
 
-		if (fp == NULL)
-			return;
-		if (fseek(fp, 0L, SEEK_END) == -1) {
-			perror("fseek");
-			return;
+#if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		if (glyph_index == 0 && _font[family] != NULL) {
+			mathtext::lock_t lock(_freetype_mutex);
+
+			glyph_index = FT_Get_Char_Index(_font[family], character);
 		}
+#endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
 
-		const long length = ftell(fp);
+		return glyph_index;
+	}
 
-		if (length == -1) {
-			perror("ftell");
-			return;
-		}
-		font_data.resize(length);
-		if (fseek(fp, 0L, SEEK_SET) == -1) {
-			perror("fseek");
-			return;
+	// Glyphs are measured by the metrics table of the font, which
+	// is computed once for all surfaces using the font, and by
+	// FreeType only if the table could not be computed
+	bool postscript_surface_t::
+	glyph_metrics(float &advance, float bounding_box[4],
+				  const wchar_t character,
+				  const unsigned int family) const
+	{
+		const uint16_t index = glyph_index(character, family);
+
+		if (_font_metrics[family] != NULL &&
+		   _font_metrics[family]->valid()) {
+			const mathtext::font_metrics_t::glyph_metrics_t *metrics =
+				_font_metrics[family]->glyph_metrics(index);
+
+			if (metrics == NULL)
+				return false;
+			advance = metrics->_advance;
+			std::copy(metrics->_bounding_box,
+					  metrics->_bounding_box + 4, bounding_box);
+
+			return true;
 		}
-		if (fread(&font_data[0], sizeof(FT_Byte), length, fp) !=
-		   static_cast<size_t>(length)) {
-			perror("fread");
-			return;
+#if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		if (_font[family] != NULL && _font[family]->units_per_EM != 0) {
+			const FT_Glyph_Metrics metrics =
+				freetype_metrics(index, family);
+			const float scale = 1000.0F / _font[family]->units_per_EM;
+
+			advance = metrics.horiAdvance * scale;
+			bounding_box[0] = metrics.horiBearingX * scale;
+			bounding_box[1] =
+				(metrics.horiBearingY - metrics.height) * scale;
+			bounding_box[2] =
+				(metrics.horiBearingX + metrics.width) * scale;
+			bounding_box[3] = metrics.horiBearingY * scale;
+
+			return true;
 		}
+#endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+
+		return false;
 	}
 
 	void postscript_surface_t::
 	open_font_overwrite(const std::string &filename,
 						const unsigned int family)
 	{
-		if (_font[family] != NULL)
+		reset_glyph_metrics(family, filename);
+#if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		if (_font[family] != NULL) {
 			FT_Done_Face(_font[family]);
-		read_font_data(_font_data[family], filename);
+			_font[family] = NULL;
+		}
+#endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		_font_metrics[family] = NULL;
+		_font_name[family].clear();
+		_font_data[family] =
+			mathtext::font_embed_t::read_font_data(filename);
+		if (_font_data[family].empty())
+			return;
+		_font_metrics[family] = &_font_data[family].font_metrics();
 
+		// The font is embedded when the output file is closed, and
+		// only if glyphs were drawn with it
+		std::string postscript_name =
+			_font_data[family].parsed_font()._font_name;
+
+#if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
 		const FT_Error error =
 			FT_New_Memory_Face(_freetype_library,
-							   &_font_data[family][0],
+							   _font_data[family].data(),
 							   _font_data[family].size(), 0,
 							   &_font[family]);
-		if (error != 0) {
-			return;
-		}
-
-		std::string embedded_str;
-
-		if (_fp != NULL) {
-			 embedded_str =
-				 mathtext::font_embed_postscript_t::
-				 font_embed_type_2(_font_name[family],
-								   _font_data[family]);
-		}
 
-		if (_master) {
-			bool embed_success = false;
-
-			if (!embedded_str.empty()) {
-				fputs(embedded_str.c_str(), _fp);
-				embed_success = true;
-			}
-			if (!embed_success) {
-				std::cerr << __FILE__ << ':' << __LINE__
-						  << ": error: could not embed font `"
-						  << filename << '\'' << std::endl;
-			}
+		if (error != 0)
+			_font[family] = NULL;
+		else if (FT_Get_Postscript_Name(_font[family]) != NULL)
+			postscript_name = FT_Get_Postscript_Name(_font[family]);
+#endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		if (postscript_name.empty()) {
+			std::cerr << __FILE__ << ':' << __LINE__
+					  << ": error: font without a PostScript name `"
+					  << filename << '\'' << std::endl;
+			return;
 		}
+		_font_name[family] = postscript_name;
 	}
 
 	void postscript_surface_t::
 	open_font_default(const std::string &filename,
 					  const unsigned int family)
 	{
-		if (_font[family] == NULL)
+		if (_font_name[family].empty())
 			open_font_overwrite(filename, family);
 	}
-#endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
 
 	postscript_surface_t::
 	postscript_surface_t(const rect_t &rect, const bool master)
-		: surface_t(rect, master), _fp(NULL), _current_point_size(0)
+		: surface_t(rect, master),
+		  _text_state(master ? new text_state_t : NULL),
+		  _raster_compression(RASTER_COMPRESSION_NONE),
+		  _raster_binary(false), _glyph_outline(false), _fp(NULL),
+		  _current_point_size(0)
 	{
 #if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
 		freetype_init();
 		std::fill(_font, _font + NFAMILY,
 				  reinterpret_cast<FT_Face>(NULL));
 #endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
-		if (master) {
+		std::fill(_font_metrics, _font_metrics + NFAMILY,
+				  static_cast<const mathtext::font_metrics_t *>(NULL));
+		if (master)
 			open_output_file();
-			write_dsc_preamble();
-		}
 	}
 
 	postscript_surface_t::
 	postscript_surface_t(const std::string &filename,
 						 const uint16_t width, const uint16_t height)
 		: surface_t(rect_t(0, 0, width, height), true),
-		  _filename(filename), _fp(NULL), _current_point_size(0)
+		  _text_state(new text_state_t),
+		  _raster_compression(RASTER_COMPRESSION_NONE),
+		  _raster_binary(false), _glyph_outline(false),
+		  _filename(filename),
+		  _fp(NULL), _current_point_size(0)
 	{
 #if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
 		freetype_init();
 		std::fill(_font, _font + NFAMILY,
 				  reinterpret_cast<FT_Face>(NULL));
 #endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		std::fill(_font_metrics, _font_metrics + NFAMILY,
+				  static_cast<const mathtext::font_metrics_t *>(NULL));
 		open_output_file();
-		write_dsc_preamble();
 	}
 
 	postscript_surface_t::
 	postscript_surface_t(postscript_surface_t &surface)
-		: surface_t(surface)
+		: surface_t(surface), _text_state(surface._text_state),
+		  _raster_compression(surface._raster_compression),
+		  _raster_binary(surface._raster_binary),
+		  _glyph_outline(surface._glyph_outline)
 	{
 #if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
 		freetype_init();
 		std::fill(_font, _font + NFAMILY,
 				  reinterpret_cast<FT_Face>(NULL));
 #endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		std::fill(_font_metrics, _font_metrics + NFAMILY,
+				  static_cast<const mathtext::font_metrics_t *>(NULL));
 		surface._subsurface.push_back(this);
 		_fp = surface._fp;
 	}
@@ -230,8 +446,8 @@ namespace gluon {
 			}
 #endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
 		if (_master) {
-			write_dsc_trailer();
 			close_output_file();
+			delete _text_state;
 		}
 	}
 
@@ -245,6 +461,10 @@ namespace gluon {
 		_subsurface.push_back(ret);
 		ret->_supersurface = this;
 		ret->_fp = _fp;
+		ret->_text_state = _text_state;
+		ret->_raster_compression = _raster_compression;
+		ret->_raster_binary = _raster_binary;
+		ret->_glyph_outline = _glyph_outline;
 #if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
 		ret->_freetype_library = _freetype_library;
 #endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
@@ -418,11 +638,45 @@ namespace gluon {
 				screen_rect().bottom() - transformed1[1]);
 	}
 
+	void postscript_surface_t::
+	set_raster_compression(const unsigned int compression)
+	{
+		if (compression >= NRASTER_COMPRESSION) {
+			fprintf(stderr, "%s:%d: error: invalid raster compression "
+					"%u\n", __FILE__, __LINE__, compression);
+			return;
+		}
+		_raster_compression = compression;
+#ifndef HAVE_ZLIB
+		if (_raster_compression == RASTER_COMPRESSION_FLATE)
+			_raster_compression = RASTER_COMPRESSION_RUN_LENGTH;
+#endif // HAVE_ZLIB
+	}
+
+	void postscript_surface_t::set_raster_binary(const bool binary)
+	{
+		_raster_binary = binary;
+	}
+
+	void postscript_surface_t::set_glyph_outline(const bool outline)
+	{
+		_glyph_outline = outline;
+	}
+
+	// The image data is quantized and compressed one row at a time,
+	// and written through to the file, so that the memory used is
+	// independent of the image size. The length of binary data, which
+	// %%BeginData requires before it, is only known afterwards, and
+	// is filled into a placeholder of the spooled page description.
 	void postscript_surface_t::
 	raster(const float x, const float y, const float width,
 		   const float height, const float density[],
 		   const int nhorizontal, const int nvertical) const
 	{
+		static const char *filter_name[NRASTER_COMPRESSION] = {
+			"", " /RunLengthDecode filter", " /FlateDecode filter"
+		};
+
 		fputs("/DeviceRGB setcolorspace\n", _fp);
 
 		const point_t transformed0 = _transform_logical_to_pixel *
@@ -442,78 +696,126 @@ namespace gluon {
 		fputs("    /Decode [0 1 0 1 0 1]\n", _fp);
 		fprintf(_fp, "    /ImageMatrix [%d 0 0 %d 0 0]\n",
 				nhorizontal, nvertical);
-		fputs("    /DataSource currentfile /ASCII85Decode filter\n",
-			  _fp);
+		fprintf(_fp, "    /DataSource currentfile%s%s\n",
+				_raster_binary ? "" : " /ASCII85Decode filter",
+				filter_name[_raster_compression]);
 		fputs(">>\n", _fp);
-		fputs("image\n", _fp);
-
-		const unsigned long npixel = nhorizontal * nvertical;
-		uint8_t *buffer = new uint8_t[npixel * 3];
-
-#ifdef __INTEL_COMPILER
-#pragma warning(push)
-#pragma warning(disable: 810)
-#endif // __INTEL_COMPILER
-		for (unsigned long i = 0; i < npixel; i++)
-			for (unsigned long j = 0; j < 3; j++)
-				buffer[i * 3 + j] = density[(i << 2) + j] < 0 ? 0U :
-					density[(i << 2) + j] < (255.0 / 256.0) ?
-					static_cast<uint8_t>(
-						density[(i << 2) + j] * 256.0F) : 255U;
-#ifdef __INTEL_COMPILER
-#pragma warning(pop)
-#endif // __INTEL_COMPILER
-
-		std::string ascii;
-
-		append_ascii85(ascii, reinterpret_cast<uint8_t *>(buffer),
-					   npixel * 3);
-
-		delete [] buffer;
-
-		fputs(ascii.c_str(), _fp);
-		fputs("\n", _fp);
+
+		// Width of the placeholder for the %%BeginData length
+		static const int length_width = 12;
+		const long begin_data_position = ftell(_fp);
+
+		if (_raster_binary)
+			fprintf(_fp, "%%%%BeginData: %*lu Binary Bytes\n",
+					length_width, 0UL);
+
+		static const char image[] = "image\n";
+
+		fputs(image, _fp);
+
+		mathtext::file_sink_t sink(_fp);
+		mathtext::ascii85_sink_t ascii85(sink);
+		mathtext::font_sink_t &encoded = _raster_binary ?
+			static_cast<mathtext::font_sink_t &>(sink) : ascii85;
+		mathtext::run_length_sink_t *run_length = NULL;
+#ifdef HAVE_ZLIB
+		mathtext::deflate_sink_t *deflate = NULL;
+#endif // HAVE_ZLIB
+		mathtext::font_sink_t *compressed = &encoded;
+
+		switch (_raster_compression) {
+		case RASTER_COMPRESSION_RUN_LENGTH:
+			run_length = new mathtext::run_length_sink_t(encoded);
+			compressed = run_length;
+			break;
+#ifdef HAVE_ZLIB
+		case RASTER_COMPRESSION_FLATE:
+			deflate = new mathtext::deflate_sink_t(encoded);
+			compressed = deflate;
+			break;
+#endif // HAVE_ZLIB
+		}
+
+		const size_t row_length = std::max(nhorizontal, 0);
+		std::vector<uint8_t> row(row_length * 3);
+
+		for (int i = 0; i < nvertical && !row.empty(); i++) {
+			quantize_rgb(&row[0], density + (i * row_length << 2),
+						 row_length);
+			compressed->write(&row[0], row.size());
+		}
+		if (run_length != NULL) {
+			run_length->finish();
+			delete run_length;
+		}
+#ifdef HAVE_ZLIB
+		if (deflate != NULL) {
+			deflate->finish();
+			delete deflate;
+		}
+#endif // HAVE_ZLIB
+		if (_raster_binary) {
+			const long end_data_position = ftell(_fp);
+
+			// The length includes the image operator
+			if (begin_data_position < 0 || end_data_position < 0 ||
+			   fseek(_fp, begin_data_position, SEEK_SET) != 0)
+				perror("fseek");
+			else {
+				fprintf(_fp, "%%%%BeginData: %*lu Binary Bytes\n",
+						length_width, static_cast<unsigned long>(
+							sizeof(image) - 1 + sink.length()));
+				fseek(_fp, end_data_position, SEEK_SET);
+			}
+			fputs("\n%%EndData\n", _fp);
+		}
+		else {
+			ascii85.finish();
+			fputs("\n", _fp);
+		}
 		fputs("grestore\n", _fp);
 	}
 
-#if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
 	mathtext::bounding_box_t postscript_surface_t::
 	bounding_box(const std::wstring string, const unsigned int family)
 	{
-		if (string.empty() || _font[family] == NULL ||
-		   _font[family]->units_per_EM == 0)
-			return mathtext::bounding_box_t(0, 0, 0, 0, 0, 0);
+		return bounding_box(string, family, _current_font_size[family]);
+	}
 
-		std::wstring::const_iterator iterator = string.begin();
+	mathtext::bounding_box_t postscript_surface_t::
+	bounding_box(const std::wstring string, const unsigned int family,
+				 const float size) const
+	{
+		if (string.empty() || family >= NFAMILY ||
+		   _font_name[family].empty())
+			return mathtext::bounding_box_t(0, 0, 0, 0, 0, 0);
 
-		const float scale = _current_font_size[family] /
-			_font[family]->units_per_EM;
-		FT_Glyph_Metrics metrics;
-		mathtext::bounding_box_t ret;
+		// The metrics are in 1/1000 em, with the y axis pointing up
+		const float scale = size / 1000.0F;
+		mathtext::bounding_box_t ret(0, 0, 0, 0, 0, 0);
+		bool empty = true;
+		float current_x = 0;
 
-		metrics = freetype_metrics(*iterator, family);
-		ret = mathtext::bounding_box_t(
-			metrics.horiBearingX * scale,
-			(-metrics.horiBearingY) * scale,
-			(metrics.horiBearingX + metrics.width) * scale,
-			(-metrics.horiBearingY + metrics.height) * scale,
-			metrics.horiAdvance * scale, 0);
-		iterator++;
+		for (std::wstring::const_iterator iterator = string.begin();
+			iterator != string.end(); iterator++) {
+			float advance = 0;
+			float box[4] = { 0, 0, 0, 0 };
 
-		float current_x = metrics.horiAdvance;
+			// A glyph without metrics takes no space
+			if (!glyph_metrics(advance, box, *iterator, family))
+				continue;
 
-		for (; iterator != string.end(); iterator++) {
-			metrics = freetype_metrics(*iterator, family);
 			const mathtext::bounding_box_t glyph_bounding_box =
-				mathtext::point_t(0, current_x) +
+				mathtext::point_t(current_x, 0) +
 				mathtext::bounding_box_t(
-					metrics.horiBearingX * scale,
-					(-metrics.horiBearingY) * scale,
-					(metrics.horiBearingX + metrics.width) * scale,
-					(-metrics.horiBearingY + metrics.height) * scale,
-					metrics.horiAdvance * scale, 0);
-			ret = ret.merge(glyph_bounding_box);
-			current_x += metrics.horiAdvance;
+					box[0] * scale, -box[3] * scale,
+					box[2] * scale, -box[1] * scale,
+					advance * scale, 0);
+
+			ret = empty ? glyph_bounding_box :
+				ret.merge(glyph_bounding_box);
+			empty = false;
+			current_x += advance * scale;
 		}
 
 		return ret;
@@ -523,48 +825,306 @@ namespace gluon {
 	text_raw(const float x, const float y, const std::wstring string,
 			 const unsigned int family)
 	{
-		if (family >= NFAMILY || _font[family] == NULL) {
+		if (family >= NFAMILY || _font_name[family].empty()) {
 			std::cerr << __FILE__ << ':' << __LINE__
 					  << ": error: font not initialized"
 					  << std::endl;
 			return;
 		}
-		if (_current_font_size[family] <= 0)
+		if (_current_font_size[family] <= 0 || string.empty())
+			return;
+
+		const point_t transformed =
+			_transform_logical_to_pixel * point_t(x, y);
+
+		if (_glyph_outline) {
+			std::vector<unsigned int> procedure;
+			float current_x = transformed[0];
+
+			encode_outline(procedure, family, string);
+			for (size_t i = 0; i < string.size(); i++) {
+				fprintf(_fp, "%.3f %.3f %.3f mtg%u\n", current_x,
+						screen_rect().bottom() - transformed[1],
+						_current_font_size[family], procedure[i]);
+				current_x += math_bounding_box(
+					string[i], family,
+					_current_font_size[family]).advance();
+			}
 			return;
-		// FIXME: Check if reloading/rescaling the font is necessary
+		}
 
-		point_t transformed = _transform_logical_to_pixel * point_t(x, y);
+		std::vector<unsigned int> code;
 
-		fprintf(_fp, "/%s findfont %.3f scalefont setfont\n"
-				"%.3f %.3f moveto ", _font_name[family].c_str(),
-				_current_font_size[family], transformed[0],
+		encode(code, family, string);
+
+		fprintf(_fp, "%.3f %.3f moveto\n", transformed[0],
 				screen_rect().bottom() - transformed[1]);
 
+		// show continues from the current point, so the string is
+		// split only where the reencoded font changes
+		for (size_t begin = 0; begin < code.size();) {
+			const unsigned int encoding =
+				code[begin] / nglyph_per_encoding;
+			size_t end = begin + 1;
+
+			while (end < code.size() &&
+				  end - begin < nglyph_per_show &&
+				  code[end] / nglyph_per_encoding == encoding)
+				end++;
+			select_font(family, encoding, _current_font_size[family]);
+			write_string(code, begin, end);
+			fputs(" show\n", _fp);
+			begin = end;
+		}
+	}
+
+	void postscript_surface_t::
+	write_glyph_name(const wchar_t glyph) const
+	{
 #include <table/adobeglyph.h>
 
-		for (std::wstring::const_reverse_iterator iterator =
-				string.rbegin();
-			iterator != string.rend(); iterator++) {
-			const wchar_t *lower =
-				std::lower_bound(adobe_glyph_ucs,
-								 adobe_glyph_ucs + nadobe_glyph,
-								 *iterator);
-			if (lower < adobe_glyph_ucs + nadobe_glyph &&
-			   *lower == *iterator) {
-				const unsigned long index =
-					lower - adobe_glyph_ucs;
-
-				fprintf(_fp, "/%s ", adobe_glyph_name[index]);
+		const wchar_t *lower =
+			std::lower_bound(adobe_glyph_ucs,
+							 adobe_glyph_ucs + nadobe_glyph, glyph);
+
+		if (lower < adobe_glyph_ucs + nadobe_glyph &&
+		   *lower == glyph) {
+			const unsigned long index = lower - adobe_glyph_ucs;
+
+			fprintf(_fp, "/%s ", adobe_glyph_name[index]);
+		}
+		else
+			fprintf(_fp, "/uni%04X ", glyph);
+	}
+
+	// Assign character codes to the glyphs of a string, and
+	// (re)define the reencoded fonts that received new glyphs
+	void postscript_surface_t::
+	encode(std::vector<unsigned int> &code, const unsigned int family,
+		   const std::wstring &string)
+	{
+		const std::string &font_name = _font_name[family];
+		std::vector<wchar_t> &glyph = _text_state->_glyph[font_name];
+		std::map<wchar_t, unsigned int> &glyph_code =
+			_text_state->_code[font_name];
+		const unsigned int nglyph_previous = glyph.size();
+
+		code.resize(string.size());
+		for (size_t i = 0; i < string.size(); i++) {
+			const std::map<wchar_t, unsigned int>::const_iterator
+				iterator = glyph_code.find(string[i]);
+
+			if (iterator != glyph_code.end())
+				code[i] = iterator->second;
+			else {
+				code[i] = glyph.size();
+				glyph_code[string[i]] = code[i];
+				glyph.push_back(string[i]);
+			}
+		}
+		if (glyph.size() == nglyph_previous)
+			return;
+		if (nglyph_previous == 0)
+			_text_state->_font_data[font_name] = _font_data[family];
+		for (unsigned int encoding =
+				nglyph_previous / nglyph_per_encoding;
+			encoding <= (glyph.size() - 1) / nglyph_per_encoding;
+			encoding++) {
+			const unsigned int begin = encoding * nglyph_per_encoding;
+			const unsigned int end =
+				std::min(begin + nglyph_per_encoding,
+						 static_cast<unsigned int>(glyph.size()));
+
+			fprintf(_fp, "/%s.%u /%s [", font_name.c_str(), encoding,
+					font_name.c_str());
+			for (unsigned int i = begin; i < end; i++) {
+				if ((i - begin) % 8 == 0)
+					fputc('\n', _fp);
+				write_glyph_name(glyph[i]);
+			}
+			fputs("] reencode_mathtext\n", _fp);
+			// The selected font is the previous definition
+			if (_text_state->_current_font_name == font_name &&
+			   _text_state->_current_encoding == encoding)
+				_text_state->_current_font_name.clear();
+		}
+	}
+
+	// Number the glyphs of a string that are drawn as outlines, which
+	// are defined when the output file is closed
+	void postscript_surface_t::
+	encode_outline(std::vector<unsigned int> &procedure,
+				   const unsigned int family, const std::wstring &string)
+	{
+		const std::string &font_name = _font_name[family];
+		std::map<uint16_t, unsigned int> &outline =
+			_text_state->_outline[font_name];
+
+		if (outline.empty())
+			_text_state->_outline_font_data[font_name] =
+				_font_data[family];
+		procedure.resize(string.size());
+		for (size_t i = 0; i < string.size(); i++) {
+			const uint16_t index = glyph_index(string[i], family);
+			const std::map<uint16_t, unsigned int>::const_iterator
+				iterator = outline.find(index);
+
+			if (iterator != outline.end())
+				procedure[i] = iterator->second;
+			else {
+				procedure[i] = _text_state->_noutline++;
+				outline[index] = procedure[i];
 			}
+		}
+	}
+
+	void postscript_surface_t::
+	select_font(const unsigned int family, const unsigned int encoding,
+				const float size)
+	{
+		if (_text_state->_current_font_name == _font_name[family] &&
+		   _text_state->_current_encoding == encoding &&
+		   _text_state->_current_size == size)
+			return;
+		fprintf(_fp, "/%s.%u %.3f selectfont\n",
+				_font_name[family].c_str(), encoding, size);
+		_text_state->_current_font_name = _font_name[family];
+		_text_state->_current_encoding = encoding;
+		_text_state->_current_size = size;
+	}
+
+	void postscript_surface_t::
+	write_string(const std::vector<unsigned int> &code,
+				 const size_t begin, const size_t end) const
+	{
+		fputc('(', _fp);
+		for (size_t i = begin; i < end; i++) {
+			const unsigned int c = 32 + code[i] % nglyph_per_encoding;
+
+			if (c == '(' || c == ')' || c == '\\')
+				fprintf(_fp, "\\%c", c);
+			else if (c < 127)
+				fputc(c, _fp);
 			else
-				fprintf(_fp, "/uni%04X ", *iterator);
+				fprintf(_fp, "\\%03o", c);
+		}
+		fputc(')', _fp);
+	}
+
+	// Encode the glyphs of all runs of a family together, so that
+	// a reencoded font is defined at most once per drawing
+	void postscript_surface_t::
+	prepare_glyph_run(const math_glyph_iterator_t &glyph_begin,
+					  const math_glyph_iterator_t &glyph_end)
+	{
+		math_glyph_iterator_t family_begin = glyph_begin;
+
+		while (family_begin != glyph_end) {
+			const unsigned int family = family_begin->_family;
+			std::wstring string;
+			math_glyph_iterator_t iterator = family_begin;
+
+			for (; iterator != glyph_end &&
+					iterator->_family == family; iterator++)
+				string.push_back(iterator->_glyph);
+			if (family < NFAMILY && !_font_name[family].empty() &&
+			   !_glyph_outline) {
+				std::vector<unsigned int> code;
+
+				encode(code, family, string);
+			}
+			family_begin = iterator;
+		}
+	}
+
+	// Glyphs of a run are split into segments on the same baseline
+	// and in the same reencoded font, and each segment is drawn by a
+	// single show, or xshow where the glyphs are not at their natural
+	// advances
+	void postscript_surface_t::
+	glyph_run(const math_glyph_iterator_t &glyph_begin,
+			  const math_glyph_iterator_t &glyph_end)
+	{
+		const unsigned int family = glyph_begin->_family;
+		const float size = glyph_begin->_size;
+
+		if (family >= NFAMILY || _font_name[family].empty()) {
+			std::cerr << __FILE__ << ':' << __LINE__
+					  << ": error: font not initialized"
+					  << std::endl;
+			return;
+		}
+		if (size <= 0)
+			return;
+
+		std::wstring string;
+		std::vector<point_t> origin;
+
+		string.reserve(glyph_end - glyph_begin);
+		origin.reserve(glyph_end - glyph_begin);
+		for (math_glyph_iterator_t iterator = glyph_begin;
+			iterator != glyph_end; iterator++) {
+			const point_t transformed =
+				_transform_logical_to_pixel *
+				point_t(iterator->_origin[0], iterator->_origin[1]);
+
+			string.push_back(iterator->_glyph);
+			origin.push_back(point_t(transformed[0],
+									 screen_rect().bottom() -
+									 transformed[1]));
+		}
+		if (_glyph_outline) {
+			std::vector<unsigned int> procedure;
+
+			encode_outline(procedure, family, string);
+			for (size_t i = 0; i < procedure.size(); i++)
+				fprintf(_fp, "%.3f %.3f %.3f mtg%u\n", origin[i][0],
+						origin[i][1], size, procedure[i]);
+			return;
+		}
+
+		std::vector<unsigned int> code;
+
+		encode(code, family, string);
+
+		std::vector<float> advance(code.size());
+
+		for (size_t begin = 0; begin < code.size();) {
+			const unsigned int encoding =
+				code[begin] / nglyph_per_encoding;
+			size_t end = begin + 1;
+
+			while (end < code.size() &&
+				  end - begin < nglyph_per_show &&
+				  code[end] / nglyph_per_encoding == encoding &&
+				  fabs(origin[end][1] - origin[begin][1]) < 1e-3F)
+				end++;
+
+			bool natural_advance = true;
+
+			for (size_t i = begin; i < end; i++) {
+				const float natural = math_bounding_box(
+					string[i], family, size).advance();
+
+				advance[i] = i + 1 < end ?
+					origin[i + 1][0] - origin[i][0] : natural;
+				if (fabs(advance[i] - natural) >= 1e-3F)
+					natural_advance = false;
+			}
+			select_font(family, encoding, size);
+			fprintf(_fp, "%.3f %.3f moveto ", origin[begin][0],
+					origin[begin][1]);
+			write_string(code, begin, end);
+			if (natural_advance)
+				fputs(" show\n", _fp);
+			else {
+				fputs(" [", _fp);
+				for (size_t i = begin; i < end; i++)
+					fprintf(_fp, (i - begin) % 8 == 7 ?
+							"%.3f\n" : "%.3f ", advance[i]);
+				fputs("] xshow\n", _fp);
+			}
+			begin = end;
 		}
-		// FIXME: extract 8-bit segment and use "show"
-		if (string.size() == 1U)
-			fprintf(_fp, "glyphshow\n");
-		else
-			fprintf(_fp, "%lu {glyphshow} repeat\n",
-					string.size());
 	}
-#endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
 }
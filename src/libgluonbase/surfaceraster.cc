@@ -0,0 +1,1079 @@
+// mathtext - A TeX/LaTeX compatible rendering library. Copyright (C)
+// 2008-2016 Yue Shi Lai <ylai@users.sourceforge.net>
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2.1 of
+// the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// 02110-1301 USA
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <algorithm>
+#include <gluon/screen.h>
+#include <mathtext/fontembed.h>
+
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#ifdef HAVE_SSE2
+#define BLEND_HAVE_SSE2
+#include <emmintrin.h>
+#endif // HAVE_SSE2
+#endif // defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+
+// References:
+//
+// R. Levien, "Inside the fastest font renderer in the world" (2016),
+// for the signed area accumulation of the coverage rasterizer.
+//
+// J. F. Blinn, "Three wrongs make a right", IEEE Comput. Graph. Appl.
+// 15(6), 90-93 (1995), for the exact division by 255.
+
+/////////////////////////////////////////////////////////////////////
+
+namespace gluon {
+
+	namespace {
+
+		unsigned int color_component(const float value)
+		{
+			return value <= 0 ? 0 : value >= 1 ? 255 :
+				static_cast<unsigned int>(value * 255.0F + 0.5F);
+		}
+
+		// Rounded x / 255, exact for 0 <= x <= 255 * 255
+		inline unsigned int div255(unsigned int x)
+		{
+			x += 128;
+			return (x + (x >> 8)) >> 8;
+		}
+
+		// The accumulated area of an edge, clipped to the columns
+		// [0, width] of a buffer with width + 2 columns per row, is
+		// deposited such that the running sum along a row is the
+		// signed coverage of each pixel. Parts of the edge left of
+		// the buffer are moved onto its first column, which preserves
+		// the winding to the right of it.
+		void accumulate_edge(float area[], const unsigned int stride,
+							 const float width, const unsigned int height,
+							 float x0, float y0, float x1, float y1)
+		{
+			if (y0 == y1)
+				return;
+
+			float direction = 1;
+
+			if (y0 > y1) {
+				std::swap(x0, x1);
+				std::swap(y0, y1);
+				direction = -1;
+			}
+
+			const float dxdy = (x1 - x0) / (y1 - y0);
+			const int row_begin = std::max(0, static_cast<int>(floorf(y0)));
+			const int row_end =
+				std::min(static_cast<int>(height),
+						 static_cast<int>(ceilf(y1)));
+
+			for (int row = row_begin; row < row_end; row++) {
+				const float y_top = std::max(static_cast<float>(row), y0);
+				const float y_bottom = std::min(row + 1.0F, y1);
+				const float dy = y_bottom - y_top;
+
+				if (dy <= 0)
+					continue;
+
+				const float xa = std::min(std::max(
+					x0 + (y_top - y0) * dxdy, 0.0F), width);
+				const float xb = std::min(std::max(
+					x0 + (y_bottom - y0) * dxdy, 0.0F), width);
+				const float d = dy * direction;
+				float *p = area + row * stride;
+				const float x_left = std::min(xa, xb);
+				const float x_right = std::max(xa, xb);
+				const float x_left_floor = floorf(x_left);
+				const float x_right_ceil = ceilf(x_right);
+				const int i_left = static_cast<int>(x_left_floor);
+				const int i_right = static_cast<int>(x_right_ceil);
+
+				if (i_right <= i_left + 1) {
+					const float x_middle =
+						0.5F * (xa + xb) - x_left_floor;
+
+					p[i_left] += d - d * x_middle;
+					p[i_left + 1] += d * x_middle;
+				}
+				else {
+					const float s = 1.0F / (x_right - x_left);
+					const float f_left = x_left - x_left_floor;
+					const float a0 =
+						0.5F * s * (1 - f_left) * (1 - f_left);
+					const float f_right = x_right - x_right_ceil + 1;
+					const float a_last = 0.5F * s * f_right * f_right;
+
+					p[i_left] += d * a0;
+					if (i_right == i_left + 2)
+						p[i_left + 1] += d * (1 - a0 - a_last);
+					else {
+						const float a1 = s * (1.5F - f_left);
+
+						p[i_left + 1] += d * (a1 - a0);
+						for (int i = i_left + 2; i < i_right - 1; i++)
+							p[i] += d * s;
+
+						const float a2 = a1 + (i_right - i_left - 3) * s;
+
+						p[i_right - 1] += d * (1 - a2 - a_last);
+					}
+					p[i_right] += d * a_last;
+				}
+			}
+		}
+
+		void blend_span_scalar(uint8_t rgba[], const uint8_t coverage[],
+							   const size_t npixel,
+							   const uint8_t color[4])
+		{
+			for (size_t i = 0; i < npixel; i++) {
+				const unsigned int a = div255(coverage[i] * color[3]);
+
+				if (a == 0)
+					continue;
+
+				uint8_t *p = rgba + 4 * i;
+
+				p[0] = div255(p[0] * (255 - a) + color[0] * a);
+				p[1] = div255(p[1] * (255 - a) + color[1] * a);
+				p[2] = div255(p[2] * (255 - a) + color[2] * a);
+				p[3] = div255(p[3] * (255 - a) + 255 * a);
+			}
+		}
+
+#ifdef BLEND_HAVE_SSE2
+		inline __m128i div255_epu16(__m128i x)
+		{
+			x = _mm_add_epi16(x, _mm_set1_epi16(128));
+
+			return _mm_srli_epi16(_mm_add_epi16(
+				x, _mm_srli_epi16(x, 8)), 8);
+		}
+
+		// Four pixels at a time in 16 bit lanes, with the same
+		// rounding as blend_span_scalar()
+		void blend_span_sse2(uint8_t rgba[], const uint8_t coverage[],
+							 const size_t npixel, const uint8_t color[4])
+		{
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i full = _mm_set1_epi16(255);
+			const __m128i alpha = _mm_set1_epi16(color[3]);
+			const __m128i source =
+				_mm_set_epi16(255, color[2], color[1], color[0],
+							  255, color[2], color[1], color[0]);
+			size_t i = 0;
+
+			for (; i + 4 <= npixel; i += 4) {
+				int coverage4;
+
+				memcpy(&coverage4, coverage + i, 4);
+				if (coverage4 == 0)
+					continue;
+
+				__m128i a = div255_epu16(_mm_mullo_epi16(
+					_mm_unpacklo_epi8(_mm_cvtsi32_si128(coverage4),
+									  zero), alpha));
+
+				a = _mm_unpacklo_epi16(a, a);
+
+				const __m128i a_low = _mm_unpacklo_epi32(a, a);
+				const __m128i a_high = _mm_unpackhi_epi32(a, a);
+				__m128i *p = reinterpret_cast<__m128i *>(rgba + 4 * i);
+				const __m128i destination = _mm_loadu_si128(p);
+				const __m128i low = div255_epu16(_mm_add_epi16(
+					_mm_mullo_epi16(_mm_unpacklo_epi8(destination, zero),
+									_mm_sub_epi16(full, a_low)),
+					_mm_mullo_epi16(source, a_low)));
+				const __m128i high = div255_epu16(_mm_add_epi16(
+					_mm_mullo_epi16(_mm_unpackhi_epi8(destination, zero),
+									_mm_sub_epi16(full, a_high)),
+					_mm_mullo_epi16(source, a_high)));
+
+				_mm_storeu_si128(p, _mm_packus_epi16(low, high));
+			}
+			blend_span_scalar(rgba + 4 * i, coverage + i, npixel - i,
+							  color);
+		}
+#endif // BLEND_HAVE_SSE2
+
+	}
+
+	raster_surface_t::glyph_atlas_t::glyph_atlas_t(void)
+		: _shelf_x(0), _shelf_y(0), _shelf_height(0)
+	{
+	}
+
+	// Shelves are filled left to right, and a new shelf is opened
+	// below the tallest glyph of the current one when it is full
+	const raster_surface_t::glyph_atlas_t::entry_t &
+	raster_surface_t::glyph_atlas_t::
+	insert(const uint16_t glyph, const uint8_t *buffer,
+		   const unsigned int width, const unsigned int height,
+		   const int pitch, const int left, const int top)
+	{
+		entry_t &entry = _entry[glyph];
+
+		memset(&entry, 0, sizeof(entry_t));
+		if (width == 0 || height == 0 || width > glyph_atlas_t::width)
+			return entry;
+		if (_shelf_x + width > glyph_atlas_t::width) {
+			_shelf_y += _shelf_height;
+			_shelf_x = 0;
+			_shelf_height = 0;
+		}
+		if (_shelf_y + height > 65535U)
+			return entry;
+		_shelf_height = std::max(_shelf_height, height);
+		if (_bitmap.size() < (_shelf_y + _shelf_height) *
+		   glyph_atlas_t::width)
+			_bitmap.resize((_shelf_y + _shelf_height) *
+						   glyph_atlas_t::width, 0);
+		for (unsigned int y = 0; y < height; y++) {
+			// A negative pitch stores the rows bottom up
+			const uint8_t *source = pitch >= 0 ?
+				buffer + y * pitch :
+				buffer + (height - 1 - y) * (-pitch);
+
+			memcpy(&_bitmap[(_shelf_y + y) * glyph_atlas_t::width +
+							_shelf_x], source, width);
+		}
+		entry._x = _shelf_x;
+		entry._y = _shelf_y;
+		entry._width = width;
+		entry._height = height;
+		entry._left = left;
+		entry._top = top;
+		_shelf_x += width;
+
+		return entry;
+	}
+
+	// The framebuffer rows start at the top edge of the screen, as
+	// seen on opengl_surface_t, where the y axis points up
+	point_t raster_surface_t::device_point(const float x, const float y)
+		const
+	{
+		const point_t transformed =
+			_transform_logical_to_pixel * point_t(x, y);
+		const rect_t screen = screen_rect();
+
+		return point_t(transformed[0] - screen.left(),
+					   screen.top() - transformed[1]);
+	}
+
+	void raster_surface_t::color(uint8_t rgba[4]) const
+	{
+		rgba[0] = color_component(_current_color.red());
+		rgba[1] = color_component(_current_color.green());
+		rgba[2] = color_component(_current_color.blue());
+		rgba[3] = color_component(_current_alpha);
+	}
+
+	// The blending follows the instruction set selection of the
+	// ASCIIHex and ASCII85 encoders. The framebuffer alpha is
+	// composited as an opaque source, so that an opaque framebuffer
+	// stays opaque.
+	void raster_surface_t::blend_span(uint8_t rgba[],
+									  const uint8_t coverage[],
+									  const size_t npixel,
+									  const uint8_t color[4])
+	{
+#ifdef BLEND_HAVE_SSE2
+		if (mathtext::encoder_instruction_set() !=
+			mathtext::ENCODER_SCALAR) {
+			blend_span_sse2(rgba, coverage, npixel, color);
+			return;
+		}
+#endif // BLEND_HAVE_SSE2
+		blend_span_scalar(rgba, coverage, npixel, color);
+	}
+
+	// The path is filled with the nonzero winding rule, saturating
+	// the accumulated coverage, over its bounding box clipped to the
+	// framebuffer
+	void raster_surface_t::
+	fill_path(const std::vector<std::vector<point_t> > &path) const
+	{
+		float x_min = HUGE_VAL;
+		float y_min = HUGE_VAL;
+		float x_max = -HUGE_VAL;
+		float y_max = -HUGE_VAL;
+
+		for (std::vector<std::vector<point_t> >::const_iterator
+				iterator = path.begin();
+			iterator != path.end(); iterator++)
+			for (std::vector<point_t>::const_iterator point_iterator =
+					iterator->begin();
+				point_iterator != iterator->end(); point_iterator++) {
+				x_min = std::min(x_min, (*point_iterator)[0]);
+				y_min = std::min(y_min, (*point_iterator)[1]);
+				x_max = std::max(x_max, (*point_iterator)[0]);
+				y_max = std::max(y_max, (*point_iterator)[1]);
+			}
+		if (!(x_min < x_max && y_min < y_max))
+			return;
+
+		const int left = std::max(0, static_cast<int>(floorf(x_min)));
+		const int top = std::max(0, static_cast<int>(floorf(y_min)));
+		const int right =
+			std::min(static_cast<int>(_framebuffer->_width),
+					 static_cast<int>(ceilf(x_max)));
+		const int bottom =
+			std::min(static_cast<int>(_framebuffer->_height),
+					 static_cast<int>(ceilf(y_max)));
+
+		if (left >= right || top >= bottom)
+			return;
+
+		const unsigned int width = right - left;
+		const unsigned int height = bottom - top;
+		const unsigned int stride = width + 2;
+		std::vector<float> area(stride * height, 0);
+
+		for (std::vector<std::vector<point_t> >::const_iterator
+				iterator = path.begin();
+			iterator != path.end(); iterator++) {
+			const size_t n = iterator->size();
+
+			for (size_t i = 0; i < n; i++) {
+				const point_t &point0 = (*iterator)[i];
+				const point_t &point1 = (*iterator)[(i + 1) % n];
+
+				accumulate_edge(&area[0], stride, width, height,
+								point0[0] - left, point0[1] - top,
+								point1[0] - left, point1[1] - top);
+			}
+		}
+
+		uint8_t rgba[4];
+		std::vector<uint8_t> coverage(width);
+
+		this->color(rgba);
+		for (unsigned int y = 0; y < height; y++) {
+			const float *a = &area[y * stride];
+			float sum = 0;
+
+			for (unsigned int x = 0; x < width; x++) {
+				sum += a[x];
+				coverage[x] = static_cast<uint8_t>(
+					std::min(fabsf(sum), 1.0F) * 255.0F + 0.5F);
+			}
+			blend_span(&_framebuffer->_pixel[
+						   4 * ((top + y) * _framebuffer->_width + left)],
+					   &coverage[0], width, rgba);
+		}
+	}
+
+	// Lines are quadrilaterals of the line width, but at least one
+	// pixel wide. Square caps extend them by half the width, which
+	// closes the corners of outlines.
+	void raster_surface_t::
+	stroke_line(std::vector<std::vector<point_t> > &path,
+				const point_t &point0, const point_t &point1,
+				const bool square_cap) const
+	{
+		const point_t direction = point1 - point0;
+		const float length = sqrtf(direction[0] * direction[0] +
+								   direction[1] * direction[1]);
+
+		if (!(length > 0))
+			return;
+
+		const float half_width =
+			0.5F * std::max(_framebuffer->_line_width, 1.0F);
+		const point_t tangent = direction * (half_width / length);
+		const point_t normal(-tangent[1], tangent[0]);
+		const point_t begin = square_cap ? point0 - tangent : point0;
+		const point_t end = square_cap ? point1 + tangent : point1;
+		std::vector<point_t> contour;
+
+		contour.push_back(begin + normal);
+		contour.push_back(end + normal);
+		contour.push_back(end - normal);
+		contour.push_back(begin - normal);
+		path.push_back(contour);
+	}
+
+#if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+	void raster_surface_t::freetype_init(void)
+	{
+		const FT_Error error = FT_Init_FreeType(&_freetype_library);
+
+		if (error != 0) {
+			std::cerr << __FILE__ << ':' << __LINE__
+					  << ": error: FreeType initialization error"
+					  << std::endl;
+		}
+	}
+
+	uint16_t raster_surface_t::glyph_index(const wchar_t character,
+										   const unsigned int family)
+		const
+	{
+		const mathtext::parsed_font_t &parsed_font =
+			_font_data[family].parsed_font();
+		FT_UInt glyph_index = parsed_font._valid ?
+			parsed_font._cid_map.find(character) : 0;
+
+		if (glyph_index == 0) {
+			mathtext::lock_t lock(_freetype_mutex);
+
+			glyph_index = FT_Get_Char_Index(_font[family], character);
+		}
+
+		return glyph_index;
+	}
+
+	FT_Glyph_Metrics raster_surface_t::
+	freetype_metrics(const wchar_t character,
+					 const unsigned int family) const
+	{
+		const FT_UInt index = glyph_index(character, family);
+		mathtext::lock_t lock(_freetype_mutex);
+
+		FT_Load_Glyph(_font[family], index, FT_LOAD_NO_SCALE);
+
+		return _font[family]->glyph->metrics;
+	}
+
+	// Glyphs are rendered unhinted, so that the raster matches the
+	// layout computed from the unscaled metrics. Glyphs that fail to
+	// render are cached as empty entries.
+	const raster_surface_t::glyph_atlas_t::entry_t *
+	raster_surface_t::atlas_entry(glyph_atlas_t &atlas,
+								  const unsigned int family,
+								  const float size,
+								  const uint16_t glyph) const
+	{
+		const std::map<uint16_t, glyph_atlas_t::entry_t>::const_iterator
+			iterator = atlas._entry.find(glyph);
+
+		if (iterator != atlas._entry.end())
+			return &iterator->second;
+
+		mathtext::lock_t lock(_freetype_mutex);
+		const FT_Face face = _font[family];
+
+		if (FT_Set_Char_Size(face, 0,
+							 static_cast<FT_F26Dot6>(size * 64.0F + 0.5F),
+							 72, 72) != 0 ||
+		   FT_Load_Glyph(face, glyph,
+						 FT_LOAD_RENDER | FT_LOAD_NO_HINTING) != 0 ||
+		   face->glyph->bitmap.pixel_mode != FT_PIXEL_MODE_GRAY)
+			return &atlas.insert(glyph, NULL, 0, 0, 0, 0, 0);
+
+		const FT_Bitmap &bitmap = face->glyph->bitmap;
+
+		return &atlas.insert(glyph, bitmap.buffer, bitmap.width,
+							 bitmap.rows, bitmap.pitch,
+							 face->glyph->bitmap_left,
+							 face->glyph->bitmap_top);
+	}
+
+	// Glyphs are placed at the pixel nearest to their origin, and
+	// their coverage is blended from the atlas row by row
+	void raster_surface_t::
+	draw_glyph(const unsigned int family, const float size,
+			   const std::vector<wchar_t> &character,
+			   const std::vector<point_t> &origin) const
+	{
+		glyph_atlas_t &atlas = _framebuffer->_glyph_atlas[
+			std::pair<std::string, float>(_font_name[family], size)];
+		const int framebuffer_width = _framebuffer->_width;
+		const int framebuffer_height = _framebuffer->_height;
+		uint8_t rgba[4];
+
+		this->color(rgba);
+		for (size_t i = 0; i < character.size(); i++) {
+			const glyph_atlas_t::entry_t *entry =
+				atlas_entry(atlas, family, size,
+							glyph_index(character[i], family));
+
+			if (entry->_width == 0)
+				continue;
+
+			const int x = static_cast<int>(floorf(origin[i][0] + 0.5F)) +
+				entry->_left;
+			const int y = static_cast<int>(floorf(origin[i][1] + 0.5F)) -
+				entry->_top;
+			const int column_begin = std::max(x, 0);
+			const int column_end =
+				std::min(x + entry->_width, framebuffer_width);
+			const int row_begin = std::max(y, 0);
+			const int row_end =
+				std::min(y + entry->_height, framebuffer_height);
+
+			if (column_begin >= column_end)
+				continue;
+			for (int row = row_begin; row < row_end; row++)
+				blend_span(&_framebuffer->_pixel[
+							   4 * (row * framebuffer_width +
+									column_begin)],
+						   atlas.row(entry->_y + row - y) + entry->_x +
+						   (column_begin - x),
+						   column_end - column_begin, rgba);
+		}
+	}
+
+	void raster_surface_t::
+	open_font_overwrite(const std::string &filename,
+						const unsigned int family)
+	{
+		reset_glyph_metrics(family, filename);
+		if (_font[family] != NULL) {
+			FT_Done_Face(_font[family]);
+			_font[family] = NULL;
+		}
+		_font_data[family] =
+			mathtext::font_embed_t::read_font_data(filename);
+		if (_font_data[family].empty())
+			return;
+
+		const FT_Error error =
+			FT_New_Memory_Face(_freetype_library,
+							   _font_data[family].data(),
+							   _font_data[family].size(), 0,
+							   &_font[family]);
+
+		if (error != 0) {
+			_font[family] = NULL;
+			return;
+		}
+
+		// The atlas is shared by fonts with the same name
+		const char *postscript_name =
+			FT_Get_Postscript_Name(_font[family]);
+
+		_font_name[family] = postscript_name != NULL ?
+			postscript_name : filename;
+	}
+
+	void raster_surface_t::
+	open_font_default(const std::string &filename,
+					  const unsigned int family)
+	{
+		if (_font[family] == NULL)
+			open_font_overwrite(filename, family);
+	}
+#endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+
+	raster_surface_t::raster_surface_t(const rect_t &rect,
+									   const bool master)
+		: surface_t(rect, master),
+		  _framebuffer(master ?
+					   new framebuffer_t(
+						   static_cast<unsigned int>(
+							   std::max(0.0F, ceilf(rect.width()))),
+						   static_cast<unsigned int>(
+							   std::max(0.0F, ceilf(rect.height())))) :
+					   NULL),
+		  _current_point_size(0)
+	{
+		_current_alpha = 1;
+#if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		freetype_init();
+		std::fill(_font, _font + NFAMILY,
+				  reinterpret_cast<FT_Face>(NULL));
+#endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+	}
+
+	raster_surface_t::raster_surface_t(const uint16_t width,
+									   const uint16_t height)
+		: surface_t(rect_t(0, 0, width, height), true),
+		  _framebuffer(new framebuffer_t(width, height)),
+		  _current_point_size(0)
+	{
+		_current_alpha = 1;
+#if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		freetype_init();
+		std::fill(_font, _font + NFAMILY,
+				  reinterpret_cast<FT_Face>(NULL));
+#endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+	}
+
+	raster_surface_t::raster_surface_t(raster_surface_t &surface)
+		: surface_t(surface), _framebuffer(surface._framebuffer),
+		  _current_point_size(0)
+	{
+		_current_alpha = 1;
+#if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		freetype_init();
+		std::fill(_font, _font + NFAMILY,
+				  reinterpret_cast<FT_Face>(NULL));
+#endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		surface._subsurface.push_back(this);
+	}
+
+	raster_surface_t::~raster_surface_t(void)
+	{
+#if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		for (unsigned int family = 0; family < NFAMILY; family++)
+			if (_font[family] != NULL) {
+				FT_Done_Face(_font[family]);
+				_font[family] = NULL;
+			}
+#endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		if (_master && _framebuffer != NULL)
+			delete _framebuffer;
+	}
+
+	raster_surface_t &raster_surface_t::surface(const rect_t &rect)
+	{
+		const rect_t scissored_rect = _rect.scissor(rect);
+		raster_surface_t *ret = new raster_surface_t(scissored_rect, false);
+
+		_subsurface.push_back(ret);
+		ret->_supersurface = this;
+		ret->_framebuffer = _framebuffer;
+#if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		ret->_freetype_library = _freetype_library;
+#endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+
+		return *ret;
+	}
+
+	raster_surface_t &raster_surface_t::
+	surface(const short x, const short y,
+			const unsigned short width,
+			const unsigned short height)
+	{
+		return surface(rect_t(x, y, width, height));
+	}
+
+	void raster_surface_t::clear(void)
+	{
+		const rect_t screen = screen_rect();
+		const int column_begin = std::max(0, static_cast<int>(
+			floorf(_rect.left() - screen.left())));
+		const int column_end =
+			std::min(static_cast<int>(_framebuffer->_width),
+					 static_cast<int>(ceilf(_rect.right() -
+											screen.left())));
+		const int row_begin = std::max(0, static_cast<int>(
+			floorf(screen.top() - _rect.top())));
+		const int row_end =
+			std::min(static_cast<int>(_framebuffer->_height),
+					 static_cast<int>(ceilf(screen.top() -
+											_rect.bottom())));
+		uint8_t rgba[4];
+
+		if (column_begin >= column_end)
+			return;
+		color(rgba);
+		for (int row = row_begin; row < row_end; row++)
+			for (int column = column_begin; column < column_end;
+				column++)
+				memcpy(&_framebuffer->_pixel[
+						   4 * (row * _framebuffer->_width + column)],
+					   rgba, 4);
+	}
+
+	bool raster_surface_t::write_png(const std::string &filename) const
+	{
+#ifdef HAVE_ZLIB
+		FILE *fp = fopen(filename.c_str(), "wb");
+
+		if (fp == NULL) {
+			perror("fopen");
+			return false;
+		}
+
+		mathtext::file_sink_t file(fp);
+
+		surface_t::write_png(file, pixel(), width(), height(), 4);
+
+		return fclose(fp) == 0;
+#else // HAVE_ZLIB
+		std::cerr << __FILE__ << ':' << __LINE__
+				  << ": error: PNG output requires zlib"
+				  << std::endl;
+
+		return false;
+#endif // HAVE_ZLIB
+	}
+
+	bool raster_surface_t::write_ppm(const std::string &filename) const
+	{
+		FILE *fp = fopen(filename.c_str(), "wb");
+
+		if (fp == NULL) {
+			perror("fopen");
+			return false;
+		}
+		fprintf(fp, "P6\n%u %u\n255\n", width(), height());
+
+		std::vector<uint8_t> rgb(3 * width());
+
+		for (unsigned int y = 0; y < height(); y++) {
+			const uint8_t *rgba = pixel() + 4 * y * width();
+
+			for (unsigned int x = 0; x < width(); x++) {
+				rgb[3 * x] = rgba[4 * x];
+				rgb[3 * x + 1] = rgba[4 * x + 1];
+				rgb[3 * x + 2] = rgba[4 * x + 2];
+			}
+			fwrite(&rgb[0], 1, rgb.size(), fp);
+		}
+
+		const bool error = ferror(fp) != 0;
+
+		return fclose(fp) == 0 && !error;
+	}
+
+	void raster_surface_t::set_color(const color_t color)
+	{
+		_current_color = color;
+	}
+
+	void raster_surface_t::set_rgb_color(const float red,
+										 const float green,
+										 const float blue)
+	{
+		set_color(color_t(color_t::COLOR_SPACE_RGB,
+						  red, green, blue));
+		_current_alpha = 1;
+	}
+
+	void raster_surface_t::set_rgba_color(const float red,
+										  const float green,
+										  const float blue,
+										  const float alpha)
+	{
+		set_color(color_t(color_t::COLOR_SPACE_RGB,
+						  red, green, blue));
+		_current_alpha = alpha;
+	}
+
+	void raster_surface_t::set_point_size(const float size)
+	{
+		_current_point_size = size;
+	}
+
+	// Points are filled circles, approximated by polygons
+	void raster_surface_t::point(const float x, const float y) const
+	{
+		if (_current_point_size <= 0)
+			return;
+
+		static const unsigned int nvertex = 32;
+		const point_t center = device_point(x, y);
+		const float radius = 0.5F * _current_point_size;
+		std::vector<std::vector<point_t> > path(1);
+
+		for (unsigned int i = 0; i < nvertex; i++) {
+			const float angle = static_cast<float>(2 * M_PI) * i / nvertex;
+
+			path[0].push_back(center + radius *
+							  point_t(cosf(angle), sinf(angle)));
+		}
+		fill_path(path);
+	}
+
+	void raster_surface_t::set_line_width(const float width)
+	{
+		_framebuffer->_line_width = width;
+	}
+
+	void raster_surface_t::line(const float x0, const float y0,
+								const float x1, const float y1) const
+	{
+		std::vector<std::vector<point_t> > path;
+
+		stroke_line(path, device_point(x0, y0), device_point(x1, y1));
+		fill_path(path);
+	}
+
+	void raster_surface_t::rectangle(const float x, const float y,
+									 const float width,
+									 const float height) const
+	{
+		const point_t corner[4] = {
+			device_point(x, y), device_point(x + width, y),
+			device_point(x + width, y + height),
+			device_point(x, y + height)
+		};
+		std::vector<std::vector<point_t> > path;
+
+		for (unsigned int i = 0; i < 4; i++)
+			stroke_line(path, corner[i], corner[(i + 1) % 4], true);
+		fill_path(path);
+	}
+
+	void raster_surface_t::
+	rectangle(const mathtext::bounding_box_t &bounding_box) const
+	{
+		rectangle(bounding_box.left(), bounding_box.bottom(),
+				  bounding_box.right() - bounding_box.left(),
+				  bounding_box.top() - bounding_box.bottom());
+	}
+
+	void raster_surface_t::
+	filled_rectangle(const float x, const float y,
+					 const float width, const float height) const
+	{
+		std::vector<std::vector<point_t> > path(1);
+
+		path[0].push_back(device_point(x, y));
+		path[0].push_back(device_point(x + width, y));
+		path[0].push_back(device_point(x + width, y + height));
+		path[0].push_back(device_point(x, y + height));
+		fill_path(path);
+	}
+
+	void raster_surface_t::
+	filled_rectangle(const mathtext::bounding_box_t &bounding_box)
+		const
+	{
+		filled_rectangle(bounding_box.left(), bounding_box.bottom(),
+						 bounding_box.right() - bounding_box.left(),
+						 bounding_box.top() - bounding_box.bottom());
+	}
+
+	void raster_surface_t::polygon(const polygon_t &p) const
+	{
+		std::vector<std::vector<point_t> > path;
+
+		for (unsigned long i = 0; i < p.size(); i++) {
+			const point_t &next = p[(i + 1) % p.size()];
+
+			stroke_line(path, device_point(p[i][0], p[i][1]),
+						device_point(next[0], next[1]), true);
+		}
+		fill_path(path);
+	}
+
+	void raster_surface_t::filled_polygon(const polygon_t &p) const
+	{
+		std::vector<std::vector<point_t> > path(1);
+
+		for (unsigned long i = 0; i < p.size(); i++)
+			path[0].push_back(device_point(p[i][0], p[i][1]));
+		fill_path(path);
+	}
+
+	// Same placement as opengl_surface_t::raster(), with the first
+	// row of the image data at y. The image is sampled at the center
+	// of each framebuffer pixel, and replaces what was drawn.
+	void raster_surface_t::
+	raster(const float x, const float y, const float width,
+		   const float height, const float density[],
+		   const int nhorizontal, const int nvertical) const
+	{
+		if (nhorizontal <= 0 || nvertical <= 0)
+			return;
+
+		const point_t transformed0 = device_point(x, y);
+		const point_t transformed1 = device_point(x + width, y + height);
+		const float image_width = transformed1[0] - transformed0[0];
+		const float image_height = transformed1[1] - transformed0[1];
+
+		if (image_width == 0 || image_height == 0)
+			return;
+
+		const float x_end = transformed0[0] + image_width;
+		const float y_end = transformed0[1] + image_height;
+		const int column_begin = std::max(0, static_cast<int>(
+			floorf(std::min(transformed0[0], x_end))));
+		const int column_end =
+			std::min(static_cast<int>(_framebuffer->_width),
+					 static_cast<int>(ceilf(std::max(transformed0[0],
+													 x_end))));
+		const int row_begin = std::max(0, static_cast<int>(
+			floorf(std::min(transformed0[1], y_end))));
+		const int row_end =
+			std::min(static_cast<int>(_framebuffer->_height),
+					 static_cast<int>(ceilf(std::max(transformed0[1],
+													 y_end))));
+
+		if (column_begin >= column_end || row_begin >= row_end)
+			return;
+
+		const unsigned long npixel = nhorizontal * nvertical;
+		std::vector<uint8_t> buffer(npixel * 3);
+		std::vector<int> column_index(column_end - column_begin);
+
+		quantize_rgb(&buffer[0], density, npixel);
+		for (int column = column_begin; column < column_end; column++) {
+			const float u =
+				(column + 0.5F - transformed0[0]) / image_width;
+
+			column_index[column - column_begin] = u >= 0 && u < 1 ?
+				std::min(static_cast<int>(u * nhorizontal),
+						 nhorizontal - 1) : -1;
+		}
+		for (int row = row_begin; row < row_end; row++) {
+			const float v = (row + 0.5F - transformed0[1]) / image_height;
+
+			if (!(v >= 0 && v < 1))
+				continue;
+
+			const uint8_t *source = &buffer[3 * nhorizontal * std::min(
+				static_cast<int>(v * nvertical), nvertical - 1)];
+			uint8_t *destination = &_framebuffer->_pixel[
+				4 * (row * _framebuffer->_width + column_begin)];
+
+			for (int column = column_begin; column < column_end;
+				column++, destination += 4) {
+				const int i = column_index[column - column_begin];
+
+				if (i < 0)
+					continue;
+				destination[0] = source[3 * i];
+				destination[1] = source[3 * i + 1];
+				destination[2] = source[3 * i + 2];
+				destination[3] = 255;
+			}
+		}
+	}
+
+#if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+	mathtext::bounding_box_t raster_surface_t::
+	bounding_box(const std::wstring string, const unsigned int family)
+	{
+		return bounding_box(string, family, _current_font_size[family]);
+	}
+
+	mathtext::bounding_box_t raster_surface_t::
+	bounding_box(const std::wstring string, const unsigned int family,
+				 const float size) const
+	{
+		// The y axis points up, as for opengl_surface_t
+		if (string.empty() || _font[family] == NULL ||
+		   _font[family]->units_per_EM == 0)
+			return mathtext::bounding_box_t(0, 0, 0, 0, 0, 0);
+
+		std::wstring::const_iterator iterator = string.begin();
+
+		const float scale = size / _font[family]->units_per_EM;
+		FT_Glyph_Metrics metrics;
+		mathtext::bounding_box_t ret;
+
+		metrics = freetype_metrics(*iterator, family);
+		ret = mathtext::bounding_box_t(
+			metrics.horiBearingX * scale,
+			(metrics.horiBearingY - metrics.height) * scale,
+			(metrics.horiBearingX + metrics.width) * scale,
+			metrics.horiBearingY * scale,
+			metrics.horiAdvance * scale, 0);
+		iterator++;
+
+		float current_x = metrics.horiAdvance;
+
+		for (; iterator != string.end(); iterator++) {
+			metrics = freetype_metrics(*iterator, family);
+			const mathtext::bounding_box_t glyph_bounding_box =
+				mathtext::point_t(0, current_x) +
+				mathtext::bounding_box_t(
+					metrics.horiBearingX * scale,
+					(metrics.horiBearingY - metrics.height) * scale,
+					(metrics.horiBearingX + metrics.width) * scale,
+					metrics.horiBearingY * scale,
+					metrics.horiAdvance * scale, 0);
+			ret = ret.merge(glyph_bounding_box);
+			current_x += metrics.horiAdvance;
+		}
+
+		return ret;
+	}
+
+	// The glyphs are placed at their natural advances
+	void raster_surface_t::
+	text_raw(const float x, const float y, const std::wstring string,
+			 const unsigned int family)
+	{
+		if (family >= NFAMILY || _font[family] == NULL) {
+			std::cerr << __FILE__ << ':' << __LINE__
+					  << ": error: font not initialized"
+					  << std::endl;
+			return;
+		}
+
+		const float size = _current_font_size[family];
+
+		if (size <= 0 || string.empty() ||
+		   _font[family]->units_per_EM == 0)
+			return;
+
+		const float scale = size / _font[family]->units_per_EM;
+		const point_t transformed = device_point(x, y);
+		std::vector<wchar_t> character(string.begin(), string.end());
+		std::vector<point_t> origin;
+		float current_x = transformed[0];
+
+		origin.reserve(string.size());
+		for (std::wstring::const_iterator iterator = string.begin();
+			iterator != string.end(); iterator++) {
+			origin.push_back(point_t(current_x, transformed[1]));
+			current_x +=
+				freetype_metrics(*iterator, family).horiAdvance * scale;
+		}
+		draw_glyph(family, size, character, origin);
+	}
+
+	void raster_surface_t::
+	glyph_run(const math_glyph_iterator_t &glyph_begin,
+			  const math_glyph_iterator_t &glyph_end)
+	{
+		const unsigned int family = glyph_begin->_family;
+		const float size = glyph_begin->_size;
+
+		if (family >= NFAMILY || _font[family] == NULL) {
+			std::cerr << __FILE__ << ':' << __LINE__
+					  << ": error: font not initialized"
+					  << std::endl;
+			return;
+		}
+		if (size <= 0)
+			return;
+
+		std::vector<wchar_t> character;
+		std::vector<point_t> origin;
+
+		character.reserve(glyph_end - glyph_begin);
+		origin.reserve(glyph_end - glyph_begin);
+		for (math_glyph_iterator_t iterator = glyph_begin;
+			iterator != glyph_end; iterator++) {
+			character.push_back(iterator->_glyph);
+			origin.push_back(device_point(iterator->_origin[0],
+										  iterator->_origin[1]));
+		}
+		draw_glyph(family, size, character, origin);
+	}
+#else // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+	void raster_surface_t::
+	open_font_overwrite(const std::string &filename,
+						const unsigned int family)
+	{
+		std::cerr << __FILE__ << ':' << __LINE__
+				  << ": error: cannot open `" << filename
+				  << "', glyph rasterization requires FreeType"
+				  << std::endl;
+	}
+
+	void raster_surface_t::
+	open_font_default(const std::string &filename,
+					  const unsigned int family)
+	{
+		open_font_overwrite(filename, family);
+	}
+#endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+
+}
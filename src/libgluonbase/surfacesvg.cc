@@ -0,0 +1,672 @@
+// mathtext - A TeX/LaTeX compatible rendering library. Copyright (C)
+// 2008-2016 Yue Shi Lai <ylai@users.sourceforge.net>
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2.1 of
+// the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// 02110-1301 USA
+
+#include <cmath>
+#include <cstdarg>
+#include <iostream>
+#include <algorithm>
+#include <gluon/screen.h>
+#include <mathtext/fontembed.h>
+
+// References:
+//
+// World Wide Web Consortium, Scalable Vector Graphics (SVG) 1.1
+// specification (W3C, 2011), 2nd edition, sections 5.6, 7.4, 9 and
+// 11.
+//
+// L. Masinter, The "data" URL scheme (IETF, 1998), RFC 2397.
+
+/////////////////////////////////////////////////////////////////////
+
+namespace gluon {
+
+	namespace {
+
+		unsigned int color_component(const float value)
+		{
+			return value <= 0 ? 0 : value >= 1 ? 255 :
+				static_cast<unsigned int>(value * 255.0F + 0.5F);
+		}
+
+	}
+
+	void svg_surface_t::open_output_file(const std::string &filename)
+	{
+		_document->_fp = fopen(filename.c_str(), "wb");
+		if (_document->_fp == NULL)
+			perror("fopen");
+	}
+
+	// The coordinates are the pixel coordinates of the other
+	// surfaces, with the y axis pointing down as in SVG
+	void svg_surface_t::write_header(void)
+	{
+		if (_document->_fp == NULL)
+			return;
+		fprintf(_document->_fp,
+				"<?xml version=\"1.0\" encoding=\"UTF-8\" "
+				"standalone=\"no\"?>\n"
+				"<svg xmlns=\"http://www.w3.org/2000/svg\" "
+				"xmlns:xlink=\"http://www.w3.org/1999/xlink\" "
+				"version=\"1.1\" width=\"%.6g\" height=\"%.6g\" "
+				"viewBox=\"%.6g 0 %.6g %.6g\">\n",
+				_rect.width(), _rect.height(), _rect.left(),
+				_rect.width(), _rect.height());
+	}
+
+	void svg_surface_t::write_trailer(void)
+	{
+		if (_document->_fp == NULL)
+			return;
+		fputs("</svg>\n", _document->_fp);
+	}
+
+	void svg_surface_t::close_output_file(void)
+	{
+		if (_document->_fp != NULL) {
+			fclose(_document->_fp);
+			_document->_fp = NULL;
+		}
+	}
+
+	void svg_surface_t::append_element(const char *format, ...) const
+	{
+		if (_document->_fp == NULL)
+			return;
+
+		va_list ap;
+
+		va_start(ap, format);
+		vfprintf(_document->_fp, format, ap);
+		va_end(ap);
+	}
+
+	std::string svg_surface_t::fill(void) const
+	{
+		char buffer[64];
+		int length = snprintf(buffer, sizeof(buffer),
+							  " fill=\"#%02x%02x%02x\"",
+							  color_component(_current_color.red()),
+							  color_component(_current_color.green()),
+							  color_component(_current_color.blue()));
+
+		if (_current_alpha < 1)
+			snprintf(buffer + length, sizeof(buffer) - length,
+					 " fill-opacity=\"%.3g\"",
+					 std::max(0.0F, _current_alpha));
+
+		return buffer;
+	}
+
+	std::string svg_surface_t::stroke(void) const
+	{
+		char buffer[128];
+		int length = snprintf(buffer, sizeof(buffer),
+							  " fill=\"none\" stroke=\"#%02x%02x%02x\" "
+							  "stroke-width=\"%.6g\"",
+							  color_component(_current_color.red()),
+							  color_component(_current_color.green()),
+							  color_component(_current_color.blue()),
+							  _document->_line_width);
+
+		if (_current_alpha < 1)
+			snprintf(buffer + length, sizeof(buffer) - length,
+					 " stroke-opacity=\"%.3g\"",
+					 std::max(0.0F, _current_alpha));
+
+		return buffer;
+	}
+
+	point_t svg_surface_t::pixel(const float x, const float y) const
+	{
+		return _transform_logical_to_pixel * point_t(x, y);
+	}
+
+#if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+	void svg_surface_t::freetype_init(void)
+	{
+		const FT_Error error = FT_Init_FreeType(&_freetype_library);
+
+		if (error != 0) {
+			std::cerr << __FILE__ << ':' << __LINE__
+					  << ": error: FreeType initialization error"
+					  << std::endl;
+		}
+	}
+
+	// The glyph index is looked up in the parsed cmap, which is
+	// shared with the outline decoding, and FreeType is consulted
+	// only for fonts or characters the parser does not map
+	uint16_t svg_surface_t::glyph_index(const wchar_t character,
+										const unsigned int family) const
+	{
+		const mathtext::parsed_font_t &parsed_font =
+			_font_data[family].parsed_font();
+		FT_UInt glyph_index = parsed_font._valid ?
+			parsed_font._cid_map.find(character) : 0;
+
+		if (glyph_index == 0) {
+			mathtext::lock_t lock(_freetype_mutex);
+
+			glyph_index = FT_Get_Char_Index(_font[family], character);
+		}
+
+		return glyph_index;
+	}
+
+	FT_Glyph_Metrics svg_surface_t::
+	freetype_metrics(const wchar_t character,
+					 const unsigned int family) const
+	{
+		const FT_UInt index = glyph_index(character, family);
+		mathtext::lock_t lock(_freetype_mutex);
+
+		FT_Load_Glyph(_font[family], index, FT_LOAD_NO_SCALE);
+
+		return _font[family]->glyph->metrics;
+	}
+
+	// Fonts are registered once per document, keyed by their
+	// PostScript name, with a short name that prefixes the XML ids
+	// of their glyphs
+	void svg_surface_t::embed_font(const unsigned int family)
+	{
+		const char *postscript_name =
+			FT_Get_Postscript_Name(_font[family]);
+
+		if (postscript_name == NULL) {
+			std::cerr << __FILE__ << ':' << __LINE__
+					  << ": error: font without a PostScript name"
+					  << std::endl;
+			return;
+		}
+		_font_name[family] = postscript_name;
+		if (_document == NULL ||
+		   _document->_font.find(_font_name[family]) !=
+		   _document->_font.end())
+			return;
+
+		document_t::font_t &font = _document->_font[_font_name[family]];
+		char resource_name[16];
+
+		snprintf(resource_name, sizeof(resource_name), "F%lu",
+				 static_cast<unsigned long>(_document->_font.size()));
+		font._resource_name = resource_name;
+		font._outline = mathtext::font_outline_t(_font_data[family]);
+		if (!font._outline.valid())
+			std::cerr << __FILE__ << ':' << __LINE__
+					  << ": error: cannot decode the outlines of `"
+					  << _font_name[family] << '\'' << std::endl;
+		font._defined.resize(font._outline.nglyph(), false);
+		font._empty.resize(font._outline.nglyph(), false);
+	}
+
+	// Glyphs drawn for the first time are defined just before they
+	// are used, which keeps the document streamable. Each run is a
+	// group scaled from glyph space units to the font size, with the
+	// y axis flipped, in which the glyph origins are the only
+	// per-glyph data.
+	void svg_surface_t::
+	draw_glyph(const unsigned int family, const float size,
+			   const std::vector<wchar_t> &character,
+			   const std::vector<point_t> &origin) const
+	{
+		const std::map<std::string, document_t::font_t>::iterator
+			iterator = _document->_font.find(_font_name[family]);
+
+		if (iterator == _document->_font.end() || character.empty())
+			return;
+
+		document_t::font_t &font = iterator->second;
+		std::vector<uint16_t> glyph;
+		std::string defs;
+		mathtext::glyph_outline_t outline;
+
+		glyph.reserve(character.size());
+		for (std::vector<wchar_t>::const_iterator character_iterator =
+				 character.begin();
+			character_iterator != character.end();
+			character_iterator++) {
+			const uint16_t index =
+				glyph_index(*character_iterator, family);
+
+			glyph.push_back(index);
+			if (index >= font._defined.size() || font._defined[index])
+				continue;
+			if (font._outline.glyph_outline(outline, index) &&
+			   !outline.empty())
+				mathtext::font_embed_svg_t::
+					append_glyph(defs, font._resource_name, index,
+								 outline);
+			else
+				font._empty[index] = true;
+			font._defined[index] = true;
+		}
+		if (!defs.empty())
+			append_element("<defs>\n%s</defs>\n", defs.c_str());
+
+		const float scale = size / 1000.0F;
+
+		append_element("<g%s transform=\"matrix(%.6g 0 0 %.6g 0 0)\">\n",
+					   fill().c_str(), scale, -scale);
+		for (size_t i = 0; i < glyph.size(); i++) {
+			if (glyph[i] >= font._defined.size() || font._empty[glyph[i]])
+				continue;
+			append_element("<use xlink:href=\"#%s\" x=\"%.6g\" "
+						   "y=\"%.6g\"/>\n",
+						   mathtext::font_embed_svg_t::glyph_id(
+								font._resource_name, glyph[i]).c_str(),
+						   origin[i][0] / scale, -origin[i][1] / scale);
+		}
+		append_element("</g>\n");
+	}
+
+	void svg_surface_t::
+	open_font_overwrite(const std::string &filename,
+						const unsigned int family)
+	{
+		reset_glyph_metrics(family, filename);
+		if (_font[family] != NULL) {
+			FT_Done_Face(_font[family]);
+			_font[family] = NULL;
+		}
+		_font_data[family] =
+			mathtext::font_embed_t::read_font_data(filename);
+		if (_font_data[family].empty())
+			return;
+
+		const FT_Error error =
+			FT_New_Memory_Face(_freetype_library,
+							   _font_data[family].data(),
+							   _font_data[family].size(), 0,
+							   &_font[family]);
+
+		if (error != 0) {
+			_font[family] = NULL;
+			return;
+		}
+		embed_font(family);
+	}
+
+	void svg_surface_t::
+	open_font_default(const std::string &filename,
+					  const unsigned int family)
+	{
+		if (_font[family] == NULL)
+			open_font_overwrite(filename, family);
+	}
+#endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+
+	svg_surface_t::svg_surface_t(const rect_t &rect, const bool master)
+		: surface_t(rect, master),
+		  _document(master ? new document_t : NULL),
+		  _current_point_size(0)
+	{
+		_current_alpha = 1;
+#if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		freetype_init();
+		std::fill(_font, _font + NFAMILY,
+				  reinterpret_cast<FT_Face>(NULL));
+#endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+	}
+
+	svg_surface_t::
+	svg_surface_t(const std::string &filename,
+				  const uint16_t width, const uint16_t height)
+		: surface_t(rect_t(0, 0, width, height), true),
+		  _document(new document_t), _current_point_size(0)
+	{
+		_current_alpha = 1;
+#if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		freetype_init();
+		std::fill(_font, _font + NFAMILY,
+				  reinterpret_cast<FT_Face>(NULL));
+#endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		open_output_file(filename);
+		write_header();
+	}
+
+	svg_surface_t::svg_surface_t(svg_surface_t &surface)
+		: surface_t(surface), _document(surface._document),
+		  _current_point_size(0)
+	{
+		_current_alpha = 1;
+#if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		freetype_init();
+		std::fill(_font, _font + NFAMILY,
+				  reinterpret_cast<FT_Face>(NULL));
+#endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		surface._subsurface.push_back(this);
+	}
+
+	svg_surface_t::~svg_surface_t(void)
+	{
+#if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		for (unsigned int family = 0; family < NFAMILY; family++)
+			if (_font[family] != NULL) {
+				FT_Done_Face(_font[family]);
+				_font[family] = NULL;
+			}
+#endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		if (_master && _document != NULL) {
+			write_trailer();
+			close_output_file();
+			delete _document;
+		}
+	}
+
+	svg_surface_t &svg_surface_t::surface(const rect_t &rect)
+	{
+		const rect_t scissored_rect = _rect.scissor(rect);
+		svg_surface_t *ret = new svg_surface_t(scissored_rect, false);
+
+		_subsurface.push_back(ret);
+		ret->_supersurface = this;
+		ret->_document = _document;
+#if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+		ret->_freetype_library = _freetype_library;
+#endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+
+		return *ret;
+	}
+
+	svg_surface_t &svg_surface_t::
+	surface(const short x, const short y,
+			const unsigned short width,
+			const unsigned short height)
+	{
+		return surface(rect_t(x, y, width, height));
+	}
+
+	void svg_surface_t::set_color(const color_t color)
+	{
+		_current_color = color;
+	}
+
+	void svg_surface_t::set_rgb_color(const float red,
+									  const float green,
+									  const float blue)
+	{
+		set_color(color_t(color_t::COLOR_SPACE_RGB,
+						  red, green, blue));
+		_current_alpha = 1;
+	}
+
+	void svg_surface_t::set_rgba_color(const float red,
+									   const float green,
+									   const float blue,
+									   const float alpha)
+	{
+		set_color(color_t(color_t::COLOR_SPACE_RGB,
+						  red, green, blue));
+		_current_alpha = alpha;
+	}
+
+	void svg_surface_t::set_point_size(const float size)
+	{
+		_current_point_size = size;
+	}
+
+	void svg_surface_t::point(const float x, const float y) const
+	{
+		if (_current_point_size != 0) {
+			const point_t transformed = pixel(x, y);
+
+			append_element("<circle cx=\"%.6g\" cy=\"%.6g\" "
+						   "r=\"%.6g\"%s/>\n", transformed[0],
+						   transformed[1], 0.5F * _current_point_size,
+						   fill().c_str());
+		}
+	}
+
+	void svg_surface_t::set_line_width(const float width)
+	{
+		_document->_line_width = width;
+	}
+
+	void svg_surface_t::line(const float x0, const float y0,
+							 const float x1, const float y1) const
+	{
+		const point_t transformed0 = pixel(x0, y0);
+		const point_t transformed1 = pixel(x1, y1);
+
+		append_element("<line x1=\"%.6g\" y1=\"%.6g\" x2=\"%.6g\" "
+					   "y2=\"%.6g\"%s/>\n", transformed0[0],
+					   transformed0[1], transformed1[0],
+					   transformed1[1], stroke().c_str());
+	}
+
+	void svg_surface_t::rectangle(const float x, const float y,
+								  const float width,
+								  const float height) const
+	{
+		const point_t transformed0 = pixel(x, y);
+		const point_t transformed1 = pixel(x + width, y + height);
+
+		append_element("<rect x=\"%.6g\" y=\"%.6g\" width=\"%.6g\" "
+					   "height=\"%.6g\"%s/>\n",
+					   std::min(transformed0[0], transformed1[0]),
+					   std::min(transformed0[1], transformed1[1]),
+					   fabs(transformed1[0] - transformed0[0]),
+					   fabs(transformed1[1] - transformed0[1]),
+					   stroke().c_str());
+	}
+
+	void svg_surface_t::
+	rectangle(const mathtext::bounding_box_t &bounding_box) const
+	{
+		rectangle(bounding_box.left(), bounding_box.bottom(),
+				  bounding_box.right() - bounding_box.left(),
+				  bounding_box.top() - bounding_box.bottom());
+	}
+
+	void svg_surface_t::
+	filled_rectangle(const float x, const float y,
+					 const float width, const float height) const
+	{
+		const point_t transformed0 = pixel(x, y);
+		const point_t transformed1 = pixel(x + width, y + height);
+
+		append_element("<rect x=\"%.6g\" y=\"%.6g\" width=\"%.6g\" "
+					   "height=\"%.6g\"%s/>\n",
+					   std::min(transformed0[0], transformed1[0]),
+					   std::min(transformed0[1], transformed1[1]),
+					   fabs(transformed1[0] - transformed0[0]),
+					   fabs(transformed1[1] - transformed0[1]),
+					   fill().c_str());
+	}
+
+	void svg_surface_t::
+	filled_rectangle(const mathtext::bounding_box_t &bounding_box)
+		const
+	{
+		filled_rectangle(bounding_box.left(), bounding_box.bottom(),
+						 bounding_box.right() - bounding_box.left(),
+						 bounding_box.top() - bounding_box.bottom());
+	}
+
+	void svg_surface_t::filled_polygon(const polygon_t &p) const
+	{
+		if (p.empty())
+			return;
+		append_element("<polygon points=\"");
+		for (unsigned long i = 0; i < p.size(); i++) {
+			const point_t transformed = pixel(p[i][0], p[i][1]);
+
+			append_element(i == 0 ? "%.6g,%.6g" : " %.6g,%.6g",
+						   transformed[0], transformed[1]);
+		}
+		append_element("\"%s/>\n", fill().c_str());
+	}
+
+	// Same placement as postscript_surface_t::raster(), with the
+	// first row of the image data at y. The image is a PNG data URI
+	// streamed through the compressor and the Base64 encoder.
+	void svg_surface_t::
+	raster(const float x, const float y, const float width,
+		   const float height, const float density[],
+		   const int nhorizontal, const int nvertical) const
+	{
+#ifdef HAVE_ZLIB
+		if (_document->_fp == NULL || nhorizontal <= 0 || nvertical <= 0)
+			return;
+
+		const point_t transformed0 = pixel(x, y);
+		const point_t transformed1 = pixel(x + width, y + height);
+
+		append_element("<image width=\"1\" height=\"1\" "
+					   "preserveAspectRatio=\"none\" "
+					   "transform=\"matrix(%.6g 0 0 %.6g %.6g %.6g)\" "
+					   "xlink:href=\"data:image/png;base64,",
+					   transformed1[0] - transformed0[0],
+					   transformed0[1] - transformed1[1],
+					   transformed0[0], transformed0[1]);
+
+		const unsigned long npixel = nhorizontal * nvertical;
+		std::vector<uint8_t> buffer(npixel * 3);
+
+		quantize_rgb(&buffer[0], density, npixel);
+
+		mathtext::file_sink_t file(_document->_fp);
+		mathtext::base64_sink_t base64(file);
+
+		write_png(base64, &buffer[0], nhorizontal, nvertical, 3);
+		base64.finish();
+		append_element("\"/>\n");
+#else // HAVE_ZLIB
+		std::cerr << __FILE__ << ':' << __LINE__
+				  << ": error: raster images require zlib"
+				  << std::endl;
+#endif // HAVE_ZLIB
+	}
+
+#if defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+	mathtext::bounding_box_t svg_surface_t::
+	bounding_box(const std::wstring string, const unsigned int family)
+	{
+		return bounding_box(string, family, _current_font_size[family]);
+	}
+
+	mathtext::bounding_box_t svg_surface_t::
+	bounding_box(const std::wstring string, const unsigned int family,
+				 const float size) const
+	{
+		if (string.empty() || _font[family] == NULL ||
+		   _font[family]->units_per_EM == 0)
+			return mathtext::bounding_box_t(0, 0, 0, 0, 0, 0);
+
+		std::wstring::const_iterator iterator = string.begin();
+
+		const float scale = size / _font[family]->units_per_EM;
+		FT_Glyph_Metrics metrics;
+		mathtext::bounding_box_t ret;
+
+		metrics = freetype_metrics(*iterator, family);
+		ret = mathtext::bounding_box_t(
+			metrics.horiBearingX * scale,
+			(-metrics.horiBearingY) * scale,
+			(metrics.horiBearingX + metrics.width) * scale,
+			(-metrics.horiBearingY + metrics.height) * scale,
+			metrics.horiAdvance * scale, 0);
+		iterator++;
+
+		float current_x = metrics.horiAdvance;
+
+		for (; iterator != string.end(); iterator++) {
+			metrics = freetype_metrics(*iterator, family);
+			const mathtext::bounding_box_t glyph_bounding_box =
+				mathtext::point_t(0, current_x) +
+				mathtext::bounding_box_t(
+					metrics.horiBearingX * scale,
+					(-metrics.horiBearingY) * scale,
+					(metrics.horiBearingX + metrics.width) * scale,
+					(-metrics.horiBearingY + metrics.height) * scale,
+					metrics.horiAdvance * scale, 0);
+			ret = ret.merge(glyph_bounding_box);
+			current_x += metrics.horiAdvance;
+		}
+
+		return ret;
+	}
+
+	// The glyphs are placed at their natural advances
+	void svg_surface_t::
+	text_raw(const float x, const float y, const std::wstring string,
+			 const unsigned int family)
+	{
+		if (family >= NFAMILY || _font[family] == NULL) {
+			std::cerr << __FILE__ << ':' << __LINE__
+					  << ": error: font not initialized"
+					  << std::endl;
+			return;
+		}
+
+		const float size = _current_font_size[family];
+
+		if (size <= 0 || string.empty() ||
+		   _font[family]->units_per_EM == 0)
+			return;
+
+		const float scale = size / _font[family]->units_per_EM;
+		const point_t transformed = pixel(x, y);
+		std::vector<wchar_t> character(string.begin(), string.end());
+		std::vector<point_t> origin;
+		float current_x = transformed[0];
+
+		origin.reserve(string.size());
+		for (std::wstring::const_iterator iterator = string.begin();
+			iterator != string.end(); iterator++) {
+			origin.push_back(point_t(current_x, transformed[1]));
+			current_x +=
+				freetype_metrics(*iterator, family).horiAdvance * scale;
+		}
+		draw_glyph(family, size, character, origin);
+	}
+
+	void svg_surface_t::
+	glyph_run(const math_glyph_iterator_t &glyph_begin,
+			  const math_glyph_iterator_t &glyph_end)
+	{
+		const unsigned int family = glyph_begin->_family;
+		const float size = glyph_begin->_size;
+
+		if (family >= NFAMILY || _font[family] == NULL) {
+			std::cerr << __FILE__ << ':' << __LINE__
+					  << ": error: font not initialized"
+					  << std::endl;
+			return;
+		}
+		if (size <= 0)
+			return;
+
+		std::vector<wchar_t> character;
+		std::vector<point_t> origin;
+
+		character.reserve(glyph_end - glyph_begin);
+		origin.reserve(glyph_end - glyph_begin);
+		for (math_glyph_iterator_t iterator = glyph_begin;
+			iterator != glyph_end; iterator++) {
+			character.push_back(iterator->_glyph);
+			origin.push_back(pixel(iterator->_origin[0],
+								   iterator->_origin[1]));
+		}
+		draw_glyph(family, size, character, origin);
+	}
+#endif // defined(HAVE_FREETYPE2) || defined(HAVE_FTGL)
+
+}
@@ -0,0 +1,357 @@
+// mathtext - A TeX/LaTeX compatible rendering library. Copyright (C)
+// 2008-2016 Yue Shi Lai <ylai@users.sourceforge.net>
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2.1 of
+// the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// 02110-1301 USA
+
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <mathtext/fontblob.h>
+#include <mathtext/fontembed.h>
+
+/////////////////////////////////////////////////////////////////////
+
+namespace mathtext {
+
+	font_blob_t::registry_t &font_blob_t::registry(void)
+	{
+		static registry_t registry;
+
+		return registry;
+	}
+
+	font_blob_t::parsed_font_registry_t &
+	font_blob_t::parsed_font_registry(void)
+	{
+		static parsed_font_registry_t registry;
+
+		return registry;
+	}
+
+	mutex_t &font_blob_t::registry_mutex(void)
+	{
+		static mutex_t mutex;
+
+		return mutex;
+	}
+
+	// The registry mutex has to be held by the caller
+	void font_blob_t::attach(mapping_t *mapping)
+	{
+		_mapping = mapping;
+		_mapping->_reference_count++;
+		if (_mapping->_address != NULL) {
+			_data = reinterpret_cast<const uint8_t *>(
+				_mapping->_address);
+			_size = _mapping->_file_size;
+		}
+		else {
+			_data = &_mapping->_copy[0];
+			_size = _mapping->_copy.size();
+		}
+	}
+
+	// The registry mutex has to be held by the caller
+	void font_blob_t::detach(void)
+	{
+		if (_mapping != NULL && --_mapping->_reference_count == 0) {
+			const registry_t::iterator iterator =
+				registry().find(std::pair<dev_t, ino_t>(
+					_mapping->_device, _mapping->_inode));
+
+			// A mapping of a file that has since been modified is
+			// no longer registered
+			if (iterator != registry().end() &&
+			   iterator->second == _mapping)
+				registry().erase(iterator);
+
+			parsed_font_entry_t *entry = _mapping->_parsed_font_entry;
+
+			if (entry != NULL && --entry->_reference_count == 0) {
+				parsed_font_registry().erase(entry->_content_hash);
+				delete entry->_parsed_font;
+				delete entry->_font_metrics;
+				delete entry;
+			}
+			if (_mapping->_address != NULL)
+				munmap(_mapping->_address, _mapping->_file_size);
+			delete _mapping;
+		}
+		_mapping = NULL;
+		_data = NULL;
+		_size = 0;
+	}
+
+	font_blob_t::font_blob_t(void)
+		: _mapping(NULL), _data(NULL), _size(0), _parsed_font(NULL),
+		  _font_metrics(NULL)
+	{
+	}
+
+	font_blob_t::font_blob_t(const std::vector<uint8_t> &data)
+		: _mapping(NULL), _data(data.empty() ? NULL : &data[0]),
+		  _size(data.size()), _parsed_font(NULL), _font_metrics(NULL)
+	{
+	}
+
+	font_blob_t::font_blob_t(const font_blob_t &blob)
+		: _mapping(NULL), _data(blob._data), _size(blob._size),
+		  _parsed_font(NULL), _font_metrics(NULL)
+	{
+		if (blob._mapping != NULL) {
+			lock_t lock(registry_mutex());
+
+			attach(blob._mapping);
+		}
+	}
+
+	font_blob_t::~font_blob_t(void)
+	{
+		delete _parsed_font;
+		delete _font_metrics;
+		if (_mapping != NULL) {
+			lock_t lock(registry_mutex());
+
+			detach();
+		}
+	}
+
+	font_blob_t &font_blob_t::operator=(const font_blob_t &blob)
+	{
+		if (this == &blob)
+			return *this;
+		delete _parsed_font;
+		_parsed_font = NULL;
+		delete _font_metrics;
+		_font_metrics = NULL;
+		if (_mapping != NULL || blob._mapping != NULL) {
+			lock_t lock(registry_mutex());
+			mapping_t *mapping = blob._mapping;
+
+			// Keep the new mapping alive, in case it is the one
+			// being detached
+			if (mapping != NULL)
+				mapping->_reference_count++;
+			detach();
+			if (mapping != NULL) {
+				attach(mapping);
+				mapping->_reference_count--;
+			}
+		}
+		_data = blob._data;
+		_size = blob._size;
+
+		return *this;
+	}
+
+	font_blob_t font_blob_t::open(const std::string &filename)
+	{
+		font_blob_t blob;
+		const int fd = ::open(filename.c_str(), O_RDONLY);
+
+		if (fd == -1) {
+			perror("open");
+			return blob;
+		}
+
+		struct stat file_status;
+
+		if (fstat(fd, &file_status) == -1) {
+			perror("fstat");
+			close(fd);
+			return blob;
+		}
+		if (file_status.st_size <= 0) {
+			close(fd);
+			return blob;
+		}
+
+		const std::pair<dev_t, ino_t>
+			key(file_status.st_dev, file_status.st_ino);
+		lock_t lock(registry_mutex());
+		const registry_t::const_iterator iterator =
+			registry().find(key);
+
+		if (iterator != registry().end() &&
+		   iterator->second->_file_size == file_status.st_size &&
+		   iterator->second->_modification_time ==
+		   file_status.st_mtime) {
+			close(fd);
+			blob.attach(iterator->second);
+
+			return blob;
+		}
+
+		mapping_t *mapping = new mapping_t;
+
+		mapping->_device = file_status.st_dev;
+		mapping->_inode = file_status.st_ino;
+		mapping->_file_size = file_status.st_size;
+		mapping->_modification_time = file_status.st_mtime;
+		mapping->_reference_count = 0;
+		mapping->_parsed_font_entry = NULL;
+		mapping->_address = mmap(NULL, file_status.st_size, PROT_READ,
+								 MAP_SHARED, fd, 0);
+		if (mapping->_address == MAP_FAILED) {
+			mapping->_address = NULL;
+			mapping->_copy.resize(file_status.st_size);
+
+			size_t offset = 0;
+
+			while (offset < mapping->_copy.size()) {
+				const ssize_t length =
+					read(fd, &mapping->_copy[offset],
+						 mapping->_copy.size() - offset);
+
+				if (length <= 0) {
+					perror("read");
+					close(fd);
+					delete mapping;
+					return blob;
+				}
+				offset += length;
+			}
+		}
+		close(fd);
+		registry()[key] = mapping;
+		blob.attach(mapping);
+
+		return blob;
+	}
+
+	// 64 bit FNV-1a
+	uint64_t font_blob_t::content_hash(const uint8_t *data,
+									   const size_t size)
+	{
+		uint64_t hash = 0xcbf29ce484222325ULL;
+
+		for (size_t i = 0; i < size; i++) {
+			hash ^= data[i];
+			hash *= 0x100000001b3ULL;
+		}
+
+		return hash;
+	}
+
+	const parsed_font_t &font_blob_t::parsed_font(void) const
+	{
+		if (_mapping == NULL) {
+			if (_parsed_font == NULL) {
+				_parsed_font = new parsed_font_t;
+				font_embed_t::parse_font(*_parsed_font, *this);
+			}
+
+			return *_parsed_font;
+		}
+		{
+			lock_t lock(registry_mutex());
+
+			if (_mapping->_parsed_font_entry != NULL)
+				return *_mapping->_parsed_font_entry->_parsed_font;
+		}
+
+		// Hashing and parsing are done without holding the lock, and
+		// a font parsed concurrently by another thread is discarded
+		const uint64_t hash = content_hash(_data, _size);
+
+		{
+			lock_t lock(registry_mutex());
+
+			if (_mapping->_parsed_font_entry == NULL) {
+				const parsed_font_registry_t::const_iterator
+					iterator = parsed_font_registry().find(hash);
+
+				if (iterator != parsed_font_registry().end()) {
+					iterator->second->_reference_count++;
+					_mapping->_parsed_font_entry = iterator->second;
+				}
+			}
+			if (_mapping->_parsed_font_entry != NULL)
+				return *_mapping->_parsed_font_entry->_parsed_font;
+		}
+
+		parsed_font_t *parsed_font = new parsed_font_t;
+
+		font_embed_t::parse_font(*parsed_font, *this);
+
+		lock_t lock(registry_mutex());
+
+		if (_mapping->_parsed_font_entry == NULL) {
+			const parsed_font_registry_t::const_iterator iterator =
+				parsed_font_registry().find(hash);
+			parsed_font_entry_t *entry;
+
+			if (iterator != parsed_font_registry().end())
+				entry = iterator->second;
+			else {
+				entry = new parsed_font_entry_t;
+				entry->_content_hash = hash;
+				entry->_parsed_font = parsed_font;
+				entry->_font_metrics = NULL;
+				entry->_reference_count = 0;
+				parsed_font_registry()[hash] = entry;
+				parsed_font = NULL;
+			}
+			entry->_reference_count++;
+			_mapping->_parsed_font_entry = entry;
+		}
+		delete parsed_font;
+
+		return *_mapping->_parsed_font_entry->_parsed_font;
+	}
+
+	// The metrics of a mapping belong to its parsed font entry, which
+	// parsed_font() creates. They are likewise computed without
+	// holding the lock, and discarded if another thread was faster.
+	const font_metrics_t &font_blob_t::font_metrics(void) const
+	{
+		parsed_font();
+		if (_mapping == NULL) {
+			if (_font_metrics == NULL)
+				_font_metrics = new font_metrics_t(*this);
+
+			return *_font_metrics;
+		}
+		{
+			lock_t lock(registry_mutex());
+
+			if (_mapping->_parsed_font_entry->_font_metrics != NULL)
+				return *_mapping->_parsed_font_entry->_font_metrics;
+		}
+
+		font_metrics_t *font_metrics = new font_metrics_t(*this);
+		lock_t lock(registry_mutex());
+		parsed_font_entry_t *entry = _mapping->_parsed_font_entry;
+
+		if (entry->_font_metrics == NULL) {
+			entry->_font_metrics = font_metrics;
+			font_metrics = NULL;
+		}
+		delete font_metrics;
+
+		return *entry->_font_metrics;
+	}
+
+	size_t font_blob_t::nmapping(void)
+	{
+		lock_t lock(registry_mutex());
+
+		return registry().size();
+	}
+
+}
@@ -46,8 +46,8 @@ namespace mathtext {
 
 	void font_embed_t::protected_memcpy(
 		void *destination,
-		std::vector<uint8_t>::const_iterator source,
-		std::vector<uint8_t>::const_iterator source_end,
+		font_blob_t::const_iterator source,
+		font_blob_t::const_iterator source_end,
 		size_t length, const char *location)
 	{
 		if (source + length > source_end) {
@@ -56,9 +56,232 @@ namespace mathtext {
 		memcpy(destination, &source[0], length);
 	}
 
+	cid_map_t::cid_map_t(void)
+		: _size(0)
+	{
+		std::fill(_page_index, _page_index + npage, 0);
+	}
+
+	// Supplementary characters beyond the Unicode range are ignored,
+	// and 0x110000 marks the end of the iteration
+	static const uint32_t cid_map_end = 0x110000U;
+
+	std::pair<wchar_t, uint16_t> cid_map_t::seek(uint32_t code) const
+	{
+		for (; code < npage * page_size; code++) {
+			const uint16_t page = _page_index[code / page_size];
+
+			if (page == 0) {
+				code |= page_size - 1;
+				continue;
+			}
+
+			const uint16_t glyph =
+				_page[(page - 1) * page_size + code % page_size];
+
+			if (glyph != 0) {
+				return std::pair<wchar_t, uint16_t>(code, glyph);
+			}
+		}
+
+		range_t key;
+
+		key._last = code;
+
+		const std::vector<range_t>::const_iterator iterator =
+			std::lower_bound(_range.begin(), _range.end(), key);
+
+		if (iterator == _range.end() || code >= cid_map_end) {
+			return std::pair<wchar_t, uint16_t>(cid_map_end, 0);
+		}
+		code = std::max(code, iterator->_first);
+
+		return std::pair<wchar_t, uint16_t>(
+			code, iterator->_glyph + (code - iterator->_first));
+	}
+
+	uint16_t cid_map_t::find_supplementary(const uint32_t code) const
+	{
+		range_t key;
+
+		key._last = code;
+
+		const std::vector<range_t>::const_iterator iterator =
+			std::lower_bound(_range.begin(), _range.end(), key);
+
+		return iterator == _range.end() || code < iterator->_first ?
+			0 : iterator->_glyph + (code - iterator->_first);
+	}
+
+	void cid_map_t::insert_supplementary(const uint32_t code,
+										 const uint16_t glyph)
+	{
+		range_t key;
+
+		key._last = code;
+
+		std::vector<range_t>::iterator iterator =
+			std::lower_bound(_range.begin(), _range.end(), key);
+
+		// Extend the preceding or the following range where the
+		// glyph indices continue, otherwise insert a new range
+		if (iterator != _range.begin() &&
+			(iterator - 1)->_last + 1 == code &&
+			static_cast<uint16_t>((iterator - 1)->_glyph +
+								  (code - (iterator - 1)->_first)) ==
+			glyph) {
+			(iterator - 1)->_last = code;
+			if (iterator != _range.end() &&
+				iterator->_first == code + 1 &&
+				iterator->_glyph == static_cast<uint16_t>(glyph + 1)) {
+				(iterator - 1)->_last = iterator->_last;
+				_range.erase(iterator);
+			}
+		}
+		else if (iterator != _range.end() &&
+				 iterator->_first == code + 1 &&
+				 iterator->_glyph == static_cast<uint16_t>(glyph + 1)) {
+			iterator->_first = code;
+			iterator->_glyph = glyph;
+		}
+		else {
+			range_t range;
+
+			range._first = code;
+			range._last = code;
+			range._glyph = glyph;
+			_range.insert(iterator, range);
+		}
+		_size++;
+	}
+
+	void cid_map_t::erase_supplementary(const uint32_t code)
+	{
+		range_t key;
+
+		key._last = code;
+
+		std::vector<range_t>::iterator iterator =
+			std::lower_bound(_range.begin(), _range.end(), key);
+
+		if (iterator == _range.end() || code < iterator->_first) {
+			return;
+		}
+		if (iterator->_first == iterator->_last) {
+			_range.erase(iterator);
+		}
+		else if (code == iterator->_first) {
+			iterator->_first++;
+			iterator->_glyph++;
+		}
+		else if (code == iterator->_last) {
+			iterator->_last--;
+		}
+		else {
+			// Split the range around the character
+			range_t range = *iterator;
+
+			range._last = code - 1;
+			iterator->_glyph += code + 1 - iterator->_first;
+			iterator->_first = code + 1;
+			_range.insert(iterator, range);
+		}
+		_size--;
+	}
+
+	void cid_map_t::insert(const wchar_t character, const uint16_t glyph)
+	{
+		const uint32_t code = static_cast<uint32_t>(character);
+
+		if (code < npage * page_size) {
+			uint16_t &page = _page_index[code / page_size];
+
+			if (page == 0) {
+				if (glyph == 0) {
+					return;
+				}
+				_page.resize(_page.size() + page_size, 0);
+				page = _page.size() / page_size;
+			}
+
+			uint16_t &entry =
+				_page[(page - 1) * page_size + code % page_size];
+
+			if (entry == 0 && glyph != 0) {
+				_size++;
+			}
+			else if (entry != 0 && glyph == 0) {
+				_size--;
+			}
+			entry = glyph;
+		}
+		else if (code < cid_map_end) {
+			erase_supplementary(code);
+			if (glyph != 0) {
+				insert_supplementary(code, glyph);
+			}
+		}
+	}
+
+	void cid_map_t::insert_range(const uint32_t first,
+								 const uint32_t last,
+								 const uint16_t glyph)
+	{
+		uint32_t code = first;
+
+		for (; code <= last && code < npage * page_size; code++) {
+			insert(code, glyph + (code - first));
+		}
+		if (code > last || code >= cid_map_end) {
+			return;
+		}
+
+		const uint32_t range_last = std::min(last, cid_map_end - 1);
+
+		if (_range.empty() || _range.back()._last < code) {
+			// Groups in ascending order are appended as a whole
+			range_t range;
+
+			range._first = code;
+			range._last = range_last;
+			range._glyph = glyph + (code - first);
+			_range.push_back(range);
+			_size += range_last - code + 1;
+		}
+		else {
+			for (; code <= range_last; code++) {
+				insert(code, glyph + (code - first));
+			}
+		}
+	}
+
+	void cid_map_t::erase(const wchar_t character)
+	{
+		insert(character, 0);
+	}
+
+	void cid_map_t::clear(void)
+	{
+		std::fill(_page_index, _page_index + npage, 0);
+		_page.clear();
+		_range.clear();
+		_size = 0;
+	}
+
+	cid_map_t::const_iterator cid_map_t::begin(void) const
+	{
+		return const_iterator(this, seek(0));
+	}
+
+	cid_map_t::const_iterator cid_map_t::end(void) const
+	{
+		return const_iterator(
+			this, std::pair<wchar_t, uint16_t>(cid_map_end, 0));
+	}
+
 	void font_embed_t::parse_ttf_encoding_subtable_format4(
-		std::map<wchar_t, uint16_t> &cid_map,
-		const std::vector<uint8_t> &font_data, const size_t offset)
+		cid_map_t &cid_map,
+		const font_blob_t &font_data, const size_t offset)
 	{
 		static const char *location =
 			"TrueType encoding table format 4";
@@ -160,18 +383,25 @@ namespace mathtext {
 #endif // LITTLE_ENDIAN
 
 		for (uint16_t segment = 0; segment < seg_count; segment++) {
+			if (id_range_offset[segment] == 0) {
+				// Glyph indices are consecutive modulo 65536, and
+				// the segment is mapped as a whole
+				cid_map.insert_range(
+					start_code[segment], end_code[segment],
+					id_delta[segment] + start_code[segment]);
+				continue;
+			}
 			for (uint32_t code = start_code[segment];
 				 code <= end_code[segment]; code++) {
-				const uint16_t inner_offset = segment +
+				const uint32_t inner_offset = segment +
 					(id_range_offset[segment] >> 1) +
 					(code - start_code[segment]);
 				const uint16_t glyph_id =
-					id_range_offset[segment] == 0 ?
-					id_delta[segment] + code :
-					inner_offset >= seg_count + variable ?
-					0 : id_range_offset[inner_offset];
+					inner_offset >= seg_count + variable ||
+					id_range_offset[inner_offset] == 0 ? 0 :
+					id_range_offset[inner_offset] + id_delta[segment];
 
-				cid_map[static_cast<wchar_t>(code)] = glyph_id;
+				cid_map.insert(static_cast<wchar_t>(code), glyph_id);
 			}
 		}
 
@@ -182,8 +412,8 @@ namespace mathtext {
 	}
 
 	void font_embed_t::parse_ttf_encoding_subtable_format12(
-		std::map<wchar_t, uint16_t> &cid_map,
-		const std::vector<uint8_t> &font_data, const size_t offset)
+		cid_map_t &cid_map,
+		const font_blob_t &font_data, const size_t offset)
 	{
 		static const char *location =
 			"TrueType encoding table format 12";
@@ -236,283 +466,1133 @@ namespace mathtext {
 			encoding_subtable_format12_group.start_glyph_id =
 				bswap_32(encoding_subtable_format12_group.start_glyph_id);
 #endif // LITTLE_ENDIAN
-			for (uint32_t code =
-					 encoding_subtable_format12_group.start_char_code,
-					 glyph_id =
-					 encoding_subtable_format12_group.start_glyph_id;
-				 code <= encoding_subtable_format12_group.end_char_code;
-				 code++, glyph_id++) {
-				cid_map[static_cast<wchar_t>(code)] = glyph_id;
+			cid_map.insert_range(
+				encoding_subtable_format12_group.start_char_code,
+				encoding_subtable_format12_group.end_char_code,
+				encoding_subtable_format12_group.start_glyph_id);
+		}
+	}
+
+	/////////////////////////////////////////////////////////////////////
+	// Font subsetting
+	/////////////////////////////////////////////////////////////////////
+
+	// Big-endian access to table data, independent of alignment
+
+	static inline uint16_t get_uint16(const font_blob_t &data,
+									  const size_t offset)
+	{
+		return (data[offset] << 8) | data[offset + 1];
+	}
+
+	static inline uint32_t get_uint32(const font_blob_t &data,
+									  const size_t offset)
+	{
+		return (static_cast<uint32_t>(data[offset]) << 24) |
+			(data[offset + 1] << 16) | (data[offset + 2] << 8) |
+			data[offset + 3];
+	}
+
+	static inline void put_uint16(std::vector<uint8_t> &data,
+								  const size_t offset,
+								  const uint16_t value)
+	{
+		data[offset] = value >> 8;
+		data[offset + 1] = value & 0xff;
+	}
+
+	static inline void put_uint32(std::vector<uint8_t> &data,
+								  const size_t offset,
+								  const uint32_t value)
+	{
+		data[offset] = value >> 24;
+		data[offset + 1] = (value >> 16) & 0xff;
+		data[offset + 2] = (value >> 8) & 0xff;
+		data[offset + 3] = value & 0xff;
+	}
+
+	// Subset fonts are named with a tag of six uppercase letters
+	// that depends only on the glyph set (PDF reference, section
+	// 5.5.3)
+	std::string font_embed_t::subset_tag(
+		const std::vector<bool> &glyph_usage)
+	{
+		// FNV-1a over the used glyph indices
+		uint32_t hash = 2166136261U;
+
+		for (size_t i = 0; i < glyph_usage.size(); i++) {
+			if (glyph_usage[i]) {
+				hash = (hash ^ (i & 0xff)) * 16777619U;
+				hash = (hash ^ (i >> 8)) * 16777619U;
+			}
+		}
+
+		std::string tag(6, 'A');
+
+		for (size_t i = 0; i < 6; i++) {
+			tag[i] = 'A' + hash % 26;
+			hash /= 26;
+		}
+
+		return tag;
+	}
+
+	// Prefix the PostScript name (name ID 6) with the subset tag. The
+	// embedders take the font name from this record.
+	bool font_embed_t::subset_rename_otf_name_table(
+		struct table_data_s &table_data, const std::string &tag)
+	{
+		const std::vector<uint8_t> &name = table_data.data;
+
+		if (!(name.size() >= 6) || get_uint16(name, 0) != 0) {
+			// Format 1 with language tags is not supported
+			return false;
+		}
+
+		const uint16_t count = get_uint16(name, 2);
+		const uint16_t string_offset = get_uint16(name, 4);
+		const size_t record_size = 12;
+
+		if (!(6 + count * record_size <= name.size())) {
+			ERROR_ACCESS("name table");
+			return false;
+		}
+
+		std::vector<uint8_t> record(name.begin() + 6,
+									name.begin() + 6 +
+									count * record_size);
+		std::vector<uint8_t> storage;
+
+		for (uint16_t i = 0; i < count; i++) {
+			const uint16_t platform_id =
+				get_uint16(record, i * record_size);
+			const uint16_t name_id =
+				get_uint16(record, i * record_size + 6);
+			const uint16_t length =
+				get_uint16(record, i * record_size + 8);
+			const size_t offset = string_offset +
+				get_uint16(record, i * record_size + 10);
+
+			if (!(offset + length <= name.size())) {
+				ERROR_ACCESS("name table");
+				return false;
+			}
+
+			std::vector<uint8_t> string;
+
+			if (name_id == 6) {
+				for (std::string::const_iterator iterator =
+						 tag.begin();
+					 iterator != tag.end(); iterator++) {
+					if (platform_id != 1) {
+						// UTF-16BE on the Unicode and Windows
+						// platforms
+						string.push_back(0);
+					}
+					string.push_back(*iterator);
+				}
+				if (platform_id != 1) {
+					string.push_back(0);
+				}
+				string.push_back('+');
+			}
+			string.insert(string.end(), name.begin() + offset,
+						  name.begin() + offset + length);
+			put_uint16(record, i * record_size + 8, string.size());
+			put_uint16(record, i * record_size + 10, storage.size());
+			storage.insert(storage.end(), string.begin(),
+						   string.end());
+		}
+
+		std::vector<uint8_t> subset_name(6);
+
+		put_uint16(subset_name, 0, 0);
+		put_uint16(subset_name, 2, count);
+		put_uint16(subset_name, 4, 6 + record.size());
+		subset_name.insert(subset_name.end(), record.begin(),
+						   record.end());
+		subset_name.insert(subset_name.end(), storage.begin(),
+						   storage.end());
+		table_data.data = subset_name;
+
+		return true;
+	}
+
+	// Add the components of used composite glyphs to the glyph usage,
+	// and copy only the used glyph descriptions. The glyph indices
+	// are unchanged, unused glyphs become empty.
+	void font_embed_t::subset_ttf_glyf_table(
+		struct table_data_s &table_data, std::vector<uint32_t> &loca,
+		std::vector<bool> &glyph_usage)
+	{
+		const std::vector<uint8_t> &glyf = table_data.data;
+		const size_t nglyph = loca.size() - 1;
+		std::vector<uint16_t> pending;
+
+		for (size_t i = 0; i < nglyph; i++) {
+			if (glyph_usage[i]) {
+				pending.push_back(i);
+			}
+		}
+		while (!pending.empty()) {
+			const uint16_t glyph_index = pending.back();
+
+			pending.pop_back();
+
+			uint32_t offset = loca[glyph_index];
+			const uint32_t end = loca[glyph_index + 1];
+
+			if (!(offset + 10 <= end && end <= glyf.size()) ||
+				static_cast<int16_t>(get_uint16(glyf, offset)) >= 0) {
+				// Empty or simple glyph
+				continue;
+			}
+			offset += 10;
+
+			// Composite glyph flags
+			static const uint16_t arg_1_and_2_are_words = 0x0001;
+			static const uint16_t we_have_a_scale = 0x0008;
+			static const uint16_t more_components = 0x0020;
+			static const uint16_t we_have_an_x_and_y_scale = 0x0040;
+			static const uint16_t we_have_a_two_by_two = 0x0080;
+			uint16_t flags;
+
+			do {
+				if (!(offset + 4 <= end)) {
+					ERROR_ACCESS("glyf table");
+					break;
+				}
+				flags = get_uint16(glyf, offset);
+
+				const uint16_t component = get_uint16(glyf, offset + 2);
+
+				if (component < nglyph && !glyph_usage[component]) {
+					glyph_usage[component] = true;
+					pending.push_back(component);
+				}
+				offset += 4 +
+					(flags & arg_1_and_2_are_words ? 4 : 2) +
+					(flags & we_have_a_scale ? 2 :
+					 flags & we_have_an_x_and_y_scale ? 4 :
+					 flags & we_have_a_two_by_two ? 8 : 0);
+			} while (flags & more_components);
+		}
+
+		std::vector<uint8_t> subset_glyf;
+		std::vector<uint32_t> subset_loca(1, 0);
+
+		for (size_t i = 0; i < nglyph; i++) {
+			if (glyph_usage[i] && loca[i] < loca[i + 1] &&
+				loca[i + 1] <= glyf.size()) {
+				subset_glyf.insert(subset_glyf.end(),
+								   glyf.begin() + loca[i],
+								   glyf.begin() + loca[i + 1]);
+				// Keep the glyph descriptions 4 byte aligned
+				subset_glyf.resize((subset_glyf.size() + 3) & ~3U, 0);
+			}
+			subset_loca.push_back(subset_glyf.size());
+		}
+		table_data.data = subset_glyf;
+		loca = subset_loca;
+	}
+
+	std::vector<uint32_t> font_embed_t::parse_ttf_loca(
+		const struct table_data_s &table_data,
+		int16_t index_to_loc_format, uint16_t num_glyphs)
+	{
+		const std::vector<uint8_t> &data = table_data.data;
+		std::vector<uint32_t> loca;
+
+		if (!(data.size() >= (num_glyphs + 1U) *
+			  (index_to_loc_format == 0 ? 2 : 4))) {
+			ERROR_ACCESS("loca table");
+			return loca;
+		}
+		loca.reserve(num_glyphs + 1);
+		for (size_t i = 0; i < num_glyphs + 1U; i++) {
+			loca.push_back(index_to_loc_format == 0 ?
+						   get_uint16(data, 2 * i) * 2U :
+						   get_uint32(data, 4 * i));
+		}
+
+		return loca;
+	}
+
+	// Write the offsets in the short format whenever the glyf table is
+	// small enough
+	void font_embed_t::subset_ttf_loca_table(
+		struct table_data_s &table_data,
+		const std::vector<uint32_t> &loca,
+		int16_t &index_to_loc_format)
+	{
+		index_to_loc_format = loca.back() < 0x20000U ? 0 : 1;
+		table_data.data.resize(loca.size() *
+							   (index_to_loc_format == 0 ? 2 : 4));
+		for (size_t i = 0; i < loca.size(); i++) {
+			if (index_to_loc_format == 0) {
+				put_uint16(table_data.data, 2 * i, loca[i] >> 1);
+			}
+			else {
+				put_uint32(table_data.data, 4 * i, loca[i]);
+			}
+		}
+	}
+
+	// Truncate hmtx after the last used glyph. Since the glyph
+	// indices are kept, glyphs beyond numGlyphs never need a metric.
+	void font_embed_t::subset_ttf_hmtx_table(
+		struct table_data_s &table_data,
+		uint16_t &number_of_h_metrics, uint16_t num_glyphs)
+	{
+		number_of_h_metrics = std::min(number_of_h_metrics, num_glyphs);
+
+		const size_t size = 4 * number_of_h_metrics +
+			2 * (num_glyphs - number_of_h_metrics);
+
+		if (size <= table_data.data.size()) {
+			table_data.data.resize(size);
+		}
+	}
+
+	void font_embed_t::subset_ttf_post_table(
+		struct table_data_s &table_data, uint16_t num_glyphs)
+	{
+		std::vector<uint8_t> &post = table_data.data;
+
+		if (!(post.size() >= 34 && get_uint32(post, 0) == 0x00020000U)) {
+			// Only format 2.0 has a per glyph array
+			return;
+		}
+
+		const uint16_t post_num_glyphs = get_uint16(post, 32);
+
+		if (!(num_glyphs < post_num_glyphs &&
+			  34 + 2U * post_num_glyphs <= post.size())) {
+			return;
+		}
+		// The glyph name strings are kept, since the name indices of
+		// the remaining glyphs refer to them by their order
+		post.erase(post.begin() + 34 + 2 * num_glyphs,
+				   post.begin() + 34 + 2 * post_num_glyphs);
+		put_uint16(post, 32, num_glyphs);
+	}
+
+	void font_embed_t::append_cff_index(
+		std::vector<uint8_t> &data,
+		const std::vector<std::vector<uint8_t> > &index)
+	{
+		data.push_back(index.size() >> 8);
+		data.push_back(index.size() & 0xff);
+		if (index.empty()) {
+			return;
+		}
+
+		size_t data_size = 0;
+
+		for (std::vector<std::vector<uint8_t> >::const_iterator
+				 iterator = index.begin();
+			 iterator != index.end(); iterator++) {
+			data_size += iterator->size();
+		}
+
+		const uint8_t off_size = data_size + 1 < 0x100U ? 1 :
+			data_size + 1 < 0x10000U ? 2 :
+			data_size + 1 < 0x1000000U ? 3 : 4;
+
+		data.push_back(off_size);
+
+		uint32_t offset = 1;
+
+		for (size_t i = 0; i <= index.size(); i++) {
+			for (int j = off_size - 1; j >= 0; j--) {
+				data.push_back((offset >> (8 * j)) & 0xff);
+			}
+			if (i < index.size()) {
+				offset += index[i].size();
+			}
+		}
+		for (std::vector<std::vector<uint8_t> >::const_iterator
+				 iterator = index.begin();
+			 iterator != index.end(); iterator++) {
+			data.insert(data.end(), iterator->begin(),
+						iterator->end());
+		}
+	}
+
+	// Split a CFF DICT into its operators, 12 x being stored as 0x0c00
+	// | x, and the raw operand bytes
+	std::vector<std::pair<uint16_t, std::vector<uint8_t> > >
+	font_embed_t::parse_cff_dict(const std::vector<uint8_t> &dict)
+	{
+		std::vector<std::pair<uint16_t, std::vector<uint8_t> > > entry;
+		std::vector<uint8_t>::const_iterator operand_begin =
+			dict.begin();
+
+		for (std::vector<uint8_t>::const_iterator iterator =
+				 dict.begin();
+			 iterator != dict.end();) {
+			if (iterator[0] <= 21) {
+				uint16_t op = iterator[0];
+
+				if (op == 12) {
+					if (!(iterator + 2 <= dict.end())) {
+						ERROR_ACCESS("CFF DICT");
+						break;
+					}
+					op = 0x0c00 | iterator[1];
+				}
+				entry.push_back(
+					std::pair<uint16_t, std::vector<uint8_t> >(
+						op, std::vector<uint8_t>(operand_begin,
+												 iterator)));
+				iterator += op >= 0x0c00 ? 2 : 1;
+				operand_begin = iterator;
+			}
+			else if ((iterator[0] >= 28 && iterator[0] <= 30) ||
+					 (iterator[0] >= 32 && iterator[0] <= 254)) {
+				parse_cff_dict_number(iterator, dict.end());
+			}
+			else {
+				iterator++;
+			}
+		}
+
+		return entry;
+	}
+
+	void font_embed_t::append_cff_dict_entry(
+		std::vector<uint8_t> &dict, uint16_t op,
+		const std::vector<uint8_t> &operand)
+	{
+		dict.insert(dict.end(), operand.begin(), operand.end());
+		if (op >= 0x0c00) {
+			dict.push_back(12);
+		}
+		dict.push_back(op & 0xff);
+	}
+
+	// Offsets are always written as 5 byte integers, so that the DICT
+	// size does not depend on the layout
+	std::vector<uint8_t> font_embed_t::cff_dict_offset(int32_t offset)
+	{
+		std::vector<uint8_t> operand(5);
+
+		operand[0] = 29;
+		put_uint32(operand, 1, offset);
+
+		return operand;
+	}
+
+	double font_embed_t::cff_dict_operand(
+		const std::vector<uint8_t> &operand, const size_t n)
+	{
+		std::vector<uint8_t>::const_iterator iterator = operand.begin();
+		double value = NAN;
+
+		for (size_t i = 0; i <= n && iterator != operand.end(); i++) {
+			value = parse_cff_dict_number(iterator, operand.end());
+		}
+
+		return value;
+	}
+
+	size_t font_embed_t::cff_charset_size(
+		const std::vector<uint8_t> &cff, uint32_t offset,
+		uint32_t nglyph)
+	{
+		if (!(offset < cff.size())) {
+			return 0;
+		}
+
+		const uint8_t format = cff[offset];
+
+		if (format == 0) {
+			return 1 + 2 * (nglyph - 1);
+		}
+
+		const size_t range_size = format == 1 ? 3 : 4;
+		size_t size = 1;
+
+		for (uint32_t covered = 1; covered < nglyph &&
+				 offset + size + range_size <= cff.size();) {
+			covered += (format == 1 ? cff[offset + size + 2] :
+						get_uint16(cff, offset + size + 2)) + 1;
+			size += range_size;
+		}
+
+		return size;
+	}
+
+	size_t font_embed_t::cff_encoding_size(
+		const std::vector<uint8_t> &cff, uint32_t offset)
+	{
+		if (!(offset + 2 <= cff.size())) {
+			return 0;
+		}
+
+		const uint8_t format = cff[offset];
+		size_t size = 2 + cff[offset + 1] *
+			((format & 0x7f) == 0 ? 1 : 2);
+
+		if ((format & 0x80) != 0 && offset + size < cff.size()) {
+			// Supplements
+			size += 1 + 3 * cff[offset + size];
+		}
+
+		return size;
+	}
+
+	// Walk a Type 2 charstring and mark the subroutines it calls.
+	// Only the operand stack and the stem count needed to locate
+	// subroutine numbers and skip hintmask bytes are tracked. Returns
+	// true once the glyph has ended.
+	bool font_embed_t::cff_charstring_closure(
+		const std::vector<uint8_t> &charstring,
+		const std::vector<std::vector<uint8_t> > &global_subr,
+		const std::vector<std::vector<uint8_t> > &local_subr,
+		std::vector<bool> &global_subr_usage,
+		std::vector<bool> &local_subr_usage,
+		std::vector<double> &stack, unsigned int &nstem,
+		bool &error, unsigned int depth)
+	{
+		// Type 2 charstring format, section 4.7
+		static const unsigned int subr_nesting_limit = 10;
+
+		if (depth > subr_nesting_limit) {
+			error = true;
+			return true;
+		}
+		for (size_t i = 0; i < charstring.size() && !error;) {
+			const uint8_t b0 = charstring[i];
+
+			if (b0 == 28 || b0 >= 32) {
+				double value;
+
+				if (b0 == 28 && i + 3 <= charstring.size()) {
+					value = static_cast<int16_t>(
+						(charstring[i + 1] << 8) | charstring[i + 2]);
+					i += 3;
+				}
+				else if (b0 <= 246) {
+					value = b0 - 139;
+					i++;
+				}
+				else if (b0 <= 250 && i + 2 <= charstring.size()) {
+					value = (b0 - 247) * 256 + charstring[i + 1] + 108;
+					i += 2;
+				}
+				else if (b0 <= 254 && i + 2 <= charstring.size()) {
+					value = -(b0 - 251) * 256 - charstring[i + 1] - 108;
+					i += 2;
+				}
+				else if (b0 == 255 && i + 5 <= charstring.size()) {
+					// 16.16 fixed point
+					value = static_cast<int32_t>(
+						get_uint32(charstring, i + 1)) / 65536.0;
+					i += 5;
+				}
+				else {
+					error = true;
+					break;
+				}
+				stack.push_back(value);
+				continue;
+			}
+			i++;
+			switch (b0) {
+			case 1:		// hstem
+			case 3:		// vstem
+			case 18:	// hstemhm
+			case 23:	// vstemhm
+				nstem += stack.size() >> 1;
+				stack.clear();
+				break;
+			case 19:	// hintmask
+			case 20:	// cntrmask
+				// Implicit vstem hints
+				nstem += stack.size() >> 1;
+				stack.clear();
+				i += (nstem + 7) >> 3;
+				break;
+			case 10:	// callsubr
+			case 29:	// callgsubr
+				{
+					const std::vector<std::vector<uint8_t> > &subr =
+						b0 == 10 ? local_subr : global_subr;
+					std::vector<bool> &subr_usage =
+						b0 == 10 ? local_subr_usage :
+						global_subr_usage;
+
+					if (stack.empty()) {
+						error = true;
+						break;
+					}
+
+					const int32_t bias =
+						subr.size() < 1240 ? 107 :
+						subr.size() < 33900 ? 1131 : 32768;
+					const int32_t subr_index =
+						static_cast<int32_t>(stack.back()) + bias;
+
+					stack.pop_back();
+					if (!(subr_index >= 0 &&
+						  static_cast<size_t>(subr_index) <
+						  subr.size())) {
+						error = true;
+						break;
+					}
+					subr_usage[subr_index] = true;
+					if (cff_charstring_closure(
+						subr[subr_index], global_subr, local_subr,
+						global_subr_usage, local_subr_usage, stack,
+						nstem, error, depth + 1)) {
+						return true;
+					}
+				}
+				break;
+			case 11:	// return
+				return false;
+			case 14:	// endchar
+				return true;
+			case 12:
+				if (i < charstring.size() &&
+					charstring[i] >= 34 && charstring[i] <= 37) {
+					// Flex
+					stack.clear();
+					i++;
+				}
+				else {
+					// The arithmetic and storage operators would
+					// require a full interpreter
+					error = true;
+				}
+				break;
+			default:
+				stack.clear();
+				break;
+			}
+		}
+
+		return error;
+	}
+
+	// Replace the unused charstrings by endchar and the unused
+	// subroutines by return. The glyph indices and the charset are
+	// unchanged. CID-keyed fonts are not supported.
+	bool font_embed_t::subset_otf_cff_table(
+		struct table_data_s &table_data, const std::string &tag,
+		const std::vector<bool> &glyph_usage)
+	{
+		const std::vector<uint8_t> &cff = table_data.data;
+
+		if (!(cff.size() >= 4)) {
+			ERROR_ACCESS("CFF header");
+			return false;
+		}
+
+		uint32_t offset = cff[2];
+		const std::vector<std::vector<uint8_t> > name_index =
+			parse_cff_index(cff, offset);
+		const std::vector<std::vector<uint8_t> > top_dict_index =
+			parse_cff_index(cff, offset);
+
+		if (name_index.size() != 1 || top_dict_index.size() != 1) {
+			ERROR_UNSUPPORTED("CFF FontSet");
+			return false;
+		}
+
+		const uint32_t string_index_offset = offset;
+		uint32_t nstring = 0;
+
+		parse_cff_index(cff, offset, &nstring);
+
+		const std::vector<uint8_t> string_index(
+			cff.begin() + string_index_offset, cff.begin() + offset);
+		const std::vector<std::vector<uint8_t> > global_subr =
+			parse_cff_index(cff, offset);
+		const std::vector<std::pair<uint16_t, std::vector<uint8_t> > >
+			top_dict = parse_cff_dict(top_dict_index[0]);
+		uint32_t charset_offset = 0;
+		uint32_t encoding_offset = 0;
+		uint32_t char_strings_offset = 0;
+		uint32_t private_size = 0;
+		uint32_t private_offset = 0;
+
+		for (std::vector<std::pair<uint16_t, std::vector<uint8_t> > >::
+				 const_iterator iterator = top_dict.begin();
+			 iterator != top_dict.end(); iterator++) {
+			switch (iterator->first) {
+			case 15:
+				charset_offset = cff_dict_operand(iterator->second, 0);
+				break;
+			case 16:
+				encoding_offset = cff_dict_operand(iterator->second, 0);
+				break;
+			case 17:
+				char_strings_offset =
+					cff_dict_operand(iterator->second, 0);
+				break;
+			case 18:
+				private_size = cff_dict_operand(iterator->second, 0);
+				private_offset = cff_dict_operand(iterator->second, 1);
+				break;
+			case 0x0c1e:	// ROS
+				return false;
+			case 0x0c06:	// CharstringType
+				if (cff_dict_operand(iterator->second, 0) != 2) {
+					ERROR_UNSUPPORTED("CharstringType other than 2");
+					return false;
+				}
+				break;
+			}
+		}
+		if (!(char_strings_offset != 0 &&
+			  char_strings_offset < cff.size() &&
+			  private_offset + private_size <= cff.size())) {
+			ERROR_ACCESS("CFF Top DICT");
+			return false;
+		}
+
+		std::vector<std::vector<uint8_t> > char_strings =
+			parse_cff_index(cff, char_strings_offset);
+		const std::vector<uint8_t> private_dict_data(
+			cff.begin() + private_offset,
+			cff.begin() + private_offset + private_size);
+		const std::vector<std::pair<uint16_t, std::vector<uint8_t> > >
+			private_dict = parse_cff_dict(private_dict_data);
+		std::vector<std::vector<uint8_t> > local_subr;
+
+		for (std::vector<std::pair<uint16_t, std::vector<uint8_t> > >::
+				 const_iterator iterator = private_dict.begin();
+			 iterator != private_dict.end(); iterator++) {
+			if (iterator->first == 19) {
+				uint32_t local_subr_offset = private_offset +
+					cff_dict_operand(iterator->second, 0);
+
+				if (local_subr_offset < cff.size()) {
+					local_subr = parse_cff_index(cff, local_subr_offset);
+				}
+			}
+		}
+
+		// Subroutine closure
+
+		std::vector<bool> global_subr_usage(global_subr.size(), false);
+		std::vector<bool> local_subr_usage(local_subr.size(), false);
+		bool error = false;
+
+		for (size_t i = 0; i < char_strings.size() && !error; i++) {
+			if (i < glyph_usage.size() && glyph_usage[i]) {
+				std::vector<double> stack;
+				unsigned int nstem = 0;
+
+				cff_charstring_closure(
+					char_strings[i], global_subr, local_subr,
+					global_subr_usage, local_subr_usage, stack, nstem,
+					error, 0);
+			}
+		}
+		if (error) {
+			// Keep all subroutines
+			std::fill(global_subr_usage.begin(),
+					  global_subr_usage.end(), true);
+			std::fill(local_subr_usage.begin(),
+					  local_subr_usage.end(), true);
+		}
+
+		static const std::vector<uint8_t> endchar(1, 14);
+		static const std::vector<uint8_t> return_(1, 11);
+
+		for (size_t i = 1; i < char_strings.size(); i++) {
+			if (!(i < glyph_usage.size() && glyph_usage[i])) {
+				char_strings[i] = endchar;
+			}
+		}
+
+		std::vector<std::vector<uint8_t> > subset_global_subr =
+			global_subr;
+		std::vector<std::vector<uint8_t> > subset_local_subr =
+			local_subr;
+
+		for (size_t i = 0; i < global_subr.size(); i++) {
+			if (!global_subr_usage[i]) {
+				subset_global_subr[i] = return_;
+			}
+		}
+		for (size_t i = 0; i < local_subr.size(); i++) {
+			if (!local_subr_usage[i]) {
+				subset_local_subr[i] = return_;
 			}
 		}
-	}
 
-	/////////////////////////////////////////////////////////////////////
-	// Currently unfinished font subsetting code below
-	/////////////////////////////////////////////////////////////////////
+		// Layout of the subset CFF
+		//
+		// Header, Name INDEX, Top DICT INDEX, String INDEX, Global
+		// Subr INDEX, charset, Encoding, CharStrings INDEX, Private
+		// DICT, Local Subr INDEX
 
-#if 0
-	// Rename:
-	// name
-	// Subset:
-	// glyf, loca, hmtx, vmtx, cmap, hdmx, VDMX, kern, LTSH, VORG
-	// Conditional subset:
-	// post 2.0
-	// Remove completely:
-	// DSIG, BASE, GDEF, GPOS, GSUB, JSTF, EBDT, EBLC, EBSC
-
-	void font_embed_t::subset_rename_otf_name_table(
-		struct table_data_s &table_data,
-		std::map<wchar_t, bool> glyph_usage)
-	{
-		// Prefix name IDs 1, 4, 6, 16, 19, 20, 21
+		const size_t charset_size = charset_offset > 2 ?
+			cff_charset_size(cff, charset_offset,
+							 char_strings.size()) : 0;
+		const size_t encoding_size = encoding_offset > 1 ?
+			cff_encoding_size(cff, encoding_offset) : 0;
 
-		// No platform ID other than 1 and 3 is permitted for the name
-		// table
+		if (!(charset_offset + charset_size <= cff.size() &&
+			  encoding_offset + encoding_size <= cff.size())) {
+			ERROR_ACCESS("CFF charset or Encoding");
+			return false;
+		}
 
-		// Platform ID = 1: 1 byte
-		// Platform ID = 3: 2 byte
+		// Two passes over the Private DICT, since the Subrs offset is
+		// its size
 
-		// Reset UID 4,000,000 and 4,999,999 and XUID
-	}
+		std::vector<uint8_t> subset_private_dict;
 
-	void font_embed_t::subset_ttf_glyf_table(
-		struct table_data_s &table_data,
-		std::map<wchar_t, bool> glyph_usage)
-	{
-	}
+		for (int pass = 0; pass < 2; pass++) {
+			const size_t private_dict_size = subset_private_dict.size();
 
-	void font_embed_t::subset_ttf_loca_table(
-		struct table_data_s &table_data,
-		std::map<wchar_t, bool> glyph_usage)
-	{
-	}
+			subset_private_dict.clear();
+			for (std::vector<std::pair<uint16_t,
+					 std::vector<uint8_t> > >::const_iterator
+					 iterator = private_dict.begin();
+				 iterator != private_dict.end(); iterator++) {
+				append_cff_dict_entry(
+					subset_private_dict, iterator->first,
+					iterator->first == 19 ?
+					cff_dict_offset(private_dict_size) :
+					iterator->second);
+			}
+		}
 
-	void font_embed_t::subset_ttf_post_table(
-		struct table_data_s &table_data,
-		std::map<wchar_t, bool> glyph_usage)
-	{
-	}
+		std::vector<uint8_t> subset_name_index;
+		std::vector<std::vector<uint8_t> > subset_name(1);
 
-	class cff_index_t {
-	public:
-		uint16_t count;
-		uint8_t off_size;
-		std::vector<uint32_t> offset;
-		std::vector<uint8_t> data;
-		cff_index_t(const uint8_t *input_data)
-		{
-			memcpy(&count, input_data, sizeof(uint16_t));
-#ifdef LITTLE_ENDIAN
-			count = bswap_16(count);
-#endif // LITTLE_ENDIAN
-			memcpy(&off_size, input_data + sizeof(uint16_t),
-				   sizeof(uint8_t));
+		subset_name[0].assign(tag.begin(), tag.end());
+		subset_name[0].push_back('+');
+		subset_name[0].insert(subset_name[0].end(),
+							  name_index[0].begin(),
+							  name_index[0].end());
+		append_cff_index(subset_name_index, subset_name);
 
-			if (!(off_size >= 1 && off_size < 5)) {
-				return;
-			}
+		std::vector<uint8_t> subset_global_subr_index;
 
-			const uint8_t *input_data_offset =
-				input_data + sizeof(uint16_t) + sizeof(uint8_t);
+		append_cff_index(subset_global_subr_index, subset_global_subr);
 
-			// The off by one or indexing from one convention in CFF
-			// is corrected here, i.e. the resulting offset table is
-			// zero-based, and not the CFF one.
+		std::vector<uint8_t> subset_char_strings_index;
 
-			offset.reserve(count + 1);
-			switch (off_size) {
-            case 1:
-				for (size_t i = 0; i < count + 1; i++) {
-					offset.push_back(input_data_offset[i]);
-				}
-				break;
-            case 2:
-				for (size_t i = 0; i < count + 1; i++) {
-					offset.push_back(reinterpret_cast<uint16_t *>(
-						input_data_offset)[i]);
-#ifdef LITTLE_ENDIAN
-					offset.back() = bswap_16(offset.back());
-#endif // LITTLE_ENDIAN
-				}
-				break;
-            case 3:
-				for (size_t i = 0; i < 3 * (count + 1); i += 3) {
-					const uint32_t value =
-						input_data_offset[3 * i] << 16 |
-						input_data_offset[3 * i + 1] << 8 |
-						input_data_offset[3 * i + 2];
-
-					offset.push_back(value);
-				}
-				break;
-            case 4:
-				for (size_t i = 0; i < count + 1; i++) {
-					offset.push_back(reinterpret_cast<uint32_t *>(
-						input_data_offset)[i]);
-#ifdef LITTLE_ENDIAN
-					offset.back() = bswap_32(offset.back());
-#endif // LITTLE_ENDIAN
-				}
-				break;
-			}
+		append_cff_index(subset_char_strings_index, char_strings);
 
-			const uint8_t *input_data_data =
-				input_data_offset + off_size * (count + 1);
+		std::vector<uint8_t> subset_local_subr_index;
 
-			data = std::vector<uint8_t>(input_data_data, input_data_data);
-		}
-		~cff_index_t(void)
-		{
-		}
-	};
+		append_cff_index(subset_local_subr_index, subset_local_subr);
 
-	void font_embed_t::subset_otf_cff_table(
-		struct table_data_s &table_data,
-		std::map<wchar_t, bool> glyph_usage)
-	{
+		// Two passes over the Top DICT, the first one with
+		// placeholder offsets to obtain its size
+
+		std::vector<uint8_t> subset_top_dict_index;
+		uint32_t subset_charset_offset = 0;
+		uint32_t subset_encoding_offset = 0;
+		uint32_t subset_char_strings_offset = 0;
+		uint32_t subset_private_offset = 0;
+
+		for (int pass = 0; pass < 2; pass++) {
+			std::vector<std::vector<uint8_t> > subset_top_dict(1);
+
+			for (std::vector<std::pair<uint16_t,
+					 std::vector<uint8_t> > >::const_iterator
+					 iterator = top_dict.begin();
+				 iterator != top_dict.end(); iterator++) {
+				std::vector<uint8_t> operand = iterator->second;
+
+				switch (iterator->first) {
+				case 13:	// UniqueID
+				case 14:	// XUID
+					// No longer unique for a subset
+					continue;
+				case 15:
+					if (charset_size > 0) {
+						operand = cff_dict_offset(subset_charset_offset);
+					}
+					break;
+				case 16:
+					if (encoding_size > 0) {
+						operand =
+							cff_dict_offset(subset_encoding_offset);
+					}
+					break;
+				case 17:
+					operand = cff_dict_offset(subset_char_strings_offset);
+					break;
+				case 18:
+					operand = cff_dict_offset(subset_private_dict.size());
+					{
+						const std::vector<uint8_t> operand_1 =
+							cff_dict_offset(subset_private_offset);
+
+						operand.insert(operand.end(), operand_1.begin(),
+									   operand_1.end());
+					}
+					break;
+				}
+				append_cff_dict_entry(subset_top_dict[0],
+									  iterator->first, operand);
+			}
+			subset_top_dict_index.clear();
+			append_cff_index(subset_top_dict_index, subset_top_dict);
+			subset_charset_offset = cff[2] + subset_name_index.size() +
+				subset_top_dict_index.size() + string_index.size() +
+				subset_global_subr_index.size();
+			subset_encoding_offset = subset_charset_offset +
+				charset_size;
+			subset_char_strings_offset = subset_encoding_offset +
+				encoding_size;
+			subset_private_offset = subset_char_strings_offset +
+				subset_char_strings_index.size();
+		}
+
+		std::vector<uint8_t> subset_cff(cff.begin(), cff.begin() + cff[2]);
+
+		// offSize of the absolute offsets
+		subset_cff[3] = 4;
+		subset_cff.insert(subset_cff.end(), subset_name_index.begin(),
+						  subset_name_index.end());
+		subset_cff.insert(subset_cff.end(),
+						  subset_top_dict_index.begin(),
+						  subset_top_dict_index.end());
+		subset_cff.insert(subset_cff.end(), string_index.begin(),
+						  string_index.end());
+		subset_cff.insert(subset_cff.end(),
+						  subset_global_subr_index.begin(),
+						  subset_global_subr_index.end());
+		subset_cff.insert(subset_cff.end(),
+						  cff.begin() + charset_offset,
+						  cff.begin() + charset_offset + charset_size);
+		subset_cff.insert(subset_cff.end(),
+						  cff.begin() + encoding_offset,
+						  cff.begin() + encoding_offset + encoding_size);
+		subset_cff.insert(subset_cff.end(),
+						  subset_char_strings_index.begin(),
+						  subset_char_strings_index.end());
+		subset_cff.insert(subset_cff.end(), subset_private_dict.begin(),
+						  subset_private_dict.end());
+		if (!local_subr.empty()) {
+			subset_cff.insert(subset_cff.end(),
+							  subset_local_subr_index.begin(),
+							  subset_local_subr_index.end());
+		}
+		table_data.data = subset_cff;
+
+		return true;
 	}
 
 	std::vector<uint8_t> font_embed_t::subset_otf(
-		const std::vector<uint8_t> &font_data,
+		const font_blob_t &font_data,
 		const std::map<wchar_t, bool> &glyph_usage)
 	{
 		std::vector<uint8_t> retval;
-		struct otf_offset_table_s {
-			char sfnt_version[4];
-			uint16_t num_tables;
-			uint16_t search_range;
-			uint16_t entry_selector;
-			uint16_t range_shift;
-		} offset_table;
 
-		memcpy(&offset_table, &font_data[0],
-			   sizeof(struct otf_offset_table_s));
-		if (strncmp(offset_table.sfnt_version, "OTTO", 4) != 0 ||
-			strncmp(offset_table.sfnt_version, "\0\1\0\0", 4) != 0) {
+		if (!(font_data.size() >= 12)) {
+			ERROR_ACCESS("OTF offset table");
+			return retval;
+		}
+
+		const uint32_t sfnt_version = get_uint32(font_data, 0);
+
+		if (sfnt_version != 0x4f54544fU &&	// "OTTO"
+			sfnt_version != 0x00010000U) {
 			// Neither a OpenType, nor TrueType font
-#if 0
-			fprintf(stderr, "%s:%d: error: unknown sfnt_version = "
-					"0x%02x%02x%02x%02x\n", __FILE__, __LINE__,
-					offset_table.sfnt_version[0],
-					offset_table.sfnt_version[1],
-					offset_table.sfnt_version[2],
-					offset_table.sfnt_version[3]);
-#endif
 			return retval;
 		}
-#ifdef LITTLE_ENDIAN
-		offset_table.num_tables = bswap_16(offset_table.num_tables);
-#endif // LITTLE_ENDIAN
 
-		struct otf_table_directory_s {
-			char tag[4];
-			uint32_t check_sum;
-			uint32_t offset;
-			uint32_t length;
+		// Tables not listed here are dropped, either since they are
+		// not used by PostScript and PDF interpreters (e.g. the
+		// OpenType layout tables), or since they contain per glyph
+		// data that is not subset (hdmx, kern, LTSH, VDMX, vmtx)
+		static const char *retained_table[] = {
+			"CFF ", "OS/2", "cmap", "cvt ", "fpgm", "gasp", "glyf",
+			"head", "hhea", "hmtx", "loca", "maxp", "name", "post",
+			"prep"
 		};
-		struct table_data_s *table_data =
-			new struct table_data_s[offset_table.num_tables];
+		static const size_t nretained_table =
+			sizeof(retained_table) / sizeof(char *);
+		const uint16_t num_tables = get_uint16(font_data, 4);
+		std::vector<struct table_data_s> table_data;
+		std::map<std::string, size_t> table_index;
 
-		for (uint16_t i = 0; i < offset_table.num_tables; i++) {
-			struct otf_table_directory_s table_directory;
+		for (uint16_t i = 0; i < num_tables; i++) {
+			const size_t directory_offset = 12 + 16 * i;
 
-			protected_memcpy(
-				&table_directory,
-				font_data.begin() +
-				sizeof(struct otf_offset_table_s) + i *
-				sizeof(struct otf_table_directory_s),
-				font_data.end(),
-				sizeof(struct otf_table_directory_s),
-				location);
-#ifdef LITTLE_ENDIAN
-			table_directory.offset =
-				bswap_32(table_directory.offset);
-			table_directory.length =
-				bswap_32(table_directory.length);
-#endif // LITTLE_ENDIAN
-#if 0
-			fprintf(stderr, "%s:%d: tag = %c%c%c%c, offset = %u, "
-					"length = %u\n", __FILE__, __LINE__,
-					table_directory.tag[0], table_directory.tag[1],
-					table_directory.tag[2], table_directory.tag[3],
-					table_directory.offset, table_directory.length);
-#endif
-			memcpy(table_data[i].tag, table_directory.tag,
-				   4 * sizeof(char));
-			table_data[i].data.resize(table_directory.length);
-			memcpy(&(table_data[i].data[0]),
-				   &font_data[table_directory.offset],
-				   table_directory.length);
-		}
-
-		size_t size_count;
-
-		size_count = sizeof(struct otf_offset_table_s) +
-			offset_table.num_tables *
-			sizeof(struct otf_table_directory_s);
-		for (size_t i = 0; i < offset_table.num_tables; i++) {
-			size_count += table_data[i].data.size();
-		}
-
-		size_t offset_current = sizeof(struct otf_offset_table_s);
-		size_t offset_check_sum_adjustment = 0;
-		bool head_table_exists = false;
-
-		retval.resize(size_count);
-		memcpy(&retval[0], &font_data[0],
-			   sizeof(struct otf_offset_table_s));
-		for (size_t i = 0; i < offset_table.num_tables; i++) {
-			struct otf_table_directory_s table_directory;
-			const bool head_table =
-				strncmp(table_directory.tag, "head", 4) == 0;
-
-			memcpy(table_directory.tag, table_data[i].tag,
-				   4 * sizeof(char));
-			if (head_table) {
-				// Reset checkSumAdjustment in order to calculate the
-				// check sum of the head table
-				offset_check_sum_adjustment = 2 * sizeof(fixed_t);
-				*reinterpret_cast<uint32_t *>(&(table_data[i].data[
-					offset_check_sum_adjustment])) = 0U;
-				// Change the offset for checkSumAdjustment to the
-				// global indexing
-				offset_check_sum_adjustment += offset_current;
-				head_table_exists = true;
-			}
-			table_directory.check_sum =
-				otf_check_sum(table_data[i].data);
-			table_directory.offset = size_count;
-			table_directory.length = table_data[i].data.size();
-
-			memcpy(&retval[offset_current], &table_directory,
-				   sizeof(struct otf_table_directory_s));
-			size_count += table_data[i].data.size();
-			offset_current += sizeof(struct otf_table_directory_s);
-		}
-
-		for (size_t i = 0; i < offset_table.num_tables; i++) {
-			memcpy(&retval[offset_current], &(table_data[i].data[0]),
-				   table_data[i].data.size());
-			offset_current += table_data[i].data.size();
-
-			const size_t padding_size =
-				(4U - table_data[i].data.size()) & 3U;
-
-			memset(&retval[offset_current], '\0', padding_size);
-			offset_current += padding_size;
-		}
-
-		if (head_table_exists) {
-			// Set checkSumAdjustment in the head table
-			*reinterpret_cast<uint32_t *>(&(retval[
-				offset_check_sum_adjustment])) =
-				0xb1b0afbaU - otf_check_sum(retval);
+			if (!(directory_offset + 16 <= font_data.size())) {
+				ERROR_ACCESS("table directory");
+				return retval;
+			}
+
+			const std::string tag(
+				font_data.begin() + directory_offset,
+				font_data.begin() + directory_offset + 4);
+			const uint32_t offset =
+				get_uint32(font_data, directory_offset + 8);
+			const uint32_t length =
+				get_uint32(font_data, directory_offset + 12);
+
+			if (!(offset + length <= font_data.size())) {
+				ERROR_ACCESS("table directory");
+				return retval;
+			}
+			if (std::find(retained_table,
+						  retained_table + nretained_table, tag) ==
+				retained_table + nretained_table) {
+				continue;
+			}
+			table_index[tag] = table_data.size();
+			table_data.push_back(table_data_s());
+			memcpy(table_data.back().tag, tag.data(), 4);
+			table_data.back().data.assign(
+				font_data.begin() + offset,
+				font_data.begin() + offset + length);
+		}
+
+		if (table_index.find("cmap") == table_index.end() ||
+			table_index.find("head") == table_index.end() ||
+			table_index.find("hhea") == table_index.end() ||
+			table_index.find("hmtx") == table_index.end() ||
+			table_index.find("maxp") == table_index.end() ||
+			table_index.find("name") == table_index.end()) {
+			fprintf(stderr, "%s:%d: error: font is missing required "
+					"tables\n", __FILE__, __LINE__);
+			return retval;
+		}
+
+		std::vector<uint8_t> &head = table_data[table_index["head"]].data;
+		std::vector<uint8_t> &hhea = table_data[table_index["hhea"]].data;
+		std::vector<uint8_t> &maxp = table_data[table_index["maxp"]].data;
+
+		if (!(head.size() >= 54 && hhea.size() >= 36 &&
+			  maxp.size() >= 6)) {
+			ERROR_ACCESS("head, hhea or maxp table");
+			return retval;
+		}
+
+		// Map the used characters to glyph indices
+
+		const uint16_t num_glyphs = get_uint16(maxp, 4);
+		const cid_map_t &cid_map = font_data.parsed_font()._cid_map;
+		std::vector<bool> glyph_index_usage(num_glyphs, false);
+
+		if (num_glyphs > 0) {
+			// .notdef
+			glyph_index_usage[0] = true;
+		}
+		for (std::map<wchar_t, bool>::const_iterator iterator =
+				 glyph_usage.begin();
+			 iterator != glyph_usage.end(); iterator++) {
+			if (iterator->second) {
+				const uint16_t glyph = cid_map.find(iterator->first);
+
+				if (glyph != 0 && glyph < num_glyphs) {
+					glyph_index_usage[glyph] = true;
+				}
+			}
+		}
+
+		if (table_index.find("glyf") != table_index.end() &&
+			table_index.find("loca") != table_index.end()) {
+			int16_t index_to_loc_format = get_uint16(head, 50);
+			std::vector<uint32_t> loca =
+				parse_ttf_loca(table_data[table_index["loca"]],
+							   index_to_loc_format, num_glyphs);
+
+			if (loca.empty()) {
+				return retval;
+			}
+			subset_ttf_glyf_table(table_data[table_index["glyf"]],
+								  loca, glyph_index_usage);
+
+			// Compact the per glyph tables by dropping the glyphs
+			// after the last used one
+			uint16_t subset_num_glyphs = num_glyphs;
+
+			while (subset_num_glyphs > 1 &&
+				   !glyph_index_usage[subset_num_glyphs - 1]) {
+				subset_num_glyphs--;
+			}
+			loca.resize(subset_num_glyphs + 1);
+			subset_ttf_loca_table(table_data[table_index["loca"]],
+								  loca, index_to_loc_format);
+			put_uint16(head, 50, index_to_loc_format);
+			put_uint16(maxp, 4, subset_num_glyphs);
+
+			uint16_t number_of_h_metrics = get_uint16(hhea, 34);
+
+			subset_ttf_hmtx_table(table_data[table_index["hmtx"]],
+								  number_of_h_metrics,
+								  subset_num_glyphs);
+			put_uint16(hhea, 34, number_of_h_metrics);
+			if (table_index.find("post") != table_index.end()) {
+				subset_ttf_post_table(table_data[table_index["post"]],
+									  subset_num_glyphs);
+			}
+		}
+
+		const std::string tag = subset_tag(glyph_index_usage);
+
+		if (table_index.find("CFF ") != table_index.end() &&
+			!subset_otf_cff_table(table_data[table_index["CFF "]],
+								  tag, glyph_index_usage)) {
+			return retval;
+		}
+		if (!subset_rename_otf_name_table(
+				table_data[table_index["name"]], tag)) {
+			return retval;
+		}
+
+		// Reassemble the font with 4 byte aligned tables, as in
+		// OpenType specification, "The Font File"
+
+		uint16_t entry_selector = 0;
+
+		while ((2U << entry_selector) <= table_data.size()) {
+			entry_selector++;
+		}
+
+		const uint16_t search_range = 16 << entry_selector;
+		size_t offset = 12 + 16 * table_data.size();
+
+		retval.resize(offset);
+		put_uint32(retval, 0, sfnt_version);
+		put_uint16(retval, 4, table_data.size());
+		put_uint16(retval, 6, search_range);
+		put_uint16(retval, 8, entry_selector);
+		put_uint16(retval, 10, 16 * table_data.size() - search_range);
+
+		// Reset checkSumAdjustment in order to calculate the check
+		// sum of the head table
+		put_uint32(head, 8, 0);
+		for (size_t i = 0; i < table_data.size(); i++) {
+			const size_t directory_offset = 12 + 16 * i;
+
+			memcpy(&retval[directory_offset], table_data[i].tag, 4);
+			put_uint32(retval, directory_offset + 4,
+					   otf_check_sum(table_data[i].data));
+			put_uint32(retval, directory_offset + 8, offset);
+			put_uint32(retval, directory_offset + 12,
+					   table_data[i].data.size());
+			retval.insert(retval.end(), table_data[i].data.begin(),
+						  table_data[i].data.end());
+			retval.resize((retval.size() + 3) & ~static_cast<size_t>(3),
+						  0);
+			offset = retval.size();
 		}
 
+		// Set checkSumAdjustment in the head table
+		const size_t head_offset =
+			get_uint32(retval, 12 + 16 * table_index["head"] + 8);
+
+		put_uint32(retval, head_offset + 8,
+				   0xb1b0afbaU - otf_check_sum(retval));
+
 		return retval;
 	}
-#endif //////////////////////////////////////////////////////////////
 
 	uint32_t font_embed_t::otf_check_sum(
 		const std::vector<uint8_t> &table_data)
@@ -583,25 +1663,15 @@ namespace mathtext {
 		return font_data;
 	}
 
-	std::vector<uint8_t> font_embed_t::read_font_data(
+	font_blob_t font_embed_t::read_font_data(
 		const std::string &filename)
 	{
-		FILE *fp = fopen(filename.c_str(), "r");
-		std::vector<uint8_t> font_data;
-
-		if (fp == NULL) {
-			perror("fopen");
-			return font_data;
-		}
-		font_data = read_font_data(fp);
-		fclose(fp);
-
-		return font_data;
+		return font_blob_t::open(filename);
 	}
 
 	std::map<std::string, std::pair<uint32_t, uint32_t> >
 	font_embed_t::parse_ttf_offset_table(
-		const std::vector<uint8_t> &font_data,
+		const font_blob_t &font_data,
 		size_t offset_table_size, uint16_t num_tables)
 	{
 		std::map<std::string, std::pair<uint32_t, uint32_t> > table;
@@ -646,8 +1716,8 @@ namespace mathtext {
 	}
 
 	void font_embed_t::parse_ttf_cmap(
-		std::map<wchar_t, uint16_t> &cid_map,
-		const std::vector<uint8_t> &font_data,
+		cid_map_t &cid_map,
+		const font_blob_t &font_data,
 		uint32_t cmap_offset)
 	{
 		if (cmap_offset == 0) {
@@ -799,7 +1869,7 @@ namespace mathtext {
 
 	void font_embed_t::parse_ttf_head(
 		double *font_bbox, uint16_t &units_per_em,
-		const std::vector<uint8_t> &font_data,
+		const font_blob_t &font_data,
 		uint32_t head_offset)
 	{
 		if (head_offset == 0) {
@@ -849,7 +1919,7 @@ namespace mathtext {
 	}
 
 	uint16_t font_embed_t::parse_ttf_hhea(
-		const std::vector<uint8_t> &font_data,
+		const font_blob_t &font_data,
 		uint32_t hhea_offset)
 	{
 		if (!(hhea_offset + 36 <= font_data.size())) {
@@ -871,7 +1941,7 @@ namespace mathtext {
 	}
 
 	std::vector<uint16_t> font_embed_t::parse_ttf_hmtx(
-		const std::vector<uint8_t> &font_data,
+		const font_blob_t &font_data,
 		uint32_t hmtx_offset, uint16_t number_of_h_metrics)
 	{
 		std::vector<uint16_t> advance_width;
@@ -888,7 +1958,7 @@ namespace mathtext {
 	}
 
 	uint16_t font_embed_t::parse_ttf_maxp(
-		const std::vector<uint8_t> &font_data,
+		const font_blob_t &font_data,
 		uint32_t maxp_offset)
 	{
 		if (!(maxp_offset + 6 <= font_data.size())) {
@@ -911,7 +1981,7 @@ namespace mathtext {
 
 	void font_embed_t::parse_ttf_name(
 		std::string &font_name, uint16_t &cid_encoding_id,
-		const std::vector<uint8_t> &font_data,
+		const font_blob_t &font_data,
 		uint32_t name_offset)
 	{
 		if (name_offset == 0) {
@@ -1050,7 +2120,7 @@ namespace mathtext {
 		uint32_t &font_descriptor_flag, double &ascent,
 		double &descent, double &leading, double &cap_height,
 		double &x_height, double &stem_v, double &avg_width,
-		const std::vector<uint8_t> &font_data,
+		const font_blob_t &font_data,
 		uint32_t os_2_offset, uint16_t units_per_em)
 	{
 		if (os_2_offset == 0) {
@@ -1172,7 +2242,7 @@ namespace mathtext {
 	void font_embed_t::parse_ttf_post(
 		std::vector<std::string> &charset,
 		double &italic_angle, uint32_t &font_descriptor_flags,
-		const std::vector<uint8_t> &font_data,
+		const font_blob_t &font_data,
 		uint32_t post_offset)
 	{
 		if (post_offset == 0) {
@@ -1269,13 +2339,16 @@ namespace mathtext {
 				}
 			}
 
-			std::string *glyph_name =
-				new std::string[max_glyph_name_index - 258 + 1];
+			// A (subset) font may use only standard Macintosh glyph
+			// names
+			const size_t nglyph_name = max_glyph_name_index >= 258 ?
+				max_glyph_name_index - 258 + 1 : 0;
+			std::string *glyph_name = new std::string[nglyph_name];
 
 			offset_current +=
 				sizeof(struct ttf_post_script_table_s) +
 				(num_glyphs + 1) * sizeof(uint16_t);
-			for (uint16_t i = 0; i <= max_glyph_name_index - 258; i++) {
+			for (size_t i = 0; i < nglyph_name; i++) {
 				uint8_t length;
 
 				memcpy(&length, &font_data[offset_current],
@@ -1331,7 +2404,7 @@ namespace mathtext {
 
 	std::vector<std::vector<uint8_t> >
 	font_embed_t::parse_cff_index(
-		const std::vector<uint8_t> &font_data,
+		const font_blob_t &font_data,
 		uint32_t &current_offset, uint32_t *skip)
 	{
 		struct cff_index_s {
@@ -1534,7 +2607,7 @@ namespace mathtext {
 	}
 
 	std::vector<std::string> font_embed_t::parse_cff_charset(
-		const std::vector<uint8_t> &data,
+		const font_blob_t &data,
 		uint32_t charset_offset, uint32_t nglyph,
 		const std::vector<std::vector<uint8_t> > &string_index)
 	{
@@ -1572,7 +2645,7 @@ namespace mathtext {
 
 	void font_embed_t::parse_cff(
 		std::vector<std::string> &charset,
-		const std::vector<uint8_t> &font_data,
+		const font_blob_t &font_data,
 		uint32_t cff_offset)
 	{
 		struct cff_header_s {
@@ -1625,95 +2698,34 @@ namespace mathtext {
 		double &italic_angle, double &ascent, double &descent,
 		double &leading, double &cap_height, double &x_height,
 		double &stem_v,double &avg_width,
-		std::map<wchar_t, uint16_t> &cid_map,
+		cid_map_t &cid_map,
 		std::vector<std::string> &charset,
 		std::vector<uint16_t> &advance_width,
 		unsigned int &cff_offset, unsigned int &cff_length,
-		const std::vector<uint8_t> &font_data)
+		const font_blob_t &font_data)
 	{
-		// OpenType file structure
-		struct otf_offset_table_s {
-			char sfnt_version[4];
-			uint16_t num_tables;
-			uint16_t search_range;
-			uint16_t entry_selector;
-			uint16_t range_shift;
-		} offset_table;
+		const parsed_font_t &font = font_data.parsed_font();
 
-		if (!(sizeof(struct otf_offset_table_s) <=
-			  font_data.size())) {
-			ERROR_ACCESS("OTF offset table");
-		}
-		memcpy(&offset_table, &font_data[0],
-			   sizeof(struct otf_offset_table_s));
-		if (strncmp(offset_table.sfnt_version, "OTTO", 4) != 0) {
+		if (!(font._valid && font._cff)) {
 			// Not a OpenType CFF/Type 2 font
 			return false;
 		}
-#ifdef LITTLE_ENDIAN
-		offset_table.num_tables = bswap_16(offset_table.num_tables);
-#endif // LITTLE_ENDIAN
-
-		std::map<std::string, std::pair<uint32_t, uint32_t> > table =
-			parse_ttf_offset_table(
-				font_data, sizeof(struct otf_offset_table_s),
-				offset_table.num_tables);
-
-		const uint32_t cmap_offset = table["cmap"].first;
-		const uint32_t head_offset = table["head"].first;
-		const uint32_t hhea_offset = table["hhea"].first;
-		const uint32_t hmtx_offset = table["hmtx"].first;
-		const uint32_t maxp_offset = table["maxp"].first;
-		const uint32_t name_offset = table["name"].first;
-		const uint32_t os_2_offset = table["OS/2"].first;
-		const uint32_t post_offset = table["post"].first;
-
-		cff_offset = table["CFF "].first;
-		cff_length = table["CFF "].second;
-
-		if (!(cmap_offset != 0 && head_offset != 0 &&
-			  hhea_offset != 0 && hmtx_offset != 0 &&
-			  maxp_offset != 0 && name_offset != 0 &&
-			  os_2_offset != 0 && cff_offset != 0)) {
-			fprintf(stderr, "%s:%d: error: OTF CFF font is "
-					"missing required tables\n", __FILE__, __LINE__);
-			return false;
-		}
-
-		parse_ttf_name(font_name, cid_encoding_id, font_data,
-					   name_offset);
-
-		uint16_t units_per_em;
-
-		parse_ttf_head(font_bbox, units_per_em, font_data,
-					   head_offset);
-		font_descriptor_flags = 0;
-		parse_ttf_post(charset, italic_angle, font_descriptor_flags,
-					   font_data, post_offset);
-		parse_ttf_cmap(cid_map, font_data, cmap_offset);
-		parse_ttf_os_2(font_descriptor_flags, ascent, descent,
-					   leading, cap_height, x_height, stem_v,
-					   avg_width, font_data, os_2_offset,
-					   units_per_em);
-
-		const uint16_t num_glyphs =
-			parse_ttf_maxp(font_data, maxp_offset);
-		advance_width =
-			parse_ttf_hmtx(font_data, hmtx_offset,
-						   parse_ttf_hhea(font_data, hhea_offset));
-
-		if (advance_width.empty()) {
-			fprintf(stderr, "%s:%d: error: hMetrics in hmtx is "
-					"empty\n", __FILE__, __LINE__);
-			return false;
-		}
-		advance_width.resize(num_glyphs, advance_width.back());
-
-		if (charset.empty()) {
-			parse_cff(charset, font_data, cff_offset);
-		}
-
-		cid_map.erase(L'\uffff');
+		font_name = font._font_name;
+		cid_encoding_id = font._cid_encoding_id;
+		std::copy(font._font_bbox, font._font_bbox + 4, font_bbox);
+		italic_angle = font._italic_angle;
+		ascent = font._ascent;
+		descent = font._descent;
+		leading = font._leading;
+		cap_height = font._cap_height;
+		x_height = font._x_height;
+		stem_v = font._stem_v;
+		avg_width = font._avg_width;
+		cid_map = font._cid_map;
+		charset = font._charset;
+		advance_width = font._advance_width;
+		cff_offset = font._cff_offset;
+		cff_length = font._cff_length;
 
 		return true;
 	}
@@ -1721,33 +2733,24 @@ namespace mathtext {
 	bool font_embed_t::parse_otf_cff_header(
 		std::string &font_name, unsigned short &cid_encoding_id,
 		unsigned int &cff_offset, unsigned int &cff_length,
-		const std::vector<uint8_t> &font_data)
+		const font_blob_t &font_data)
 	{
-		uint32_t font_descriptor_flags = 0;
-		double font_bbox[4];
-		double italic_angle;
-		double ascent;
-		double descent;
-		double leading;
-		double cap_height;
-		double x_height;
-		double stem_v;
-		double avg_width;
-		std::map<wchar_t, uint16_t> cid_map;
-		std::vector<std::string> charset;
-		std::vector<uint16_t> advance_width;
+		const parsed_font_t &font = font_data.parsed_font();
+
+		if (!(font._valid && font._cff)) {
+			return false;
+		}
+		font_name = font._font_name;
+		cid_encoding_id = font._cid_encoding_id;
+		cff_offset = font._cff_offset;
+		cff_length = font._cff_length;
 
-		return parse_otf_cff_header(
-			font_name, cid_encoding_id, font_descriptor_flags,
-			font_bbox, italic_angle, ascent, descent, leading,
-			cap_height, x_height, stem_v, avg_width, cid_map,
-			charset, advance_width, cff_offset, cff_length,
-			font_data);
+		return true;
 	}
 
 	std::vector<std::string>
 	font_embed_t::charset_from_adobe_glyph_list(
-		std::map<wchar_t, uint16_t> &cid_map)
+		cid_map_t &cid_map)
 	{
 		// Regenerate cid_map from the Adobe glyph list
 
@@ -1757,7 +2760,7 @@ namespace mathtext {
 			return std::vector<std::string>(1, ".notdef");
 		}
 		charset.resize(cid_map.size());
-		for (std::map<wchar_t, uint16_t>::const_iterator iterator =
+		for (cid_map_t::const_iterator iterator =
 				 cid_map.begin();
 			 iterator != cid_map.end(); iterator++) {
 			if (iterator->second < charset.size()) {
@@ -1786,6 +2789,8 @@ namespace mathtext {
 				charset[iterator->second] = buf;
 			}
 		}
+		// Unmapped characters are not part of cid_map
+		charset[0] = ".notdef";
 
 		return charset;
 	}
@@ -1796,121 +2801,241 @@ namespace mathtext {
 		double &italic_angle, double &ascent, double &descent,
 		double &leading, double &cap_height, double &x_height,
 		double &stem_v,double &avg_width,
-		std::map<wchar_t, uint16_t> &cid_map,
+		cid_map_t &cid_map,
 		std::vector<std::string> &charset,
 		std::vector<uint16_t> &advance_width,
-		const std::vector<uint8_t> &font_data)
+		const font_blob_t &font_data)
 	{
+		const parsed_font_t &font = font_data.parsed_font();
+
 		cid_map.clear();
 		charset.clear();
+		if (!(font._valid && !font._cff)) {
+			return false;
+		}
+		font_name = font._font_name;
+		cid_encoding_id = font._cid_encoding_id;
+		std::copy(font._font_bbox, font._font_bbox + 4, font_bbox);
+		italic_angle = font._italic_angle;
+		ascent = font._ascent;
+		descent = font._descent;
+		leading = font._leading;
+		cap_height = font._cap_height;
+		x_height = font._x_height;
+		stem_v = font._stem_v;
+		avg_width = font._avg_width;
+		cid_map = font._cid_map;
+		charset = font._charset;
+		advance_width = font._advance_width;
 
-		struct ttf_offset_table_s {
-			fixed_t sfnt_version;
-			uint16_t num_tables;
-			uint16_t search_range;
-			uint16_t entry_selector;
-			uint16_t range_shift;
-		} offset_table;
+		return true;
+	}
 
-		if (!(sizeof(struct ttf_offset_table_s) <=
-			  font_data.size())) {
-			ERROR_ACCESS("TTF offset table");
+	bool font_embed_t::parse_ttf_header(
+		std::string &font_name, double *font_bbox,
+		cid_map_t &cid_map,
+		std::vector<std::string> &charset,
+		const font_blob_t &font_data)
+	{
+		const parsed_font_t &font = font_data.parsed_font();
+
+		cid_map.clear();
+		charset.clear();
+		if (!(font._valid && !font._cff)) {
+			return false;
 		}
-		memcpy(&offset_table, &font_data[0],
-			   sizeof(struct ttf_offset_table_s));
-#ifdef LITTLE_ENDIAN
-		offset_table.sfnt_version =
-			bswap_32(offset_table.sfnt_version);
-		offset_table.num_tables = bswap_16(offset_table.num_tables);
-#endif // LITTLE_ENDIAN
-		if (offset_table.sfnt_version != 0x00010000) {
+		font_name = font._font_name;
+		std::copy(font._font_bbox, font._font_bbox + 4, font_bbox);
+		cid_map = font._cid_map;
+		charset = font._charset;
+
+		return true;
+	}
+
+	parsed_font_t::parsed_font_t(void)
+		: _valid(false), _cff(false), _cid_encoding_id(0),
+		  _font_descriptor_flags(0), _italic_angle(0), _ascent(0),
+		  _descent(0), _leading(0), _cap_height(0), _x_height(0),
+		  _stem_v(0), _avg_width(0), _cff_offset(0), _cff_length(0)
+	{
+		std::fill(_font_bbox, _font_bbox + 4, 0.0);
+	}
+
+	const parsed_font_t::table_t *
+	parsed_font_t::table(const char *tag) const
+	{
+		table_t key;
+
+		key._tag = (static_cast<uint32_t>(
+			static_cast<uint8_t>(tag[0])) << 24) |
+			(static_cast<uint8_t>(tag[1]) << 16) |
+			(static_cast<uint8_t>(tag[2]) << 8) |
+			static_cast<uint8_t>(tag[3]);
+
+		const std::vector<table_t>::const_iterator iterator =
+			std::lower_bound(_table.begin(), _table.end(), key);
+
+		return iterator != _table.end() && iterator->_tag == key._tag ?
+			&*iterator : NULL;
+	}
+
+	bool font_embed_t::parse_font(
+		parsed_font_t &font, const font_blob_t &font_data,
+		const parsed_font_t *original)
+	{
+		font = parsed_font_t();
+		if (!(font_data.size() >= 12)) {
+			ERROR_ACCESS("OTF offset table");
+			return false;
+		}
+
+		const uint32_t sfnt_version = get_uint32(font_data, 0);
+
+		if (sfnt_version == 0x4f54544fU) {
+			// "OTTO"
+			font._cff = true;
+		}
+		else if (sfnt_version != 0x00010000U) {
+			// Neither a OpenType, nor TrueType font
 			return false;
 		}
 
-		std::map<std::string, std::pair<uint32_t, uint32_t> > table =
-			parse_ttf_offset_table(
-				font_data, sizeof(struct ttf_offset_table_s),
-				offset_table.num_tables);
+		const uint16_t num_tables = get_uint16(font_data, 4);
+
+		font._table.reserve(num_tables);
+		for (uint16_t i = 0; i < num_tables; i++) {
+			const size_t directory_offset = 12 + 16 * i;
+
+			if (!(directory_offset + 16 <= font_data.size())) {
+				ERROR_ACCESS("table directory");
+				return false;
+			}
+
+			parsed_font_t::table_t table;
+
+			table._tag = get_uint32(font_data, directory_offset);
+			table._offset =
+				get_uint32(font_data, directory_offset + 8);
+			table._length =
+				get_uint32(font_data, directory_offset + 12);
+			if (!(static_cast<uint64_t>(table._offset) +
+				  table._length <= font_data.size())) {
+				ERROR_ACCESS("table directory");
+				continue;
+			}
+			font._table.push_back(table);
+		}
+		std::sort(font._table.begin(), font._table.end());
+
+		const uint32_t cmap_offset = font.table_offset("cmap");
+		const uint32_t head_offset = font.table_offset("head");
+		const uint32_t hhea_offset = font.table_offset("hhea");
+		const uint32_t hmtx_offset = font.table_offset("hmtx");
+		const uint32_t maxp_offset = font.table_offset("maxp");
+		const uint32_t name_offset = font.table_offset("name");
+		const uint32_t os_2_offset = font.table_offset("OS/2");
+		const uint32_t post_offset = font.table_offset("post");
 
-		const uint32_t cmap_offset = table["cmap"].first;
-		const uint32_t head_offset = table["head"].first;
-		const uint32_t hhea_offset = table["hhea"].first;
-		const uint32_t hmtx_offset = table["hmtx"].first;
-		const uint32_t maxp_offset = table["maxp"].first;
-		const uint32_t name_offset = table["name"].first;
-		const uint32_t os_2_offset = table["OS/2"].first;
-		const uint32_t post_offset = table["post"].first;
+		if (font._cff) {
+			const parsed_font_t::table_t *cff = font.table("CFF ");
 
+			if (cff != NULL) {
+				font._cff_offset = cff->_offset;
+				font._cff_length = cff->_length;
+			}
+		}
 		if (!(cmap_offset != 0 && head_offset != 0 &&
 			  hhea_offset != 0 && hmtx_offset != 0 &&
 			  maxp_offset != 0 && name_offset != 0 &&
-			  os_2_offset != 0)) {
-			fprintf(stderr, "%s:%d: error: TTF font is missing "
-					"required tables\n", __FILE__, __LINE__);
+			  os_2_offset != 0 &&
+			  (!font._cff || font._cff_offset != 0))) {
+			fprintf(stderr, "%s:%d: error: %s font is missing "
+					"required tables\n", __FILE__, __LINE__,
+					font._cff ? "OTF CFF" : "TTF");
 			return false;
 		}
 
-		parse_ttf_name(font_name, cid_encoding_id, font_data,
-					   name_offset);
+		parse_ttf_name(font._font_name, font._cid_encoding_id,
+					   font_data, name_offset);
+
+		const uint16_t num_glyphs =
+			parse_ttf_maxp(font_data, maxp_offset);
+
+		if (original != NULL) {
+			// Subsetting renames the font and truncates the per
+			// glyph tables, but retains the character mapping, the
+			// metrics and the glyph names
+			font._font_descriptor_flags =
+				original->_font_descriptor_flags;
+			std::copy(original->_font_bbox, original->_font_bbox + 4,
+					  font._font_bbox);
+			font._italic_angle = original->_italic_angle;
+			font._ascent = original->_ascent;
+			font._descent = original->_descent;
+			font._leading = original->_leading;
+			font._cap_height = original->_cap_height;
+			font._x_height = original->_x_height;
+			font._stem_v = original->_stem_v;
+			font._avg_width = original->_avg_width;
+			font._cid_map = original->_cid_map;
+			font._charset = original->_charset;
+			font._advance_width = original->_advance_width;
+			if (font._charset.size() > num_glyphs) {
+				font._charset.resize(num_glyphs);
+			}
+			if (font._advance_width.size() > num_glyphs) {
+				font._advance_width.resize(num_glyphs);
+			}
+			font._valid = !font._advance_width.empty();
+
+			return font._valid;
+		}
 
 		uint16_t units_per_em;
 
-		parse_ttf_head(font_bbox, units_per_em, font_data,
+		parse_ttf_head(font._font_bbox, units_per_em, font_data,
 					   head_offset);
-		font_descriptor_flags = 0;
-		parse_ttf_post(charset, italic_angle, font_descriptor_flags,
-					   font_data, post_offset);
-		parse_ttf_cmap(cid_map, font_data, cmap_offset);
-		parse_ttf_os_2(font_descriptor_flags, ascent, descent,
-					   leading, cap_height, x_height, stem_v,
-					   avg_width, font_data, os_2_offset,
-					   units_per_em);
-
-		const uint16_t num_glyphs =
-			parse_ttf_maxp(font_data, maxp_offset);
-		advance_width =
+		parse_ttf_post(font._charset, font._italic_angle,
+					   font._font_descriptor_flags, font_data,
+					   post_offset);
+		parse_ttf_cmap(font._cid_map, font_data, cmap_offset);
+		parse_ttf_os_2(font._font_descriptor_flags, font._ascent,
+					   font._descent, font._leading, font._cap_height,
+					   font._x_height, font._stem_v, font._avg_width,
+					   font_data, os_2_offset, units_per_em);
+		font._advance_width =
 			parse_ttf_hmtx(font_data, hmtx_offset,
 						   parse_ttf_hhea(font_data, hhea_offset));
 
-		if (advance_width.empty()) {
+		if (font._advance_width.empty()) {
 			fprintf(stderr, "%s:%d: error: hMetrics in hmtx is "
 					"empty\n", __FILE__, __LINE__);
 			return false;
 		}
-		advance_width.resize(num_glyphs, advance_width.back());
+		font._advance_width.resize(num_glyphs,
+								   font._advance_width.back());
+		// Glyph space units, i.e. 1/1000 em
+		for (std::vector<uint16_t>::iterator iterator =
+				 font._advance_width.begin();
+			 iterator != font._advance_width.end(); iterator++) {
+			*iterator = (*iterator * 1000U + (units_per_em >> 1)) /
+				units_per_em;
+		}
 
-		if (charset.empty()) {
-			charset = charset_from_adobe_glyph_list(cid_map);
+		if (font._charset.empty()) {
+			if (font._cff) {
+				parse_cff(font._charset, font_data, font._cff_offset);
+			}
+			else {
+				font._charset =
+					charset_from_adobe_glyph_list(font._cid_map);
+			}
 		}
 
-		cid_map.erase(L'\uffff');
+		font._cid_map.erase(L'\uffff');
+		font._valid = true;
 
 		return true;
 	}
 
-	bool font_embed_t::parse_ttf_header(
-		std::string &font_name, double *font_bbox,
-		std::map<wchar_t, uint16_t> &cid_map,
-		std::vector<std::string> &charset,
-		const std::vector<uint8_t> &font_data)
-	{
-		uint16_t cid_encoding_id;
-		uint32_t font_descriptor_flags = 0;
-		double italic_angle;
-		double ascent;
-		double descent;
-		double leading;
-		double cap_height;
-		double x_height;
-		double stem_v;
-		double avg_width;
-		std::vector<uint16_t> advance_width;
-
-		return parse_ttf_header(
-			font_name, cid_encoding_id, font_descriptor_flags,
-			font_bbox, italic_angle, ascent, descent, leading,
-			cap_height, x_height, stem_v, avg_width, cid_map,
-			charset, advance_width, font_data);
-	}
-
 }
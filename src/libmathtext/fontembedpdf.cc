@@ -162,43 +162,88 @@ namespace mathtext {
 
 	std::map<std::string, std::string>
 	font_embed_pdf_t::font_embed_cid(
-		std::string &font_name,
-		const std::vector<unsigned char> &font_data,
-		unsigned int type)
+		font_sink_t &font_file, std::string &font_name,
+		const font_blob_t &font_data_full,
+		unsigned int type,
+		const std::map<wchar_t, bool> &glyph_usage)
 	{
-		unsigned short cid_encoding_id;
-		uint32_t font_descriptor_flags = 0;
-		double font_bbox[4];
-		double italic_angle;
-		double ascent;
-		double descent;
-		double leading;
-		double cap_height;
-		double x_height;
-		double stem_v;
-		double avg_width;
-		std::map<wchar_t, uint16_t> cid_map;
-		std::vector<std::string> charset;
-		std::vector<uint16_t> advance_width;
-		unsigned int cff_offset;
-		unsigned int cff_length;
+		// The whole font is embedded if no glyph usage is given, or
+		// the font cannot be subset
+		const std::vector<unsigned char> font_data_subset =
+			glyph_usage.empty() ? std::vector<unsigned char>() :
+			subset_otf(font_data_full, glyph_usage);
+		const font_blob_t font_data =
+			font_data_subset.empty() ? font_data_full :
+			font_data_subset;
+		parsed_font_t font_subset;
+
+		if (!font_data_subset.empty()) {
+			parse_font(font_subset, font_data,
+					   &font_data_full.parsed_font());
+		}
 
+		const parsed_font_t &font = font_data_subset.empty() ?
+			font_data_full.parsed_font() : font_subset;
 		std::map<std::string, std::string> pdf_object;
 
-		if (!(type == 0 ?
-			  parse_otf_cff_header(
-				font_name, cid_encoding_id, font_descriptor_flags,
-				font_bbox, italic_angle, ascent, descent, leading,
-				cap_height, x_height, stem_v, avg_width, cid_map,
-				charset, advance_width, cff_offset, cff_length,
-				font_data) :
-			  parse_ttf_header(
-				font_name, cid_encoding_id, font_descriptor_flags,
-				font_bbox, italic_angle, ascent, descent, leading,
-				cap_height, x_height, stem_v, avg_width, cid_map,
-				charset, advance_width, font_data))) {
+		if (!(font._valid && font._cff == (type == 0))) {
 			return pdf_object;
 		}
+		font_name = font._font_name;
+
+		const uint32_t font_descriptor_flags =
+			font._font_descriptor_flags;
+		const double *font_bbox = font._font_bbox;
+		const double italic_angle = font._italic_angle;
+		const double ascent = font._ascent;
+		const double descent = font._descent;
+		const double leading = font._leading;
+		const double cap_height = font._cap_height;
+		const double x_height = font._x_height;
+		const double stem_v = font._stem_v;
+		const double avg_width = font._avg_width;
+		cid_map_t cid_map = font._cid_map;
+		std::vector<uint16_t> advance_width = font._advance_width;
+		const unsigned int cff_offset = font._cff_offset;
+		const unsigned int cff_length = font._cff_length;
+
+		if (!font_data_subset.empty()) {
+			// Restrict the CMap to the used characters, and repeat
+			// widths over the unused glyphs so that /W collapses
+			// into ranges
+			cid_map_t subset_cid_map;
+			std::vector<bool> subset_glyph(advance_width.size(), false);
+
+			for (std::map<wchar_t, bool>::const_iterator iterator =
+					 glyph_usage.begin();
+				 iterator != glyph_usage.end(); iterator++) {
+				if (!iterator->second) {
+					continue;
+				}
+
+				const uint16_t glyph = cid_map.find(iterator->first);
+
+				if (glyph != 0 && glyph < advance_width.size()) {
+					subset_cid_map.insert(iterator->first, glyph);
+					subset_glyph[glyph] = true;
+				}
+			}
+			if (!subset_cid_map.empty()) {
+				cid_map = subset_cid_map;
+
+				size_t last_glyph = 0;
+
+				for (size_t i = 1; i < advance_width.size(); i++) {
+					if (subset_glyph[i]) {
+						last_glyph = i;
+					}
+					else {
+						advance_width[i] = advance_width[i - 1];
+					}
+				}
+				advance_width.resize(last_glyph + 1);
+			}
+		}
 
 		// Layout of a embedded CID Type 0/2 font
 		//
@@ -216,37 +261,7 @@ namespace mathtext {
 			*std::max_element(advance_width.begin(),
 							  advance_width.end());
 
-		std::string font_file32 =
-			"<<\n";
-
-		if (type == 0) {
-			font_file32 += "/Subtype /CIDFontType0C\n";
-		}
-
 		char buffer[4096];
-
-		snprintf(buffer, 4096,
-				 "/Length %u\n"
-				 ">>\n"
-				 "stream\n",
-				 type == 0 ? cff_length :
-				 static_cast<unsigned int>(font_data.size()));
-		font_file32 += buffer;
-
-		if (type == 0) {
-			font_file32.insert(
-				font_file32.end(), font_data.begin() + cff_offset,
-				font_data.begin() + cff_offset + cff_length);
-		}
-		else {
-			font_file32.insert(
-				font_file32.end(), font_data.begin(),
-				font_data.end());
-		}
-		font_file32 += "\nendstream\n";
-
-		pdf_object["/FontFile32"] = font_file32;
-
 		std::string font_descriptor =
 			"<<\n"
 			"/Type /FontDescriptor\n";
@@ -351,8 +366,7 @@ namespace mathtext {
 		std::vector<struct cid_range_s> cid_range;
 
 		{
-			std::map<wchar_t, uint16_t>::const_iterator iterator =
-				cid_map.begin();
+			cid_map_t::const_iterator iterator = cid_map.begin();
 			const struct cid_range_s r0 = {
 				static_cast<uint32_t>(iterator->first),
 				static_cast<uint32_t>(iterator->first),
@@ -419,7 +433,7 @@ namespace mathtext {
 
 				const unsigned int chunk =
 					std::min(100U, static_cast<unsigned int>
-							 (cid_char.end() - iterator) / 2);
+							 (cid_char.end() - iterator));
 
 				snprintf(buffer, 4096, "%u begincidchar\n",
 						 chunk);
@@ -447,7 +461,7 @@ namespace mathtext {
 
 				const unsigned int chunk =
 					std::min(100U, static_cast<unsigned int>
-							 (cid_range.end() - iterator) / 3);
+							 (cid_range.end() - iterator));
 
 				snprintf(buffer, 4096, "%u begincidrange\n",
 						 chunk);
@@ -512,23 +526,97 @@ namespace mathtext {
 			"/DescendantFonts [%u %u R]\n"
 			">>\n";
 
+		// The font program is written last, when the font is known
+		// to be embeddable
+
+		if (type == 0) {
+			font_file.write(&font_data[cff_offset], cff_length);
+		}
+		else {
+			font_file.write(font_data.data(), font_data.size());
+		}
+
 		return pdf_object;
 	}
 
+	std::string font_embed_pdf_t::font_file_object(
+		const std::string &font_file, unsigned int type)
+	{
+		std::string font_file32 =
+			"<<\n";
+
+		if (type == 0) {
+			font_file32 += "/Subtype /CIDFontType0C\n";
+		}
+
+		char buffer[4096];
+
+		snprintf(buffer, 4096,
+				 "/Length %u\n"
+				 ">>\n"
+				 "stream\n",
+				 static_cast<unsigned int>(font_file.size()));
+		font_file32 += buffer;
+		font_file32 += font_file;
+		font_file32 += "\nendstream\n";
+
+		return font_file32;
+	}
+
+	std::map<std::string, std::string>
+	font_embed_pdf_t::font_embed_type_2(
+		font_sink_t &font_file, std::string &font_name,
+		const font_blob_t &font_data,
+		const std::map<wchar_t, bool> &glyph_usage)
+	{
+		return font_embed_cid(font_file, font_name, font_data, 0,
+							  glyph_usage);
+	}
+
+	std::map<std::string, std::string>
+	font_embed_pdf_t::font_embed_type_42(
+		font_sink_t &font_file, std::string &font_name,
+		const font_blob_t &font_data,
+		const std::map<wchar_t, bool> &glyph_usage)
+	{
+		return font_embed_cid(font_file, font_name, font_data, 2,
+							  glyph_usage);
+	}
+
 	std::map<std::string, std::string>
 	font_embed_pdf_t::font_embed_type_2(
 		std::string &font_name,
-		const std::vector<unsigned char> &font_data)
+		const font_blob_t &font_data,
+		const std::map<wchar_t, bool> &glyph_usage)
 	{
-		return font_embed_cid(font_name, font_data, 0);
+		std::string font_file;
+		string_sink_t sink(font_file);
+		std::map<std::string, std::string> pdf_object =
+			font_embed_cid(sink, font_name, font_data, 0, glyph_usage);
+
+		if (!pdf_object.empty()) {
+			pdf_object["/FontFile32"] = font_file_object(font_file, 0);
+		}
+
+		return pdf_object;
 	}
 
 	std::map<std::string, std::string>
 	font_embed_pdf_t::font_embed_type_42(
 		std::string &font_name,
-		const std::vector<unsigned char> &font_data)
+		const font_blob_t &font_data,
+		const std::map<wchar_t, bool> &glyph_usage)
 	{
-		return font_embed_cid(font_name, font_data, 2);
+		std::string font_file;
+		string_sink_t sink(font_file);
+		std::map<std::string, std::string> pdf_object =
+			font_embed_cid(sink, font_name, font_data, 2, glyph_usage);
+
+		if (!pdf_object.empty()) {
+			pdf_object["/FontFile32"] = font_file_object(font_file, 2);
+		}
+
+		return pdf_object;
 	}
 
 }
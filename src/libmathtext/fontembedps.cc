@@ -44,26 +44,40 @@
 namespace mathtext {
 
 
+   namespace {
+
+      // Counts the line breaks written to it
+      class line_count_sink_t : public font_sink_t {
+      private:
+         unsigned int _line;
+      public:
+         line_count_sink_t(void)
+         : _line(0)
+         {
+         }
+         virtual void write(const uint8_t *buffer, const size_t length)
+         {
+            _line += std::count(buffer, buffer + length, '\n');
+         }
+         inline unsigned int line(void) const
+         {
+            return _line;
+         }
+      };
+
+   }
+
+
 ////////////////////////////////////////////////////////////////////////////////
 
    void font_embed_postscript_t::append_asciihex(
                                                  std::string &ascii, const unsigned char *buffer,
                                                  const size_t length)
    {
-      const int width = 64;
-      int column = 0;
-
-      for(size_t i = 0; i < length; i++) {
-         char str[3];
-
-         snprintf(str, 3, "%02hhX", buffer[i]);
-         ascii.append(str, 2);
-         column += 2;
-         if(column >= width) {
-            ascii.append(1, '\n');
-            column = 0;
-         }
-      }
+      string_sink_t sink(ascii);
+      asciihex_sink_t asciihex(sink);
+
+      asciihex.write(buffer, length);
    }
 
 
@@ -72,38 +86,13 @@ namespace mathtext {
    unsigned int font_embed_postscript_t::ascii85_line_count(
                                                             const uint8_t *buffer, const size_t length)
    {
-      const unsigned int width = 64;
-      unsigned int column = 0;
-      unsigned int line = 0;
-
-      if (length >= 4) {
-         for (size_t i = 0; i < length - 3; i += 4) {
-            unsigned int b = reinterpret_cast<
-            const unsigned int *>(buffer)[i >> 2];
-
-            if (b == 0) {
-               column++;
-               if (column == width - 1) {
-                  line++;
-                  column = 0;
-               }
-            }
-            else {
-               if (column + 5 >= width) {
-                  column += 5 - width;
-                  line++;
-               }
-               else {
-                  column += 5;
-               }
-            }
-         }
-      }
-      if (column + (length & 3) + 3 >= width) {
-         line++;
-      }
+      line_count_sink_t sink;
+      ascii85_sink_t ascii85(sink);
+
+      ascii85.write(buffer, length);
+      ascii85.finish();
 
-      return line;
+      return sink.line();
    }
 
 
@@ -113,93 +102,20 @@ namespace mathtext {
                                                 std::string &ascii, const uint8_t *buffer,
                                                 const size_t length)
    {
-      const int width = 64;
-      int column = 0;
-
-      if (length >= 4) {
-         for (size_t i = 0; i < length - 3; i += 4) {
-            unsigned int dword = reinterpret_cast<
-            const unsigned int *>(buffer)[i >> 2];
-
-            if (dword == 0) {
-               ascii.append(1, 'z');
-               column++;
-               if (column == width - 1) {
-                  ascii.append(1, '\n');
-                  column = 0;
-               }
-            }
-            else {
-#ifdef LITTLE_ENDIAN
-               dword = bswap_32(dword);
-#endif // LITTLE_ENDIAN
-
-               char str[5];
-
-               str[4] = static_cast<char>(dword % 85 + '!');
-               dword /= 85;
-               str[3] = static_cast<char>(dword % 85 + '!');
-               dword /= 85;
-               str[2] = static_cast<char>(dword % 85 + '!');
-               dword /= 85;
-               str[1] = static_cast<char>(dword % 85 + '!');
-               dword /= 85;
-               str[0] = static_cast<char>(dword % 85 + '!');
-               for (size_t j = 0; j < 5; j++) {
-                  ascii.append(1, str[j]);
-                  column++;
-                  if(column == width) {
-                     ascii.append(1, '\n');
-                     column = 0;
-                  }
-               }
-            }
-         }
-      }
-
-      int k = length & 3;
-
-      if(k > 0) {
-         unsigned int dword = 0;
-
-         memcpy(&dword, buffer + (length & ~3), k);
-#ifdef LITTLE_ENDIAN
-         dword = bswap_32(dword);
-#endif // LITTLE_ENDIAN
-
-         char str[5];
-
-         str[4] = static_cast<char>(dword % 85 + '!');
-         dword /= 85;
-         str[3] = static_cast<char>(dword % 85 + '!');
-         dword /= 85;
-         str[2] = static_cast<char>(dword % 85 + '!');
-         dword /= 85;
-         str[1] = static_cast<char>(dword % 85 + '!');
-         dword /= 85;
-         str[0] = static_cast<char>(dword % 85 + '!');
-         for(int j = 0; j < k + 1; j++) {
-            ascii.append(1, str[j]);
-            column++;
-            if(column == width) {
-               ascii.append(1, '\n');
-               column = 0;
-            }
-         }
+      string_sink_t sink(ascii);
+      ascii85_sink_t ascii85(sink);
 
-      }
-      if(column > width - 2)
-         ascii.append(1, '\n');
-      ascii.append("~>");
+      ascii85.write(buffer, length);
+      ascii85.finish();
    }
 
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Embed font type 1
 
-   std::string font_embed_postscript_t::font_embed_type_1(
-                                                          std::string &font_name,
-                                                          const std::vector<unsigned char> &font_data)
+   bool font_embed_postscript_t::font_embed_type_1(
+                                                   font_sink_t &sink, std::string &font_name,
+                                                   const font_blob_t &font_data)
    {
       struct pfb_segment_header_s {
          char always_128;
@@ -212,8 +128,11 @@ namespace mathtext {
          TYPE_EOF
       };
 
+      if (font_data.size() < 2) {
+         return false;
+      }
+
       char magic_number[2];
-      std::string ret;
 
       memcpy(magic_number, &font_data[0], 2);
       if(magic_number[0] == '\200') {
@@ -237,15 +156,16 @@ namespace mathtext {
             segment_header.length =
             bswap_32(segment_header.length);
 #endif // LITTLE_ENDIAN
-            char *buffer = new char[segment_header.length];
-            char *fname;
-
-            memcpy(buffer, &font_data[offset],
-                   segment_header.length);
-            offset += segment_header.length;
 
             switch(segment_header.type) {
                case TYPE_ASCII:
+               {
+                  // Only the ASCII segments are copied, for the CR
+                  // -> LF conversion
+                  std::vector<char> buffer(
+                     font_data.begin() + offset,
+                     font_data.begin() + offset + segment_header.length);
+
                   // Simple CR -> LF conversion
                   for (int i = 0;
                        i < (int)(segment_header.length) - 1; i++) {
@@ -257,53 +177,59 @@ namespace mathtext {
                   if (buffer[segment_header.length - 1] == '\r') {
                      buffer[segment_header.length - 1] = '\n';
                   }
-                  ret.append(buffer, segment_header.length);
+                  sink.write(reinterpret_cast<uint8_t *>(&buffer[0]),
+                             segment_header.length);
+
+                  char *fname = (char*)memmem(&buffer[0],
+                                              segment_header.length,
+                                              "/FontName", 9);
+                  char *const buffer_end =
+                  &buffer[0] + segment_header.length;
 
-                  fname = (char*)memmem(buffer, segment_header.length,
-                                        "/FontName", 9);
                   if (fname) {
                      fname += 9;
-                     while (fname < buffer + segment_header.length &&
-                            isspace(*fname)) {
+                     while (fname < buffer_end && isspace(*fname)) {
                         fname++;
                      }
-                     if (fname < buffer + segment_header.length &&
-                         *fname == '/') {
+                     if (fname < buffer_end && *fname == '/') {
                         fname++;
                      }
                      int len = 0;
-                     while (fname + len < buffer + segment_header.length &&
+                     while (fname + len < buffer_end &&
                             isgraph(*(fname + len))) {
                         len++;
                      }
                      font_name.assign(fname, len);
                   }
+               }
                   break;
                case TYPE_BINARY:
-                  append_asciihex(
-                                  ret, reinterpret_cast<uint8_t *>(buffer),
-                                  segment_header.length);
+               {
+                  asciihex_sink_t asciihex(sink);
+
+                  asciihex.write(&font_data[offset],
+                                 segment_header.length);
+               }
                   break;
                default:
                {}
             }
-
-            delete [] buffer;
+            offset += segment_header.length;
 
             segment_header.always_128 = font_data[offset];
             segment_header.type = font_data[offset + 1];
          }
 
-         return ret;
+         return true;
       }
       else if(strncmp(magic_number, "%!", 2) == 0) {
          // Printer font ASCII
          fprintf(stderr, "%s:%d: Printer font ASCII is not "
                  "implemented\n", __FILE__, __LINE__);
-         return std::string();
+         return false;
       }
 
-      return std::string();
+      return false;
    }
 
 
@@ -311,104 +237,136 @@ namespace mathtext {
 /// Embed an OpenType CFF font (Type 2) file in ASCII85 encoding
 /// with the PostScript syntax
 
-   std::string font_embed_postscript_t::font_embed_type_2(
-                                                          std::string &font_name,
-                                                          const std::vector<unsigned char> &font_data)
+   bool font_embed_postscript_t::font_embed_type_2(
+                                                   font_sink_t &sink, std::string &font_name,
+                                                   const font_blob_t &font_data_full,
+                                                   const std::map<wchar_t, bool> &glyph_usage)
    {
-      unsigned short cid_encoding_id;
-      unsigned int cff_offset;
-      unsigned int cff_length;
-
-      if (!parse_otf_cff_header(font_name, cid_encoding_id,
-                                cff_offset, cff_length,
-                                font_data)) {
-         return std::string();
+      // The whole font is embedded if no glyph usage is given, or the
+      // font cannot be subset
+      const std::vector<unsigned char> font_data_subset =
+      glyph_usage.empty() ? std::vector<unsigned char>() :
+      subset_otf(font_data_full, glyph_usage);
+      const font_blob_t font_data =
+      font_data_subset.empty() ? font_data_full : font_data_subset;
+      parsed_font_t font_subset;
+
+      if (!font_data_subset.empty()) {
+         parse_font(font_subset, font_data,
+                    &font_data_full.parsed_font());
+      }
+
+      const parsed_font_t &font = font_data_subset.empty() ?
+      font_data_full.parsed_font() : font_subset;
+
+      if (!(font._valid && font._cff)) {
+         return false;
       }
+      font_name = font._font_name;
 
-      std::vector<unsigned char> cff;
+      // The CFF is read by the FontSetInit procedure set from the
+      // current file, and therefore preceded by StartData
+      static const char start_data[] = "StartData\r";
+      const uint8_t *cff = &font_data[font._cff_offset];
+      const unsigned int cff_length = font._cff_length;
 
-      cff.resize(cff_length + 10);
-      memcpy(&cff[0], "StartData\r", 10);
-      memcpy(&cff[10], &font_data[cff_offset], cff_length);
+      // The DSC line count requires a first pass over the encoding,
+      // which is cheaper than holding the encoded font in memory
+      line_count_sink_t line_count;
 
-      char linebuf[BUFSIZ];
-      std::string ret;
+      {
+         ascii85_sink_t ascii85(line_count);
 
-      snprintf(linebuf, BUFSIZ, "%%%%BeginResource: FontSet (%s)\n",
-               font_name.c_str());
-      ret.append(linebuf);
-      ret.append("%%VMusage: 0 0\n");
-      ret.append("/FontSetInit /ProcSet findresource begin\n");
-      snprintf(linebuf, BUFSIZ, "%%%%BeginData: %u ASCII Lines\n",
-               ascii85_line_count(&cff[0], cff_length) + 2);
-      ret.append(linebuf);
-      snprintf(linebuf, BUFSIZ,
-               "/%s %u currentfile /ASCII85Decode filter cvx exec\n",
-               font_name.c_str(), cff_length);
-      ret.append(linebuf);
-      append_ascii85(ret, &cff[0], cff_length + 10);
-      ret.append(1, '\n');
-      ret.append("%%EndData\n");
-      ret.append("%%EndResource\n");
+         ascii85.put(start_data);
+         ascii85.write(cff, cff_length);
+         ascii85.finish();
+      }
 
-      return ret;
+      sink.printf("%%%%BeginResource: FontSet (%s)\n",
+                  font_name.c_str());
+      sink.put("%%VMusage: 0 0\n");
+      sink.put("/FontSetInit /ProcSet findresource begin\n");
+      // The line with the filter, and the last line of the encoding
+      // that is not terminated by a line break
+      sink.printf("%%%%BeginData: %u ASCII Lines\n",
+                  line_count.line() + 2);
+      sink.printf("/%s %u currentfile /ASCII85Decode filter cvx exec\n",
+                  font_name.c_str(), cff_length);
+
+      ascii85_sink_t ascii85(sink);
+
+      ascii85.put(start_data);
+      ascii85.write(cff, cff_length);
+      ascii85.finish();
+      sink.put("\n");
+      sink.put("%%EndData\n");
+      sink.put("%%EndResource\n");
+
+      return true;
    }
 
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Embed a TrueType font as Type 42 with the PostScript syntax
 
-   std::string font_embed_postscript_t::font_embed_type_42(
-                                                           std::string &font_name,
-                                                           const std::vector<unsigned char> &font_data)
+   bool font_embed_postscript_t::font_embed_type_42(
+                                                    font_sink_t &sink, std::string &font_name,
+                                                    const font_blob_t &font_data_full,
+                                                    const std::map<wchar_t, bool> &glyph_usage)
    {
-      double font_bbox[4];
-      std::map<wchar_t, uint16_t> cid_map;
-      std::vector<std::string> char_strings;
-
-      if (!parse_ttf_header(font_name, font_bbox, cid_map,
-                            char_strings, font_data)) {
-         fprintf(stderr, "%s:%d:\n", __FILE__, __LINE__);
-         return std::string();
+      const std::vector<unsigned char> font_data_subset =
+      glyph_usage.empty() ? std::vector<unsigned char>() :
+      subset_otf(font_data_full, glyph_usage);
+      const font_blob_t font_data =
+      font_data_subset.empty() ? font_data_full : font_data_subset;
+      parsed_font_t font_subset;
+
+      if (!font_data_subset.empty()) {
+         parse_font(font_subset, font_data,
+                    &font_data_full.parsed_font());
       }
 
-      char linebuf[BUFSIZ];
-      std::string ret;
+      const parsed_font_t &font = font_data_subset.empty() ?
+      font_data_full.parsed_font() : font_subset;
 
-      snprintf(linebuf, BUFSIZ, "%%%%BeginResource: FontSet (%s)\n",
-               font_name.c_str());
-      ret.append(linebuf);
-      ret.append("%%VMusage: 0 0\n");
-      ret.append("11 dict begin\n");
-      snprintf(linebuf, BUFSIZ, "/FontName /%s def\n",
-               font_name.c_str());
-      ret.append(linebuf);
-      ret.append("/Encoding 256 array\n");
-      snprintf(linebuf, BUFSIZ,
-               "0 1 255 { 1 index exch /%s put } for\n",
-               char_strings[0].c_str());
-      ret.append(linebuf);
+      if (!(font._valid && !font._cff) || font._charset.empty()) {
+         fprintf(stderr, "%s:%d:\n", __FILE__, __LINE__);
+         return false;
+      }
+      font_name = font._font_name;
+
+      const double *font_bbox = font._font_bbox;
+      const cid_map_t &cid_map = font._cid_map;
+      const std::vector<std::string> &char_strings = font._charset;
+
+      sink.printf("%%%%BeginResource: FontSet (%s)\n",
+                  font_name.c_str());
+      sink.put("%%VMusage: 0 0\n");
+      sink.put("11 dict begin\n");
+      sink.printf("/FontName /%s def\n", font_name.c_str());
+      sink.put("/Encoding 256 array\n");
+      sink.printf("0 1 255 { 1 index exch /%s put } for\n",
+                  char_strings[0].c_str());
       for (unsigned int code_point = 0; code_point < 256;
            code_point++) {
-         unsigned int glyph_index = cid_map[code_point];
+         const unsigned int glyph_index = cid_map.find(code_point);
 
-         if (char_strings[glyph_index] != ".notdef" &&
+         // A subset font has no glyphs after the last used one
+         if (glyph_index < char_strings.size() &&
+             char_strings[glyph_index] != ".notdef" &&
              char_strings[glyph_index] != "") {
-            snprintf(linebuf, BUFSIZ, "dup %u /%s put\n",
-                     code_point,
-                     char_strings[glyph_index].c_str());
-            ret.append(linebuf);
+            sink.printf("dup %u /%s put\n", code_point,
+                        char_strings[glyph_index].c_str());
          }
       }
-      ret.append("readonly def\n");
-      ret.append("/PaintType 0 def\n");   // 0 for filled, 2 for stroked
-      ret.append("/FontMatrix [1 0 0 1 0 0] def\n");
-      snprintf(linebuf, BUFSIZ, "/FontBBox [%f %f %f %f] def\n",
-               font_bbox[0], font_bbox[1], font_bbox[2], font_bbox[3]);
-      ret.append(linebuf);
-      ret.append("/FontType 42 def\n");
+      sink.put("readonly def\n");
+      sink.put("/PaintType 0 def\n");   // 0 for filled, 2 for stroked
+      sink.put("/FontMatrix [1 0 0 1 0 0] def\n");
+      sink.printf("/FontBBox [%f %f %f %f] def\n",
+                  font_bbox[0], font_bbox[1], font_bbox[2], font_bbox[3]);
+      sink.put("/FontType 42 def\n");
       // FIXME: XUID generation using the font data's MD5
-      ret.append("/sfnts [\n");
+      sink.put("/sfnts [\n");
 
       const size_t block_size = 32262;
       size_t offset = 0;
@@ -416,13 +374,14 @@ namespace mathtext {
       while (offset < font_data.size()) {
          const size_t output_length =
          std::min(block_size, font_data.size() - offset);
+         asciihex_sink_t asciihex(sink);
 
-         ret.append("<\n");
-         append_asciihex(ret, &font_data[offset], output_length);
-         ret.append(">\n");
+         sink.put("<\n");
+         asciihex.write(&font_data[offset], output_length);
+         sink.put(">\n");
          offset += output_length;
       }
-      ret.append("] def\n");
+      sink.put("] def\n");
 
       unsigned int char_strings_count = 0;
 
@@ -434,21 +393,60 @@ namespace mathtext {
          }
       }
 
-      snprintf(linebuf, BUFSIZ, "/CharStrings %u dict dup begin\n",
-               char_strings_count);
-      ret.append(linebuf);
+      sink.printf("/CharStrings %u dict dup begin\n",
+                  char_strings_count);
       for (unsigned int glyph_index = 0;
            glyph_index < char_strings.size(); glyph_index++) {
          if (!char_strings[glyph_index].empty()) {
-            snprintf(linebuf, BUFSIZ, "/%s %u def\n",
-                     char_strings[glyph_index].c_str(),
-                     glyph_index);
-            ret.append(linebuf);
+            sink.printf("/%s %u def\n",
+                        char_strings[glyph_index].c_str(),
+                        glyph_index);
          }
       }
-      ret.append("end readonly def\n");
-      ret.append("FontName currentdict end definefont pop\n");
-      ret.append("%%EndResource\n");
+      sink.put("end readonly def\n");
+      sink.put("FontName currentdict end definefont pop\n");
+      sink.put("%%EndResource\n");
+
+      return true;
+   }
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+   std::string font_embed_postscript_t::font_embed_type_1(
+                                                          std::string &font_name,
+                                                          const font_blob_t &font_data)
+   {
+      std::string ret;
+      string_sink_t sink(ret);
+
+      font_embed_type_1(sink, font_name, font_data);
+
+      return ret;
+   }
+
+   std::string font_embed_postscript_t::font_embed_type_2(
+                                                          std::string &font_name,
+                                                          const font_blob_t &font_data,
+                                                          const std::map<wchar_t, bool> &glyph_usage)
+   {
+      std::string ret;
+      string_sink_t sink(ret);
+
+      font_embed_type_2(sink, font_name, font_data, glyph_usage);
+
+      return ret;
+   }
+
+   std::string font_embed_postscript_t::font_embed_type_42(
+                                                           std::string &font_name,
+                                                           const font_blob_t &font_data,
+                                                           const std::map<wchar_t, bool> &glyph_usage)
+   {
+      std::string ret;
+      string_sink_t sink(ret);
+
+      font_embed_type_42(sink, font_name, font_data, glyph_usage);
 
       return ret;
    }
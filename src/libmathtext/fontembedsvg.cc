@@ -0,0 +1,202 @@
+// mathtext - A TeX/LaTeX compatible rendering library. Copyright (C)
+// 2008-2016 Yue Shi Lai <ylai@users.sourceforge.net>
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2.1 of
+// the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// 02110-1301 USA
+
+#include <mathtext/fontembed.h>
+#include <set>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+// References:
+//
+// World Wide Web Consortium, Scalable Vector Graphics (SVG) 1.1
+// specification (W3C, 2011), 2nd edition, sections 5.6 and 8.3.
+//
+// World Wide Web Consortium, Namespaces in XML 1.0 (W3C, 2009), 3rd
+// edition, section 3 (NCName).
+
+namespace mathtext {
+
+	namespace {
+
+		// Coordinates are in 1/1000 em, and a tenth of that is well
+		// below what can be resolved at any practical font size
+		void append_coordinate(std::string &path_data, const float x)
+		{
+			const long tenth = static_cast<long>(floor(x * 10.0 + 0.5));
+			char buffer[24];
+
+			if (tenth % 10 == 0) {
+				snprintf(buffer, 24, "%ld", tenth / 10);
+			}
+			else {
+				snprintf(buffer, 24, "%s%ld.%ld", tenth < 0 ? "-" : "",
+						 labs(tenth) / 10, labs(tenth) % 10);
+			}
+			// A minus sign separates numbers by itself
+			if (!path_data.empty() && buffer[0] != '-') {
+				const char last = path_data[path_data.size() - 1];
+
+				if (last >= '0' && last <= '9') {
+					path_data.append(1, ' ');
+				}
+			}
+			path_data.append(buffer);
+		}
+
+	}
+
+	void font_embed_svg_t::append_path_data(
+		std::string &path_data, const glyph_outline_t &outline)
+	{
+		static const char command[glyph_outline_t::NOPERATOR] = {
+			'M', 'L', 'Q', 'C', 'Z'
+		};
+		std::vector<float>::const_iterator point =
+			outline._point.begin();
+
+		for (std::vector<uint8_t>::const_iterator iterator =
+				 outline._operator.begin();
+			 iterator != outline._operator.end(); iterator++) {
+			if (*iterator >= glyph_outline_t::NOPERATOR) {
+				break;
+			}
+			path_data.append(1, command[*iterator]);
+
+			const unsigned int n = 2 * glyph_outline_t::npoint(*iterator);
+
+			for (unsigned int i = 0; i < n; i++) {
+				append_coordinate(path_data, *point);
+				point++;
+			}
+		}
+	}
+
+	std::string font_embed_svg_t::glyph_id(const std::string &font_name,
+										   const uint16_t glyph)
+	{
+		// PostScript names may contain characters not allowed in an
+		// XML NCName, or begin with a digit
+		std::string id;
+
+		if (font_name.empty() ||
+			!((font_name[0] >= 'A' && font_name[0] <= 'Z') ||
+			  (font_name[0] >= 'a' && font_name[0] <= 'z'))) {
+			id.append(1, '_');
+		}
+		for (std::string::const_iterator iterator = font_name.begin();
+			 iterator != font_name.end(); iterator++) {
+			const char c = *iterator;
+
+			if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') ||
+				(c >= '0' && c <= '9') || c == '-' || c == '.') {
+				id.append(1, c);
+			}
+			else {
+				id.append(1, '_');
+			}
+		}
+
+		char buffer[8];
+
+		snprintf(buffer, 8, "-%u", glyph);
+		id.append(buffer);
+
+		return id;
+	}
+
+	void font_embed_svg_t::append_glyph(std::string &svg,
+										const std::string &font_name,
+										const uint16_t glyph,
+										const glyph_outline_t &outline)
+	{
+		if (outline.empty()) {
+			return;
+		}
+		svg.append("<path id=\"");
+		svg.append(glyph_id(font_name, glyph));
+		svg.append("\" d=\"");
+		append_path_data(svg, outline);
+		svg.append("\"/>\n");
+	}
+
+	bool font_embed_svg_t::font_embed_svg(
+		font_sink_t &sink, std::string &font_name,
+		const font_blob_t &font_data,
+		const std::map<wchar_t, bool> &glyph_usage)
+	{
+		const parsed_font_t &font = font_data.parsed_font();
+		const font_outline_t font_outline(font_data);
+
+		if (!(font._valid && font_outline.valid())) {
+			return false;
+		}
+		font_name = font._font_name;
+
+		std::set<uint16_t> glyph;
+
+		if (glyph_usage.empty()) {
+			for (cid_map_t::const_iterator iterator =
+					 font._cid_map.begin();
+				 iterator != font._cid_map.end(); iterator++) {
+				glyph.insert(iterator->second);
+			}
+		}
+		else {
+			for (std::map<wchar_t, bool>::const_iterator iterator =
+					 glyph_usage.begin();
+				 iterator != glyph_usage.end(); iterator++) {
+				const uint16_t g = font._cid_map.find(iterator->first);
+
+				if (g != 0) {
+					glyph.insert(g);
+				}
+			}
+		}
+
+		glyph_outline_t outline;
+		std::string svg;
+
+		sink.put("<defs>\n");
+		for (std::set<uint16_t>::const_iterator iterator =
+				 glyph.begin();
+			 iterator != glyph.end(); iterator++) {
+			if (font_outline.glyph_outline(outline, *iterator)) {
+				svg.clear();
+				append_glyph(svg, font_name, *iterator, outline);
+				sink.put(svg);
+			}
+		}
+		sink.put("</defs>\n");
+
+		return true;
+	}
+
+	std::string font_embed_svg_t::font_embed_svg(
+		std::string &font_name, const font_blob_t &font_data,
+		const std::map<wchar_t, bool> &glyph_usage)
+	{
+		std::string ret;
+		string_sink_t sink(ret);
+
+		font_embed_svg(sink, font_name, font_data, glyph_usage);
+
+		return ret;
+	}
+
+}
@@ -0,0 +1,1835 @@
+// mathtext - A TeX/LaTeX compatible rendering library. Copyright (C)
+// 2008-2016 Yue Shi Lai <ylai@users.sourceforge.net>
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2.1 of
+// the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// 02110-1301 USA
+
+#include <mathtext/fontembed.h>
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+
+// References:
+//
+// Adobe Systems, Inc., The Compact Font Format specification
+// (Adobe Systems, Inc., San Jose, CA, 2003), technical note #5176,
+// version 1.0.
+//
+// Adobe Systems, Inc., The Type 2 charstring format (Adobe Systems,
+// Inc., San Jose, CA, 2000), technical note #5177.
+//
+// Apple Computer, Inc., TrueType reference ranual (2002)
+
+#define ERROR_ACCESS(t) \
+	(fprintf(stderr, "%s:%d: error: access out of bound in %s\n", \
+			 __FILE__, __LINE__, t));
+
+namespace mathtext {
+
+	namespace {
+
+		inline uint16_t get_uint16(const font_blob_t &data,
+								   const size_t offset)
+		{
+			return (data[offset] << 8) | data[offset + 1];
+		}
+
+		inline uint32_t get_uint32(const font_blob_t &data,
+								   const size_t offset)
+		{
+			return (static_cast<uint32_t>(data[offset]) << 24) |
+				(data[offset + 1] << 16) | (data[offset + 2] << 8) |
+				data[offset + 3];
+		}
+
+		// Type 2 charstring format, appendix B
+		const unsigned int charstring_stack_limit = 48;
+		const unsigned int charstring_transient_size = 32;
+		const unsigned int charstring_subr_nesting_limit = 10;
+
+		// Composite glyphs nest only a few levels in practice
+		const unsigned int ttf_component_nesting_limit = 8;
+
+		// Composite glyph flags
+		const uint16_t arg_1_and_2_are_words = 0x0001;
+		const uint16_t args_are_xy_values = 0x0002;
+		const uint16_t we_have_a_scale = 0x0008;
+		const uint16_t more_components = 0x0020;
+		const uint16_t we_have_an_x_and_y_scale = 0x0040;
+		const uint16_t we_have_a_two_by_two = 0x0080;
+		const uint16_t use_my_metrics = 0x0200;
+
+		inline uint32_t ttf_component_size(const uint16_t flags)
+		{
+			return 4 + (flags & arg_1_and_2_are_words ? 4 : 2) +
+				(flags & we_have_a_scale ? 2 :
+				 flags & we_have_an_x_and_y_scale ? 4 :
+				 flags & we_have_a_two_by_two ? 8 : 0);
+		}
+
+		inline int32_t subr_bias(const uint32_t nsubr)
+		{
+			return nsubr < 1240 ? 107 : nsubr < 33900 ? 1131 : 32768;
+		}
+
+	}
+
+	unsigned int glyph_outline_t::npoint(const uint8_t op)
+	{
+		static const unsigned int npoint_operator[NOPERATOR] = {
+			1, 1, 2, 3, 0
+		};
+
+		return op < NOPERATOR ? npoint_operator[op] : 0;
+	}
+
+	void glyph_outline_t::move_to(const float x, const float y)
+	{
+		close_path();
+		_operator.push_back(MOVE_TO);
+		_point.push_back(x);
+		_point.push_back(y);
+	}
+
+	void glyph_outline_t::line_to(const float x, const float y)
+	{
+		_operator.push_back(LINE_TO);
+		_point.push_back(x);
+		_point.push_back(y);
+	}
+
+	void glyph_outline_t::quadratic_to(const float x1, const float y1,
+									   const float x, const float y)
+	{
+		_operator.push_back(QUADRATIC_TO);
+		_point.push_back(x1);
+		_point.push_back(y1);
+		_point.push_back(x);
+		_point.push_back(y);
+	}
+
+	void glyph_outline_t::cubic_to(const float x1, const float y1,
+								   const float x2, const float y2,
+								   const float x, const float y)
+	{
+		_operator.push_back(CUBIC_TO);
+		_point.push_back(x1);
+		_point.push_back(y1);
+		_point.push_back(x2);
+		_point.push_back(y2);
+		_point.push_back(x);
+		_point.push_back(y);
+	}
+
+	void glyph_outline_t::close_path(void)
+	{
+		if (!_operator.empty() && _operator.back() != CLOSE_PATH) {
+			_operator.push_back(CLOSE_PATH);
+		}
+	}
+
+	void glyph_outline_t::append(const glyph_outline_t &outline,
+								 const float matrix[6])
+	{
+		close_path();
+		_operator.insert(_operator.end(), outline._operator.begin(),
+						 outline._operator.end());
+		_point.reserve(_point.size() + outline._point.size());
+		for (size_t i = 0; i + 1 < outline._point.size(); i += 2) {
+			const float x = outline._point[i];
+			const float y = outline._point[i + 1];
+
+			_point.push_back(matrix[0] * x + matrix[2] * y + matrix[4]);
+			_point.push_back(matrix[1] * x + matrix[3] * y + matrix[5]);
+		}
+		close_path();
+	}
+
+	namespace {
+
+		// Same precision as the SVG path data, followed by the
+		// separating space
+		void append_coordinate(std::string &path, const float x)
+		{
+			const long tenth = static_cast<long>(floor(x * 10.0 + 0.5));
+			char buffer[24];
+
+			if (tenth % 10 == 0) {
+				snprintf(buffer, 24, "%ld ", tenth / 10);
+			}
+			else {
+				snprintf(buffer, 24, "%s%ld.%ld ", tenth < 0 ? "-" : "",
+						 labs(tenth) / 10, labs(tenth) % 10);
+			}
+			path.append(buffer);
+		}
+
+	}
+
+	void glyph_outline_t::append_postfix(
+		std::string &path, const char *const name[NOPERATOR]) const
+	{
+		std::vector<float>::const_iterator point = _point.begin();
+		// Current point and start of the contour, for raising
+		// quadratic segments and after closing a contour
+		float current[2] = { 0, 0 };
+		float start[2] = { 0, 0 };
+
+		for (std::vector<uint8_t>::const_iterator iterator =
+				 _operator.begin();
+			 iterator != _operator.end(); iterator++) {
+			switch (*iterator) {
+			case MOVE_TO:
+			case LINE_TO:
+				current[0] = point[0];
+				current[1] = point[1];
+				if (*iterator == MOVE_TO) {
+					start[0] = current[0];
+					start[1] = current[1];
+				}
+				append_coordinate(path, current[0]);
+				append_coordinate(path, current[1]);
+				point += 2;
+				break;
+			case QUADRATIC_TO:
+				{
+					// The control points of the cubic are 2/3 of
+					// the way from the end points to the quadratic
+					// control point
+					const float control[2] = { point[0], point[1] };
+
+					append_coordinate(path, current[0] + (2.0F / 3.0F) *
+									  (control[0] - current[0]));
+					append_coordinate(path, current[1] + (2.0F / 3.0F) *
+									  (control[1] - current[1]));
+					current[0] = point[2];
+					current[1] = point[3];
+					append_coordinate(path, current[0] + (2.0F / 3.0F) *
+									  (control[0] - current[0]));
+					append_coordinate(path, current[1] + (2.0F / 3.0F) *
+									  (control[1] - current[1]));
+					append_coordinate(path, current[0]);
+					append_coordinate(path, current[1]);
+					point += 4;
+				}
+				break;
+			case CUBIC_TO:
+				for (unsigned int i = 0; i < 6; i++) {
+					append_coordinate(path, point[i]);
+				}
+				current[0] = point[4];
+				current[1] = point[5];
+				point += 6;
+				break;
+			case CLOSE_PATH:
+				current[0] = start[0];
+				current[1] = start[1];
+				break;
+			default:
+				return;
+			}
+			path.append(name[*iterator == QUADRATIC_TO ?
+							 static_cast<uint8_t>(CUBIC_TO) : *iterator]);
+			path.append(1, '\n');
+		}
+	}
+
+	bool glyph_outline_t::control_box(float box[4]) const
+	{
+		if (_point.size() < 2) {
+			return false;
+		}
+		box[0] = box[2] = _point[0];
+		box[1] = box[3] = _point[1];
+		for (size_t i = 2; i + 1 < _point.size(); i += 2) {
+			box[0] = std::min(box[0], _point[i]);
+			box[1] = std::min(box[1], _point[i + 1]);
+			box[2] = std::max(box[2], _point[i]);
+			box[3] = std::max(box[3], _point[i + 1]);
+		}
+
+		return true;
+	}
+
+	namespace {
+
+		// Extend [lower, upper] by the extremum of a quadratic or
+		// cubic Bezier curve in one coordinate, where the derivative
+		// vanishes for 0 < t < 1
+		void extend_quadratic(float &lower, float &upper,
+							  const double p0, const double p1,
+							  const double p2)
+		{
+			const double denominator = p0 - 2 * p1 + p2;
+
+			if (denominator == 0) {
+				return;
+			}
+
+			const double t = (p0 - p1) / denominator;
+
+			if (t > 0 && t < 1) {
+				const double s = 1 - t;
+				const float p = static_cast<float>(
+					s * s * p0 + 2 * s * t * p1 + t * t * p2);
+
+				lower = std::min(lower, p);
+				upper = std::max(upper, p);
+			}
+		}
+
+		void extend_cubic(float &lower, float &upper,
+						  const double p0, const double p1,
+						  const double p2, const double p3)
+		{
+			// The derivative is 3 (a t^2 + b t + c)
+			const double a = -p0 + 3 * p1 - 3 * p2 + p3;
+			const double b = 2 * (p0 - 2 * p1 + p2);
+			const double c = p1 - p0;
+			double t[2];
+			unsigned int nt = 0;
+
+			if (a == 0) {
+				if (b != 0) {
+					t[nt++] = -c / b;
+				}
+			}
+			else {
+				const double discriminant = b * b - 4 * a * c;
+
+				if (discriminant >= 0) {
+					const double root = sqrt(discriminant);
+
+					t[nt++] = (-b + root) / (2 * a);
+					t[nt++] = (-b - root) / (2 * a);
+				}
+			}
+			for (unsigned int i = 0; i < nt; i++) {
+				if (t[i] > 0 && t[i] < 1) {
+					const double s = 1 - t[i];
+					const float p = static_cast<float>(
+						s * s * s * p0 + 3 * s * s * t[i] * p1 +
+						3 * s * t[i] * t[i] * p2 +
+						t[i] * t[i] * t[i] * p3);
+
+					lower = std::min(lower, p);
+					upper = std::max(upper, p);
+				}
+			}
+		}
+
+	}
+
+	bool glyph_outline_t::bounding_box(float box[4]) const
+	{
+		if (_point.size() < 2) {
+			return false;
+		}
+		box[0] = box[2] = _point[0];
+		box[1] = box[3] = _point[1];
+
+		std::vector<float>::const_iterator point = _point.begin();
+		float current[2] = { 0, 0 };
+		float start[2] = { 0, 0 };
+
+		for (std::vector<uint8_t>::const_iterator iterator =
+				 _operator.begin();
+			 iterator != _operator.end(); iterator++) {
+			// Offset of the end point of the segment
+			unsigned int end = 0;
+
+			switch (*iterator) {
+			case MOVE_TO:
+			case LINE_TO:
+				break;
+			case QUADRATIC_TO:
+				end = 2;
+				for (unsigned int j = 0; j < 2; j++) {
+					extend_quadratic(box[j], box[j + 2], current[j],
+									 point[j], point[j + 2]);
+				}
+				break;
+			case CUBIC_TO:
+				end = 4;
+				for (unsigned int j = 0; j < 2; j++) {
+					extend_cubic(box[j], box[j + 2], current[j],
+								 point[j], point[j + 2], point[j + 4]);
+				}
+				break;
+			case CLOSE_PATH:
+				current[0] = start[0];
+				current[1] = start[1];
+				continue;
+			default:
+				return true;
+			}
+			current[0] = point[end];
+			current[1] = point[end + 1];
+			if (*iterator == MOVE_TO) {
+				start[0] = current[0];
+				start[1] = current[1];
+			}
+			box[0] = std::min(box[0], current[0]);
+			box[1] = std::min(box[1], current[1]);
+			box[2] = std::max(box[2], current[0]);
+			box[3] = std::max(box[3], current[1]);
+			point += end + 2;
+		}
+
+		return true;
+	}
+
+	bool font_outline_t::cff_index_t::parse(const font_blob_t &font_data,
+											uint32_t &offset)
+	{
+		if (!(static_cast<uint64_t>(offset) + 2 <= font_data.size())) {
+			return false;
+		}
+		_count = get_uint16(font_data, offset);
+		if (_count == 0) {
+			_off_size = 0;
+			_offset = _data = offset + 2;
+			offset += 2;
+			return true;
+		}
+		if (!(offset + 3U <= font_data.size())) {
+			return false;
+		}
+		_off_size = font_data[offset + 2];
+		_offset = offset + 3;
+		if (!(_off_size >= 1 && _off_size <= 4 &&
+			  static_cast<uint64_t>(_offset) +
+			  (_count + 1U) * _off_size <= font_data.size())) {
+			return false;
+		}
+		_data = _offset + (_count + 1) * _off_size - 1;
+
+		uint32_t begin;
+		uint32_t end;
+
+		// The end of the last element is the end of the INDEX
+		if (!element(font_data, _count - 1, begin, end)) {
+			return false;
+		}
+		offset = end;
+
+		return true;
+	}
+
+	bool font_outline_t::cff_index_t::element(
+		const font_blob_t &font_data, const uint32_t index,
+		uint32_t &begin, uint32_t &end) const
+	{
+		if (!(index < _count)) {
+			return false;
+		}
+
+		uint32_t offset[2] = { 0, 0 };
+
+		for (uint32_t i = 0; i < 2; i++) {
+			const uint32_t position = _offset + (index + i) * _off_size;
+
+			for (uint32_t j = 0; j < _off_size; j++) {
+				offset[i] = (offset[i] << 8) | font_data[position + j];
+			}
+		}
+		begin = _data + offset[0];
+		end = _data + offset[1];
+
+		return offset[0] >= 1 && offset[0] <= offset[1] &&
+			end <= font_data.size();
+	}
+
+	// Interpreter state of a charstring, kept across subroutine calls
+	class font_outline_t::charstring_state_t {
+	public:
+		double _stack[charstring_stack_limit];
+		unsigned int _nstack;
+		double _transient[charstring_transient_size];
+		// Current point in font units
+		double _x;
+		double _y;
+		unsigned int _nstem;
+		bool _width_parsed;
+		bool _ended;
+		float _scale_x;
+		float _scale_y;
+		inline charstring_state_t(const float scale_x,
+								  const float scale_y)
+			: _nstack(0), _x(0), _y(0), _nstem(0),
+			  _width_parsed(false), _ended(false),
+			  _scale_x(scale_x), _scale_y(scale_y)
+		{
+			std::fill(_transient,
+					  _transient + charstring_transient_size, 0.0);
+		}
+		// The first stack-clearing operator may carry the advance
+		// width as an extra argument, which is discarded
+		inline void parse_width(const bool extra_argument)
+		{
+			if (!_width_parsed && extra_argument && _nstack > 0) {
+				std::copy(_stack + 1, _stack + _nstack, _stack);
+				_nstack--;
+			}
+			_width_parsed = true;
+		}
+		inline void move(glyph_outline_t &outline, const double dx,
+						 const double dy)
+		{
+			_x += dx;
+			_y += dy;
+			outline.move_to(_x * _scale_x, _y * _scale_y);
+		}
+		inline void line(glyph_outline_t &outline, const double dx,
+						 const double dy)
+		{
+			_x += dx;
+			_y += dy;
+			outline.line_to(_x * _scale_x, _y * _scale_y);
+		}
+		inline void curve(glyph_outline_t &outline,
+						  const double dx1, const double dy1,
+						  const double dx2, const double dy2,
+						  const double dx3, const double dy3)
+		{
+			const double x1 = _x + dx1;
+			const double y1 = _y + dy1;
+			const double x2 = x1 + dx2;
+			const double y2 = y1 + dy2;
+
+			_x = x2 + dx3;
+			_y = y2 + dy3;
+			outline.cubic_to(x1 * _scale_x, y1 * _scale_y,
+							 x2 * _scale_x, y2 * _scale_y,
+							 _x * _scale_x, _y * _scale_y);
+		}
+	};
+
+	font_outline_t::font_outline_t(void)
+		: _valid(false), _cff(false), _nglyph(0), _scale_x(1),
+		  _scale_y(1), _fd_select(0), _glyf_offset(0), _glyf_length(0),
+		  _loca_offset(0), _loca_length(0), _long_loca(false)
+	{
+	}
+
+	font_outline_t::font_outline_t(const font_blob_t &font_data)
+		: _font_data(font_data), _valid(false), _cff(false),
+		  _nglyph(0), _scale_x(1), _scale_y(1), _fd_select(0),
+		  _glyf_offset(0), _glyf_length(0), _loca_offset(0),
+		  _loca_length(0), _long_loca(false)
+	{
+		if (_font_data.empty()) {
+			return;
+		}
+
+		const parsed_font_t &font = _font_data.parsed_font();
+
+		if (!font._valid) {
+			return;
+		}
+		_cff = font._cff;
+		_valid = _cff ?
+			parse_cff(font._cff_offset, font._cff_length) :
+			parse_ttf();
+	}
+
+	std::vector<uint8_t> font_outline_t::cff_dict(
+		const uint32_t begin, const uint32_t end) const
+	{
+		return std::vector<uint8_t>(_font_data.begin() + begin,
+									_font_data.begin() + end);
+	}
+
+	bool font_outline_t::parse_cff_private_dict(
+		cff_index_t &local_subr, const uint32_t cff_offset,
+		const uint32_t cff_length,
+		const std::vector<uint8_t> &operand) const
+	{
+		const double private_size = cff_dict_operand(operand, 0);
+		const double private_offset = cff_dict_operand(operand, 1);
+
+		if (!(private_size >= 0 && private_offset >= 0 &&
+			  private_offset + private_size <= cff_length)) {
+			ERROR_ACCESS("CFF Private DICT");
+			return false;
+		}
+
+		const uint32_t begin =
+			cff_offset + static_cast<uint32_t>(private_offset);
+		const std::vector<std::pair<uint16_t, std::vector<uint8_t> > >
+			private_dict = parse_cff_dict(
+				cff_dict(begin,
+						 begin + static_cast<uint32_t>(private_size)));
+
+		for (std::vector<std::pair<uint16_t, std::vector<uint8_t> > >::
+				 const_iterator iterator = private_dict.begin();
+			 iterator != private_dict.end(); iterator++) {
+			if (iterator->first == 19) {
+				// Subrs, relative to the Private DICT
+				const double subr_offset =
+					cff_dict_operand(iterator->second, 0);
+
+				if (!(subr_offset >= 0 &&
+					  private_offset + subr_offset < cff_length)) {
+					ERROR_ACCESS("CFF Subrs");
+					return false;
+				}
+
+				uint32_t offset =
+					begin + static_cast<uint32_t>(subr_offset);
+
+				if (!local_subr.parse(_font_data, offset)) {
+					ERROR_ACCESS("CFF Subrs");
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	bool font_outline_t::parse_cff(const uint32_t cff_offset,
+								   const uint32_t cff_length)
+	{
+		if (!(cff_length >= 4 &&
+			  static_cast<uint64_t>(cff_offset) + cff_length <=
+			  _font_data.size())) {
+			ERROR_ACCESS("CFF header");
+			return false;
+		}
+
+		uint32_t offset = cff_offset + _font_data[cff_offset + 2];
+		cff_index_t name_index;
+		cff_index_t top_dict_index;
+		cff_index_t string_index;
+
+		if (!(name_index.parse(_font_data, offset) &&
+			  top_dict_index.parse(_font_data, offset) &&
+			  string_index.parse(_font_data, offset) &&
+			  _global_subr.parse(_font_data, offset))) {
+			ERROR_ACCESS("CFF INDEX");
+			return false;
+		}
+
+		uint32_t top_dict_begin;
+		uint32_t top_dict_end;
+
+		if (!top_dict_index.element(_font_data, 0, top_dict_begin,
+									top_dict_end)) {
+			ERROR_ACCESS("CFF Top DICT");
+			return false;
+		}
+
+		const std::vector<std::pair<uint16_t, std::vector<uint8_t> > >
+			top_dict = parse_cff_dict(
+				cff_dict(top_dict_begin, top_dict_end));
+		double char_strings_offset = -1;
+		double fd_array_offset = -1;
+		double fd_select_offset = -1;
+		const std::vector<uint8_t> *private_operand = NULL;
+		// FontMatrix
+		double matrix[2] = { 0.001, 0.001 };
+
+		for (std::vector<std::pair<uint16_t, std::vector<uint8_t> > >::
+				 const_iterator iterator = top_dict.begin();
+			 iterator != top_dict.end(); iterator++) {
+			switch (iterator->first) {
+			case 17:	// CharStrings
+				char_strings_offset =
+					cff_dict_operand(iterator->second, 0);
+				break;
+			case 18:	// Private
+				private_operand = &iterator->second;
+				break;
+			case 0x0c06:	// CharstringType
+				if (cff_dict_operand(iterator->second, 0) != 2) {
+					return false;
+				}
+				break;
+			case 0x0c07:	// FontMatrix
+				matrix[0] = cff_dict_operand(iterator->second, 0);
+				matrix[1] = cff_dict_operand(iterator->second, 3);
+				break;
+			case 0x0c24:	// FDArray
+				fd_array_offset = cff_dict_operand(iterator->second, 0);
+				break;
+			case 0x0c25:	// FDSelect
+				fd_select_offset =
+					cff_dict_operand(iterator->second, 0);
+				break;
+			}
+		}
+		if (!(char_strings_offset > 0 &&
+			  char_strings_offset < cff_length)) {
+			ERROR_ACCESS("CFF CharStrings");
+			return false;
+		}
+		offset = cff_offset + static_cast<uint32_t>(char_strings_offset);
+		if (!_char_strings.parse(_font_data, offset)) {
+			ERROR_ACCESS("CFF CharStrings");
+			return false;
+		}
+		_nglyph = std::min(_char_strings._count, 65535U);
+		// Also excludes NaN from a FontMatrix with missing operands
+		if (!(fabs(matrix[0]) > 0 && fabs(matrix[0]) < HUGE_VAL &&
+			  fabs(matrix[1]) > 0 && fabs(matrix[1]) < HUGE_VAL)) {
+			return false;
+		}
+		// Glyph space units are 1/1000 em
+		_scale_x = matrix[0] * 1000.0;
+		_scale_y = matrix[1] * 1000.0;
+
+		if (fd_array_offset > 0 && fd_select_offset > 0) {
+			// CID-keyed font, with the Private DICT and the local
+			// subroutines of each Font DICT
+			if (!(fd_array_offset < cff_length &&
+				  fd_select_offset < cff_length)) {
+				ERROR_ACCESS("CFF FDArray");
+				return false;
+			}
+			offset = cff_offset + static_cast<uint32_t>(fd_array_offset);
+
+			cff_index_t fd_array;
+
+			if (!fd_array.parse(_font_data, offset)) {
+				ERROR_ACCESS("CFF FDArray");
+				return false;
+			}
+			_local_subr.resize(fd_array._count);
+			for (uint32_t i = 0; i < fd_array._count; i++) {
+				uint32_t begin;
+				uint32_t end;
+
+				if (!fd_array.element(_font_data, i, begin, end)) {
+					ERROR_ACCESS("CFF Font DICT");
+					return false;
+				}
+
+				const std::vector<std::pair<uint16_t,
+					std::vector<uint8_t> > > font_dict =
+					parse_cff_dict(cff_dict(begin, end));
+
+				for (std::vector<std::pair<uint16_t,
+						 std::vector<uint8_t> > >::const_iterator
+						 iterator = font_dict.begin();
+					 iterator != font_dict.end(); iterator++) {
+					if (iterator->first == 18 &&
+						!parse_cff_private_dict(
+							_local_subr[i], cff_offset, cff_length,
+							iterator->second)) {
+						return false;
+					}
+				}
+			}
+			_fd_select =
+				cff_offset + static_cast<uint32_t>(fd_select_offset);
+		}
+		else {
+			_local_subr.resize(1);
+			if (private_operand != NULL &&
+				!parse_cff_private_dict(_local_subr[0], cff_offset,
+										cff_length, *private_operand)) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool font_outline_t::parse_ttf(void)
+	{
+		const parsed_font_t &font = _font_data.parsed_font();
+		const parsed_font_t::table_t *head = font.table("head");
+		const parsed_font_t::table_t *maxp = font.table("maxp");
+		const parsed_font_t::table_t *glyf = font.table("glyf");
+		const parsed_font_t::table_t *loca = font.table("loca");
+
+		if (head == NULL || maxp == NULL || glyf == NULL ||
+			loca == NULL) {
+			return false;
+		}
+		if (!(head->_length >= 54 && maxp->_length >= 6)) {
+			ERROR_ACCESS("head or maxp table");
+			return false;
+		}
+
+		const uint16_t units_per_em =
+			get_uint16(_font_data, head->_offset + 18);
+
+		if (units_per_em == 0) {
+			return false;
+		}
+		_scale_x = _scale_y = 1000.0F / units_per_em;
+		_long_loca = get_uint16(_font_data, head->_offset + 50) != 0;
+		_nglyph = get_uint16(_font_data, maxp->_offset + 4);
+		_glyf_offset = glyf->_offset;
+		_glyf_length = glyf->_length;
+		_loca_offset = loca->_offset;
+		_loca_length = loca->_length;
+		if (!(_loca_length >= (_nglyph + 1U) * (_long_loca ? 4 : 2))) {
+			ERROR_ACCESS("loca table");
+			return false;
+		}
+
+		return true;
+	}
+
+	// FDSelect formats 0 and 3 (CFF specification, section 19)
+	unsigned int font_outline_t::cff_font_dict(const uint16_t glyph)
+		const
+	{
+		if (_fd_select == 0 || !(_fd_select < _font_data.size())) {
+			return 0;
+		}
+
+		const uint8_t format = _font_data[_fd_select];
+
+		if (format == 0) {
+			if (_fd_select + 1U + glyph < _font_data.size()) {
+				return _font_data[_fd_select + 1 + glyph];
+			}
+		}
+		else if (format == 3 && _fd_select + 3U <= _font_data.size()) {
+			const uint16_t nrange = get_uint16(_font_data, _fd_select + 1);
+
+			if (_fd_select + 5U + 3U * nrange <= _font_data.size()) {
+				// Binary search over the ranges, each of which is
+				// the first glyph and the Font DICT index, followed
+				// by the sentinel glyph
+				uint32_t lower = 0;
+				uint32_t upper = nrange;
+
+				while (upper - lower > 1) {
+					const uint32_t middle = (lower + upper) / 2;
+
+					if (get_uint16(_font_data,
+								   _fd_select + 3 + 3 * middle) <=
+						glyph) {
+						lower = middle;
+					}
+					else {
+						upper = middle;
+					}
+				}
+				if (nrange > 0) {
+					return _font_data[_fd_select + 3 + 3 * lower + 2];
+				}
+			}
+		}
+
+		return 0;
+	}
+
+	bool font_outline_t::cff_charstring(
+		glyph_outline_t &outline, charstring_state_t &state,
+		const uint32_t begin, const uint32_t end,
+		const cff_index_t &local_subr, const unsigned int depth) const
+	{
+		if (depth > charstring_subr_nesting_limit) {
+			return false;
+		}
+
+		double *stack = state._stack;
+		unsigned int &n = state._nstack;
+
+		for (uint32_t i = begin; i < end;) {
+			const uint8_t b0 = _font_data[i];
+
+			if (b0 == 28 || b0 >= 32) {
+				double value;
+
+				if (b0 == 28 && i + 3 <= end) {
+					value = static_cast<int16_t>(
+						get_uint16(_font_data, i + 1));
+					i += 3;
+				}
+				else if (b0 >= 32 && b0 <= 246) {
+					value = b0 - 139;
+					i++;
+				}
+				else if (b0 >= 247 && b0 <= 250 && i + 2 <= end) {
+					value = (b0 - 247) * 256 + _font_data[i + 1] + 108;
+					i += 2;
+				}
+				else if (b0 >= 251 && b0 <= 254 && i + 2 <= end) {
+					value = -(b0 - 251) * 256 - _font_data[i + 1] - 108;
+					i += 2;
+				}
+				else if (b0 == 255 && i + 5 <= end) {
+					// 16.16 fixed point
+					value = static_cast<int32_t>(
+						get_uint32(_font_data, i + 1)) / 65536.0;
+					i += 5;
+				}
+				else {
+					return false;
+				}
+				if (n >= charstring_stack_limit) {
+					return false;
+				}
+				stack[n++] = value;
+				continue;
+			}
+			i++;
+			switch (b0) {
+			case 1:		// hstem
+			case 3:		// vstem
+			case 18:	// hstemhm
+			case 23:	// vstemhm
+				state.parse_width(n % 2 == 1);
+				state._nstem += n / 2;
+				n = 0;
+				break;
+			case 19:	// hintmask
+			case 20:	// cntrmask
+				// With implicit vstem hints
+				state.parse_width(n % 2 == 1);
+				state._nstem += n / 2;
+				n = 0;
+				i += (state._nstem + 7) / 8;
+				break;
+			case 21:	// rmoveto
+				state.parse_width(n > 2);
+				if (n < 2) {
+					return false;
+				}
+				state.move(outline, stack[0], stack[1]);
+				n = 0;
+				break;
+			case 22:	// hmoveto
+				state.parse_width(n > 1);
+				if (n < 1) {
+					return false;
+				}
+				state.move(outline, stack[0], 0);
+				n = 0;
+				break;
+			case 4:		// vmoveto
+				state.parse_width(n > 1);
+				if (n < 1) {
+					return false;
+				}
+				state.move(outline, 0, stack[0]);
+				n = 0;
+				break;
+			case 5:		// rlineto
+				for (unsigned int j = 0; j + 2 <= n; j += 2) {
+					state.line(outline, stack[j], stack[j + 1]);
+				}
+				n = 0;
+				break;
+			case 6:		// hlineto
+			case 7:		// vlineto
+				for (unsigned int j = 0; j < n; j++) {
+					if ((j % 2 == 0) == (b0 == 6)) {
+						state.line(outline, stack[j], 0);
+					}
+					else {
+						state.line(outline, 0, stack[j]);
+					}
+				}
+				n = 0;
+				break;
+			case 8:		// rrcurveto
+				for (unsigned int j = 0; j + 6 <= n; j += 6) {
+					state.curve(outline, stack[j], stack[j + 1],
+								stack[j + 2], stack[j + 3],
+								stack[j + 4], stack[j + 5]);
+				}
+				n = 0;
+				break;
+			case 24:	// rcurveline
+				{
+					unsigned int j = 0;
+
+					for (; j + 8 <= n; j += 6) {
+						state.curve(outline, stack[j], stack[j + 1],
+									stack[j + 2], stack[j + 3],
+									stack[j + 4], stack[j + 5]);
+					}
+					if (j + 2 <= n) {
+						state.line(outline, stack[j], stack[j + 1]);
+					}
+				}
+				n = 0;
+				break;
+			case 25:	// rlinecurve
+				{
+					unsigned int j = 0;
+
+					for (; j + 8 <= n; j += 2) {
+						state.line(outline, stack[j], stack[j + 1]);
+					}
+					if (j + 6 <= n) {
+						state.curve(outline, stack[j], stack[j + 1],
+									stack[j + 2], stack[j + 3],
+									stack[j + 4], stack[j + 5]);
+					}
+				}
+				n = 0;
+				break;
+			case 26:	// vvcurveto
+				{
+					unsigned int j = 0;
+					double dx1 = 0;
+
+					if (n % 2 == 1) {
+						dx1 = stack[0];
+						j = 1;
+					}
+					for (; j + 4 <= n; j += 4) {
+						state.curve(outline, dx1, stack[j],
+									stack[j + 1], stack[j + 2],
+									0, stack[j + 3]);
+						dx1 = 0;
+					}
+				}
+				n = 0;
+				break;
+			case 27:	// hhcurveto
+				{
+					unsigned int j = 0;
+					double dy1 = 0;
+
+					if (n % 2 == 1) {
+						dy1 = stack[0];
+						j = 1;
+					}
+					for (; j + 4 <= n; j += 4) {
+						state.curve(outline, stack[j], dy1,
+									stack[j + 1], stack[j + 2],
+									stack[j + 3], 0);
+						dy1 = 0;
+					}
+				}
+				n = 0;
+				break;
+			case 30:	// vhcurveto
+			case 31:	// hvcurveto
+				{
+					// Curves alternate between starting horizontal
+					// and vertical, and the last one may have a
+					// fifth argument for the other end coordinate
+					bool horizontal = b0 == 31;
+
+					for (unsigned int j = 0; j + 4 <= n;) {
+						const bool last = n - j == 5;
+						const double d = last ? stack[j + 4] : 0;
+
+						if (horizontal) {
+							state.curve(outline, stack[j], 0,
+										stack[j + 1], stack[j + 2],
+										d, stack[j + 3]);
+						}
+						else {
+							state.curve(outline, 0, stack[j],
+										stack[j + 1], stack[j + 2],
+										stack[j + 3], d);
+						}
+						j += last ? 5 : 4;
+						horizontal = !horizontal;
+					}
+				}
+				n = 0;
+				break;
+			case 10:	// callsubr
+			case 29:	// callgsubr
+				{
+					const cff_index_t &subr =
+						b0 == 10 ? local_subr : _global_subr;
+
+					if (n < 1) {
+						return false;
+					}
+
+					const double index =
+						stack[--n] + subr_bias(subr._count);
+					uint32_t subr_begin;
+					uint32_t subr_end;
+
+					if (!(index >= 0 &&
+						  subr.element(_font_data,
+									   static_cast<uint32_t>(index),
+									   subr_begin, subr_end))) {
+						return false;
+					}
+					if (!cff_charstring(outline, state, subr_begin,
+										subr_end, local_subr,
+										depth + 1)) {
+						return false;
+					}
+					if (state._ended) {
+						return true;
+					}
+				}
+				break;
+			case 11:	// return
+				return true;
+			case 14:	// endchar
+				// The deprecated accented character arguments of
+				// seac are ignored
+				state.parse_width(n == 1 || n == 5);
+				outline.close_path();
+				state._ended = true;
+				return true;
+			case 12:
+				{
+					if (!(i < end)) {
+						return false;
+					}
+
+					const uint8_t b1 = _font_data[i++];
+
+					switch (b1) {
+					case 35:	// flex
+						if (n < 13) {
+							return false;
+						}
+						state.curve(outline, stack[0], stack[1],
+									stack[2], stack[3],
+									stack[4], stack[5]);
+						state.curve(outline, stack[6], stack[7],
+									stack[8], stack[9],
+									stack[10], stack[11]);
+						n = 0;
+						break;
+					case 34:	// hflex
+						if (n < 7) {
+							return false;
+						}
+						state.curve(outline, stack[0], 0,
+									stack[1], stack[2], stack[3], 0);
+						state.curve(outline, stack[4], 0,
+									stack[5], -stack[2], stack[6], 0);
+						n = 0;
+						break;
+					case 36:	// hflex1
+						if (n < 9) {
+							return false;
+						}
+						state.curve(outline, stack[0], stack[1],
+									stack[2], stack[3], stack[4], 0);
+						state.curve(outline, stack[5], 0,
+									stack[6], stack[7], stack[8],
+									-(stack[1] + stack[3] + stack[7]));
+						n = 0;
+						break;
+					case 37:	// flex1
+						{
+							if (n < 11) {
+								return false;
+							}
+
+							double dx = 0;
+							double dy = 0;
+
+							for (unsigned int j = 0; j < 10; j += 2) {
+								dx += stack[j];
+								dy += stack[j + 1];
+							}
+
+							const bool horizontal = fabs(dx) > fabs(dy);
+
+							state.curve(outline, stack[0], stack[1],
+										stack[2], stack[3],
+										stack[4], stack[5]);
+							state.curve(outline, stack[6], stack[7],
+										stack[8], stack[9],
+										horizontal ? stack[10] : -dx,
+										horizontal ? -dy : stack[10]);
+						}
+						n = 0;
+						break;
+					case 3:		// and
+					case 4:		// or
+					case 10:	// add
+					case 11:	// sub
+					case 12:	// div
+					case 15:	// eq
+					case 24:	// mul
+						{
+							if (n < 2) {
+								return false;
+							}
+
+							const double a = stack[n - 2];
+							const double b = stack[n - 1];
+							double value = 0;
+
+							switch (b1) {
+							case 3:
+								value = a != 0 && b != 0;
+								break;
+							case 4:
+								value = a != 0 || b != 0;
+								break;
+							case 10:
+								value = a + b;
+								break;
+							case 11:
+								value = a - b;
+								break;
+							case 12:
+								value = b != 0 ? a / b : 0;
+								break;
+							case 15:
+								value = a == b;
+								break;
+							case 24:
+								value = a * b;
+								break;
+							}
+							n--;
+							stack[n - 1] = value;
+						}
+						break;
+					case 5:		// not
+					case 9:		// abs
+					case 14:	// neg
+					case 26:	// sqrt
+						if (n < 1) {
+							return false;
+						}
+						switch (b1) {
+						case 5:
+							stack[n - 1] = stack[n - 1] == 0;
+							break;
+						case 9:
+							stack[n - 1] = fabs(stack[n - 1]);
+							break;
+						case 14:
+							stack[n - 1] = -stack[n - 1];
+							break;
+						case 26:
+							stack[n - 1] = stack[n - 1] > 0 ?
+								sqrt(stack[n - 1]) : 0;
+							break;
+						}
+						break;
+					case 18:	// drop
+						if (n < 1) {
+							return false;
+						}
+						n--;
+						break;
+					case 20:	// put
+						{
+							if (n < 2) {
+								return false;
+							}
+
+							const double index = stack[n - 1];
+
+							if (index >= 0 &&
+								index < charstring_transient_size) {
+								state._transient[
+									static_cast<unsigned int>(index)] =
+									stack[n - 2];
+							}
+							n -= 2;
+						}
+						break;
+					case 21:	// get
+						{
+							if (n < 1) {
+								return false;
+							}
+
+							const double index = stack[n - 1];
+
+							stack[n - 1] =
+								index >= 0 &&
+								index < charstring_transient_size ?
+								state._transient[
+									static_cast<unsigned int>(index)] :
+								0;
+						}
+						break;
+					case 22:	// ifelse
+						if (n < 4) {
+							return false;
+						}
+						if (stack[n - 2] > stack[n - 1]) {
+							stack[n - 4] = stack[n - 3];
+						}
+						n -= 3;
+						break;
+					case 23:	// random
+						if (n >= charstring_stack_limit) {
+							return false;
+						}
+						// Any value in (0, 1], deterministic output
+						// being preferable
+						stack[n++] = 0.5;
+						break;
+					case 27:	// dup
+						if (!(n >= 1 && n < charstring_stack_limit)) {
+							return false;
+						}
+						stack[n] = stack[n - 1];
+						n++;
+						break;
+					case 28:	// exch
+						if (n < 2) {
+							return false;
+						}
+						std::swap(stack[n - 2], stack[n - 1]);
+						break;
+					case 29:	// index
+						{
+							if (n < 1) {
+								return false;
+							}
+
+							const double index = stack[n - 1];
+							const unsigned int j = index < 0 ? 0 :
+								static_cast<unsigned int>(index);
+
+							stack[n - 1] = j + 1 < n ?
+								stack[n - 2 - j] : 0;
+						}
+						break;
+					case 30:	// roll
+						{
+							if (n < 2) {
+								return false;
+							}
+
+							const double count = stack[n - 2];
+							const int shift =
+								static_cast<int>(stack[n - 1]);
+
+							n -= 2;
+							if (!(count > 0 && count <= n)) {
+								return false;
+							}
+
+							const unsigned int m =
+								static_cast<unsigned int>(count);
+							const unsigned int k =
+								((shift % static_cast<int>(m)) + m) % m;
+
+							// Rolling up by k moves the top k
+							// elements to the bottom
+							std::rotate(stack + n - m, stack + n - k,
+										stack + n);
+						}
+						break;
+					default:
+						return false;
+					}
+				}
+				break;
+			default:
+				// Reserved operators
+				n = 0;
+				break;
+			}
+		}
+
+		return true;
+	}
+
+	// Offsets of the glyph data within the glyf table
+	void font_outline_t::ttf_glyph_location(uint32_t &begin,
+											uint32_t &end,
+											const uint16_t glyph) const
+	{
+		begin = _long_loca ?
+			get_uint32(_font_data, _loca_offset + 4 * glyph) :
+			get_uint16(_font_data, _loca_offset + 2 * glyph) * 2U;
+		end = _long_loca ?
+			get_uint32(_font_data, _loca_offset + 4 * glyph + 4) :
+			get_uint16(_font_data, _loca_offset + 2 * glyph + 2) * 2U;
+	}
+
+	bool font_outline_t::ttf_glyph(glyph_outline_t &outline,
+								   const uint16_t glyph,
+								   const unsigned int depth) const
+	{
+		if (!(glyph < _nglyph && depth <= ttf_component_nesting_limit)) {
+			return false;
+		}
+
+		uint32_t begin;
+		uint32_t end;
+
+		ttf_glyph_location(begin, end, glyph);
+		if (begin == end) {
+			// Glyph without contours, e.g. the space
+			return true;
+		}
+		if (!(begin + 10 <= end && end <= _glyf_length)) {
+			ERROR_ACCESS("glyf table");
+			return false;
+		}
+
+		const uint32_t glyph_end = _glyf_offset + end;
+		uint32_t offset = _glyf_offset + begin;
+		const int16_t ncontour =
+			static_cast<int16_t>(get_uint16(_font_data, offset));
+
+		offset += 10;
+		if (ncontour >= 0) {
+			// Simple glyph
+			if (!(offset + 2U * ncontour + 2 <= glyph_end)) {
+				ERROR_ACCESS("glyf table");
+				return false;
+			}
+			if (ncontour == 0) {
+				return true;
+			}
+
+			std::vector<uint16_t> contour_end(ncontour);
+
+			for (int16_t i = 0; i < ncontour; i++) {
+				contour_end[i] = get_uint16(_font_data, offset + 2 * i);
+				if (i > 0 && contour_end[i] < contour_end[i - 1]) {
+					return false;
+				}
+			}
+			offset += 2 * ncontour;
+
+			const uint32_t npoint = contour_end.back() + 1U;
+			const uint16_t instruction_length =
+				get_uint16(_font_data, offset);
+
+			offset += 2 + instruction_length;
+
+			// Glyph flags
+			static const uint8_t on_curve_point = 0x01;
+			static const uint8_t x_short_vector = 0x02;
+			static const uint8_t y_short_vector = 0x04;
+			static const uint8_t repeat_flag = 0x08;
+			static const uint8_t x_is_same_or_positive = 0x10;
+			static const uint8_t y_is_same_or_positive = 0x20;
+			std::vector<uint8_t> flag;
+
+			flag.reserve(npoint);
+			while (flag.size() < npoint) {
+				if (!(offset < glyph_end)) {
+					ERROR_ACCESS("glyf table");
+					return false;
+				}
+
+				const uint8_t f = _font_data[offset++];
+
+				flag.push_back(f);
+				if (f & repeat_flag) {
+					if (!(offset < glyph_end)) {
+						ERROR_ACCESS("glyf table");
+						return false;
+					}
+
+					const uint8_t repeat = _font_data[offset++];
+
+					flag.insert(flag.end(),
+								std::min(static_cast<uint32_t>(repeat),
+										 npoint - static_cast<uint32_t>(
+											 flag.size())), f);
+				}
+			}
+
+			// Coordinates are deltas, x for all points followed by y
+			std::vector<float> coordinate(2 * npoint);
+
+			for (uint32_t axis = 0; axis < 2; axis++) {
+				const uint8_t short_vector =
+					axis == 0 ? x_short_vector : y_short_vector;
+				const uint8_t same_or_positive = axis == 0 ?
+					x_is_same_or_positive : y_is_same_or_positive;
+				const float scale = axis == 0 ? _scale_x : _scale_y;
+				int32_t value = 0;
+
+				for (uint32_t i = 0; i < npoint; i++) {
+					if (flag[i] & short_vector) {
+						if (!(offset + 1 <= glyph_end)) {
+							ERROR_ACCESS("glyf table");
+							return false;
+						}
+
+						const int32_t delta = _font_data[offset++];
+
+						value += flag[i] & same_or_positive ?
+							delta : -delta;
+					}
+					else if (!(flag[i] & same_or_positive)) {
+						if (!(offset + 2 <= glyph_end)) {
+							ERROR_ACCESS("glyf table");
+							return false;
+						}
+						value += static_cast<int16_t>(
+							get_uint16(_font_data, offset));
+						offset += 2;
+					}
+					coordinate[2 * i + axis] = value * scale;
+				}
+			}
+
+			// Contours of quadratic curves, where two consecutive off
+			// curve points imply an on curve point midway
+			uint32_t first = 0;
+
+			for (int16_t c = 0; c < ncontour; c++) {
+				const uint32_t last = contour_end[c];
+				const uint32_t length = last - first + 1;
+
+				if (first > last) {
+					return false;
+				}
+
+				uint32_t start = first;
+
+				while (start <= last &&
+					   !(flag[start] & on_curve_point)) {
+					start++;
+				}
+
+				float start_x;
+				float start_y;
+				uint32_t nvisit;
+
+				if (start <= last) {
+					start_x = coordinate[2 * start];
+					start_y = coordinate[2 * start + 1];
+					nvisit = length - 1;
+				}
+				else {
+					// No on curve point at all
+					start = last;
+					start_x = 0.5F * (coordinate[2 * first] +
+									  coordinate[2 * last]);
+					start_y = 0.5F * (coordinate[2 * first + 1] +
+									  coordinate[2 * last + 1]);
+					nvisit = length;
+				}
+				outline.move_to(start_x, start_y);
+
+				bool control = false;
+				float control_x = 0;
+				float control_y = 0;
+
+				for (uint32_t j = 1; j <= nvisit; j++) {
+					const uint32_t k = first + (start - first + j) % length;
+					const float x = coordinate[2 * k];
+					const float y = coordinate[2 * k + 1];
+
+					if (flag[k] & on_curve_point) {
+						if (control) {
+							outline.quadratic_to(control_x, control_y,
+												 x, y);
+							control = false;
+						}
+						else {
+							outline.line_to(x, y);
+						}
+					}
+					else {
+						if (control) {
+							outline.quadratic_to(
+								control_x, control_y,
+								0.5F * (control_x + x),
+								0.5F * (control_y + y));
+						}
+						control = true;
+						control_x = x;
+						control_y = y;
+					}
+				}
+				if (control) {
+					outline.quadratic_to(control_x, control_y,
+										 start_x, start_y);
+				}
+				outline.close_path();
+				first = last + 1;
+			}
+
+			return true;
+		}
+
+		uint16_t flags;
+
+		do {
+			if (!(offset + 4 <= glyph_end)) {
+				ERROR_ACCESS("glyf table");
+				return false;
+			}
+			flags = get_uint16(_font_data, offset);
+
+			const uint16_t component = get_uint16(_font_data, offset + 2);
+			const uint32_t argument_size =
+				flags & arg_1_and_2_are_words ? 4 : 2;
+			const uint32_t scale_size =
+				flags & we_have_a_scale ? 2 :
+				flags & we_have_an_x_and_y_scale ? 4 :
+				flags & we_have_a_two_by_two ? 8 : 0;
+
+			offset += 4;
+			if (!(offset + argument_size + scale_size <= glyph_end)) {
+				ERROR_ACCESS("glyf table");
+				return false;
+			}
+
+			float matrix[6] = { 1, 0, 0, 1, 0, 0 };
+
+			// Matching points instead of an offset are not
+			// supported, and the component is placed unshifted
+			if (flags & args_are_xy_values) {
+				if (flags & arg_1_and_2_are_words) {
+					matrix[4] = static_cast<int16_t>(
+						get_uint16(_font_data, offset)) * _scale_x;
+					matrix[5] = static_cast<int16_t>(
+						get_uint16(_font_data, offset + 2)) * _scale_y;
+				}
+				else {
+					matrix[4] = static_cast<int8_t>(
+						_font_data[offset]) * _scale_x;
+					matrix[5] = static_cast<int8_t>(
+						_font_data[offset + 1]) * _scale_y;
+				}
+			}
+			offset += argument_size;
+
+			// F2Dot14 scale and the 2 by 2 matrix
+			float f2dot14[4];
+
+			for (uint32_t i = 0; i < scale_size / 2; i++) {
+				f2dot14[i] = static_cast<int16_t>(
+					get_uint16(_font_data, offset + 2 * i)) / 16384.0F;
+			}
+			if (flags & we_have_a_scale) {
+				matrix[0] = matrix[3] = f2dot14[0];
+			}
+			else if (flags & we_have_an_x_and_y_scale) {
+				matrix[0] = f2dot14[0];
+				matrix[3] = f2dot14[1];
+			}
+			else if (flags & we_have_a_two_by_two) {
+				std::copy(f2dot14, f2dot14 + 4, matrix);
+			}
+			offset += scale_size;
+
+			glyph_outline_t component_outline;
+
+			if (!ttf_glyph(component_outline, component, depth + 1)) {
+				return false;
+			}
+			outline.append(component_outline, matrix);
+		} while (flags & more_components);
+
+		return true;
+	}
+
+	bool font_outline_t::glyph_outline(glyph_outline_t &outline,
+									   const uint16_t glyph) const
+	{
+		outline.clear();
+		if (!(_valid && glyph < _nglyph)) {
+			return false;
+		}
+		if (!_cff) {
+			return ttf_glyph(outline, glyph, 0);
+		}
+
+		uint32_t begin;
+		uint32_t end;
+
+		if (!_char_strings.element(_font_data, glyph, begin, end)) {
+			ERROR_ACCESS("CFF CharStrings");
+			return false;
+		}
+
+		const unsigned int font_dict = cff_font_dict(glyph);
+
+		if (!(font_dict < _local_subr.size())) {
+			return false;
+		}
+
+		charstring_state_t state(_scale_x, _scale_y);
+
+		if (!cff_charstring(outline, state, begin, end,
+							_local_subr[font_dict], 0)) {
+			outline.clear();
+			return false;
+		}
+		outline.close_path();
+
+		return true;
+	}
+
+	// A composite glyph has the advance of a component flagged
+	// USE_MY_METRICS, which may itself be composite
+	uint16_t font_outline_t::metrics_glyph(const uint16_t glyph) const
+	{
+		uint16_t ret = glyph;
+
+		if (!_valid || _cff) {
+			return ret;
+		}
+		for (unsigned int depth = 0;
+			 depth <= ttf_component_nesting_limit && ret < _nglyph;
+			 depth++) {
+			uint32_t begin;
+			uint32_t end;
+
+			ttf_glyph_location(begin, end, ret);
+			if (!(begin + 10 <= end && end <= _glyf_length)) {
+				return ret;
+			}
+
+			const uint32_t glyph_end = _glyf_offset + end;
+			uint32_t offset = _glyf_offset + begin;
+
+			if (static_cast<int16_t>(get_uint16(_font_data, offset)) >=
+				0) {
+				// Simple glyph
+				return ret;
+			}
+			offset += 10;
+
+			uint16_t flags;
+
+			do {
+				if (!(offset + 4 <= glyph_end)) {
+					return ret;
+				}
+				flags = get_uint16(_font_data, offset);
+				if (flags & use_my_metrics) {
+					break;
+				}
+				offset += ttf_component_size(flags);
+			} while (flags & more_components);
+			if (!(flags & use_my_metrics)) {
+				return ret;
+			}
+			ret = get_uint16(_font_data, offset + 2);
+		}
+
+		return ret;
+	}
+
+	bool font_outline_t::glyph_bounding_box(float box[4],
+											const uint16_t glyph) const
+	{
+		std::fill(box, box + 4, 0.0F);
+		if (!(_valid && glyph < _nglyph)) {
+			return false;
+		}
+		if (_cff) {
+			glyph_outline_t outline;
+
+			if (!glyph_outline(outline, glyph)) {
+				return false;
+			}
+			outline.bounding_box(box);
+
+			return true;
+		}
+
+		uint32_t begin;
+		uint32_t end;
+
+		ttf_glyph_location(begin, end, glyph);
+		if (begin == end) {
+			return true;
+		}
+		if (!(begin + 10 <= end && end <= _glyf_length)) {
+			ERROR_ACCESS("glyf table");
+			return false;
+		}
+
+		// xMin, yMin, xMax and yMax follow numberOfContours, and
+		// also bound composite glyphs
+		const uint32_t offset = _glyf_offset + begin;
+
+		for (unsigned int i = 0; i < 4; i++) {
+			box[i] = (i % 2 == 0 ? _scale_x : _scale_y) *
+				static_cast<int16_t>(
+					get_uint16(_font_data, offset + 2 + 2 * i));
+		}
+
+		return true;
+	}
+
+	font_metrics_t::font_metrics_t(void)
+	{
+	}
+
+	font_metrics_t::font_metrics_t(const font_blob_t &font_data)
+	{
+		if (font_data.empty()) {
+			return;
+		}
+
+		const parsed_font_t &font = font_data.parsed_font();
+
+		if (!font._valid) {
+			return;
+		}
+
+		const parsed_font_t::table_t *head = font.table("head");
+		const parsed_font_t::table_t *hhea = font.table("hhea");
+		const parsed_font_t::table_t *hmtx = font.table("hmtx");
+
+		if (head == NULL || hhea == NULL || hmtx == NULL) {
+			return;
+		}
+		if (!(head->_length >= 54 && hhea->_length >= 36)) {
+			ERROR_ACCESS("head or hhea table");
+			return;
+		}
+
+		const uint16_t units_per_em =
+			get_uint16(font_data, head->_offset + 18);
+		const uint16_t nhorizontal_metric =
+			get_uint16(font_data, hhea->_offset + 34);
+
+		if (units_per_em == 0 || nhorizontal_metric == 0) {
+			return;
+		}
+		if (!(4U * nhorizontal_metric <= hmtx->_length)) {
+			ERROR_ACCESS("hmtx table");
+			return;
+		}
+
+		const font_outline_t font_outline(font_data);
+
+		if (!font_outline.valid()) {
+			return;
+		}
+
+		// The advances are unscaled in hmtx, in units of the head
+		// table also for CFF fonts, and glyphs past the last
+		// horizontal metric have its advance. FreeType likewise
+		// applies USE_MY_METRICS when loading a glyph.
+		const float scale = 1000.0F / units_per_em;
+
+		_glyph_metrics.resize(font_outline.nglyph());
+		for (size_t i = 0; i < _glyph_metrics.size(); i++) {
+			const uint16_t glyph = static_cast<uint16_t>(i);
+			const uint16_t metric =
+				std::min(font_outline.metrics_glyph(glyph),
+						 static_cast<uint16_t>(nhorizontal_metric - 1));
+
+			_glyph_metrics[i]._advance = scale *
+				get_uint16(font_data, hmtx->_offset + 4 * metric);
+			font_outline.glyph_bounding_box(
+				_glyph_metrics[i]._bounding_box, glyph);
+		}
+	}
+
+}
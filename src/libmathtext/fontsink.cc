@@ -0,0 +1,900 @@
+// mathtext - A TeX/LaTeX compatible rendering library. Copyright (C)
+// 2008-2016 Yue Shi Lai <ylai@users.sourceforge.net>
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2.1 of
+// the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// 02110-1301 USA
+
+#include <cstdarg>
+#include <cstring>
+#include <algorithm>
+#include <unistd.h>
+#include <mathtext/fontsink.h>
+
+// The SSE2 and AVX2 encoders are compiled for the respective
+// instruction set by function attributes, and selected at run time,
+// so that the library does not require either
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#ifdef HAVE_SSE2
+#define ENCODER_HAVE_SSE2
+#include <emmintrin.h>
+#endif // HAVE_SSE2
+#ifdef HAVE_AVX2
+#define ENCODER_HAVE_AVX2
+#include <immintrin.h>
+#endif // HAVE_AVX2
+#endif // defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+
+/////////////////////////////////////////////////////////////////////
+
+namespace mathtext {
+
+	namespace {
+
+		// Input is encoded in blocks of this size, which bounds the
+		// memory used by the encoders independently of the length
+		// written
+		const size_t encode_block_size = 4096;
+
+		// Characters per line of the ASCII encodings
+		const unsigned int ascii_line_width = 64;
+
+		const char hex_digit[] = "0123456789ABCDEF";
+
+		const char base64_digit[] =
+			"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz"
+			"0123456789+/";
+
+		// Copies the characters, breaking lines at ascii_line_width,
+		// and returns the number of characters written
+		size_t wrap_line(char *wrapped, const char *encoded,
+						 size_t length, unsigned int &column)
+		{
+			char *p = wrapped;
+
+			while (length > 0) {
+				const size_t line_length =
+					std::min(length, static_cast<size_t>(
+						ascii_line_width - column));
+
+				memcpy(p, encoded, line_length);
+				p += line_length;
+				encoded += line_length;
+				length -= line_length;
+				column += line_length;
+				if (column == ascii_line_width) {
+					*p++ = '\n';
+					column = 0;
+				}
+			}
+
+			return p - wrapped;
+		}
+
+		inline uint32_t load_uint32_be(const uint8_t *buffer)
+		{
+			return (static_cast<uint32_t>(buffer[0]) << 24) |
+				(static_cast<uint32_t>(buffer[1]) << 16) |
+				(static_cast<uint32_t>(buffer[2]) << 8) |
+				static_cast<uint32_t>(buffer[3]);
+		}
+
+		// Encodes the 4 bytes as 5 characters, of which length + 1
+		// are significant for a final, partial group
+		inline void ascii85_digit(char *encoded, uint32_t dword)
+		{
+			for (int j = 4; j >= 0; j--) {
+				encoded[j] = static_cast<char>(dword % 85 + '!');
+				dword /= 85;
+			}
+		}
+
+		// The encoders take no line breaks into account. The
+		// ASCIIHex encoders write 2 characters per byte, the ASCII85
+		// encoders, for complete 4 byte groups, 5 characters or "z"
+		// per group, and return the number of characters written.
+
+		void asciihex_scalar(char *encoded, const uint8_t *buffer,
+							 const size_t length)
+		{
+			for (size_t i = 0; i < length; i++) {
+				encoded[2 * i] = hex_digit[buffer[i] >> 4];
+				encoded[2 * i + 1] = hex_digit[buffer[i] & 15];
+			}
+		}
+
+		size_t ascii85_scalar(char *encoded, const uint8_t *buffer,
+							  const size_t ngroup)
+		{
+			char *p = encoded;
+
+			for (size_t i = 0; i < ngroup; i++) {
+				const uint32_t dword = load_uint32_be(buffer + 4 * i);
+
+				if (dword == 0) {
+					*p++ = 'z';
+				}
+				else {
+					ascii85_digit(p, dword);
+					p += 5;
+				}
+			}
+
+			return p - encoded;
+		}
+
+#ifdef ENCODER_HAVE_SSE2
+		__attribute__((target("sse2"))) void
+		asciihex_sse2(char *encoded, const uint8_t *buffer,
+					  const size_t length)
+		{
+			const __m128i low_nibble = _mm_set1_epi8(15);
+			const __m128i nine = _mm_set1_epi8(9);
+			const __m128i zero = _mm_set1_epi8('0');
+			// 'A' - '0' - 10
+			const __m128i letter = _mm_set1_epi8(7);
+			size_t i = 0;
+
+			for (; i + 16 <= length; i += 16) {
+				const __m128i b = _mm_loadu_si128(
+					reinterpret_cast<const __m128i *>(buffer + i));
+				__m128i high =
+					_mm_and_si128(_mm_srli_epi16(b, 4), low_nibble);
+				__m128i low = _mm_and_si128(b, low_nibble);
+
+				high = _mm_add_epi8(
+					_mm_add_epi8(high, zero),
+					_mm_and_si128(_mm_cmpgt_epi8(high, nine), letter));
+				low = _mm_add_epi8(
+					_mm_add_epi8(low, zero),
+					_mm_and_si128(_mm_cmpgt_epi8(low, nine), letter));
+				_mm_storeu_si128(
+					reinterpret_cast<__m128i *>(encoded + 2 * i),
+					_mm_unpacklo_epi8(high, low));
+				_mm_storeu_si128(
+					reinterpret_cast<__m128i *>(encoded + 2 * i + 16),
+					_mm_unpackhi_epi8(high, low));
+			}
+			asciihex_scalar(encoded + 2 * i, buffer + i, length - i);
+		}
+
+		// Quotient by 85 of each unsigned 32 bit element, using
+		// floor(x / 85) = floor(x * ceil(2^38 / 85) / 2^38) for all x
+		// < 2^32
+		__attribute__((target("sse2"))) inline __m128i
+		div85_sse2(const __m128i x)
+		{
+			const __m128i magic = _mm_set1_epi32(0xc0c0c0c1U);
+			const __m128i even =
+				_mm_srli_epi64(_mm_mul_epu32(x, magic), 38);
+			const __m128i odd = _mm_srli_epi64(
+				_mm_mul_epu32(_mm_srli_epi64(x, 32), magic), 38);
+
+			return _mm_or_si128(even, _mm_slli_epi64(odd, 32));
+		}
+
+		// x - 85 * q, with 85 * q = 64 * q + 16 * q + 4 * q + q, as
+		// SSE2 lacks a 32 bit multiplication
+		__attribute__((target("sse2"))) inline __m128i
+		mod85_sse2(const __m128i x, const __m128i q)
+		{
+			const __m128i q85 = _mm_add_epi32(
+				_mm_add_epi32(_mm_slli_epi32(q, 6),
+							  _mm_slli_epi32(q, 4)),
+				_mm_add_epi32(_mm_slli_epi32(q, 2), q));
+
+			return _mm_sub_epi32(x, q85);
+		}
+
+		__attribute__((target("sse2"))) size_t
+		ascii85_sse2(char *encoded, const uint8_t *buffer,
+					 const size_t ngroup)
+		{
+			const __m128i byte_mask = _mm_set1_epi32(0xff00);
+			// '!' added to each byte
+			const __m128i exclamation = _mm_set1_epi8('!');
+			char *p = encoded;
+			size_t i = 0;
+
+			for (; i + 4 <= ngroup; i += 4) {
+				__m128i x = _mm_loadu_si128(
+					reinterpret_cast<const __m128i *>(buffer + 4 * i));
+
+				// Groups of zeros are abbreviated, and rare enough
+				// outside of images not to be vectorized
+				if (_mm_movemask_epi8(
+						_mm_cmpeq_epi32(x, _mm_setzero_si128())) != 0) {
+					p += ascii85_scalar(p, buffer + 4 * i, 4);
+					continue;
+				}
+				// Big endian
+				x = _mm_or_si128(
+					_mm_or_si128(_mm_slli_epi32(x, 24),
+								 _mm_srli_epi32(x, 24)),
+					_mm_or_si128(
+						_mm_and_si128(_mm_slli_epi32(x, 8),
+									  _mm_slli_epi32(byte_mask, 8)),
+						_mm_and_si128(_mm_srli_epi32(x, 8),
+									  byte_mask)));
+
+				const __m128i q1 = div85_sse2(x);
+				const __m128i q2 = div85_sse2(q1);
+				const __m128i q3 = div85_sse2(q2);
+				const __m128i q4 = div85_sse2(q3);
+				// The first 4 characters of each group, in (little
+				// endian) memory order, and the fifth
+				const __m128i d0123 = _mm_add_epi32(
+					_mm_or_si128(
+						_mm_or_si128(q4, _mm_slli_epi32(
+										 mod85_sse2(q3, q4), 8)),
+						_mm_or_si128(
+							_mm_slli_epi32(mod85_sse2(q2, q3), 16),
+							_mm_slli_epi32(mod85_sse2(q1, q2), 24))),
+					exclamation);
+				const __m128i d4 = _mm_add_epi32(mod85_sse2(x, q1),
+												 _mm_set1_epi32('!'));
+				uint32_t head[4];
+				uint32_t tail[4];
+
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(head),
+								 d0123);
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(tail), d4);
+				for (int k = 0; k < 4; k++) {
+					memcpy(p, head + k, 4);
+					p[4] = static_cast<char>(tail[k]);
+					p += 5;
+				}
+			}
+			p += ascii85_scalar(p, buffer + 4 * i, ngroup - i);
+
+			return p - encoded;
+		}
+#endif // ENCODER_HAVE_SSE2
+
+#ifdef ENCODER_HAVE_AVX2
+		__attribute__((target("avx2"))) inline __m256i
+		hex_digit_avx2(const __m256i nibble)
+		{
+			return _mm256_add_epi8(
+				_mm256_add_epi8(nibble, _mm256_set1_epi8('0')),
+				_mm256_and_si256(
+					_mm256_cmpgt_epi8(nibble, _mm256_set1_epi8(9)),
+					_mm256_set1_epi8(7)));
+		}
+
+		__attribute__((target("avx2"))) void
+		asciihex_avx2(char *encoded, const uint8_t *buffer,
+					  const size_t length)
+		{
+			const __m256i low_nibble = _mm256_set1_epi8(15);
+			size_t i = 0;
+
+			for (; i + 32 <= length; i += 32) {
+				const __m256i b = _mm256_loadu_si256(
+					reinterpret_cast<const __m256i *>(buffer + i));
+				const __m256i high = hex_digit_avx2(
+					_mm256_and_si256(_mm256_srli_epi16(b, 4),
+									 low_nibble));
+				const __m256i low = hex_digit_avx2(
+					_mm256_and_si256(b, low_nibble));
+				// Interleaving is within 128 bit lanes, i.e. bytes
+				// 0-7 and 16-23, and 8-15 and 24-31
+				const __m256i first = _mm256_unpacklo_epi8(high, low);
+				const __m256i second = _mm256_unpackhi_epi8(high, low);
+
+				_mm256_storeu_si256(
+					reinterpret_cast<__m256i *>(encoded + 2 * i),
+					_mm256_permute2x128_si256(first, second, 0x20));
+				_mm256_storeu_si256(
+					reinterpret_cast<__m256i *>(encoded + 2 * i + 32),
+					_mm256_permute2x128_si256(first, second, 0x31));
+			}
+			asciihex_scalar(encoded + 2 * i, buffer + i, length - i);
+		}
+
+		__attribute__((target("avx2"))) inline __m256i
+		div85_avx2(const __m256i x)
+		{
+			const __m256i magic = _mm256_set1_epi32(0xc0c0c0c1U);
+			const __m256i even =
+				_mm256_srli_epi64(_mm256_mul_epu32(x, magic), 38);
+			const __m256i odd = _mm256_srli_epi64(
+				_mm256_mul_epu32(_mm256_srli_epi64(x, 32), magic), 38);
+
+			return _mm256_or_si256(even, _mm256_slli_epi64(odd, 32));
+		}
+
+		__attribute__((target("avx2"))) inline __m256i
+		digit_avx2(const __m256i x, const __m256i q)
+		{
+			return _mm256_add_epi32(
+				_mm256_sub_epi32(
+					x, _mm256_mullo_epi32(q, _mm256_set1_epi32(85))),
+				_mm256_set1_epi32('!'));
+		}
+
+		__attribute__((target("avx2"))) size_t
+		ascii85_avx2(char *encoded, const uint8_t *buffer,
+					 const size_t ngroup)
+		{
+			// Byte swap within 32 bit elements
+			const __m256i big_endian = _mm256_setr_epi8(
+				3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+				3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+			// From digit j of group k at 4 * j + k, per 128 bit
+			// lane, to the 5 characters of each group in sequence,
+			// where -1 yields 0 for the other source
+			const __m256i digit_0_3 = _mm256_setr_epi8(
+				0, 4, 8, 12, -1, 1, 5, 9, 13, -1, 2, 6, 10, 14, -1, 3,
+				0, 4, 8, 12, -1, 1, 5, 9, 13, -1, 2, 6, 10, 14, -1, 3);
+			const __m256i digit_4 = _mm256_setr_epi8(
+				-1, -1, -1, -1, 0, -1, -1, -1, -1, 1, -1, -1, -1, -1,
+				2, -1,
+				-1, -1, -1, -1, 0, -1, -1, -1, -1, 1, -1, -1, -1, -1,
+				2, -1);
+			const __m256i tail_0_3 = _mm256_setr_epi8(
+				7, 11, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+				-1, -1,
+				7, 11, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+				-1, -1);
+			const __m256i tail_4 = _mm256_setr_epi8(
+				-1, -1, -1, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+				-1, -1,
+				-1, -1, -1, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+				-1, -1);
+			char *p = encoded;
+			size_t i = 0;
+
+			for (; i + 8 <= ngroup; i += 8) {
+				__m256i x = _mm256_loadu_si256(
+					reinterpret_cast<const __m256i *>(buffer + 4 * i));
+
+				if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(
+						x, _mm256_setzero_si256())) != 0) {
+					p += ascii85_scalar(p, buffer + 4 * i, 8);
+					continue;
+				}
+				x = _mm256_shuffle_epi8(x, big_endian);
+
+				const __m256i q1 = div85_avx2(x);
+				const __m256i q2 = div85_avx2(q1);
+				const __m256i q3 = div85_avx2(q2);
+				const __m256i q4 = div85_avx2(q3);
+				const __m256i d01 = _mm256_packs_epi32(
+					_mm256_add_epi32(q4, _mm256_set1_epi32('!')),
+					digit_avx2(q3, q4));
+				const __m256i d23 = _mm256_packs_epi32(
+					digit_avx2(q2, q3), digit_avx2(q1, q2));
+				const __m256i d4 = _mm256_packs_epi32(
+					digit_avx2(x, q1), digit_avx2(x, q1));
+				// Digit j of group k at 4 * j + k per lane
+				const __m256i d0123 = _mm256_packus_epi16(d01, d23);
+				const __m256i d4444 = _mm256_packus_epi16(d4, d4);
+				const __m256i head = _mm256_or_si256(
+					_mm256_shuffle_epi8(d0123, digit_0_3),
+					_mm256_shuffle_epi8(d4444, digit_4));
+				const __m256i tail = _mm256_or_si256(
+					_mm256_shuffle_epi8(d0123, tail_0_3),
+					_mm256_shuffle_epi8(d4444, tail_4));
+				uint8_t tail_buffer[32];
+
+				_mm256_storeu_si256(
+					reinterpret_cast<__m256i *>(tail_buffer), tail);
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(p),
+								 _mm256_castsi256_si128(head));
+				memcpy(p + 16, tail_buffer, 4);
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(p + 20),
+								 _mm256_extracti128_si256(head, 1));
+				memcpy(p + 36, tail_buffer + 16, 4);
+				p += 40;
+			}
+			p += ascii85_scalar(p, buffer + 4 * i, ngroup - i);
+
+			return p - encoded;
+		}
+#endif // ENCODER_HAVE_AVX2
+
+		encoder_instruction_set_t detect_instruction_set(void)
+		{
+#ifdef ENCODER_HAVE_AVX2
+			if (__builtin_cpu_supports("avx2")) {
+				return ENCODER_AVX2;
+			}
+#endif // ENCODER_HAVE_AVX2
+#ifdef ENCODER_HAVE_SSE2
+			if (__builtin_cpu_supports("sse2")) {
+				return ENCODER_SSE2;
+			}
+#endif // ENCODER_HAVE_SSE2
+			return ENCODER_SCALAR;
+		}
+
+		encoder_instruction_set_t &selected_instruction_set(void)
+		{
+			static encoder_instruction_set_t instruction_set =
+				detect_instruction_set();
+
+			return instruction_set;
+		}
+
+		void asciihex(char *encoded, const uint8_t *buffer,
+					  const size_t length)
+		{
+			switch (selected_instruction_set()) {
+#ifdef ENCODER_HAVE_AVX2
+			case ENCODER_AVX2:
+				asciihex_avx2(encoded, buffer, length);
+				break;
+#endif // ENCODER_HAVE_AVX2
+#ifdef ENCODER_HAVE_SSE2
+			case ENCODER_SSE2:
+				asciihex_sse2(encoded, buffer, length);
+				break;
+#endif // ENCODER_HAVE_SSE2
+			default:
+				asciihex_scalar(encoded, buffer, length);
+			}
+		}
+
+		size_t ascii85(char *encoded, const uint8_t *buffer,
+					   const size_t ngroup)
+		{
+			switch (selected_instruction_set()) {
+#ifdef ENCODER_HAVE_AVX2
+			case ENCODER_AVX2:
+				return ascii85_avx2(encoded, buffer, ngroup);
+#endif // ENCODER_HAVE_AVX2
+#ifdef ENCODER_HAVE_SSE2
+			case ENCODER_SSE2:
+				return ascii85_sse2(encoded, buffer, ngroup);
+#endif // ENCODER_HAVE_SSE2
+			default:
+				return ascii85_scalar(encoded, buffer, ngroup);
+			}
+		}
+
+	}
+
+	encoder_instruction_set_t encoder_instruction_set(void)
+	{
+		return selected_instruction_set();
+	}
+
+	bool set_encoder_instruction_set(
+		const encoder_instruction_set_t instruction_set)
+	{
+		switch (instruction_set) {
+		case ENCODER_SCALAR:
+			break;
+#ifdef ENCODER_HAVE_SSE2
+		case ENCODER_SSE2:
+			if (!__builtin_cpu_supports("sse2")) {
+				return false;
+			}
+			break;
+#endif // ENCODER_HAVE_SSE2
+#ifdef ENCODER_HAVE_AVX2
+		case ENCODER_AVX2:
+			if (!__builtin_cpu_supports("avx2")) {
+				return false;
+			}
+			break;
+#endif // ENCODER_HAVE_AVX2
+		default:
+			return false;
+		}
+		selected_instruction_set() = instruction_set;
+
+		return true;
+	}
+
+	font_sink_t::~font_sink_t(void)
+	{
+	}
+
+	void font_sink_t::put(const char *string)
+	{
+		write(reinterpret_cast<const uint8_t *>(string), strlen(string));
+	}
+
+	void font_sink_t::put(const std::string &string)
+	{
+		write(reinterpret_cast<const uint8_t *>(string.data()),
+			  string.size());
+	}
+
+	void font_sink_t::printf(const char *format, ...)
+	{
+		char buffer[BUFSIZ];
+		va_list ap;
+
+		va_start(ap, format);
+
+		const int length = vsnprintf(buffer, BUFSIZ, format, ap);
+
+		va_end(ap);
+		if (length < 0) {
+			return;
+		}
+		if (length < BUFSIZ) {
+			write(reinterpret_cast<const uint8_t *>(buffer), length);
+			return;
+		}
+
+		std::vector<char> long_buffer(length + 1);
+
+		va_start(ap, format);
+		vsnprintf(&long_buffer[0], long_buffer.size(), format, ap);
+		va_end(ap);
+		write(reinterpret_cast<const uint8_t *>(&long_buffer[0]),
+			  length);
+	}
+
+	file_sink_t::file_sink_t(FILE *fp)
+		: _fp(fp), _length(0)
+	{
+	}
+
+	void file_sink_t::write(const uint8_t *buffer, const size_t length)
+	{
+		fwrite(buffer, sizeof(uint8_t), length, _fp);
+		_length += length;
+	}
+
+	fd_sink_t::fd_sink_t(const int fd)
+		: _fd(fd), _buffer(65536), _buffer_length(0)
+	{
+	}
+
+	fd_sink_t::~fd_sink_t(void)
+	{
+		flush();
+	}
+
+	void fd_sink_t::write(const uint8_t *buffer, const size_t length)
+	{
+		if (_buffer_length + length > _buffer.size()) {
+			flush();
+		}
+		if (length >= _buffer.size()) {
+			// Too long to be worth buffering
+			size_t offset = 0;
+
+			while (offset < length) {
+				const ssize_t written =
+					::write(_fd, buffer + offset, length - offset);
+
+				if (written <= 0) {
+					perror("write");
+					return;
+				}
+				offset += written;
+			}
+			return;
+		}
+		memcpy(&_buffer[_buffer_length], buffer, length);
+		_buffer_length += length;
+	}
+
+	void fd_sink_t::flush(void)
+	{
+		size_t offset = 0;
+
+		while (offset < _buffer_length) {
+			const ssize_t written =
+				::write(_fd, &_buffer[offset], _buffer_length - offset);
+
+			if (written <= 0) {
+				perror("write");
+				break;
+			}
+			offset += written;
+		}
+		_buffer_length = 0;
+	}
+
+	string_sink_t::string_sink_t(std::string &string)
+		: _string(string)
+	{
+	}
+
+	void string_sink_t::write(const uint8_t *buffer, const size_t length)
+	{
+		_string.append(reinterpret_cast<const char *>(buffer), length);
+	}
+
+	asciihex_sink_t::asciihex_sink_t(font_sink_t &sink)
+		: _sink(sink), _column(0), _encoded(2 * encode_block_size),
+		  _wrapped(2 * encode_block_size +
+				   2 * encode_block_size / ascii_line_width + 1)
+	{
+	}
+
+	void asciihex_sink_t::write(const uint8_t *buffer,
+								const size_t length)
+	{
+		for (size_t offset = 0; offset < length;
+			 offset += encode_block_size) {
+			const size_t block_length =
+				std::min(encode_block_size, length - offset);
+
+			asciihex(&_encoded[0], buffer + offset, block_length);
+			_sink.write(reinterpret_cast<const uint8_t *>(&_wrapped[0]),
+						wrap_line(&_wrapped[0], &_encoded[0],
+								  2 * block_length, _column));
+		}
+	}
+
+	ascii85_sink_t::ascii85_sink_t(font_sink_t &sink)
+		: _sink(sink), _tuple_length(0), _column(0),
+		  _encoded(5 * encode_block_size / 4 + 5),
+		  _wrapped(5 * encode_block_size / 4 + 5 +
+				   (5 * encode_block_size / 4 + 5) /
+				   ascii_line_width + 1)
+	{
+	}
+
+	void ascii85_sink_t::put_encoded(const size_t length)
+	{
+		_sink.write(reinterpret_cast<const uint8_t *>(&_wrapped[0]),
+					wrap_line(&_wrapped[0], &_encoded[0], length,
+							  _column));
+	}
+
+	void ascii85_sink_t::write(const uint8_t *buffer,
+							   const size_t length)
+	{
+		size_t offset = 0;
+
+		// Complete the group left over from the previous write
+		if (_tuple_length > 0) {
+			while (_tuple_length < 4 && offset < length) {
+				_tuple[_tuple_length++] = buffer[offset++];
+			}
+			if (_tuple_length < 4) {
+				return;
+			}
+			put_encoded(ascii85_scalar(&_encoded[0], _tuple, 1));
+			_tuple_length = 0;
+		}
+		while (length - offset >= 4) {
+			const size_t ngroup =
+				std::min(encode_block_size, length - offset) >> 2;
+
+			put_encoded(ascii85(&_encoded[0], buffer + offset, ngroup));
+			offset += ngroup << 2;
+		}
+		while (offset < length) {
+			_tuple[_tuple_length++] = buffer[offset++];
+		}
+	}
+
+	void ascii85_sink_t::finish(void)
+	{
+		if (_tuple_length > 0) {
+			// A partial group of n bytes is padded with zeros, and
+			// written as its first n + 1 characters, never as "z"
+			std::fill(_tuple + _tuple_length, _tuple + 4, 0);
+			ascii85_digit(&_encoded[0], load_uint32_be(_tuple));
+			put_encoded(_tuple_length + 1);
+			_tuple_length = 0;
+		}
+
+		std::string ascii;
+
+		// Keep the end-of-data marker on one line
+		if (_column > ascii_line_width - 2) {
+			ascii.append(1, '\n');
+		}
+		ascii.append("~>");
+		_column = 0;
+		_sink.put(ascii);
+	}
+
+	run_length_sink_t::run_length_sink_t(font_sink_t &sink)
+		: _sink(sink), _literal_length(0), _run_byte(0), _run_length(0),
+		  _buffer(encode_block_size), _buffer_length(0)
+	{
+	}
+
+	void run_length_sink_t::flush_buffer(void)
+	{
+		_sink.write(&_buffer[0], _buffer_length);
+		_buffer_length = 0;
+	}
+
+	void run_length_sink_t::put_literal(void)
+	{
+		if (_literal_length == 0) {
+			return;
+		}
+		if (_buffer_length + 1 + _literal_length > _buffer.size()) {
+			flush_buffer();
+		}
+		_buffer[_buffer_length++] = _literal_length - 1;
+		memcpy(&_buffer[_buffer_length], _literal, _literal_length);
+		_buffer_length += _literal_length;
+		_literal_length = 0;
+	}
+
+	// Runs of less than 3 bytes take no more space as part of a
+	// literal, and do not split it
+	void run_length_sink_t::put_run(void)
+	{
+		if (_run_length >= 3) {
+			put_literal();
+			if (_buffer_length + 2 > _buffer.size()) {
+				flush_buffer();
+			}
+			_buffer[_buffer_length++] = 257 - _run_length;
+			_buffer[_buffer_length++] = _run_byte;
+		}
+		else {
+			for (unsigned int i = 0; i < _run_length; i++) {
+				_literal[_literal_length++] = _run_byte;
+				if (_literal_length == sizeof(_literal)) {
+					put_literal();
+				}
+			}
+		}
+		_run_length = 0;
+	}
+
+	void run_length_sink_t::write(const uint8_t *buffer,
+								  const size_t length)
+	{
+		for (size_t i = 0; i < length; i++) {
+			if (_run_length > 0 && buffer[i] == _run_byte &&
+				_run_length < 128) {
+				_run_length++;
+			}
+			else {
+				put_run();
+				_run_byte = buffer[i];
+				_run_length = 1;
+			}
+		}
+	}
+
+	void run_length_sink_t::finish(void)
+	{
+		put_run();
+		put_literal();
+		if (_buffer_length + 1 > _buffer.size()) {
+			flush_buffer();
+		}
+		_buffer[_buffer_length++] = 128;
+		flush_buffer();
+	}
+
+	base64_sink_t::base64_sink_t(font_sink_t &sink)
+		: _sink(sink), _tuple_length(0),
+		  _encoded(4 * (encode_block_size / 3) + 4)
+	{
+	}
+
+	void base64_sink_t::write(const uint8_t *buffer,
+							  const size_t length)
+	{
+		size_t offset = 0;
+
+		while (offset < length) {
+			// Each block is encoded as whole groups of 3 bytes,
+			// beginning with the group left over from the previous
+			// write
+			char *p = &_encoded[0];
+
+			while (offset < length &&
+				   p - &_encoded[0] < static_cast<ptrdiff_t>(
+					   _encoded.size() - 4)) {
+				_tuple[_tuple_length++] = buffer[offset++];
+				if (_tuple_length == 3) {
+					const uint32_t group = (_tuple[0] << 16) |
+						(_tuple[1] << 8) | _tuple[2];
+
+					p[0] = base64_digit[group >> 18];
+					p[1] = base64_digit[(group >> 12) & 63];
+					p[2] = base64_digit[(group >> 6) & 63];
+					p[3] = base64_digit[group & 63];
+					p += 4;
+					_tuple_length = 0;
+				}
+			}
+			_sink.write(reinterpret_cast<const uint8_t *>(&_encoded[0]),
+						p - &_encoded[0]);
+		}
+	}
+
+	void base64_sink_t::finish(void)
+	{
+		if (_tuple_length == 0) {
+			return;
+		}
+
+		std::fill(_tuple + _tuple_length, _tuple + 3, 0);
+
+		const uint32_t group = (_tuple[0] << 16) | (_tuple[1] << 8) |
+			_tuple[2];
+		char ascii[4] = {
+			base64_digit[group >> 18], base64_digit[(group >> 12) & 63],
+			base64_digit[(group >> 6) & 63], base64_digit[group & 63]
+		};
+
+		// A partial group of n bytes is written as n + 1 digits
+		std::fill(ascii + _tuple_length + 1, ascii + 4, '=');
+		_sink.write(reinterpret_cast<const uint8_t *>(ascii), 4);
+		_tuple_length = 0;
+	}
+
+#ifdef HAVE_ZLIB
+	deflate_sink_t::deflate_sink_t(font_sink_t &sink, const int level)
+		: _sink(sink), _buffer(65536)
+	{
+		_stream.zalloc = Z_NULL;
+		_stream.zfree = Z_NULL;
+		_stream.opaque = Z_NULL;
+		if (deflateInit(&_stream, level) != Z_OK) {
+			fprintf(stderr, "%s:%d: error: deflateInit: %s\n",
+					__FILE__, __LINE__, _stream.msg);
+		}
+	}
+
+	deflate_sink_t::~deflate_sink_t(void)
+	{
+		deflateEnd(&_stream);
+	}
+
+	void deflate_sink_t::deflate_buffer(const int flush)
+	{
+		int ret;
+
+		do {
+			_stream.next_out = &_buffer[0];
+			_stream.avail_out = _buffer.size();
+			ret = deflate(&_stream, flush);
+			if (ret == Z_STREAM_ERROR) {
+				fprintf(stderr, "%s:%d: error: deflate\n",
+						__FILE__, __LINE__);
+				return;
+			}
+			_sink.write(&_buffer[0],
+						_buffer.size() - _stream.avail_out);
+		} while (_stream.avail_out == 0 ||
+				 (flush == Z_FINISH && ret != Z_STREAM_END));
+	}
+
+	void deflate_sink_t::write(const uint8_t *buffer,
+							   const size_t length)
+	{
+		// zlib takes the input length as uInt
+		for (size_t offset = 0; offset < length;) {
+			const size_t block_length =
+				std::min(length - offset, static_cast<size_t>(1U << 30));
+
+			_stream.next_in = const_cast<Bytef *>(buffer + offset);
+			_stream.avail_in = block_length;
+			deflate_buffer(Z_NO_FLUSH);
+			offset += block_length;
+		}
+	}
+
+	void deflate_sink_t::finish(void)
+	{
+		_stream.next_in = Z_NULL;
+		_stream.avail_in = 0;
+		deflate_buffer(Z_FINISH);
+	}
+#endif // HAVE_ZLIB
+
+}
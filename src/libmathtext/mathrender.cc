@@ -17,8 +17,10 @@
 // 02110-1301 USA
 
 #include <cmath>
+#include <cstdio>
 #include <algorithm>
 #include <sstream>
+#include <typeinfo>
 #include <mathtext/mathrender.h>
 
 /////////////////////////////////////////////////////////////////////
@@ -149,55 +151,165 @@ namespace mathtext {
 
 	bounding_box_t math_text_renderer_t::
 	math_bounding_box(const math_text_t::box_t &box,
-					  const unsigned int style)
+					  const unsigned int style) const
 	{
-		set_font_size(style_size(style), FAMILY_REGULAR);
+		return bounding_box(box._string, FAMILY_REGULAR,
+							style_size(style));
+	}
 
-		const bounding_box_t box_bounding_box =
-			bounding_box(box._string, FAMILY_REGULAR);
+	math_text_renderer_t::math_token_t math_text_renderer_t::
+	math_layout(math_layout_t &layout,
+				const math_text_t::box_t &box,
+				const unsigned int style) const
+	{
+#ifdef MATHTEXT_STATISTICS
+		layout._statistics.count(statistics_t::COUNTER_LAYOUT_BOX);
+		layout._statistics.count(statistics_t::COUNTER_BOUNDING_BOX);
+#endif // MATHTEXT_STATISTICS
 
-		reset_font_size(FAMILY_REGULAR);
+		math_token_t token(math_token_t::TYPE_BOX,
+						   math_bounding_box(box, style));
 
-		return box_bounding_box;
-	}
+		token._family = FAMILY_REGULAR;
+		token._size = style_size(style);
+		token._begin = layout._string.size();
+		layout._string.push_back(box._string);
 
-	void math_text_renderer_t::
-	math_text(const point_t origin,
-			  const math_text_t::box_t &box,
-			  const unsigned int style,
-			  const bool render_structure)
-	{
-		if (render_structure) {
-			// Nothing
-		}
-		set_font_size(style_size(style), FAMILY_REGULAR);
-		text_raw(origin[0], origin[1], box._string, FAMILY_REGULAR);
-		reset_font_size(FAMILY_REGULAR);
+		return token;
 	}
 #ifdef __INTEL_COMPILER
 #pragma warning(pop)
 #endif // __INTEL_COMPILER
 
+	// The metrics are cached unscaled, and since outline fonts scale
+	// linearly, only the first size a glyph is requested in is
+	// measured by the surface
 	bounding_box_t math_text_renderer_t::
 	math_bounding_box(const wchar_t &glyph,
 					  const unsigned int family, const float size)
+		const
 	{
-		set_font_size(size, family);
+		const bool cache = family < NFAMILY && size > 0;
 
-		const std::wstring string = std::wstring(1, glyph);
+		if (cache) {
+			lock_t lock(_glyph_metrics_mutex);
+			const std::map<wchar_t, bounding_box_t>::const_iterator
+				iterator = _glyph_metrics[family].find(glyph);
+
+			if (iterator != _glyph_metrics[family].end()) {
+				_glyph_metrics_hit++;
+				return affine_transform_t::scale(size, size) *
+					iterator->second;
+			}
+			_glyph_metrics_miss++;
+		}
+
+		// Measured without holding the lock, two threads missing
+		// the same glyph both measure it and store the same value
 		const bounding_box_t math_symbol_bounding_box =
-			bounding_box(string, family);
+			bounding_box(std::wstring(1, glyph), family, size);
 
-		reset_font_size(family);
+		if (cache) {
+			lock_t lock(_glyph_metrics_mutex);
+
+			_glyph_metrics[family].insert(
+				std::pair<wchar_t, bounding_box_t>(
+					glyph,
+					affine_transform_t::scale(1.0F / size, 1.0F / size) *
+					math_symbol_bounding_box));
+		}
 
 		return math_symbol_bounding_box;
 	}
 
+	bounding_box_t math_text_renderer_t::
+	bounding_box(const std::wstring string, const unsigned int family,
+				 const float size) const
+	{
+		const float current_size = font_size(family);
+
+		if (!(current_size > 0))
+			return bounding_box_t(0, 0, 0, 0, 0, 0);
+
+		const float scale = size / current_size;
+		// The two-argument bounding_box() only reads the renderer,
+		// although it is not declared const, but may use font
+		// libraries that are not thread-safe
+		lock_t lock(_bounding_box_mutex);
+
+		return affine_transform_t::scale(scale, scale) *
+			const_cast<math_text_renderer_t *>(this)->
+			bounding_box(string, family);
+	}
+
+	unsigned long math_text_renderer_t::next_font_serial(void)
+	{
+		static unsigned long font_serial = 0;
+
+#ifdef __GNUC__
+		return __sync_add_and_fetch(&font_serial, 1UL);
+#else // __GNUC__
+		return ++font_serial;
+#endif // __GNUC__
+	}
+
+	// A NUL character, which is never part of a file name, marks
+	// fonts that are known only to their renderer
+	std::string math_text_renderer_t::unique_font_identity(void)
+	{
+		char buffer[32];
+
+		snprintf(buffer, 32, "%lu", next_font_serial());
+
+		return std::string(1, '\0') + buffer;
+	}
+
+	void math_text_renderer_t::
+	reset_glyph_metrics(const unsigned int family,
+						const std::string &font_name)
+	{
+		lock_t lock(_glyph_metrics_mutex);
+
+		if (family < NFAMILY) {
+			_glyph_metrics[family].clear();
+			_font_identity[family] = font_name.empty() ?
+				unique_font_identity() : font_name;
+		}
+	}
+
+	void math_text_renderer_t::reset_glyph_metrics(void)
+	{
+		lock_t lock(_glyph_metrics_mutex);
+
+		for (unsigned int family = 0; family < NFAMILY; family++) {
+			_glyph_metrics[family].clear();
+			_font_identity[family] = unique_font_identity();
+		}
+	}
+
+	std::string math_text_renderer_t::font_identity(void) const
+	{
+		lock_t lock(_glyph_metrics_mutex);
+		std::string ret = typeid(*this).name();
+
+		for (unsigned int family = 0; family < NFAMILY; family++) {
+			ret.push_back('\n');
+			ret.append(_font_identity[family]);
+		}
+
+		return ret;
+	}
+
 	void math_text_renderer_t::
 	math_text(const point_t origin, const wchar_t &glyph,
 			  const unsigned int family, const float size,
 			  const bool render_structure)
 	{
+#ifdef MATHTEXT_STATISTICS
+		if (font_size(family) != size)
+			count(statistics_t::COUNTER_FONT_SIZE_CHANGE);
+		count(statistics_t::COUNTER_GLYPH);
+#endif // MATHTEXT_STATISTICS
 		set_font_size(size, family);
 
 		const std::wstring string = std::wstring(1, glyph);
@@ -207,420 +319,430 @@ namespace mathtext {
 								   family);
 		}
 		else {
+#ifdef MATHTEXT_STATISTICS
+			count(statistics_t::COUNTER_TEXT_RAW);
+#endif // MATHTEXT_STATISTICS
 			text_raw(origin[0], origin[1], string, family);
 		}
 		reset_font_size(family);
 	}
 
-	bounding_box_t math_text_renderer_t::
-	math_bounding_box(const math_text_t::math_symbol_t &math_symbol,
-					  const unsigned int style)
+	math_text_renderer_t::math_token_t math_text_renderer_t::
+	math_layout(math_layout_t &layout,
+				const math_text_t::math_symbol_t &math_symbol,
+				const unsigned int style) const
 	{
+#ifdef MATHTEXT_STATISTICS
+		layout._statistics.count(
+			statistics_t::COUNTER_LAYOUT_MATH_SYMBOL);
+#endif // MATHTEXT_STATISTICS
 		const unsigned int family = math_family(math_symbol);
 		const float size = style_size(style);
 
-		return math_bounding_box(math_symbol._glyph, family, size);
+		return math_token_t(
+			math_bounding_box(math_symbol._glyph, family, size),
+			math_symbol._glyph, family, size);
 	}
 
-	void math_text_renderer_t::
-	math_text(const point_t origin,
-			  const math_text_t::math_symbol_t &math_symbol,
-			  const unsigned int style,
-			  const bool render_structure)
-	{
-		const unsigned int family = math_family(math_symbol);
-		const float size = style_size(style);
-
-		math_text(origin, math_symbol._glyph, family, size,
-				  render_structure);
-	}
+	/////////////////////////////////////////////////////////////////
 
-	bounding_box_t math_text_renderer_t::
-	math_bounding_box(const math_text_t::math_symbol_t &math_symbol,
-					  const unsigned int style, const float height)
+	// Append the tokens of a list to the layout, and return the
+	// list token that refers to them
+	math_text_renderer_t::math_token_t math_text_renderer_t::
+	math_layout_list(math_layout_t &layout,
+					 const std::vector<math_token_t> &token_list)
+		const
 	{
-		std::vector<math_token_t> token =
-			math_tokenize(math_symbol, style, height);
-
-		if (token.empty())
-			return bounding_box_t(0, 0, 0, 0, 0, 0);
+		if (token_list.empty())
+			return math_token_t(math_token_t::TYPE_SPACE,
+								bounding_box_t(0, 0, 0, 0, 0, 0));
 
 		std::vector<math_token_t>::const_iterator iterator =
-			token.begin();
-		bounding_box_t ret = iterator->_offset +
+			token_list.begin();
+		bounding_box_t bounding_box = iterator->_offset +
 			iterator->_bounding_box;
 
-		for (; iterator != token.end(); iterator++)
-			ret = ret.merge(iterator->_offset +
-							iterator->_bounding_box);
+		for (; iterator != token_list.end(); iterator++)
+			bounding_box = bounding_box.merge(iterator->_offset +
+											  iterator->_bounding_box);
 
-		return ret;
+		math_token_t token(math_token_t::TYPE_LIST, bounding_box);
+
+		token._begin = layout._token.size();
+		layout._token.insert(layout._token.end(),
+							 token_list.begin(), token_list.end());
+		token._end = layout._token.size();
+
+		return token;
 	}
 
-	void math_text_renderer_t::
-	math_text(const point_t origin,
-			  const math_text_t::math_symbol_t &math_symbol,
-			  const unsigned int style, const float height,
-			  const bool render_structure)
+	// A field can be a math symbol or a math list
+	math_text_renderer_t::math_token_t math_text_renderer_t::
+	math_layout(math_layout_t &layout,
+				const math_text_t::field_t &field,
+				const unsigned int style) const
 	{
-		std::vector<math_token_t> token =
-			math_tokenize(math_symbol, style, height);
+#ifdef MATHTEXT_STATISTICS
+		layout._statistics.count(statistics_t::COUNTER_LAYOUT_FIELD);
+#endif // MATHTEXT_STATISTICS
+		switch (field._type) {
+		case math_text_t::field_t::TYPE_MATH_SYMBOL:
+			return math_layout(layout, field._math_symbol, style);
+			break;
+		case math_text_t::field_t::TYPE_BOX:
+			return math_layout(layout, field._box, style);
+			break;
+		case math_text_t::field_t::TYPE_MATH_LIST:
+			{
+				const math_token_t *memo =
+					layout.find_memo(&field, style);
 
-		for (std::vector<math_token_t>::const_iterator iterator =
-				token.begin();
-			iterator != token.end(); iterator++)
-			math_text(origin +
-					  transform_pixel_to_logical().linear() *
-					  iterator->_offset,
-					  iterator->_extensible._glyph,
-					  iterator->_extensible._family,
-					  iterator->_extensible._size, render_structure);
+				if (memo != NULL)
+					return *memo;
+			}
+			return math_layout(layout, field._math_list.begin(),
+							   field._math_list.end(), style);
+			break;
+		default:
+			return math_token_t(math_token_t::TYPE_SPACE,
+								bounding_box_t(0, 0, 0, 0, 0, 0));
+		}
 	}
 
-	/////////////////////////////////////////////////////////////////
+	math_text_renderer_t::math_token_t math_text_renderer_t::
+	math_layout(math_layout_t &layout,
+				const math_text_t::atom_t &atom,
+				const unsigned int style) const
+	{
+#ifdef MATHTEXT_STATISTICS
+		layout._statistics.count(statistics_t::COUNTER_LAYOUT_ATOM);
+#endif // MATHTEXT_STATISTICS
+		const math_token_t *memo = layout.find_memo(&atom, style);
 
-	// A field can be a math symbol or a math list
+		if (memo != NULL)
+			return *memo;
+
+		return math_layout_atom(layout, atom, style);
+	}
+
+	// Measure a field, where TeX only needs the dimensions of a box.
+	// The tokens are kept and memoized, for when the same field is
+	// set in the same style.
 	bounding_box_t math_text_renderer_t::
-	math_bounding_box(const std::vector<math_text_t::item_t>::
-					  const_iterator &math_list_begin,
-					  const std::vector<math_text_t::item_t>::
-					  const_iterator &math_list_end,
-					  unsigned int style)
+	math_bounding_box(math_layout_t &layout,
+					  const math_text_t::field_t &field,
+					  const unsigned int style) const
 	{
-		std::vector<math_token_t> token =
-			math_tokenize(math_list_begin, math_list_end, style);
+		const math_token_t token = math_layout(layout, field, style);
 
-		if (token.empty())
-			return bounding_box_t(0, 0, 0, 0, 0, 0);
+		if (field._type == math_text_t::field_t::TYPE_MATH_LIST)
+			layout._memo[std::make_pair(
+				static_cast<const void *>(&field), style)] = token;
 
-		std::vector<math_token_t>::const_iterator iterator =
-			token.begin();
-		bounding_box_t ret = iterator->_offset +
-			iterator->_bounding_box;
+		return token._bounding_box;
+	}
 
-		for (; iterator != token.end(); iterator++)
-			ret = ret.merge(iterator->_offset +
-							iterator->_bounding_box);
+	bounding_box_t math_text_renderer_t::
+	math_bounding_box(math_layout_t &layout,
+					  const math_text_t::atom_t &atom,
+					  const unsigned int style) const
+	{
+		const math_token_t token = math_layout(layout, atom, style);
 
-		return ret;
+		layout._memo[std::make_pair(
+			static_cast<const void *>(&atom), style)] = token;
+
+		return token._bounding_box;
 	}
 
+	/////////////////////////////////////////////////////////////////
+
+	// Draw the layout, except for the glyphs, which are collected
+	// to be drawn in runs by math_text(std::vector<math_glyph_t> &)
 	void math_text_renderer_t::
-	math_text(const point_t origin,
-			  const std::vector<math_text_t::item_t>::
-			  const_iterator &math_list_begin,
-			  const std::vector<math_text_t::item_t>::
-			  const_iterator &math_list_end,
-			  const unsigned int style,
+	math_text(std::vector<math_glyph_t> &glyph, const point_t origin,
+			  const math_layout_t &layout, const math_token_t &token,
 			  const bool render_structure)
 	{
-		if (render_structure) {
-			point(origin[0], origin[1]);
-			rectangle(origin +
-					  math_bounding_box(math_list_begin,
-										math_list_end, style));
+		switch (token._type) {
+		case math_token_t::TYPE_GLYPH:
+			if (render_structure)
+				math_text(origin, token._glyph, token._family,
+						  token._size, render_structure);
+			else
+				glyph.push_back(math_glyph_t(
+					origin, token._glyph, token._family,
+					token._size));
+			break;
+		case math_token_t::TYPE_BOX:
+#ifdef MATHTEXT_STATISTICS
+			if (font_size(token._family) != token._size)
+				count(statistics_t::COUNTER_FONT_SIZE_CHANGE);
+			count(statistics_t::COUNTER_TEXT_RAW);
+#endif // MATHTEXT_STATISTICS
+			set_font_size(token._size, token._family);
+			text_raw(origin[0], origin[1],
+					 layout._string[token._begin], token._family);
+			reset_font_size(token._family);
+			break;
+		case math_token_t::TYPE_RULE:
+			filled_rectangle(origin +
+							 transform_pixel_to_logical().linear() *
+							 token._bounding_box);
+			break;
+		case math_token_t::TYPE_LIST:
+			if (render_structure) {
+				point(origin[0], origin[1]);
+				rectangle(origin + token._bounding_box);
+			}
+			for (unsigned long i = token._begin; i < token._end; i++)
+				math_text(glyph, origin +
+						  transform_pixel_to_logical().linear() *
+						  layout._token[i]._offset,
+						  layout, layout._token[i], render_structure);
+			break;
 		}
+		// math_token_t::TYPE_SPACE can be ignored
+	}
 
-		std::vector<math_text_t::item_t>::const_iterator
-			math_list_begin_interior = math_list_begin;
-		std::vector<math_text_t::item_t>::const_iterator
-			math_list_end_interior = math_list_end;
-		bool delimiter = false;
-
-		if (math_list_begin->_type ==
-		   math_text_t::item_t::TYPE_BOUNDARY &&
-		   (math_list_end - 1)->_type ==
-		   math_text_t::item_t::TYPE_BOUNDARY) {
-			math_list_begin_interior++;
-			math_list_end_interior--;
-			delimiter = true;
+	void math_text_renderer_t::
+	math_text(std::vector<math_glyph_t> &glyph)
+	{
+		// Stable, so that glyphs within a run keep their order
+		std::stable_sort(glyph.begin(), glyph.end());
+#ifdef MATHTEXT_STATISTICS
+		count(statistics_t::COUNTER_GLYPH, glyph.size());
+#endif // MATHTEXT_STATISTICS
+		prepare_glyph_run(glyph.begin(), glyph.end());
+
+		math_glyph_iterator_t glyph_begin = glyph.begin();
+
+		while (glyph_begin != glyph.end()) {
+			math_glyph_iterator_t glyph_end = glyph_begin + 1;
+
+			while (glyph_end != glyph.end() &&
+				  !(*glyph_begin < *glyph_end))
+				glyph_end++;
+#ifdef MATHTEXT_STATISTICS
+			count(statistics_t::COUNTER_GLYPH_RUN);
+#endif // MATHTEXT_STATISTICS
+			glyph_run(glyph_begin, glyph_end);
+			glyph_begin = glyph_end;
 		}
+	}
 
-		std::vector<math_token_t> token =
-			math_tokenize(math_list_begin, math_list_end, style);
-		std::vector<math_token_t>::const_iterator token_iterator =
-			token.begin();
-
-		if (delimiter) {
-			math_text(origin +
-					  transform_pixel_to_logical().linear() *
-					  token_iterator->_offset,
-					  math_list_begin->_atom._nucleus._math_symbol,
-					  style, token_iterator->_delimiter_height,
-					  render_structure);
-			token_iterator++;
-		}
+	void math_text_renderer_t::
+	glyph_run(const math_glyph_iterator_t &glyph_begin,
+			  const math_glyph_iterator_t &glyph_end)
+	{
+#ifdef MATHTEXT_STATISTICS
+		if (font_size(glyph_begin->_family) != glyph_begin->_size)
+			count(statistics_t::COUNTER_FONT_SIZE_CHANGE);
+		count(statistics_t::COUNTER_TEXT_RAW, glyph_end - glyph_begin);
+#endif // MATHTEXT_STATISTICS
+		set_font_size(glyph_begin->_size, glyph_begin->_family);
+		for (math_glyph_iterator_t iterator = glyph_begin;
+			iterator != glyph_end; iterator++)
+			text_raw(iterator->_origin[0], iterator->_origin[1],
+					 std::wstring(1, iterator->_glyph),
+					 iterator->_family);
+		reset_font_size(glyph_begin->_family);
+	}
 
-		static const math_text_t::item_t fraction_item =
-			math_text_t::item_t::TYPE_GENERALIZED_FRACTION;
-		const std::vector<math_text_t::item_t>::const_iterator
-			fraction_iterator =
-			std::find(math_list_begin_interior,
-					  math_list_end_interior, fraction_item);
-
-		if (fraction_iterator != math_list_end_interior) {
-			const float thickness = fraction_iterator->_length *
-				default_rule_thickness * style_size(style);
-
-			math_text(origin +
-					  transform_pixel_to_logical().linear() *
-					  token_iterator->_offset,
-					  fraction_iterator + 1, math_list_end_interior,
-					  token_iterator->_style,
-					  render_structure);
-			token_iterator++;
-			if (thickness > 0) {
-				filled_rectangle(
-					origin +
-					transform_pixel_to_logical().linear() *
-					(token_iterator->_offset +
-					 token_iterator->_bounding_box));
-				token_iterator++;
-			}
-			math_text(origin +
-					  transform_pixel_to_logical().linear() *
-					  token_iterator->_offset,
-					  math_list_begin_interior, fraction_iterator,
-					  token_iterator->_style,
-					  render_structure);
-			token_iterator++;
+	math_text_renderer_t::math_layout_t math_text_renderer_t::
+	layout(const math_text_t &text, const bool display_style) const
+	{
+		math_layout_t layout;
+#ifdef MATHTEXT_STATISTICS
+		const statistics_t glyph_metrics = glyph_metrics_statistics();
+		const double start = statistics_t::now();
+
+		layout._statistics.count(statistics_t::COUNTER_FORMULA);
+		layout._statistics._time[statistics_t::TIMER_PARSE] =
+			text._parse_time;
+#endif // MATHTEXT_STATISTICS
+
+		layout._render_structure = text._render_structure;
+		if (!text.well_formed()) {
+			const std::wstring string = L"*** invalid: " + text.code();
+
+			const float size = font_size(FAMILY_PLAIN);
+
+			layout._root = math_token_t(
+				math_token_t::TYPE_BOX,
+				bounding_box(string, FAMILY_PLAIN, size));
+			layout._root._family = FAMILY_PLAIN;
+			layout._root._size = size;
+			layout._string.push_back(string);
+#ifdef MATHTEXT_STATISTICS
+			layout._statistics.count(
+				statistics_t::COUNTER_BOUNDING_BOX);
+#endif // MATHTEXT_STATISTICS
 		}
-		else
-			// Incrementally process a math list
-			for (std::vector<math_text_t::item_t>::const_iterator
-					iterator = math_list_begin_interior;
-				iterator != math_list_end_interior; iterator++) {
-			switch (iterator->_type) {
-			case math_text_t::item_t::TYPE_ATOM:
-				if (render_structure)
-					rectangle(origin +
-							  transform_pixel_to_logical().linear() *
-							  (token_iterator->_offset +
-							   token_iterator->_bounding_box));
-				math_text(origin +
-						  transform_pixel_to_logical().linear() *
-						  token_iterator->_offset,
-						  iterator->_atom,
-						  token_iterator->_style,
-						  render_structure);
-				token_iterator++;
-				break;
-			}
-			// math_text_t::item_t::TYPE_KERN can be ignored
+		else {
+			const unsigned int initial_style = display_style ?
+				math_text_t::item_t::STYLE_DISPLAY :
+				math_text_t::item_t::STYLE_TEXT;
+
+			layout._root = math_layout(
+				layout, text._math_list._math_list.begin(),
+				text._math_list._math_list.end(), initial_style);
+			layout._memo.clear();
 		}
+#ifdef MATHTEXT_STATISTICS
+		layout._statistics._time[statistics_t::TIMER_LAYOUT] =
+			statistics_t::now() - start;
+		layout._statistics += glyph_metrics_statistics();
+		layout._statistics -= glyph_metrics;
 
-		if (delimiter)
-			math_text(origin +
-					  transform_pixel_to_logical().linear() *
-					  token_iterator->_offset,
-					  (math_list_end - 1)->
-					  _atom._nucleus._math_symbol,
-					  token_iterator->_style,
-					  token_iterator->_delimiter_height,
-					  render_structure);
+		lock_t lock(_statistics_mutex);
+
+		_statistics += layout._statistics;
+#endif // MATHTEXT_STATISTICS
+
+		return layout;
 	}
 
 	bounding_box_t math_text_renderer_t::
-	math_bounding_box(const math_text_t::field_t &field,
-					  const unsigned int style)
+	bounding_box(const math_text_t &text, const bool display_style)
+		const
 	{
-		switch (field._type) {
-		case math_text_t::field_t::TYPE_MATH_SYMBOL:
-			return math_bounding_box(field._math_symbol, style);
-			break;
-		case math_text_t::field_t::TYPE_BOX:
-			return math_bounding_box(field._box, style);
-			break;
-		case math_text_t::field_t::TYPE_MATH_LIST:
-			return math_bounding_box(field._math_list.begin(),
-									 field._math_list.end(), style);
-			break;
-		default:
-			return bounding_box_t(0, 0, 0, 0, 0, 0);
-		}
+		return layout(text, display_style).bounding_box();
 	}
 
 	void math_text_renderer_t::
-	math_text(const point_t origin,
-			  const math_text_t::field_t &field,
-			  const unsigned int style, const bool render_structure)
+	text(const float x, const float y, const math_text_t &text,
+		 const bool display_style)
 	{
-		switch (field._type) {
-		case math_text_t::field_t::TYPE_MATH_SYMBOL:
-			math_text(origin, field._math_symbol, style,
-					  render_structure);
-			break;
-		case math_text_t::field_t::TYPE_BOX:
-			math_text(origin, field._box, style, render_structure);
-			break;
-		case math_text_t::field_t::TYPE_MATH_LIST:
-			math_text(origin, field._math_list.begin(),
-					  field._math_list.end(), style,
-					  render_structure);
-			break;
+		this->text(x, y, layout(text, display_style));
+	}
+
+	void math_text_renderer_t::
+	text(const float x, const float y, const math_layout_t &layout)
+	{
+#ifdef MATHTEXT_STATISTICS
+		statistics_t before;
+
+		begin_draw_statistics(before);
+#endif // MATHTEXT_STATISTICS
+		std::vector<math_glyph_t> glyph;
+
+		math_text(glyph, point_t(x, y), layout, layout._root,
+				  layout._render_structure);
+		math_text(glyph);
+#ifdef MATHTEXT_STATISTICS
+		end_draw_statistics(before, layout._statistics);
+#endif // MATHTEXT_STATISTICS
+	}
+
+	void math_text_renderer_t::
+	text(const std::vector<math_text_item_t> &item)
+	{
+		std::vector<point_t> origin;
+		std::vector<math_layout_t> layout;
+
+		origin.reserve(item.size());
+		layout.reserve(item.size());
+		for (std::vector<math_text_item_t>::const_iterator iterator =
+				item.begin();
+			iterator != item.end(); iterator++) {
+			origin.push_back(point_t(iterator->_x, iterator->_y));
+			layout.push_back(this->layout(*iterator->_math_text,
+										  iterator->_display_style));
 		}
+		text(origin, layout);
 	}
 
-	// TeX algorithm for (three-way) atoms:
-	//
-	// See Knuth, The TeXbook (1986), pp. 445f.
-	bounding_box_t math_text_renderer_t::
-	math_bounding_box(const math_text_t::atom_t &atom,
-					  const unsigned int style)
+	void math_text_renderer_t::
+	text(const std::vector<point_t> &origin,
+		 const std::vector<math_layout_t> &layout)
 	{
-		std::vector<math_token_t> token =
-			math_tokenize(atom, style);
+#ifdef MATHTEXT_STATISTICS
+		statistics_t before;
+		statistics_t layout_statistics;
+
+		begin_draw_statistics(before);
+#endif // MATHTEXT_STATISTICS
+		std::vector<math_glyph_t> glyph;
+		const size_t size = std::min(origin.size(), layout.size());
+
+		for (size_t i = 0; i < size; i++) {
+			math_text(glyph, origin[i], layout[i], layout[i]._root,
+					  layout[i]._render_structure);
+#ifdef MATHTEXT_STATISTICS
+			layout_statistics += layout[i]._statistics;
+#endif // MATHTEXT_STATISTICS
+		}
+		math_text(glyph);
+#ifdef MATHTEXT_STATISTICS
+		end_draw_statistics(before, layout_statistics);
+#endif // MATHTEXT_STATISTICS
+	}
+#ifdef MATHTEXT_STATISTICS
 
-		if (token.empty())
-			return bounding_box_t(0, 0, 0, 0, 0, 0);
+	/////////////////////////////////////////////////////////////////
 
-		std::vector<math_token_t>::const_iterator iterator =
-			token.begin();
-		bounding_box_t ret = iterator->_offset +
-			iterator->_bounding_box;
+	statistics_t math_text_renderer_t::glyph_metrics_statistics(void)
+		const
+	{
+		statistics_t statistics;
+		lock_t lock(_glyph_metrics_mutex);
 
-		for (; iterator != token.end(); iterator++)
-			ret = ret.merge(iterator->_offset +
-							iterator->_bounding_box);
+		// Every cache miss is measured by the surface
+		statistics._counter[statistics_t::COUNTER_BOUNDING_BOX] =
+			_glyph_metrics_miss;
+		statistics._counter[statistics_t::COUNTER_GLYPH_METRICS_HIT] =
+			_glyph_metrics_hit;
 
-		return ret;
+		return statistics;
 	}
 
+	// The counters before drawing, with the start time in place of
+	// the emit time
 	void math_text_renderer_t::
-	math_text(const point_t origin,
-			  const math_text_t::atom_t &atom,
-			  const unsigned int style,
-			  const bool render_structure)
+	begin_draw_statistics(statistics_t &before)
 	{
-		const float x = origin[0];
-		const float y = origin[1];
-
-		if (render_structure) {
-			point(x, y);
-			rectangle(point_t(x, y) +
-					  math_bounding_box(atom, style));
-		}
+		before = glyph_metrics_statistics();
+		before._counter[statistics_t::COUNTER_BYTE_WRITTEN] =
+			output_size();
+		before._time[statistics_t::TIMER_EMIT] = statistics_t::now();
+		_draw_statistics.clear();
+	}
 
-		std::vector<math_token_t> token =
-			math_tokenize(atom, style);
-		std::vector<math_token_t>::const_iterator token_iterator =
-			token.begin();
+	void math_text_renderer_t::
+	end_draw_statistics(const statistics_t &before,
+						const statistics_t &layout)
+	{
+		statistics_t after = glyph_metrics_statistics();
 
-		bounding_box_t nucleus_bounding_box;
+		after._counter[statistics_t::COUNTER_BYTE_WRITTEN] =
+			output_size();
+		after._time[statistics_t::TIMER_EMIT] = statistics_t::now();
+		after -= before;
+		_draw_statistics += after;
+		_formula_statistics = layout;
+		_formula_statistics += _draw_statistics;
 
-		// Rule 11
-		if (atom._type == math_text_t::atom_t::TYPE_RAD) {
-			if (!atom._index.empty()) {
-				math_text(origin +
-						  transform_pixel_to_logical().linear() *
-						  token_iterator->_offset,
-						  atom._index, token_iterator->_style,
-						  render_structure);
-				token_iterator++;
-			}
+		lock_t lock(_statistics_mutex);
 
-			const math_text_t::math_symbol_t
-				symbol_surd("\\surd", style);
-
-			// Surd
-			math_text(origin +
-					  transform_pixel_to_logical().linear() *
-					  token_iterator->_offset,
-					  symbol_surd, token_iterator->_style,
-					  token_iterator->_delimiter_height,
-					  render_structure);
-			token_iterator++;
-			// Rule with clearance
-			filled_rectangle(
-				origin + transform_pixel_to_logical().linear() *
-				(token_iterator->_offset +
-				 token_iterator->_bounding_box));
-			// Skip the clearance token, too
-			token_iterator += 2;
-		}
-		if (atom._type == math_text_t::atom_t::TYPE_OP &&
-		   atom._nucleus._type ==
-		   math_text_t::field_t::TYPE_MATH_SYMBOL)
-			math_text(origin +
-					  transform_pixel_to_logical().linear() *
-					  token_iterator->_offset,
-					  atom._nucleus._math_symbol._glyph,
-					  FAMILY_STIX_REGULAR,
-					  style_size(style) * if_else_display(style,
-							large_operator_display_scale, 1.0F),
-					  render_structure);
-		else
-			math_text(origin +
-					  transform_pixel_to_logical().linear() *
-					  token_iterator->_offset,
-					  atom._nucleus, token_iterator->_style,
-					  render_structure);
-
-		if (atom._superscript.empty() && atom._subscript.empty())
-			return;
-
-		token_iterator++;
-
-		if (atom._superscript.empty()) {
-			math_text(origin +
-					  transform_pixel_to_logical().linear() *
-					  token_iterator->_offset,
-					  atom._subscript, token_iterator->_style,
-					  render_structure);
-			return;
-		}
-		if (atom._subscript.empty()) {
-			math_text(origin +
-					  transform_pixel_to_logical().linear() *
-					  token_iterator->_offset,
-					  atom._superscript, token_iterator->_style,
-					  render_structure);
-			return;
-		}
-		math_text(origin + transform_pixel_to_logical().linear() *
-				  token_iterator->_offset,
-				  atom._superscript, token_iterator->_style,
-				  render_structure);
-		token_iterator++;
-		math_text(origin + transform_pixel_to_logical().linear() *
-				  token_iterator->_offset,
-				  atom._subscript, token_iterator->_style,
-				  render_structure);
+		_statistics += _draw_statistics;
 	}
 
-	bounding_box_t math_text_renderer_t::
-	bounding_box(const math_text_t &text, const bool display_style)
+	statistics_t math_text_renderer_t::statistics(void) const
 	{
-		if (!text.well_formed())
-			bounding_box(L"*** invalid: " + text.code());
-
-		const unsigned int initial_style = display_style ?
-			math_text_t::item_t::STYLE_DISPLAY :
-			math_text_t::item_t::STYLE_TEXT;
+		lock_t lock(_statistics_mutex);
 
-		return math_bounding_box(text._math_list._math_list,
-								 initial_style);
+		return _statistics;
 	}
 
-	void math_text_renderer_t::
-	text(const float x, const float y, const math_text_t &text,
-		 const bool display_style)
+	void math_text_renderer_t::reset_statistics(void)
 	{
-		if (!text.well_formed()) {
-			text_raw(x, y, L"*** invalid: " + text.code());
-		}
-
-		const unsigned int initial_style = display_style ?
-			math_text_t::item_t::STYLE_DISPLAY :
-			math_text_t::item_t::STYLE_TEXT;
+		lock_t lock(_statistics_mutex);
 
-		if (text._render_structure) {
-			point(x, y);
-			rectangle(point_t(x, y) + math_bounding_box(
-				text._math_list._math_list, initial_style));
-		}
-		math_text(point_t(x, y), text._math_list._math_list,
-				  initial_style, text._render_structure);
+		_statistics.clear();
+		_formula_statistics.clear();
 	}
 
+#endif // MATHTEXT_STATISTICS
+
 }
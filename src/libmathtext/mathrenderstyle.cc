@@ -154,18 +154,12 @@ namespace mathtext {
 
 	// The most elementary building block is the math symbol
 	float math_text_renderer_t::x_height(const unsigned int style)
+		const
 	{
 		const unsigned int family = FAMILY_ITALIC;
 		const float size = style_size(style);
 
-		set_font_size(size, family);
-
-		bounding_box_t math_symbol_bounding_box =
-			bounding_box(L"x", family);
-
-		reset_font_size(family);
-
-		return math_symbol_bounding_box.ascent();
+		return math_bounding_box(L'x', family, size).ascent();
 	}
 
 	float math_text_renderer_t::quad(const unsigned int style)
@@ -354,6 +348,7 @@ namespace mathtext {
 	extensible_glyph(wchar_t glyph[4], unsigned long &nrepeat,
 					 const math_text_t::math_symbol_t &math_symbol,
 					 const unsigned int style, const float height)
+		const
 	{
 		// See Knuth, The METAFONTbook (1986), p. 318
 		enum {
@@ -27,13 +27,17 @@ namespace mathtext {
 	/////////////////////////////////////////////////////////////////
 	// Math List Tokenization
 
-	std::vector<math_text_renderer_t::math_token_t>
-	math_text_renderer_t::
-	math_tokenize(const math_text_t::math_symbol_t &math_symbol,
-				  const unsigned int style, const float height)
+	math_text_renderer_t::math_token_t math_text_renderer_t::
+	math_layout(math_layout_t &layout,
+				const math_text_t::math_symbol_t &math_symbol,
+				const unsigned int style, const float height) const
 	{
+#ifdef MATHTEXT_STATISTICS
+		layout._statistics.count(statistics_t::COUNTER_LAYOUT_EXTENSIBLE);
+#endif // MATHTEXT_STATISTICS
 		if (math_symbol._glyph == L'.')
-			return std::vector<math_text_renderer_t::math_token_t>();
+			return math_token_t(math_token_t::TYPE_SPACE,
+								bounding_box_t(0, 0, 0, 0, 0, 0));
 
 		enum {
 			GLYPH_TOP = 0,
@@ -47,13 +51,9 @@ namespace mathtext {
 		const bounding_box_t normal_bounding_box =
 			math_bounding_box(math_symbol._glyph, family, size);
 
-		if (normal_bounding_box.height() >= height) {
-			const math_token_t token(normal_bounding_box,
-									 math_symbol._glyph, family,
-									 size);
-
-			return std::vector<math_token_t>(1, token);
-		}
+		if (normal_bounding_box.height() >= height)
+			return math_token_t(normal_bounding_box,
+								math_symbol._glyph, family, size);
 
 		unsigned long nmath_symbol_large_family;
 		const unsigned int *math_symbol_large_family;
@@ -66,14 +66,11 @@ namespace mathtext {
 				math_bounding_box(math_symbol._glyph,
 								  math_symbol_large_family[i], size);
 
-			if (large_bounding_box.height() >= height) {
-				const math_token_t token(large_bounding_box,
-										 math_symbol._glyph,
-										 math_symbol_large_family[i],
-										 size);
-
-				return std::vector<math_token_t>(1, token);
-			}
+			if (large_bounding_box.height() >= height)
+				return math_token_t(large_bounding_box,
+									math_symbol._glyph,
+									math_symbol_large_family[i],
+									size);
 		}
 
 		// Extensible glyph after the TFM charlist mechanism, see
@@ -86,12 +83,21 @@ namespace mathtext {
 
 		if (glyph[GLYPH_BOTTOM] != L'\0' &&
 		   glyph[GLYPH_REPEATABLE] != L'\0') {
-			static const unsigned int extensible_family =
+#ifdef MATHTEXT_STATISTICS
+			// Twice with a middle piece, below and above it
+			layout._statistics.count(
+				statistics_t::COUNTER_EXTENSIBLE_REPEAT,
+				glyph[GLYPH_MIDDLE] != L'\0' ? 2 * nrepeat : nrepeat);
+#endif // MATHTEXT_STATISTICS
+			const unsigned int extensible_family =
 				math_symbol._glyph == L'|' ? FAMILY_STIX_REGULAR :
 				FAMILY_STIX_SIZE_1_REGULAR;
 			const bounding_box_t bounding_box_bottom =
 				math_bounding_box(glyph[GLYPH_BOTTOM],
 								  extensible_family, size);
+			const bounding_box_t bounding_box_repeatable =
+				math_bounding_box(glyph[GLYPH_REPEATABLE],
+								  extensible_family, size);
 			std::vector<math_token_t> token_list;
 
 			token_list.push_back(math_token_t(
@@ -101,10 +107,6 @@ namespace mathtext {
 
 			current_y += bounding_box_bottom.ascent();
 			for (unsigned long i = 0; i < nrepeat; i++) {
-				const bounding_box_t bounding_box_repeatable =
-					math_bounding_box(glyph[GLYPH_REPEATABLE],
-									  extensible_family, size);
-
 				current_y += bounding_box_repeatable.descent();
 				token_list.push_back(math_token_t(
 					point_t(0, current_y), bounding_box_repeatable,
@@ -123,10 +125,6 @@ namespace mathtext {
 					glyph[GLYPH_MIDDLE], extensible_family, size));
 				current_y += bounding_box_middle.ascent();
 				for (unsigned long i = 0; i < nrepeat; i++) {
-					const bounding_box_t bounding_box_repeatable =
-						math_bounding_box(glyph[GLYPH_REPEATABLE],
-										  extensible_family, size);
-
 					current_y += bounding_box_repeatable.descent();
 					token_list.push_back(math_token_t(
 						point_t(0, current_y),
@@ -146,23 +144,28 @@ namespace mathtext {
 				point_t(0, current_y), bounding_box_top,
 				glyph[GLYPH_TOP], extensible_family, size));
 
-			return token_list;
+			return math_layout_list(layout, token_list);
 		}
 
-		const math_token_t token(normal_bounding_box,
-								 math_symbol._glyph, family, size);
-
-		return std::vector<math_token_t>(1, token);
+		return math_token_t(normal_bounding_box,
+							math_symbol._glyph, family, size);
 	}
 
-	std::vector<math_text_renderer_t::math_token_t>
-	math_text_renderer_t::
-	math_tokenize(const std::vector<math_text_t::item_t>::
-				  const_iterator &math_list_begin,
-				  const std::vector<math_text_t::item_t>::
-				  const_iterator &math_list_end,
-				  const unsigned int style)
+	math_text_renderer_t::math_token_t math_text_renderer_t::
+	math_layout(math_layout_t &layout,
+				const std::vector<math_text_t::item_t>::
+				const_iterator &math_list_begin,
+				const std::vector<math_text_t::item_t>::
+				const_iterator &math_list_end,
+				const unsigned int style) const
 	{
+#ifdef MATHTEXT_STATISTICS
+		layout._statistics.count(statistics_t::COUNTER_LAYOUT_MATH_LIST);
+#endif // MATHTEXT_STATISTICS
+		if (math_list_begin == math_list_end)
+			return math_token_t(math_token_t::TYPE_SPACE,
+								bounding_box_t(0, 0, 0, 0, 0, 0));
+
 		const float size = style_size(style);
 		const float style_axis_height = axis_height * size;
 		unsigned int previous_atom_type =
@@ -175,18 +178,7 @@ namespace mathtext {
 			math_list_begin_interior = math_list_begin;
 		std::vector<math_text_t::item_t>::const_iterator
 			math_list_end_interior = math_list_end;
-		static const math_text_t::item_t fraction_item =
-			math_text_t::item_t::TYPE_GENERALIZED_FRACTION;
-		const std::vector<math_text_t::item_t>::const_iterator
-			fraction_iterator =
-			std::find(math_list_begin_interior,
-					  math_list_end_interior, fraction_item);
-		const bool generalized_fraction =
-			fraction_iterator != math_list_end_interior;
 		bool delimiter = false;
-		float delimiter_height;
-		bounding_box_t bounding_box_delimiter_left(0, 0, 0, 0, 0, 0);
-		bounding_box_t bounding_box_delimiter_right(0, 0, 0, 0, 0, 0);
 
 		if (math_list_begin->_type ==
 		   math_text_t::item_t::TYPE_BOUNDARY &&
@@ -195,67 +187,38 @@ namespace mathtext {
 			math_list_begin_interior++;
 			math_list_end_interior--;
 			delimiter = true;
-
-			const bounding_box_t bounding_box_interior =
-				math_bounding_box(math_list_begin_interior,
-								  math_list_end_interior, style);
-			const float extension =
-				std::max(bounding_box_interior.ascent() -
-						 style_axis_height,
-						 bounding_box_interior.descent() +
-						 style_axis_height);
-
-			delimiter_height = extension * 0.002F * delimiter_factor;
-			if (generalized_fraction)
-				// Rule 15e
-				delimiter_height = std::max(delimiter_height,
-					if_else_display(style, delim_1, delim_2) * size);
-
-			bounding_box_delimiter_left =
-				math_bounding_box(math_list_begin->_atom.
-								  _nucleus._math_symbol,
-								  style, delimiter_height);
-			bounding_box_delimiter_right =
-				math_bounding_box((math_list_end - 1)->_atom.
-								  _nucleus._math_symbol,
-								  style, delimiter_height);
+			// The interior is laid out first and shifted by the
+			// advance of the left delimiter, once its height is
+			// known
+			previous_atom_type = math_list_begin->_atom._type;
 		}
 
+		static const math_text_t::item_t fraction_item =
+			math_text_t::item_t::TYPE_GENERALIZED_FRACTION;
+		const std::vector<math_text_t::item_t>::const_iterator
+			fraction_iterator =
+			std::find(math_list_begin_interior,
+					  math_list_end_interior, fraction_item);
+		const bool generalized_fraction =
+			fraction_iterator != math_list_end_interior;
 		std::vector<math_token_t> token_list;
 
-		if (delimiter) {
-			// Standard advance mode
-
-			// post_process_atom_type_initial(atom_type) is not
-			// necessary, since the current item is guaranteed not to
-			// be of type Bin.
-
-			// FIXME: Must be in starting style.
-
-			const float shift_delimiter_left = style_axis_height -
-				bounding_box_delimiter_left.vertical_center();
-
-			token_list.push_back(math_token_t(
-				point_t(current_x, shift_delimiter_left),
-				bounding_box_delimiter_left, style,
-				delimiter_height));
-
-			current_x += bounding_box_delimiter_left.advance();
-			previous_atom_type = math_list_begin->_atom._type;
-		}
-
 		if (generalized_fraction) {
 			// Rule 15a, 15b
 			const float thickness = fraction_iterator->_length *
 				default_rule_thickness * size;
+			math_token_t numerator =
+				math_layout(layout, math_list_begin_interior,
+							fraction_iterator,
+							next_numerator_style(style));
+			math_token_t denominator =
+				math_layout(layout, fraction_iterator + 1,
+							math_list_end_interior,
+							next_denominator_style(style));
 			const bounding_box_t numerator_bounding_box =
-				math_bounding_box(math_list_begin_interior,
-								  fraction_iterator,
-								  next_numerator_style(style));
+				numerator._bounding_box;
 			const bounding_box_t denominator_bounding_box =
-				math_bounding_box(fraction_iterator + 1,
-								  math_list_end_interior,
-								  next_denominator_style(style));
+				denominator._bounding_box;
 			const float min_shift_up =
 				if_else_display(style, num_1,
 								thickness > 0 ? num_2 : num_3) *
@@ -340,11 +303,9 @@ namespace mathtext {
 				horizontal_shift_denominator = 0;
 			}
 
-			token_list.push_back(math_token_t(
+			token_list.push_back(denominator.at(
 				point_t(current_x + horizontal_shift_denominator,
-						-shift_down),
-				denominator_bounding_box,
-				next_denominator_style(style)));
+						-shift_down)));
 			if (thickness > 0) {
 #if 0
 				const float constrained_thickness =
@@ -358,17 +319,15 @@ namespace mathtext {
 							 denominator_bounding_box.right());
 
 				token_list.push_back(math_token_t(
-					point_t(current_x + left,
-							style_axis_height - 0.5F * thickness),
+					math_token_t::TYPE_RULE,
 					bounding_box_t(0, 0, right - left, thickness,
-								   0, 0),
-					style));
+								   0, 0)).at(
+					point_t(current_x + left,
+							style_axis_height - 0.5F * thickness)));
 			}
-			token_list.push_back(math_token_t(
+			token_list.push_back(numerator.at(
 				point_t(current_x + horizontal_shift_numerator,
-						shift_up),
-				numerator_bounding_box,
-				next_numerator_style(style)));
+						shift_up)));
 
 			const float advance =
 				std::max(horizontal_shift_numerator +
@@ -386,7 +345,7 @@ namespace mathtext {
 					iterator = math_list_begin_interior;
 				iterator != math_list_end_interior; iterator++) {
 				unsigned int atom_type;
-				bounding_box_t item_bounding_box;
+				math_token_t item;
 				unsigned int current_style = has_accent ?
 					prime_style(style) : style;
 				bool accent;
@@ -395,9 +354,8 @@ namespace mathtext {
 				switch (iterator->_type) {
 				case math_text_t::item_t::TYPE_ATOM:
 					atom_type = iterator->_atom._type;
-					item_bounding_box =
-						math_bounding_box(iterator->_atom,
-										  current_style);
+					item = math_layout(layout, iterator->_atom,
+									   current_style);
 					accent = valid_accent(vertical_alignment,
 										  iterator, math_list_end);
 					if (accent) {
@@ -406,7 +364,8 @@ namespace mathtext {
 							const_iterator iterator_next =
 							iterator + 1;
 						const bounding_box_t next_item_bounding_box =
-							math_bounding_box(iterator_next->_atom,
+							math_bounding_box(layout,
+											  iterator_next->_atom,
 											  style);
 						const float horizontal_shift =
 							(iterator == math_list_begin ? 0.0F :
@@ -416,17 +375,16 @@ namespace mathtext {
 							horizontal_center() +
 							0.5F * next_item_bounding_box.
 							italic_correction() -
-							item_bounding_box.horizontal_center();
+							item._bounding_box.horizontal_center();
 						const float vertical_shift =
 							vertical_alignment ?
 							std::max(0.0F,
 								next_item_bounding_box.ascent() -
 								x_height(style)) : 0.0F;
 
-						token_list.push_back(math_token_t(
+						token_list.push_back(item.at(
 							point_t(current_x + horizontal_shift,
-									vertical_shift),
-							item_bounding_box, style));
+									vertical_shift)));
 						has_accent = true;
 					}
 					else {
@@ -446,10 +404,9 @@ namespace mathtext {
 								horizontal_shift;
 						}
 
-						token_list.push_back(math_token_t(
-							point_t(current_x, 0), item_bounding_box,
-							current_style));
-						current_x += item_bounding_box.advance();
+						token_list.push_back(item.at(
+							point_t(current_x, 0)));
+						current_x += item._bounding_box.advance();
 						has_accent = false;
 						previous_atom_type = atom_type;
 					}
@@ -463,6 +420,63 @@ namespace mathtext {
 
 		// Rule 19 (again)
 		if (delimiter) {
+			bounding_box_t bounding_box_interior(0, 0, 0, 0, 0, 0);
+
+			if (!token_list.empty()) {
+				bounding_box_interior = token_list.front()._offset +
+					token_list.front()._bounding_box;
+				for (std::vector<math_token_t>::const_iterator
+						iterator = token_list.begin();
+					iterator != token_list.end(); iterator++)
+					bounding_box_interior =
+						bounding_box_interior.merge(
+							iterator->_offset +
+							iterator->_bounding_box);
+			}
+
+			const float extension =
+				std::max(bounding_box_interior.ascent() -
+						 style_axis_height,
+						 bounding_box_interior.descent() +
+						 style_axis_height);
+			float delimiter_height =
+				extension * 0.002F * delimiter_factor;
+
+			if (generalized_fraction)
+				// Rule 15e
+				delimiter_height = std::max(delimiter_height,
+					if_else_display(style, delim_1, delim_2) * size);
+
+			math_token_t delimiter_left =
+				math_layout(layout, math_list_begin->_atom.
+							_nucleus->_math_symbol,
+							style, delimiter_height);
+			math_token_t delimiter_right =
+				math_layout(layout, (math_list_end - 1)->_atom.
+							_nucleus->_math_symbol,
+							style, delimiter_height);
+
+			// Standard advance mode
+
+			// post_process_atom_type_initial(atom_type) is not
+			// necessary, since the current item is guaranteed not to
+			// be of type Bin.
+
+			// FIXME: Must be in starting style.
+
+			const float shift_delimiter_left = style_axis_height -
+				delimiter_left._bounding_box.vertical_center();
+			const point_t advance_delimiter_left =
+				point_t(delimiter_left._bounding_box.advance(), 0);
+
+			for (std::vector<math_token_t>::iterator iterator =
+					token_list.begin();
+				iterator != token_list.end(); iterator++)
+				iterator->_offset += advance_delimiter_left;
+			current_x += advance_delimiter_left[0];
+			token_list.insert(token_list.begin(), delimiter_left.at(
+				point_t(0, shift_delimiter_left)));
+
 			unsigned int atom_type =
 				(math_list_end - 1)->_atom._type;
 			// Standard advance mode
@@ -478,24 +492,22 @@ namespace mathtext {
 			current_x += horizontal_shift;
 
 			const float shift_delimiter_right = style_axis_height -
-				bounding_box_delimiter_right.vertical_center();
+				delimiter_right._bounding_box.vertical_center();
 
-			token_list.push_back(math_token_t(
-				point_t(current_x, shift_delimiter_right),
-				bounding_box_delimiter_right, style,
-				delimiter_height));
+			token_list.push_back(delimiter_right.at(
+				point_t(current_x, shift_delimiter_right)));
 		}
 
-		return token_list;
+		return math_layout_list(layout, token_list);
 	}
 
-	std::vector<math_text_renderer_t::math_token_t>
-	math_text_renderer_t::
-	math_tokenize(const math_text_t::atom_t &atom,
-				  const unsigned int style)
+	math_text_renderer_t::math_token_t math_text_renderer_t::
+	math_layout_atom(math_layout_t &layout,
+					 const math_text_t::atom_t &atom,
+					 const unsigned int style) const
 	{
 		const float size = style_size(style);
-		std::vector<math_text_renderer_t::math_token_t> token_list;
+		std::vector<math_token_t> token_list;
 		bounding_box_t nucleus_bounding_box;
 		float current_x = 0;
 		float nucleus_shift_up = 0;
@@ -508,17 +520,21 @@ namespace mathtext {
 				style_radical_rule_thickness + 0.25F *
 				if_else_display(style, x_height(style),
 								style_radical_rule_thickness);
+			math_token_t radicand =
+				math_layout(layout, *atom._nucleus,
+							prime_style(style));
 			const bounding_box_t bounding_box_radicand =
-				math_bounding_box(atom._nucleus,
-								  prime_style(style));
+				radicand._bounding_box;
 			const float min_delimiter_height =
 				bounding_box_radicand.height() + min_clearance +
 				style_radical_rule_thickness;
 			const math_text_t::math_symbol_t
 				symbol_surd("\\surd", style);
+			math_token_t surd =
+				math_layout(layout, symbol_surd, style,
+							min_delimiter_height);
 			const bounding_box_t bounding_box_surd =
-				math_bounding_box(symbol_surd, style,
-								  min_delimiter_height);
+				surd._bounding_box;
 			const float surd_intrinsic_shift_down =
 				bounding_box_surd.ascent() -
 				style_radical_rule_thickness;
@@ -531,33 +547,32 @@ namespace mathtext {
 						bounding_box_radicand.height()) :
 				min_clearance;
 
-			if (!atom._index.empty()) {
+			if (!atom._index->empty()) {
 				// The positive space of 5 mu to the index is hard
 				// wired in plain.tex
 				current_x += (5.0F / 18.0F) * size;
 
-				const bounding_box_t bounding_box_index =
-					math_bounding_box(atom._index,
+				math_token_t index =
+					math_layout(layout, *atom._index,
 						math_text_t::item_t::STYLE_SCRIPT_SCRIPT);
+				const bounding_box_t bounding_box_index =
+					index._bounding_box;
+				const bounding_box_t bounding_box_index_prime =
+					math_bounding_box(layout, *atom._index,
+									  prime_style(style));
 				const float radical_height =
-					(std::max(math_bounding_box(
-						atom._index, prime_style(style)).ascent(),
+					(std::max(bounding_box_index_prime.ascent(),
 							  bounding_box_radicand.ascent() +
 							  clearance +
 							  2.0F * style_radical_rule_thickness) -
-					 std::max(math_bounding_box(
-						atom._index, prime_style(style)).descent(),
+					 std::max(bounding_box_index_prime.descent(),
 							  bounding_box_radicand.descent()));
 
 				nucleus_bounding_box =
 					point_t(current_x, 0.6F * radical_height) +
-					math_bounding_box(
-						atom._index,
-						math_text_t::item_t::STYLE_SCRIPT_SCRIPT);
-				token_list.push_back(math_token_t(
-					point_t(current_x, 0.6F * radical_height),
-					bounding_box_index,
-					math_text_t::item_t::STYLE_SCRIPT_SCRIPT));
+					bounding_box_index;
+				token_list.push_back(index.at(
+					point_t(current_x, 0.6F * radical_height)));
 				// The negative space of 10 mu to the surd is hard
 				// wired in plain.tex
 				current_x += bounding_box_index.advance() -
@@ -572,11 +587,10 @@ namespace mathtext {
 						radicand_ascent_clearance -
 						surd_intrinsic_shift_down) +
 				bounding_box_surd);
-			token_list.push_back(math_token_t(
+			token_list.push_back(surd.at(
 				point_t(current_x,
 						radicand_ascent_clearance -
-						surd_intrinsic_shift_down),
-				bounding_box_surd, style, min_delimiter_height));
+						surd_intrinsic_shift_down)));
 			current_x += bounding_box_surd.advance();
 
 			const float constrained_thickness =
@@ -605,7 +619,8 @@ namespace mathtext {
 			nucleus_bounding_box = nucleus_bounding_box.merge(
 				origin_rule + bounding_box_rule);
 			token_list.push_back(math_token_t(
-				origin_rule, bounding_box_rule, style));
+				math_token_t::TYPE_RULE,
+				bounding_box_rule).at(origin_rule));
 
 			const bounding_box_t bounding_box_clearance =
 				bounding_box_t(0, -2.0F * constrained_thickness,
@@ -616,15 +631,14 @@ namespace mathtext {
 			nucleus_bounding_box = nucleus_bounding_box.merge(
 				origin_rule + bounding_box_clearance);
 			token_list.push_back(math_token_t(
-				origin_rule, bounding_box_clearance, style));
+				math_token_t::TYPE_SPACE,
+				bounding_box_clearance).at(origin_rule));
 
 			const point_t origin_radicand = point_t(current_x, 0);
 
 			nucleus_bounding_box = nucleus_bounding_box.merge(
 				origin_radicand + bounding_box_radicand);
-			token_list.push_back(math_token_t(
-				origin_radicand, bounding_box_radicand,
-				prime_style(style)));
+			token_list.push_back(radicand.at(origin_radicand));
 			current_x += bounding_box_radicand.advance();
 		}
 		else if (atom._type == math_text_t::atom_t::TYPE_OP) {
@@ -634,37 +648,48 @@ namespace mathtext {
 				 math_text_t::atom_t::LIMITS_DISPLAYLIMITS &&
 				 is_display_style(style));
 
-			if (atom._nucleus._type ==
+			math_token_t nucleus;
+
+			if (atom._nucleus->_type ==
 			   math_text_t::field_t::TYPE_MATH_SYMBOL) {
 				// Rule 13
+				const float nucleus_size = size *
+					if_else_display(style,
+						large_operator_display_scale, 1.0F);
+
 				nucleus_bounding_box = math_bounding_box(
-					atom._nucleus._math_symbol._glyph,
-					FAMILY_STIX_REGULAR,
-					size * if_else_display(style,
-						large_operator_display_scale, 1.0F));
+					atom._nucleus->_math_symbol._glyph,
+					FAMILY_STIX_REGULAR, nucleus_size);
 				nucleus_shift_up =
 					axis_height * size -
 					nucleus_bounding_box.vertical_center();
-				if (limits && atom._subscript.empty())
+				if (limits && atom._subscript->empty())
 					nucleus_bounding_box.advance() +=
 						nucleus_bounding_box.italic_correction();
+				nucleus = math_token_t(
+					nucleus_bounding_box,
+					atom._nucleus->_math_symbol._glyph,
+					FAMILY_STIX_REGULAR, nucleus_size);
+			}
+			else {
+				nucleus = math_layout(layout, *atom._nucleus, style);
+				nucleus_bounding_box = nucleus._bounding_box;
 			}
-			else
-				nucleus_bounding_box =
-					math_bounding_box(atom._nucleus, style);
 
-			if (limits && !(atom._superscript.empty() &&
-						   atom._subscript.empty())) {
+			if (limits && !(atom._superscript->empty() &&
+						   atom._subscript->empty())) {
 				// Rule 13a
 				const unsigned int superscript_style =
 					next_superscript_style(style);
 				const unsigned int subscript_style =
 					next_subscript_style(style);
 
-				if (atom._superscript.empty()) {
+				if (atom._superscript->empty()) {
+					math_token_t subscript =
+						math_layout(layout, *atom._subscript,
+									subscript_style);
 					const bounding_box_t subscript_bounding_box =
-						math_bounding_box(atom._subscript,
-										  subscript_style);
+						subscript._bounding_box;
 					const float shift_right =
 						nucleus_bounding_box.horizontal_center() -
 						subscript_bounding_box.horizontal_center() -
@@ -680,30 +705,25 @@ namespace mathtext {
 						nucleus_shift_up;
 
 					if (shift_right >= 0) {
-						token_list.push_back(math_token_t(
-							point_t(0, nucleus_shift_up),
-							nucleus_bounding_box, style));
-						token_list.push_back(math_token_t(
-							point_t(shift_right, -shift_down),
-							subscript_bounding_box,
-							subscript_style));
+						token_list.push_back(nucleus.at(
+							point_t(0, nucleus_shift_up)));
+						token_list.push_back(subscript.at(
+							point_t(shift_right, -shift_down)));
 					}
 					else {
-						token_list.push_back(math_token_t(
-							point_t(-shift_right,
-									nucleus_shift_up),
-							nucleus_bounding_box, style));
-						token_list.push_back(math_token_t(
-							point_t(0, -shift_down),
-							subscript_bounding_box,
-							subscript_style));
+						token_list.push_back(nucleus.at(
+							point_t(-shift_right, nucleus_shift_up)));
+						token_list.push_back(subscript.at(
+							point_t(0, -shift_down)));
 					}
-					return token_list;
+					return math_layout_list(layout, token_list);
 				}
-				if (atom._subscript.empty()) {
+				if (atom._subscript->empty()) {
+					math_token_t superscript =
+						math_layout(layout, *atom._superscript,
+									superscript_style);
 					const bounding_box_t superscript_bounding_box =
-						math_bounding_box(atom._superscript,
-										  superscript_style);
+						superscript._bounding_box;
 					const float shift_right =
 						nucleus_bounding_box.horizontal_center() -
 						superscript_bounding_box.
@@ -719,32 +739,29 @@ namespace mathtext {
 						nucleus_shift_up;
 
 					if (shift_right >= 0) {
-						token_list.push_back(math_token_t(
-							point_t(0, nucleus_shift_up),
-							nucleus_bounding_box, style));
-						token_list.push_back(math_token_t(
-							point_t(shift_right, shift_up),
-							superscript_bounding_box,
-							superscript_style));
+						token_list.push_back(nucleus.at(
+							point_t(0, nucleus_shift_up)));
+						token_list.push_back(superscript.at(
+							point_t(shift_right, shift_up)));
 					}
 					else {
-						token_list.push_back(math_token_t(
-							point_t(-shift_right,
-									nucleus_shift_up),
-							nucleus_bounding_box, style));
-						token_list.push_back(math_token_t(
-							point_t(0, shift_up),
-							superscript_bounding_box,
-							superscript_style));
+						token_list.push_back(nucleus.at(
+							point_t(-shift_right, nucleus_shift_up)));
+						token_list.push_back(superscript.at(
+							point_t(0, shift_up)));
 					}
-					return token_list;
+					return math_layout_list(layout, token_list);
 				}
+				math_token_t superscript =
+					math_layout(layout, *atom._superscript,
+								superscript_style);
 				const bounding_box_t superscript_bounding_box =
-					math_bounding_box(atom._superscript,
-									  superscript_style);
+					superscript._bounding_box;
+				math_token_t subscript =
+					math_layout(layout, *atom._subscript,
+								subscript_style);
 				const bounding_box_t subscript_bounding_box =
-					math_bounding_box(atom._subscript,
-									  subscript_style);
+					subscript._bounding_box;
 				const float shift_right_superscript =
 					nucleus_bounding_box.horizontal_center() -
 					superscript_bounding_box.horizontal_center() +
@@ -775,41 +792,35 @@ namespace mathtext {
 					std::min(0.0F, std::min(shift_right_superscript,
 											shift_right_subscript));
 
-				token_list.push_back(math_token_t(
-					point_t(-min_shift_right,
-							nucleus_shift_up),
-					nucleus_bounding_box, style));
-				token_list.push_back(math_token_t(
+				token_list.push_back(nucleus.at(
+					point_t(-min_shift_right, nucleus_shift_up)));
+				token_list.push_back(superscript.at(
 					point_t(shift_right_superscript -
 							min_shift_right,
-							shift_up),
-					superscript_bounding_box,
-					superscript_style));
-				token_list.push_back(math_token_t(
+							shift_up)));
+				token_list.push_back(subscript.at(
 					point_t(shift_right_subscript -
 							min_shift_right,
-							-shift_down),
-					subscript_bounding_box,
-					subscript_style));
-				return token_list;
+							-shift_down)));
+				return math_layout_list(layout, token_list);
 			}
 
 			// \nolimits or nucleus only
-			token_list.push_back(math_token_t(
-				point_t(0, nucleus_shift_up),
-				nucleus_bounding_box, style));
+			token_list.push_back(nucleus.at(
+				point_t(0, nucleus_shift_up)));
 			current_x += nucleus_bounding_box.advance();
 		}
 		else {	// Neither Rad nor Op
-			nucleus_bounding_box =
-				math_bounding_box(atom._nucleus, style);
-			token_list.push_back(math_token_t(
-				nucleus_bounding_box, style));
+			const math_token_t nucleus =
+				math_layout(layout, *atom._nucleus, style);
+
+			nucleus_bounding_box = nucleus._bounding_box;
+			token_list.push_back(nucleus);
 			current_x += nucleus_bounding_box.advance();
 		}
 
-		if (atom._superscript.empty() && atom._subscript.empty())
-			return token_list;
+		if (atom._superscript->empty() && atom._subscript->empty())
+			return math_layout_list(layout, token_list);
 
 		const float current_x_italic_corrected = current_x +
 			nucleus_bounding_box.italic_correction();
@@ -827,22 +838,25 @@ namespace mathtext {
 			subscript_size * sub_drop;
 
 		// Rule 18b
-		if (atom._superscript.empty()) {
+		if (atom._superscript->empty()) {
+			math_token_t subscript =
+				math_layout(layout, *atom._subscript, subscript_style);
 			const bounding_box_t subscript_bounding_box =
-				math_bounding_box(atom._subscript, subscript_style);
+				subscript._bounding_box;
 			const float shift_down =
 				std::max(std::max(min_shift_down,
 								  nucleus_size * sub_1),
 						 subscript_bounding_box.ascent() -
 						 0.8F * x_height(subscript_style));
-			token_list.push_back(math_token_t(
-				point_t(current_x, nucleus_shift_up - shift_down),
-				subscript_bounding_box, subscript_style));
-			return token_list;
+			token_list.push_back(subscript.at(
+				point_t(current_x, nucleus_shift_up - shift_down)));
+			return math_layout_list(layout, token_list);
 		}
 		// Rule 18c
+		math_token_t superscript =
+			math_layout(layout, *atom._superscript, superscript_style);
 		const bounding_box_t superscript_bounding_box =
-			math_bounding_box(atom._superscript, superscript_style);
+			superscript._bounding_box;
 		const float min_shift_up_2 = nucleus_size *
 			(style == math_text_t::item_t::STYLE_DISPLAY ?
 			 sup_1 : is_prime_style(style) ? sup_3 : sup_2);
@@ -851,20 +865,21 @@ namespace mathtext {
 					 superscript_bounding_box.descent() +
 					 0.2F * x_height(superscript_style));
 		// Rule 18d
-		if (atom._subscript.empty()) {
-			token_list.push_back(math_token_t(
+		if (atom._subscript->empty()) {
+			token_list.push_back(superscript.at(
 				point_t(current_x_italic_corrected,
-						nucleus_shift_up + shift_up),
-				superscript_bounding_box, superscript_style));
-			return token_list;
+						nucleus_shift_up + shift_up)));
+			return math_layout_list(layout, token_list);
 		}
 
 		// Still rule 18d
 		float shift_down =
 			std::max(min_shift_down, nucleus_size * sub_2);
 		// Rule 18e
+		math_token_t subscript =
+			math_layout(layout, *atom._subscript, subscript_style);
 		const bounding_box_t subscript_bounding_box =
-			math_bounding_box(atom._subscript, subscript_style);
+			subscript._bounding_box;
 
 		if ((shift_up - superscript_bounding_box.descent()) -
 		   (subscript_bounding_box.ascent() - shift_down) <
@@ -884,16 +899,14 @@ namespace mathtext {
 			}
 		}
 		// Rule 18f
-		token_list.push_back(math_token_t(
+		token_list.push_back(superscript.at(
 			point_t(current_x_italic_corrected,
-					nucleus_shift_up + shift_up),
-			superscript_bounding_box, superscript_style));
-		token_list.push_back(math_token_t(
+					nucleus_shift_up + shift_up)));
+		token_list.push_back(subscript.at(
 			point_t(current_x,
-					nucleus_shift_up - shift_down),
-			subscript_bounding_box, subscript_style));
+					nucleus_shift_up - shift_down)));
 
-		return token_list;
+		return math_layout_list(layout, token_list);
 	}
 
 }
@@ -27,7 +27,7 @@ namespace mathtext {
 
 	/////////////////////////////////////////////////////////////////
 
-	void math_text_t::field_t::transform_script(void)
+	void math_text_t::field_t::transform_script(field_pool_t &pool)
 	{
 		const unsigned long size = _math_list.size();
 
@@ -42,21 +42,23 @@ namespace mathtext {
 		if (last->_type == item_t::TYPE_ATOM &&
 		   second_last->_type == item_t::TYPE_ATOM &&
 		   second_last->_atom._type == atom_t::TYPE_ACC &&
-		   !(last->_atom._superscript.empty() &&
-			 last->_atom._subscript.empty())) {
+		   !(last->_atom._superscript->empty() &&
+			 last->_atom._subscript->empty())) {
 			// Rule 12
-			atom_t atom = field_t();
+			atom_t atom = empty_field();
+			field_t *nucleus = pool.allocate(field_t());
 
-			atom._nucleus._math_list.push_back(*second_last);
-			atom._nucleus._math_list.push_back(*last);
+			nucleus->_math_list.push_back(*second_last);
+			nucleus->_math_list.push_back(*last);
 			atom._superscript =
-				atom._nucleus._math_list.back()._atom._superscript;
+				nucleus->_math_list.back()._atom._superscript;
 			atom._subscript =
-				atom._nucleus._math_list.back()._atom._subscript;
-			atom._nucleus._math_list.back()._atom._superscript =
-				field_t();
-			atom._nucleus._math_list.back()._atom._subscript =
-				field_t();
+				nucleus->_math_list.back()._atom._subscript;
+			nucleus->_math_list.back()._atom._superscript =
+				empty_field();
+			nucleus->_math_list.back()._atom._subscript =
+				empty_field();
+			atom._nucleus = nucleus;
 			_math_list.pop_back();
 			_math_list.pop_back();
 			_math_list.push_back(item_t(atom));
@@ -71,80 +73,118 @@ namespace mathtext {
 	// FIXME: Check for malformed "..._a^b_c" (instead of just
 	// overwriting)
 	void math_text_t::field_t::
-	append(const field_t &field, const bool superscript,
-		   const bool subscript)
+	append(field_pool_t &pool, const field_t *field,
+		   const bool superscript, const bool subscript)
 	{
 		if ((superscript || subscript) && _math_list.empty())
-			_math_list.push_back(item_t(field_t()));
+			_math_list.push_back(item_t(empty_field()));
 
 		if (superscript) {
 			_math_list.back()._atom._superscript = field;
-			transform_script();
+			transform_script(pool);
 		}
 		else if (subscript) {
 			_math_list.back()._atom._subscript = field;
-			transform_script();
+			transform_script(pool);
 		}
 		else
 			append(item_t(item_t::TYPE_ATOM, atom_t(field)));
 	}
 
 	void math_text_t::field_t::
-	prepend(const unsigned int type,
+	append(field_pool_t &pool, const field_t &field,
+		   const bool superscript, const bool subscript)
+	{
+		append(pool, pool.allocate(field), superscript, subscript);
+	}
+
+	void math_text_t::field_t::
+	prepend(field_pool_t &pool, const unsigned int type,
 			const math_symbol_t &math_symbol)
 	{
 		_math_list.insert(_math_list.begin(),
-						  item_t(type,
-								 atom_t(field_t(math_symbol))));
+						  item_t(type, atom_t(pool.allocate(
+							  field_t(math_symbol)))));
 	}
 
 	void math_text_t::field_t::
-	append(const unsigned int type, const math_symbol_t &math_symbol,
-		   const bool superscript, const bool subscript)
+	append(field_pool_t &pool, const unsigned int type,
+		   const math_symbol_t &math_symbol, const bool superscript,
+		   const bool subscript)
 	{
 		if ((superscript || subscript) && _math_list.empty())
-			_math_list.push_back(item_t(field_t()));
+			_math_list.push_back(item_t(empty_field()));
 
 		if (superscript) {
 			_math_list.back()._atom._superscript =
-				field_t(math_symbol);
-			transform_script();
+				pool.allocate(field_t(math_symbol));
+			transform_script(pool);
 		}
 		else if (subscript) {
 			_math_list.back()._atom._subscript =
-				field_t(math_symbol);
-			transform_script();
+				pool.allocate(field_t(math_symbol));
+			transform_script(pool);
 		}
 		else
-			append(item_t(type, atom_t(field_t(math_symbol))));
+			append(item_t(type, atom_t(pool.allocate(
+				field_t(math_symbol)))));
 	}
 
 	math_text_t::field_t::
-	field_t(const std::vector<std::string> &str_split,
+	field_t(field_pool_t &pool, const std::string &code,
+			const tex_token_iterator_t &token_begin,
+			const tex_token_iterator_t &token_end,
 			const unsigned int default_family)
 		: _type(TYPE_MATH_LIST)
 	{
-		parse_math_list(str_split, default_family);
+		parse_math_list(pool, code, token_begin, token_end,
+						default_family);
 	}
 
-	math_text_t::field_t::
-	field_t(const std::string &str_delimiter_left,
-			const std::vector<std::string> &str_split,
-			const std::string &str_delimiter_right,
-			const unsigned int default_family)
-		: _type(TYPE_MATH_LIST)
+	math_text_t::field_t *math_text_t::field_t::
+	new_math_list(field_pool_t &pool, const std::string &code,
+				  const tex_token_iterator_t &token_begin,
+				  const tex_token_iterator_t &token_end,
+				  const unsigned int default_family)
+	{
+		// Parse in place, the pool never moves allocated fields
+		field_t *field = pool.allocate(field_t());
+
+		field->parse_math_list(pool, code, token_begin, token_end,
+							   default_family);
+
+		return field;
+	}
+
+	math_text_t::field_t *math_text_t::field_t::
+	new_math_list(field_pool_t &pool, const std::string &code,
+				  const tex_token_t &token_delimiter_left,
+				  const tex_token_iterator_t &token_begin,
+				  const tex_token_iterator_t &token_end,
+				  const tex_token_t &token_delimiter_right,
+				  const unsigned int default_family)
 	{
-		parse_math_list(str_split, default_family);
+		field_t *field = pool.allocate(field_t());
+
+		field->parse_math_list(pool, code, token_begin, token_end,
+							   default_family);
 
 		const math_symbol_t
-			symbol_left(str_delimiter_left, default_family);
+			symbol_left(token_delimiter_left.string(code),
+						token_delimiter_left._descriptor,
+						default_family);
 
-		prepend(item_t::TYPE_BOUNDARY, symbol_left);
+		field->prepend(pool, item_t::TYPE_BOUNDARY, symbol_left);
 
 		const math_symbol_t
-			symbol_right(str_delimiter_right, default_family);
+			symbol_right(token_delimiter_right.string(code),
+						 token_delimiter_right._descriptor,
+						 default_family);
+
+		field->append(pool, item_t::TYPE_BOUNDARY, symbol_right,
+					  false, false);
 
-		append(item_t::TYPE_BOUNDARY, symbol_right, false, false);
+		return field;
 	}
 
 	bool math_text_t::field_t::generalized_fraction(void) const
@@ -163,9 +203,9 @@ namespace mathtext {
 	{
 		// Only nucleus affects the atom type (Knuth, The TeXbook,
 		// 1986, p. 171)
-		if (_nucleus._type == field_t::TYPE_MATH_SYMBOL)
-			_type = _nucleus._math_symbol._type;
-		else if (_nucleus.generalized_fraction())
+		if (_nucleus->_type == field_t::TYPE_MATH_SYMBOL)
+			_type = _nucleus->_math_symbol._type;
+		else if (_nucleus->generalized_fraction())
 			_type = atom_t::TYPE_INNER;
 		else
 			// FIXME: Does TeX flatten compound expressions before
@@ -175,8 +215,8 @@ namespace mathtext {
 
 	bool math_text_t::atom_t::is_combining_diacritical(void) const
 	{
-		return _nucleus._type == field_t::TYPE_MATH_SYMBOL &&
-			_nucleus._math_symbol.is_combining_diacritical();
+		return _nucleus->_type == field_t::TYPE_MATH_SYMBOL &&
+			_nucleus->_math_symbol.is_combining_diacritical();
 	}
 
 	unsigned int math_text_t::atom_t::
@@ -220,6 +260,53 @@ namespace mathtext {
 		}
 	}
 
+	math_text_t::field_pool_t::~field_pool_t(void)
+	{
+		for (std::vector<std::vector<field_t> *>::const_iterator
+				iterator = _block.begin();
+			iterator != _block.end(); iterator++)
+			delete *iterator;
+	}
+
+	math_text_t::field_t *
+	math_text_t::field_pool_t::allocate(const field_t &field)
+	{
+		// Blocks never grow beyond their reserved capacity, so that
+		// the fields in them are never moved
+		if (_block.empty() ||
+		   _block.back()->size() >= nfield_per_block) {
+			_block.push_back(new std::vector<field_t>());
+			_block.back()->reserve(nfield_per_block);
+		}
+		_block.back()->push_back(field);
+
+		return &_block.back()->back();
+	}
+
+	const math_text_t::field_t *math_text_t::empty_field(void)
+	{
+		static const field_t empty;
+
+		return &empty;
+	}
+
+	math_text_t &math_text_t::operator=(const math_text_t &math_text)
+	{
+		if (math_text._field_pool != NULL)
+			math_text._field_pool->reference();
+		if (_field_pool != NULL && _field_pool->release())
+			delete _field_pool;
+		_code = math_text._code;
+		_math_list = math_text._math_list;
+		_field_pool = math_text._field_pool;
+		_render_structure = math_text._render_structure;
+#ifdef MATHTEXT_STATISTICS
+		_parse_time = math_text._parse_time;
+#endif // MATHTEXT_STATISTICS
+
+		return *this;
+	}
+
 	std::wstring math_text_t::bad_cast(const std::string string)
 	{
 		std::wstring wstring;
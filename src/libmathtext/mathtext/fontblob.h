@@ -0,0 +1,156 @@
+// -*- mode: c++; -*-
+
+// mathtext - A TeX/LaTeX compatible rendering library. Copyright (C)
+// 2008-2016 Yue Shi Lai <ylai@users.sourceforge.net>
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2.1 of
+// the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// 02110-1301 USA
+
+#ifndef MATHTEXT_FONTBLOB_H_
+#define MATHTEXT_FONTBLOB_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <map>
+#include <stdint.h>
+#include <sys/types.h>
+#include <mathtext/mutex.h>
+
+namespace mathtext {
+
+	class parsed_font_t;
+	class font_metrics_t;
+
+	/**
+	 * Read-only view of font file data
+	 *
+	 * The class font_blob_t refers either to a font file that is
+	 * memory mapped once per process, or to a vector that is owned
+	 * by the caller. Font files are registered by device and inode,
+	 * and the mapping is shared by all blobs of the same file. It is
+	 * reference counted, and unmapped when the last blob referring
+	 * to it is destroyed. Since the mapping is read-only, its pages
+	 * are also shared with other processes reading the same file.
+	 *
+	 * A blob constructed from a vector does not own the data, and
+	 * remains valid only as long as the vector is neither modified
+	 * nor destroyed.
+	 *
+	 * The parsed font of a mapping is likewise shared, and with any
+	 * other mapping of the same content, e.g. of a copy of the font
+	 * file, and so is its glyph metrics table.
+	 */
+	class font_blob_t {
+	private:
+		class parsed_font_entry_t {
+		public:
+			uint64_t _content_hash;
+			parsed_font_t *_parsed_font;
+			// Computed on first use, NULL until then
+			font_metrics_t *_font_metrics;
+			unsigned long _reference_count;
+		};
+		class mapping_t {
+		public:
+			dev_t _device;
+			ino_t _inode;
+			off_t _file_size;
+			time_t _modification_time;
+			void *_address;
+			// Fallback where the file cannot be mapped
+			std::vector<uint8_t> _copy;
+			unsigned long _reference_count;
+			parsed_font_entry_t *_parsed_font_entry;
+		};
+		typedef std::map<std::pair<dev_t, ino_t>, mapping_t *>
+		registry_t;
+		typedef std::map<uint64_t, parsed_font_entry_t *>
+		parsed_font_registry_t;
+		mapping_t *_mapping;
+		const uint8_t *_data;
+		size_t _size;
+		// Parsed font and glyph metrics of a blob that is not mapped
+		mutable parsed_font_t *_parsed_font;
+		mutable font_metrics_t *_font_metrics;
+		static registry_t &registry(void);
+		static parsed_font_registry_t &parsed_font_registry(void);
+		static mutex_t &registry_mutex(void);
+		static uint64_t content_hash(const uint8_t *data,
+									 const size_t size);
+		void attach(mapping_t *mapping);
+		void detach(void);
+	public:
+		typedef const uint8_t *const_iterator;
+		font_blob_t(void);
+		font_blob_t(const std::vector<uint8_t> &data);
+		font_blob_t(const font_blob_t &blob);
+		~font_blob_t(void);
+		font_blob_t &operator=(const font_blob_t &blob);
+		/**
+		 * Returns the shared blob of a font file, mapping it if no
+		 * other blob refers to the file
+		 *
+		 * @param[in] filename font file name
+		 * @return blob of the file contents, or an empty blob if
+		 * the file cannot be read
+		 */
+		static font_blob_t open(const std::string &filename);
+		inline const uint8_t *data(void) const
+		{
+			return _data;
+		}
+		inline size_t size(void) const
+		{
+			return _size;
+		}
+		inline bool empty(void) const
+		{
+			return _size == 0;
+		}
+		inline const_iterator begin(void) const
+		{
+			return _data;
+		}
+		inline const_iterator end(void) const
+		{
+			return _data + _size;
+		}
+		inline const uint8_t &operator[](const size_t index) const
+		{
+			return _data[index];
+		}
+		/**
+		 * Returns the parsed font, parsing it on first use
+		 *
+		 * @return parsed font, valid as long as the blob is
+		 */
+		const parsed_font_t &parsed_font(void) const;
+		/**
+		 * Returns the advance and ink bounds of every glyph,
+		 * computing them on first use
+		 *
+		 * @return glyph metrics table, valid as long as the blob is
+		 */
+		const font_metrics_t &font_metrics(void) const;
+		/**
+		 * Returns the number of font files currently mapped
+		 */
+		static size_t nmapping(void);
+	};
+
+}
+
+#endif // MATHTEXT_FONTBLOB_H_
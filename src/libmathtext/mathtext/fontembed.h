@@ -16,14 +16,211 @@
 // Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
 // 02110-1301 USA
 
+#ifndef MATHTEXT_FONTEMBED_H_
+#define MATHTEXT_FONTEMBED_H_
+
 #include <vector>
 #include <string>
 #include <map>
 #include <cstdio>
 #include <stdint.h>
+#include <mathtext/fontblob.h>
+#include <mathtext/fontsink.h>
 
 namespace mathtext {
 
+	/**
+	 * Mapping of Unicode characters to glyph indices
+	 *
+	 * Characters of the Basic Multilingual Plane are looked up in a
+	 * two level table, with a 256 entry page allocated only where
+	 * characters are mapped. Supplementary characters are kept as a
+	 * sorted list of ranges mapped to consecutive glyph indices, the
+	 * same way as cmap format 12 groups. Glyph index 0 (.notdef) is
+	 * not stored, i.e. mapping a character to it unmaps it.
+	 *
+	 * Iteration is in character order, and dereferencing an iterator
+	 * yields a std::pair<wchar_t, uint16_t> as for a std::map.
+	 */
+	class cid_map_t {
+	private:
+		class range_t {
+		public:
+			uint32_t _first;
+			uint32_t _last;
+			uint16_t _glyph;
+			inline bool operator<(const range_t &range) const
+			{
+				return _last < range._last;
+			}
+		};
+		static const uint32_t npage = 256;
+		static const uint32_t page_size = 256;
+		// 1 + index into _page, or 0 if the page is not allocated
+		uint16_t _page_index[npage];
+		std::vector<uint16_t> _page;
+		std::vector<range_t> _range;
+		size_t _size;
+		std::pair<wchar_t, uint16_t> seek(uint32_t code) const;
+		uint16_t find_supplementary(const uint32_t code) const;
+		void insert_supplementary(const uint32_t code,
+								  const uint16_t glyph);
+		void erase_supplementary(const uint32_t code);
+	public:
+		class const_iterator {
+		private:
+			const cid_map_t *_cid_map;
+			std::pair<wchar_t, uint16_t> _value;
+		public:
+			inline const_iterator(void)
+				: _cid_map(NULL), _value(0, 0)
+			{
+			}
+			inline const_iterator(
+				const cid_map_t *cid_map,
+				const std::pair<wchar_t, uint16_t> &value)
+				: _cid_map(cid_map), _value(value)
+			{
+			}
+			inline const std::pair<wchar_t, uint16_t> &
+			operator*(void) const
+			{
+				return _value;
+			}
+			inline const std::pair<wchar_t, uint16_t> *
+			operator->(void) const
+			{
+				return &_value;
+			}
+			inline const_iterator &operator++(void)
+			{
+				_value = _cid_map->seek(
+					static_cast<uint32_t>(_value.first) + 1);
+				return *this;
+			}
+			inline const_iterator operator++(int)
+			{
+				const const_iterator ret = *this;
+
+				++*this;
+				return ret;
+			}
+			inline bool operator==(const const_iterator &iterator)
+				const
+			{
+				return _value.first == iterator._value.first;
+			}
+			inline bool operator!=(const const_iterator &iterator)
+				const
+			{
+				return _value.first != iterator._value.first;
+			}
+		};
+		cid_map_t(void);
+		/**
+		 * Returns the glyph index of a character
+		 *
+		 * @param[in] character Unicode character
+		 * @return glyph index, or 0 if the character is not mapped
+		 */
+		inline uint16_t find(const wchar_t character) const
+		{
+			const uint32_t code = static_cast<uint32_t>(character);
+
+			if (code < npage * page_size) {
+				const uint16_t page = _page_index[code / page_size];
+
+				return page == 0 ? 0 :
+					_page[(page - 1) * page_size + code % page_size];
+			}
+
+			return find_supplementary(code);
+		}
+		void insert(const wchar_t character, const uint16_t glyph);
+		/**
+		 * Maps a range of characters to consecutive glyph indices
+		 *
+		 * @param[in] first first character of the range
+		 * @param[in] last last character of the range
+		 * @param[in] glyph glyph index of the first character
+		 */
+		void insert_range(const uint32_t first, const uint32_t last,
+						  const uint16_t glyph);
+		void erase(const wchar_t character);
+		void clear(void);
+		inline size_t size(void) const
+		{
+			return _size;
+		}
+		inline bool empty(void) const
+		{
+			return _size == 0;
+		}
+		const_iterator begin(void) const;
+		const_iterator end(void) const;
+	};
+
+	/**
+	 * Table directory, names, metrics and character mapping of an
+	 * OpenType or TrueType font
+	 *
+	 * A parsed_font_t is built by font_embed_t::parse_font(), and
+	 * for a memory mapped font file only once, see
+	 * font_blob_t::parsed_font(). The table directory is a flat
+	 * array sorted by tag. Advance widths are in glyph space units,
+	 * i.e. 1/1000 em.
+	 */
+	class parsed_font_t {
+	public:
+		class table_t {
+		public:
+			uint32_t _tag;
+			uint32_t _offset;
+			uint32_t _length;
+			inline bool operator<(const table_t &table) const
+			{
+				return _tag < table._tag;
+			}
+		};
+		// False if the font could not be parsed
+		bool _valid;
+		// OpenType CFF (Type 2) rather than TrueType (Type 42)
+		bool _cff;
+		std::vector<table_t> _table;
+		std::string _font_name;
+		unsigned short _cid_encoding_id;
+		uint32_t _font_descriptor_flags;
+		double _font_bbox[4];
+		double _italic_angle;
+		double _ascent;
+		double _descent;
+		double _leading;
+		double _cap_height;
+		double _x_height;
+		double _stem_v;
+		double _avg_width;
+		cid_map_t _cid_map;
+		std::vector<std::string> _charset;
+		std::vector<uint16_t> _advance_width;
+		uint32_t _cff_offset;
+		uint32_t _cff_length;
+		parsed_font_t(void);
+		/**
+		 * Returns the table directory entry of a table
+		 *
+		 * @param[in] tag four character table tag, e.g. "cmap"
+		 * @return table directory entry, or NULL if the font has no
+		 * such table
+		 */
+		const table_t *table(const char *tag) const;
+		inline uint32_t table_offset(const char *tag) const
+		{
+			const table_t *entry = table(tag);
+
+			return entry == NULL ? 0 : entry->_offset;
+		}
+	};
+
 	class font_embed_t {
 	protected:
 		struct table_data_s {
@@ -32,75 +229,114 @@ namespace mathtext {
 		};
 		static void protected_memcpy(
 			void *destination,
-			std::vector<uint8_t>::const_iterator source,
-			std::vector<uint8_t>::const_iterator source_end,
+			font_blob_t::const_iterator source,
+			font_blob_t::const_iterator source_end,
 			size_t length, const char *location);
-		static void subset_rename_otf_name_table(
-			struct table_data_s &table_data, uint8_t *glyph_usage);
+		static std::string subset_tag(
+			const std::vector<bool> &glyph_usage);
+		static bool subset_rename_otf_name_table(
+			struct table_data_s &table_data, const std::string &tag);
 		static void subset_ttf_glyf_table(
-			struct table_data_s &table_data, uint8_t *glyph_usage);
+			struct table_data_s &table_data, std::vector<uint32_t> &loca,
+			std::vector<bool> &glyph_usage);
+		static std::vector<uint32_t> parse_ttf_loca(
+			const struct table_data_s &table_data,
+			int16_t index_to_loc_format, uint16_t num_glyphs);
 		static void subset_ttf_loca_table(
-			struct table_data_s &table_data, uint8_t *glyph_usage);
+			struct table_data_s &table_data,
+			const std::vector<uint32_t> &loca,
+			int16_t &index_to_loc_format);
+		static void subset_ttf_hmtx_table(
+			struct table_data_s &table_data,
+			uint16_t &number_of_h_metrics, uint16_t num_glyphs);
 		static void subset_ttf_post_table(
-			struct table_data_s &table_data, uint8_t *glyph_usage);
-		static void subset_otf_cff_table(
-			struct table_data_s &table_data, uint8_t *glyph_usage);
+			struct table_data_s &table_data, uint16_t num_glyphs);
+		static void append_cff_index(
+			std::vector<uint8_t> &data,
+			const std::vector<std::vector<uint8_t> > &index);
+		static std::vector<std::pair<uint16_t, std::vector<uint8_t> > >
+		parse_cff_dict(const std::vector<uint8_t> &dict);
+		static void append_cff_dict_entry(
+			std::vector<uint8_t> &dict, uint16_t op,
+			const std::vector<uint8_t> &operand);
+		static std::vector<uint8_t> cff_dict_offset(int32_t offset);
+		// Returns the operand n of a DICT entry, or NaN if missing
+		static double cff_dict_operand(
+			const std::vector<uint8_t> &operand, const size_t n);
+		static size_t cff_charset_size(
+			const std::vector<uint8_t> &cff, uint32_t offset,
+			uint32_t nglyph);
+		static size_t cff_encoding_size(
+			const std::vector<uint8_t> &cff, uint32_t offset);
+		static bool cff_charstring_closure(
+			const std::vector<uint8_t> &charstring,
+			const std::vector<std::vector<uint8_t> > &global_subr,
+			const std::vector<std::vector<uint8_t> > &local_subr,
+			std::vector<bool> &global_subr_usage,
+			std::vector<bool> &local_subr_usage,
+			std::vector<double> &stack, unsigned int &nstem,
+			bool &error, unsigned int depth);
+		static bool subset_otf_cff_table(
+			struct table_data_s &table_data, const std::string &tag,
+			const std::vector<bool> &glyph_usage);
 		static void parse_ttf_encoding_subtable_format4(
-			std::map<wchar_t, uint16_t> &cid_map,
-			const std::vector<uint8_t> &font_data,
+			cid_map_t &cid_map,
+			const font_blob_t &font_data,
 			const size_t offset);
 		static void parse_ttf_encoding_subtable_format12(
-			std::map<wchar_t, uint16_t> &cid_map,
-			const std::vector<uint8_t> &font_data,
+			cid_map_t &cid_map,
+			const font_blob_t &font_data,
 			const size_t offset);
 		static unsigned int otf_check_sum(
 			const std::vector<unsigned char> &table_data);
 	public:
 		// I/O
 		static std::vector<unsigned char> read_font_data(FILE *);
-		static std::vector<unsigned char> read_font_data(
+		// The font file is memory mapped and shared, see
+		// font_blob_t::open()
+		static font_blob_t read_font_data(
 			const std::string &filename);
 		// Font parsing
 		// OTF/TTF tables
 		static std::map<std::string, std::pair<uint32_t, uint32_t> >
 		parse_ttf_offset_table(
-			const std::vector<uint8_t> &font_data,
+			const font_blob_t &font_data,
 			size_t offset_table_size, uint16_t num_tables);
 		static void parse_ttf_cmap(
-			std::map<wchar_t, uint16_t> &cid_map,
-			const std::vector<uint8_t> &font_data,
+			cid_map_t &cid_map,
+			const font_blob_t &font_data,
 			uint32_t cmap_offset);
 		static void parse_ttf_head(
 			double *font_bbox, uint16_t &units_per_em,
-			const std::vector<uint8_t> &font_data,
+			const font_blob_t &font_data,
 			uint32_t head_offset);
 		static uint16_t parse_ttf_hhea(
-			const std::vector<uint8_t> &font_data,
+			const font_blob_t &font_data,
 			uint32_t hhea_offset);
 		static std::vector<uint16_t> parse_ttf_hmtx(
-			const std::vector<uint8_t> &font_data,
+			const font_blob_t &font_data,
 			uint32_t hmtx_offset, uint16_t number_of_h_metrics);
 		static uint16_t parse_ttf_maxp(
-			const std::vector<uint8_t> &font_data,
+			const font_blob_t &font_data,
 			uint32_t maxp_offset);
 		static void parse_ttf_name(
 			std::string &font_name, uint16_t &cid_encoding_id,
-			const std::vector<uint8_t> &font_data,
+			const font_blob_t &font_data,
 			uint32_t name_offset);
 		static void parse_ttf_os_2(
 			uint32_t &font_descriptor_flag, double &ascent,
 			double &descent, double &leading, double &cap_height,
 			double &x_height, double &stem_v, double &avg_width,
-			const std::vector<uint8_t> &font_data,
+			const font_blob_t &font_data,
 			uint32_t os_2_offset, uint16_t units_per_em);
 		static void parse_ttf_post(
 			std::vector<std::string> &charset,
 			double &italic_angle, uint32_t &font_descriptor_flags,
-			const std::vector<uint8_t> &font_data,
+			const font_blob_t &font_data,
 			uint32_t name_offset);
 		// CFF parsing
 		static std::vector<std::vector<uint8_t> > parse_cff_index(
-			const std::vector<uint8_t> &font_data,
+			const font_blob_t &font_data,
 			uint32_t &current_offset, uint32_t *skip_psize = NULL);
 		static double parse_cff_dict_number(
 			std::vector<uint8_t>::const_iterator &data,
@@ -112,12 +348,12 @@ namespace mathtext {
 			uint16_t sid,
 			const std::vector<std::vector<uint8_t> > &string_index);
 		static std::vector<std::string> parse_cff_charset(
-			const std::vector<uint8_t> &data,
+			const font_blob_t &data,
 			uint32_t charset_offset, uint32_t cff_nglyph,
 			const std::vector<std::vector<uint8_t> > &string_index);
 		static void parse_cff(
 			std::vector<std::string> &charset,
-			const std::vector<uint8_t> &font_data,
+			const font_blob_t &font_data,
 			uint32_t cff_offset);
 		// OTF CFF parsing interface
 		static bool parse_otf_cff_header(
@@ -126,36 +362,59 @@ namespace mathtext {
 			double &italic_angle, double &ascent, double &descent,
 			double &leading, double &cap_height, double &x_height,
 			double &stem_v,double &avg_width,
-			std::map<wchar_t, uint16_t> &cid_map,
+			cid_map_t &cid_map,
 			std::vector<std::string> &charset,
 			std::vector<uint16_t> &advance_width,
 			unsigned int &cff_offset, unsigned int &cff_length,
-			const std::vector<uint8_t> &font_data);
+			const font_blob_t &font_data);
 		static bool parse_otf_cff_header(
 			std::string &font_name, unsigned short &cid_encoding_id,
 			unsigned int &cff_offset, unsigned int &cff_length,
-			const std::vector<unsigned char> &font_data);
+			const font_blob_t &font_data);
+		/**
+		 * Parses the tables of an OpenType or TrueType font
+		 *
+		 * @param[out] font parsed font
+		 * @param[in] font_data OpenType or TrueType font
+		 * @param[in] original if font_data is a subset_otf() of a
+		 * font, the parsed original font, whose character mapping
+		 * and metrics are then reused
+		 * @return true if the font could be parsed
+		 */
+		static bool parse_font(
+			parsed_font_t &font, const font_blob_t &font_data,
+			const parsed_font_t *original = NULL);
 		static std::vector<std::string>
 			charset_from_adobe_glyph_list(
-			std::map<wchar_t, uint16_t> &cid_map);
+			cid_map_t &cid_map);
 		static bool parse_ttf_header(
 			std::string &font_name, unsigned short &cid_encoding_id,
 			uint32_t font_descriptor_flags, double *font_bbox,
 			double &italic_angle, double &ascent, double &descent,
 			double &leading, double &cap_height, double &x_height,
 			double &stem_v,double &avg_width,
-			std::map<wchar_t, uint16_t> &cid_map,
+			cid_map_t &cid_map,
 			std::vector<std::string> &charset,
 			std::vector<uint16_t> &advance_width,
-			const std::vector<uint8_t> &font_data);
+			const font_blob_t &font_data);
 		static bool parse_ttf_header(
 			std::string &font_name, double *font_bbox,
-			std::map<wchar_t, uint16_t> &cid_map,
+			cid_map_t &cid_map,
 			std::vector<std::string> &charset,
-			const std::vector<unsigned char> &font_data);
+			const font_blob_t &font_data);
 		// Font subsetting
+		/**
+		 * Returns an OpenType or TrueType font reduced to the glyphs
+		 * of the used characters, and the glyphs they are composed
+		 * of. Glyph indices are preserved, and the PostScript name is
+		 * prefixed with a subset tag, e.g. "ABCDEF+".
+		 *
+		 * @param[in] font_data OpenType or TrueType font
+		 * @param[in] glyph_usage characters that are used
+		 * @return subset font, or empty if the font cannot be subset
+		 */
 		static std::vector<unsigned char> subset_otf(
-			const std::vector<unsigned char> &font_data,
+			const font_blob_t &font_data,
 			const std::map<wchar_t, bool> &glyph_usage);
 	};
 
@@ -170,15 +429,37 @@ namespace mathtext {
 			std::string &ascii, const uint8_t *buffer,
 			const size_t length);
 	public:
+		/**
+		 * The embedders write the font resource into the sink, and
+		 * return false, writing nothing, if the font cannot be
+		 * embedded in the respective format
+		 */
+		static bool font_embed_type_1(
+			font_sink_t &sink, std::string &font_name,
+			const font_blob_t &font_data);
+		static bool font_embed_type_2(
+			font_sink_t &sink, std::string &font_name,
+			const font_blob_t &font_data,
+			const std::map<wchar_t, bool> &glyph_usage =
+			std::map<wchar_t, bool>());
+		static bool font_embed_type_42(
+			font_sink_t &sink, std::string &font_name,
+			const font_blob_t &font_data,
+			const std::map<wchar_t, bool> &glyph_usage =
+			std::map<wchar_t, bool>());
 		static std::string font_embed_type_1(
 			std::string &font_name,
-			const std::vector<unsigned char> &font_data);
+			const font_blob_t &font_data);
 		static std::string font_embed_type_2(
 			std::string &font_name,
-			const std::vector<unsigned char> &font_data);
+			const font_blob_t &font_data,
+			const std::map<wchar_t, bool> &glyph_usage =
+			std::map<wchar_t, bool>());
 		static std::string font_embed_type_42(
 			std::string &font_name,
-			const std::vector<unsigned char> &font_data);
+			const font_blob_t &font_data,
+			const std::map<wchar_t, bool> &glyph_usage =
+			std::map<wchar_t, bool>());
 	};
 
 	class font_embed_pdf_t : public font_embed_t {
@@ -201,28 +482,343 @@ namespace mathtext {
 			const std::vector<uint16_t> &advance_width);
 		static std::string pdf_vector_differences(
 			const std::string &key,
-			const std::map<wchar_t, uint16_t> &cid_map,
+			const cid_map_t &cid_map,
 			const std::vector<std::string> &charset);
 		static std::map<std::string, std::string>
 		font_embed_cid(
-			std::string &font_name,
-			const std::vector<unsigned char> &font_data,
-			unsigned int type);
+			font_sink_t &font_file, std::string &font_name,
+			const font_blob_t &font_data,
+			unsigned int type,
+			const std::map<wchar_t, bool> &glyph_usage);
+		static std::string font_file_object(
+			const std::string &font_file, unsigned int type);
 	public:
+		/**
+		 * The embedders write the font program, i.e. the data of
+		 * the /FontFile3 or /FontFile2 stream, into the sink font_file
+		 * and return the remaining objects, or return an empty map,
+		 * writing nothing, if the font cannot be embedded. The
+		 * /FontFile3 stream dictionary requires /Subtype
+		 * /CIDFontType0C.
+		 */
+		static std::map<std::string, std::string>
+		font_embed_type_2(
+			font_sink_t &font_file, std::string &font_name,
+			const font_blob_t &font_data,
+			const std::map<wchar_t, bool> &glyph_usage =
+			std::map<wchar_t, bool>());
+		static std::map<std::string, std::string>
+		font_embed_type_42(
+			font_sink_t &font_file, std::string &font_name,
+			const font_blob_t &font_data,
+			const std::map<wchar_t, bool> &glyph_usage =
+			std::map<wchar_t, bool>());
+		/**
+		 * As above, with the font program returned as the complete
+		 * stream object "/FontFile32"
+		 */
 		static std::map<std::string, std::string>
 		font_embed_type_2(
 			std::string &font_name,
-			const std::vector<unsigned char> &font_data);
+			const font_blob_t &font_data,
+			const std::map<wchar_t, bool> &glyph_usage =
+			std::map<wchar_t, bool>());
 		static std::map<std::string, std::string>
 		font_embed_type_42(
 			std::string &font_name,
-			const std::vector<unsigned char> &font_data);
+			const font_blob_t &font_data,
+			const std::map<wchar_t, bool> &glyph_usage =
+			std::map<wchar_t, bool>());
+	};
+
+	/**
+	 * Outline of a glyph in glyph space units, i.e. 1/1000 em, with
+	 * the y axis pointing up
+	 *
+	 * The path is a sequence of operators, each followed in _point
+	 * by the coordinates of 1 (MOVE_TO, LINE_TO), 2 (QUADRATIC_TO,
+	 * from TrueType fonts) or 3 (CUBIC_TO, from CFF fonts) points,
+	 * and by none for CLOSE_PATH. Every contour begins with MOVE_TO
+	 * and ends with CLOSE_PATH.
+	 */
+	class glyph_outline_t {
+	public:
+		enum {
+			MOVE_TO = 0,
+			LINE_TO,
+			QUADRATIC_TO,
+			CUBIC_TO,
+			CLOSE_PATH,
+			NOPERATOR
+		};
+		std::vector<uint8_t> _operator;
+		// x and y of each point
+		std::vector<float> _point;
+		static unsigned int npoint(const uint8_t op);
+		inline void clear(void)
+		{
+			_operator.clear();
+			_point.clear();
+		}
+		inline bool empty(void) const
+		{
+			return _operator.empty();
+		}
+		/**
+		 * Begins a contour, closing the current one
+		 */
+		void move_to(const float x, const float y);
+		void line_to(const float x, const float y);
+		void quadratic_to(const float x1, const float y1,
+						  const float x, const float y);
+		void cubic_to(const float x1, const float y1,
+					  const float x2, const float y2,
+					  const float x, const float y);
+		/**
+		 * Closes the current contour, if any
+		 */
+		void close_path(void);
+		/**
+		 * Appends an outline transformed by the matrix [a b c d e f],
+		 * i.e. x' = a x + c y + e and y' = b x + d y + f
+		 */
+		void append(const glyph_outline_t &outline,
+					const float matrix[6]);
+		/**
+		 * Appends the path construction operators of the outline in
+		 * postfix notation, as in PostScript and PDF content
+		 * streams, e.g. "10 0 m 20 0 l h", with each quadratic
+		 * segment raised to the equivalent cubic one
+		 *
+		 * @param[in] name names of the operators, indexed by
+		 * operator, where the name for QUADRATIC_TO is unused
+		 */
+		void append_postfix(std::string &path,
+							const char *const name[NOPERATOR]) const;
+		/**
+		 * Returns the bounding box of the points, which encloses
+		 * the outline, as left, bottom, right and top, or false if
+		 * the outline is empty
+		 */
+		bool control_box(float box[4]) const;
+		/**
+		 * Returns the exact bounding box of the outline, i.e. the
+		 * end points and the extrema of the curves, as left, bottom,
+		 * right and top, or false if the outline is empty
+		 */
+		bool bounding_box(float box[4]) const;
+	};
+
+	/**
+	 * Glyph outline decoder of an OpenType CFF or TrueType font
+	 *
+	 * The glyph data, i.e. the CharStrings and subroutine INDEXes
+	 * of the CFF table, or the glyf table and its loca offsets, are
+	 * located once on construction, using the parsed table directory
+	 * of the font, so that decoding a glyph reads only the data of
+	 * that glyph. Type 2 charstrings are interpreted including the
+	 * subroutine, flex and arithmetic operators, and CID-keyed fonts
+	 * through their FDSelect. TrueType composite glyphs are
+	 * assembled from their components.
+	 */
+	class font_outline_t : public font_embed_t {
+	private:
+		// Location of a CFF INDEX within the font data
+		class cff_index_t {
+		public:
+			uint32_t _count;
+			uint8_t _off_size;
+			// Offset array, and the byte preceding the data, to
+			// which the offsets are relative
+			uint32_t _offset;
+			uint32_t _data;
+			inline cff_index_t(void)
+				: _count(0), _off_size(0), _offset(0), _data(0)
+			{
+			}
+			bool parse(const font_blob_t &font_data,
+					   uint32_t &offset);
+			bool element(const font_blob_t &font_data,
+						 const uint32_t index, uint32_t &begin,
+						 uint32_t &end) const;
+		};
+		class charstring_state_t;
+		font_blob_t _font_data;
+		bool _valid;
+		bool _cff;
+		uint16_t _nglyph;
+		// Font units to glyph space units
+		float _scale_x;
+		float _scale_y;
+		cff_index_t _char_strings;
+		cff_index_t _global_subr;
+		// Local subroutines of each Font DICT, a single one unless
+		// the font is CID-keyed
+		std::vector<cff_index_t> _local_subr;
+		uint32_t _fd_select;
+		uint32_t _glyf_offset;
+		uint32_t _glyf_length;
+		uint32_t _loca_offset;
+		uint32_t _loca_length;
+		bool _long_loca;
+		std::vector<uint8_t> cff_dict(const uint32_t begin,
+									  const uint32_t end) const;
+		bool parse_cff(const uint32_t cff_offset,
+					   const uint32_t cff_length);
+		bool parse_cff_private_dict(
+			cff_index_t &local_subr, const uint32_t cff_offset,
+			const uint32_t cff_length,
+			const std::vector<uint8_t> &operand) const;
+		bool parse_ttf(void);
+		unsigned int cff_font_dict(const uint16_t glyph) const;
+		bool cff_charstring(glyph_outline_t &outline,
+							charstring_state_t &state,
+							const uint32_t begin, const uint32_t end,
+							const cff_index_t &local_subr,
+							const unsigned int depth) const;
+		void ttf_glyph_location(uint32_t &begin, uint32_t &end,
+								const uint16_t glyph) const;
+		bool ttf_glyph(glyph_outline_t &outline, const uint16_t glyph,
+					   const unsigned int depth) const;
+	public:
+		font_outline_t(void);
+		font_outline_t(const font_blob_t &font_data);
+		/**
+		 * Returns false if the font has no glyph data that can be
+		 * decoded
+		 */
+		inline bool valid(void) const
+		{
+			return _valid;
+		}
+		inline uint16_t nglyph(void) const
+		{
+			return _nglyph;
+		}
+		/**
+		 * Decodes the outline of a glyph
+		 *
+		 * @param[out] outline outline of the glyph, empty for a
+		 * glyph without contours
+		 * @param[in] glyph glyph index
+		 * @return false if the glyph data is invalid
+		 */
+		bool glyph_outline(glyph_outline_t &outline,
+						   const uint16_t glyph) const;
+		/**
+		 * Returns the ink bounds of a glyph, from the glyf header of
+		 * a TrueType glyph, and from the decoded outline of a CFF
+		 * glyph
+		 *
+		 * @param[out] box left, bottom, right and top in glyph space
+		 * units, all zero for a glyph without contours
+		 * @param[in] glyph glyph index
+		 * @return false if the glyph data is invalid
+		 */
+		bool glyph_bounding_box(float box[4], const uint16_t glyph)
+			const;
+		/**
+		 * Returns the glyph whose horizontal metrics apply to a
+		 * glyph, which differs from it only for TrueType composite
+		 * glyphs with a component flagged USE_MY_METRICS
+		 */
+		uint16_t metrics_glyph(const uint16_t glyph) const;
 	};
 
+	/**
+	 * Advance and ink bounds of every glyph of an OpenType CFF or
+	 * TrueType font
+	 *
+	 * The table is dense, indexed by the glyph index, and filled on
+	 * construction, with the advances from the hmtx table and the
+	 * bounds from font_outline_t::glyph_bounding_box(), so that
+	 * text can be measured without FreeType and without loading
+	 * glyphs. All values are in glyph space units, i.e. 1/1000 em,
+	 * with the y axis pointing up. The table of a font file is
+	 * shared, see font_blob_t::font_metrics().
+	 */
+	class font_metrics_t {
+	public:
+		class glyph_metrics_t {
+		public:
+			float _advance;
+			// Left, bottom, right and top
+			float _bounding_box[4];
+		};
+	private:
+		std::vector<glyph_metrics_t> _glyph_metrics;
+	public:
+		font_metrics_t(void);
+		font_metrics_t(const font_blob_t &font_data);
+		/**
+		 * Returns false if the font has no metrics that can be read
+		 */
+		inline bool valid(void) const
+		{
+			return !_glyph_metrics.empty();
+		}
+		inline size_t nglyph(void) const
+		{
+			return _glyph_metrics.size();
+		}
+		/**
+		 * Returns the metrics of a glyph, or NULL if the glyph index
+		 * is out of range
+		 */
+		inline const glyph_metrics_t *glyph_metrics(
+			const uint16_t glyph) const
+		{
+			return glyph < _glyph_metrics.size() ?
+				&_glyph_metrics[glyph] : NULL;
+		}
+	};
+
+	/**
+	 * Glyph outlines as SVG path elements
+	 *
+	 * Each glyph is defined once as a <path> in glyph space units,
+	 * with the y axis pointing up, and drawn by <use> elements that
+	 * scale it to the font size and flip the y axis.
+	 */
 	class font_embed_svg_t : public font_embed_t {
+	public:
+		/**
+		 * Appends the path data of an outline, e.g. "M10 0L20 0Z"
+		 */
+		static void append_path_data(std::string &path_data,
+									 const glyph_outline_t &outline);
+		/**
+		 * Returns the XML id of the path of a glyph, derived from the
+		 * PostScript name of the font
+		 */
+		static std::string glyph_id(const std::string &font_name,
+									const uint16_t glyph);
+		/**
+		 * Appends the <path> element of a glyph, or nothing for a
+		 * glyph without contours
+		 */
+		static void append_glyph(std::string &svg,
+								 const std::string &font_name,
+								 const uint16_t glyph,
+								 const glyph_outline_t &outline);
+		/**
+		 * Writes a <defs> element with the paths of the glyphs of the
+		 * used characters, or of all mapped characters if
+		 * glyph_usage is empty, and returns false, writing nothing,
+		 * if the outlines cannot be decoded
+		 */
+		static bool font_embed_svg(
+			font_sink_t &sink, std::string &font_name,
+			const font_blob_t &font_data,
+			const std::map<wchar_t, bool> &glyph_usage =
+			std::map<wchar_t, bool>());
 		static std::string font_embed_svg(
 			std::string &font_name,
-			const std::vector<unsigned char> &font_data);
+			const font_blob_t &font_data,
+			const std::map<wchar_t, bool> &glyph_usage =
+			std::map<wchar_t, bool>());
 	};
 
 }
+
+#endif // MATHTEXT_FONTEMBED_H_
@@ -0,0 +1,219 @@
+// -*- mode: c++; -*-
+
+// mathtext - A TeX/LaTeX compatible rendering library. Copyright (C)
+// 2008-2016 Yue Shi Lai <ylai@users.sourceforge.net>
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2.1 of
+// the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// 02110-1301 USA
+
+#ifndef MATHTEXT_FONTSINK_H_
+#define MATHTEXT_FONTSINK_H_
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <stdint.h>
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif // HAVE_ZLIB
+
+namespace mathtext {
+
+	/**
+	 * Destination of font embedding output
+	 *
+	 * The embedders write into a sink as the output is generated, so
+	 * that embedding a font holds no more than the font data itself
+	 * in memory. Encoding and compressing sinks pass their output on
+	 * to another sink, and have to be finished by finish() once all
+	 * data is written.
+	 */
+	class font_sink_t {
+	public:
+		virtual ~font_sink_t(void);
+		virtual void write(const uint8_t *buffer,
+						   const size_t length) = 0;
+		void put(const char *string);
+		void put(const std::string &string);
+		void printf(const char *format, ...);
+	};
+
+	/**
+	 * Sink writing to a stdio stream
+	 */
+	class file_sink_t : public font_sink_t {
+	private:
+		FILE *_fp;
+		unsigned long _length;
+	public:
+		file_sink_t(FILE *fp);
+		virtual void write(const uint8_t *buffer, const size_t length);
+		/**
+		 * Returns the number of bytes written
+		 */
+		inline unsigned long length(void) const
+		{
+			return _length;
+		}
+	};
+
+	/**
+	 * Sink writing to a file descriptor, buffered
+	 */
+	class fd_sink_t : public font_sink_t {
+	private:
+		int _fd;
+		std::vector<uint8_t> _buffer;
+		size_t _buffer_length;
+	public:
+		fd_sink_t(const int fd);
+		virtual ~fd_sink_t(void);
+		virtual void write(const uint8_t *buffer, const size_t length);
+		void flush(void);
+	};
+
+	/**
+	 * Sink appending to a string
+	 */
+	class string_sink_t : public font_sink_t {
+	private:
+		std::string &_string;
+	public:
+		string_sink_t(std::string &string);
+		virtual void write(const uint8_t *buffer, const size_t length);
+	};
+
+	/**
+	 * Instruction sets of the ASCIIHex and ASCII85 encoders
+	 */
+	enum encoder_instruction_set_t {
+		ENCODER_SCALAR = 0,
+		ENCODER_SSE2,
+		ENCODER_AVX2
+	};
+
+	/**
+	 * Returns the instruction set used by the encoders, which by
+	 * default is the most capable one that is both compiled in (by
+	 * HAVE_SSE2 or HAVE_AVX2) and supported by the CPU
+	 */
+	encoder_instruction_set_t encoder_instruction_set(void);
+	/**
+	 * Selects the instruction set used by the encoders, e.g. for
+	 * benchmarking. Must not be called while encoding.
+	 *
+	 * @return false, leaving the selection unchanged, if the
+	 * instruction set is not available
+	 */
+	bool set_encoder_instruction_set(
+		const encoder_instruction_set_t instruction_set);
+
+	/**
+	 * ASCIIHex encoder, with lines of 64 characters
+	 */
+	class asciihex_sink_t : public font_sink_t {
+	private:
+		font_sink_t &_sink;
+		unsigned int _column;
+		// Output of one block, before and after line breaking
+		std::vector<char> _encoded;
+		std::vector<char> _wrapped;
+	public:
+		asciihex_sink_t(font_sink_t &sink);
+		virtual void write(const uint8_t *buffer, const size_t length);
+	};
+
+	/**
+	 * ASCII85 encoder, with lines of 64 characters, which finish()
+	 * terminates by the end-of-data marker "~>"
+	 */
+	class ascii85_sink_t : public font_sink_t {
+	private:
+		font_sink_t &_sink;
+		uint8_t _tuple[4];
+		unsigned int _tuple_length;
+		unsigned int _column;
+		std::vector<char> _encoded;
+		std::vector<char> _wrapped;
+		void put_encoded(const size_t length);
+	public:
+		ascii85_sink_t(font_sink_t &sink);
+		virtual void write(const uint8_t *buffer, const size_t length);
+		void finish(void);
+	};
+
+	/**
+	 * RunLengthDecode compressor, which finish() terminates by the
+	 * end-of-data byte 128
+	 */
+	class run_length_sink_t : public font_sink_t {
+	private:
+		font_sink_t &_sink;
+		// Pending literal bytes, and the run of identical bytes
+		// following them
+		uint8_t _literal[128];
+		unsigned int _literal_length;
+		uint8_t _run_byte;
+		unsigned int _run_length;
+		std::vector<uint8_t> _buffer;
+		size_t _buffer_length;
+		void put_literal(void);
+		void put_run(void);
+		void flush_buffer(void);
+	public:
+		run_length_sink_t(font_sink_t &sink);
+		virtual void write(const uint8_t *buffer, const size_t length);
+		void finish(void);
+	};
+
+	/**
+	 * Base64 encoder without line breaks, e.g. for data URIs, which
+	 * finish() terminates by the padding
+	 */
+	class base64_sink_t : public font_sink_t {
+	private:
+		font_sink_t &_sink;
+		uint8_t _tuple[3];
+		unsigned int _tuple_length;
+		std::vector<char> _encoded;
+	public:
+		base64_sink_t(font_sink_t &sink);
+		virtual void write(const uint8_t *buffer, const size_t length);
+		void finish(void);
+	};
+
+#ifdef HAVE_ZLIB
+	/**
+	 * zlib (FlateDecode) compressor
+	 */
+	class deflate_sink_t : public font_sink_t {
+	private:
+		font_sink_t &_sink;
+		z_stream _stream;
+		std::vector<uint8_t> _buffer;
+		void deflate_buffer(const int flush);
+	public:
+		deflate_sink_t(font_sink_t &sink,
+					   const int level = Z_DEFAULT_COMPRESSION);
+		virtual ~deflate_sink_t(void);
+		virtual void write(const uint8_t *buffer, const size_t length);
+		void finish(void);
+	};
+#endif // HAVE_ZLIB
+
+}
+
+#endif // MATHTEXT_FONTSINK_H_
@@ -23,9 +23,12 @@
 
 #include <string>
 #include <iostream>
+#include <map>
 #include <stdint.h>
 #include <mathtext/geometry.h>
 #include <mathtext/mathtext.h>
+#include <mathtext/mutex.h>
+#include <mathtext/statistics.h>
 
 namespace mathtext {
 
@@ -129,58 +132,189 @@ namespace mathtext {
 		// Token
 		class math_token_t {
 		public:
+			enum {
+				TYPE_SPACE = 0,
+				TYPE_GLYPH,
+				TYPE_BOX,
+				TYPE_RULE,
+				TYPE_LIST
+			};
+			unsigned int _type;
 			point_t _offset;
 			bounding_box_t _bounding_box;
-			union {
-				unsigned int _style;
-				struct {
-					wchar_t _glyph;
-					unsigned int _family;
-					float _size;
-				} _extensible;
-			};
-			float _delimiter_height;
-			inline math_token_t(
-				const bounding_box_t bounding_box,
-				const unsigned int style,
-				const float delimiter_height = 0.0F)
-				: _offset(0, 0), _bounding_box(bounding_box),
-				  _style(style), _delimiter_height(delimiter_height)
+			// TYPE_GLYPH and TYPE_BOX
+			wchar_t _glyph;
+			unsigned int _family;
+			float _size;
+			// TYPE_LIST: range of the child tokens, TYPE_BOX: index
+			// of the string
+			unsigned long _begin;
+			unsigned long _end;
+			inline math_token_t(void)
+				: _type(TYPE_SPACE), _offset(0, 0),
+				  _bounding_box(0, 0, 0, 0, 0, 0), _glyph(L'\0'),
+				  _family(0), _size(0.0F), _begin(0), _end(0)
 			{
 			}
 			inline math_token_t(
-				const point_t offset,
-				const bounding_box_t bounding_box,
-				const unsigned int style,
-				const float delimiter_height = 0.0F)
-				: _offset(offset), _bounding_box(bounding_box),
-				  _style(style), _delimiter_height(delimiter_height)
+				const unsigned int type,
+				const bounding_box_t bounding_box)
+				: _type(type), _offset(0, 0),
+				  _bounding_box(bounding_box), _glyph(L'\0'),
+				  _family(0), _size(0.0F), _begin(0), _end(0)
 			{
 			}
 			inline math_token_t(
 				const bounding_box_t bounding_box,
 				const wchar_t glyph, const unsigned int family,
 				const float size)
-				: _offset(0, 0), _bounding_box(bounding_box),
-				  _delimiter_height(0.0F)
+				: _type(TYPE_GLYPH), _offset(0, 0),
+				  _bounding_box(bounding_box), _glyph(glyph),
+				  _family(family), _size(size), _begin(0), _end(0)
 			{
-				_extensible._glyph = glyph;
-				_extensible._family = family;
-				_extensible._size = size;
 			}
 			inline math_token_t(
 				const point_t offset,
 				const bounding_box_t bounding_box,
 				const wchar_t glyph, const unsigned int family,
 				const float size)
-				: _offset(offset), _bounding_box(bounding_box),
-				  _delimiter_height(0.0F)
+				: _type(TYPE_GLYPH), _offset(offset),
+				  _bounding_box(bounding_box), _glyph(glyph),
+				  _family(family), _size(size), _begin(0), _end(0)
+			{
+			}
+			inline math_token_t &at(const point_t offset)
+			{
+				_offset = offset;
+
+				return *this;
+			}
+		};
+	public:
+		/**
+		 * Positioned token tree of a formula
+		 *
+		 * A layout is built in a single pass over the math list by
+		 * layout(), and drawing it with text() only walks the tree,
+		 * without measuring any glyph again. The child tokens of a
+		 * list token are stored contiguously in _token, and each
+		 * offset is in pixel coordinates, relative to the parent.
+		 *
+		 * Atoms and math lists that are measured before they are
+		 * set, e.g. the nucleus under an accent, are memoized by
+		 * node and style while the layout is built, so that they
+		 * are laid out only once. The memo refers to the formula
+		 * and is discarded when layout() returns.
+		 *
+		 * With MATHTEXT_STATISTICS, the layout also holds the
+		 * statistics of parsing and laying out its formula.
+		 */
+		class math_layout_t {
+		private:
+			typedef std::map<std::pair<const void *, unsigned int>,
+							 math_token_t> memo_t;
+			std::vector<math_token_t> _token;
+			std::vector<std::wstring> _string;
+			math_token_t _root;
+			bool _render_structure;
+			memo_t _memo;
+			unsigned long _memo_hit;
+#ifdef MATHTEXT_STATISTICS
+			statistics_t _statistics;
+#endif // MATHTEXT_STATISTICS
+			inline const math_token_t *
+			find_memo(const void *node, const unsigned int style)
+			{
+				if (_memo.empty())
+					return NULL;
+
+				const memo_t::const_iterator iterator =
+					_memo.find(std::make_pair(node, style));
+
+				if (iterator == _memo.end())
+					return NULL;
+				_memo_hit++;
+
+				return &iterator->second;
+			}
+		public:
+			inline math_layout_t(void)
+				: _render_structure(false), _memo_hit(0)
+			{
+			}
+			inline bounding_box_t bounding_box(void) const
 			{
-				_extensible._glyph = glyph;
-				_extensible._family = family;
-				_extensible._size = size;
+				return _root._bounding_box;
 			}
+			inline bool empty(void) const
+			{
+				return _root._type == math_token_t::TYPE_SPACE;
+			}
+			/**
+			 * Returns the number of atoms and math lists whose
+			 * layout was taken from the memo
+			 */
+			inline unsigned long memo_hit(void) const
+			{
+				return _memo_hit;
+			}
+#ifdef MATHTEXT_STATISTICS
+			inline const statistics_t &statistics(void) const
+			{
+				return _statistics;
+			}
+#endif // MATHTEXT_STATISTICS
+			friend class math_text_renderer_t;
 		};
+		/**
+		 * Formula placed at a position, for drawing many formulae
+		 * with text(const std::vector<math_text_item_t> &)
+		 */
+		class math_text_item_t {
+		public:
+			float _x;
+			float _y;
+			const math_text_t *_math_text;
+			bool _display_style;
+			inline math_text_item_t(const float x, const float y,
+									const math_text_t &math_text,
+									const bool display_style = false)
+				: _x(x), _y(y), _math_text(&math_text),
+				  _display_style(display_style)
+			{
+			}
+		};
+		/**
+		 * Glyph placed at a position in logical coordinates
+		 *
+		 * Glyphs of the formulae drawn together are collected and
+		 * ordered by family and size, so that glyph_run() is called
+		 * once for every family and size, instead of changing the
+		 * font state for every glyph.
+		 */
+		class math_glyph_t {
+		public:
+			point_t _origin;
+			wchar_t _glyph;
+			unsigned int _family;
+			float _size;
+			inline math_glyph_t(const point_t &origin,
+								const wchar_t glyph,
+								const unsigned int family,
+								const float size)
+				: _origin(origin), _glyph(glyph), _family(family),
+				  _size(size)
+			{
+			}
+			inline bool operator<(const math_glyph_t &glyph) const
+			{
+				return _family < glyph._family ||
+					(_family == glyph._family && _size < glyph._size);
+			}
+		};
+		typedef std::vector<math_glyph_t>::const_iterator
+			math_glyph_iterator_t;
+	private:
 		/////////////////////////////////////////////////////////////
 		// Style test and change
 		float style_size(const unsigned int style) const;
@@ -211,7 +345,7 @@ namespace mathtext {
 		unsigned int next_denominator_style(const unsigned int style)
 			const;
 		/////////////////////////////////////////////////////////////
-		float x_height(const unsigned int style);
+		float x_height(const unsigned int style) const;
 		float quad(const unsigned int style) const;
 		unsigned int
 		math_family(const math_text_t::math_symbol_t &math_symbol)
@@ -232,6 +366,36 @@ namespace mathtext {
 		float math_spacing(
 			unsigned int left_type, unsigned int right_type,
 			unsigned int style) const;
+		/////////////////////////////////////////////////////////////
+		// Glyph metrics cache, in units of the font size, shared by
+		// concurrent layouts. The cache and its counters are only
+		// accessed while holding _glyph_metrics_mutex
+		mutable std::map<wchar_t, bounding_box_t>
+		_glyph_metrics[NFAMILY];
+		mutable unsigned long _glyph_metrics_hit;
+		mutable unsigned long _glyph_metrics_miss;
+		mutable mutex_t _glyph_metrics_mutex;
+		// Serializes the measurements of the default sized
+		// bounding_box()
+		mutable mutex_t _bounding_box_mutex;
+		// Font file names, or unique strings for fonts that are not
+		// named, see font_identity()
+		std::string _font_identity[NFAMILY];
+		static unsigned long next_font_serial(void);
+		static std::string unique_font_identity(void);
+#ifdef MATHTEXT_STATISTICS
+		// Layouts are added to _statistics as they finish, possibly
+		// concurrently, while drawing is counted in
+		// _draw_statistics and added once per call of text()
+		mutable statistics_t _statistics;
+		mutable mutex_t _statistics_mutex;
+		statistics_t _draw_statistics;
+		statistics_t _formula_statistics;
+		statistics_t glyph_metrics_statistics(void) const;
+		void begin_draw_statistics(statistics_t &before);
+		void end_draw_statistics(const statistics_t &before,
+								 const statistics_t &layout);
+#endif // MATHTEXT_STATISTICS
 	protected:
 		virtual affine_transform_t
 		transform_logical_to_pixel(void) const = 0;
@@ -240,10 +404,11 @@ namespace mathtext {
 		/////////////////////////////////////////////////////////////
 		// Box rendering
 		bounding_box_t math_bounding_box(
-			const math_text_t::box_t &box, const unsigned int style);
-		void math_text(
-			const point_t origin, const math_text_t::box_t &box,
-			const unsigned int style, const bool render_structure);
+			const math_text_t::box_t &box, const unsigned int style)
+			const;
+		math_token_t math_layout(
+			math_layout_t &layout, const math_text_t::box_t &box,
+			const unsigned int style) const;
 		/////////////////////////////////////////////////////////////
 		// Symbol rendering
 		static bool is_wgl_4(const wchar_t c);
@@ -256,18 +421,15 @@ namespace mathtext {
 		static bool is_cjk_punctuation_closed(const wchar_t c);
 		bounding_box_t math_bounding_box(
 			const wchar_t &glyph, const unsigned int family,
-			const float size);
+			const float size) const;
 		void math_text(
 			const point_t origin, const wchar_t &glyph,
 			const unsigned int family, const float size,
 			const bool render_structure);
-		bounding_box_t math_bounding_box(
+		math_token_t math_layout(
+			math_layout_t &layout,
 			const math_text_t::math_symbol_t &math_symbol,
-			const unsigned int style);
-		void math_text(
-			const point_t origin,
-			const math_text_t::math_symbol_t &math_symbol,
-			const unsigned int style, const bool render_structure);
+			const unsigned int style) const;
 		/////////////////////////////////////////////////////////////
 		// Extensible glyph rendering
 		void large_family(
@@ -276,63 +438,110 @@ namespace mathtext {
 		void extensible_glyph(
 			wchar_t glyph[4], unsigned long &nrepeat,
 			const math_text_t::math_symbol_t &math_symbol,
-			const unsigned int style, const float height);
-		std::vector<math_token_t> math_tokenize(
-			const math_text_t::math_symbol_t &math_symbol,
-			const unsigned int style, const float height);
-		bounding_box_t math_bounding_box(
-			const math_text_t::math_symbol_t &math_symbol,
-			const unsigned int style, const float height);
-		void math_text(
-			const point_t origin,
+			const unsigned int style, const float height) const;
+		math_token_t math_layout(
+			math_layout_t &layout,
 			const math_text_t::math_symbol_t &math_symbol,
-			const unsigned int style, const float height,
-			const bool render_structure);
+			const unsigned int style, const float height) const;
 		/////////////////////////////////////////////////////////////
 		// Math list rendering
-		std::vector<math_token_t> math_tokenize(
+		math_token_t math_layout_list(
+			math_layout_t &layout,
+			const std::vector<math_token_t> &token_list) const;
+		math_token_t math_layout(
+			math_layout_t &layout,
 			const std::vector<math_text_t::item_t>::const_iterator &
 			math_list_begin,
 			const std::vector<math_text_t::item_t>::const_iterator &
 			math_list_end,
-			unsigned int style);
-		bounding_box_t math_bounding_box(
-			const std::vector<math_text_t::item_t>::const_iterator &
-			math_list_begin,
-			const std::vector<math_text_t::item_t>::const_iterator &
-			math_list_end,
-			unsigned int style);
-		void math_text(
-			const point_t origin,
-			const std::vector<math_text_t::item_t>::const_iterator &
-			math_list_begin,
-			const std::vector<math_text_t::item_t>::const_iterator &
-			math_list_end,
-			const unsigned int style, const bool render_structure);
+			const unsigned int style) const;
 		/////////////////////////////////////////////////////////////
 		// Field rendering
+		math_token_t math_layout(
+			math_layout_t &layout, const math_text_t::field_t &field,
+			const unsigned int style) const;
 		bounding_box_t math_bounding_box(
-			const math_text_t::field_t &field,
-			const unsigned int style);
-		void math_text(
-			const point_t origin, const math_text_t::field_t &field,
-			const unsigned int style, const bool render_structure);
+			math_layout_t &layout, const math_text_t::field_t &field,
+			const unsigned int style) const;
 		/////////////////////////////////////////////////////////////
 		// Atom rendering
-		std::vector<math_token_t> math_tokenize(
-			const math_text_t::atom_t &atom, unsigned int style);
+		math_token_t math_layout_atom(
+			math_layout_t &layout, const math_text_t::atom_t &atom,
+			const unsigned int style) const;
+		math_token_t math_layout(
+			math_layout_t &layout, const math_text_t::atom_t &atom,
+			const unsigned int style) const;
 		bounding_box_t math_bounding_box(
-			const math_text_t::atom_t &atom,
-			const unsigned int style);
+			math_layout_t &layout, const math_text_t::atom_t &atom,
+			const unsigned int style) const;
+		/////////////////////////////////////////////////////////////
+		// Layout rendering
 		void math_text(
-			const point_t origin, const math_text_t::atom_t &atom,
-			const unsigned int style, const bool render_structure);
+			std::vector<math_glyph_t> &glyph, const point_t origin,
+			const math_layout_t &layout, const math_token_t &token,
+			const bool render_structure);
+		void math_text(std::vector<math_glyph_t> &glyph);
+		/**
+		 * Draws glyphs that all have the same family and size
+		 *
+		 * The default implementation changes the font size once and
+		 * draws each glyph with text_raw(). Surfaces may override it
+		 * to select the font only once for the run.
+		 *
+		 * @param[in] glyph_begin first glyph of the run
+		 * @param[in] glyph_end end of the run
+		 */
+		virtual void glyph_run(
+			const math_glyph_iterator_t &glyph_begin,
+			const math_glyph_iterator_t &glyph_end);
+		/**
+		 * Called once with all glyphs to be drawn, ordered by family
+		 * and size, before the glyph_run() calls
+		 *
+		 * The default implementation does nothing. Surfaces may
+		 * override it to prepare font resources for all runs at
+		 * once.
+		 *
+		 * @param[in] glyph_begin first glyph
+		 * @param[in] glyph_end end of the glyphs
+		 */
+		inline virtual void prepare_glyph_run(
+			const math_glyph_iterator_t &glyph_begin,
+			const math_glyph_iterator_t &glyph_end)
+		{
+		}
+#ifdef MATHTEXT_STATISTICS
+		/**
+		 * Returns the number of bytes of output written so far, for
+		 * the statistics of surfaces that write files
+		 *
+		 * The default implementation returns 0.
+		 */
+		inline virtual unsigned long output_size(void) const
+		{
+			return 0;
+		}
+		/**
+		 * Adds to a counter of the statistics of the formulae being
+		 * drawn, e.g. from glyph_run()
+		 */
+		inline void count(const unsigned int counter,
+						  const unsigned long n = 1)
+		{
+			_draw_statistics.count(counter, n);
+		}
+#endif // MATHTEXT_STATISTICS
 		/////////////////////////////////////////////////////////////
 	public:
 		/////////////////////////////////////////////////////////////
 		// Constructor and destructor
 		inline math_text_renderer_t(void)
+			: _glyph_metrics_hit(0), _glyph_metrics_miss(0)
 		{
+			// Until a font is named by reset_glyph_metrics(), the
+			// fonts are known only to this renderer
+			for (unsigned int family = 0; family < NFAMILY; family++)
+				_font_identity[family] = unique_font_identity();
 		}
 		inline virtual ~math_text_renderer_t(void)
 		{
@@ -360,15 +569,143 @@ namespace mathtext {
 		virtual void text_with_bounding_box(
 			const float x, const float y, const std::wstring string,
 			const unsigned int family = FAMILY_PLAIN) = 0;
+		/**
+		 * Measures a string at a given font size, without changing
+		 * the font state of the renderer
+		 *
+		 * All glyph measurements of layout() are made through this
+		 * function, and it must be safe to call concurrently for
+		 * layouts to run in parallel. The default implementation
+		 * measures with the two-argument bounding_box() at the
+		 * current font size of the family and scales the result,
+		 * which assumes outline fonts. Since the two-argument
+		 * bounding_box() need not be thread-safe, e.g. with FTGL,
+		 * the default implementation measures one string at a time.
+		 * Surfaces that can measure at any size and concurrently,
+		 * e.g. from unscaled font metrics, should override it.
+		 *
+		 * @param[in] string string to be measured
+		 * @param[in] family font family
+		 * @param[in] size font size
+		 * @return bounding box of the string
+		 */
+		virtual bounding_box_t bounding_box(
+			const std::wstring string, const unsigned int family,
+			const float size) const;
 		/////////////////////////////////////////////////////////////
 		// Interface
+		/**
+		 * Lays out a formula
+		 *
+		 * The layout only reads the renderer, keeping its state in
+		 * the returned layout and on the stack, and may therefore
+		 * run concurrently from several threads, e.g. to lay out
+		 * many labels on a worker pool. The fonts and the font size
+		 * must not be changed, and nothing drawn on the renderer,
+		 * until the concurrent layouts have finished. Drawing the
+		 * layouts with text() is not thread-safe.
+		 *
+		 * @param[in] math_text formula
+		 * @param[in] display_style true for display style, false for
+		 * text style
+		 * @return layout that can be drawn with text()
+		 */
+		math_layout_t layout(
+			const math_text_t &math_text,
+			const bool display_style = false) const;
 		bounding_box_t bounding_box(
 			const math_text_t &math_text,
-			const bool display_style = false);
+			const bool display_style = false) const;
 		void text(
 			const float x, const float y,
 			const math_text_t &math_text,
 			const bool display_style = false);
+		void text(
+			const float x, const float y,
+			const math_layout_t &layout);
+		/**
+		 * Lays out and draws many formulae, e.g. the tick labels of
+		 * an axis, with the glyphs of all formulae grouped into runs
+		 * of the same family and size
+		 *
+		 * @param[in] item formulae and their positions
+		 */
+		void text(const std::vector<math_text_item_t> &item);
+		/**
+		 * Draws many formulae that are already laid out
+		 *
+		 * @param[in] origin positions of the formulae
+		 * @param[in] layout layouts of the formulae
+		 */
+		void text(const std::vector<point_t> &origin,
+				  const std::vector<math_layout_t> &layout);
+		/////////////////////////////////////////////////////////////
+		// Glyph metrics cache
+		/**
+		 * Discards the cached glyph metrics of a font family
+		 *
+		 * Must be called whenever the font of the family is
+		 * replaced, e.g. by surface_t::open_font_overwrite().
+		 *
+		 * @param[in] family font family
+		 * @param[in] font_name name that identifies the new font to
+		 * other renderers, e.g. its file name, or empty if the font
+		 * is known only to this renderer
+		 */
+		void reset_glyph_metrics(const unsigned int family,
+								 const std::string &font_name =
+								 std::string());
+		/**
+		 * Discards the cached glyph metrics of all font families,
+		 * whose fonts are then known only to this renderer
+		 */
+		void reset_glyph_metrics(void);
+		inline unsigned long glyph_metrics_hit(void) const
+		{
+			lock_t lock(_glyph_metrics_mutex);
+
+			return _glyph_metrics_hit;
+		}
+		inline unsigned long glyph_metrics_miss(void) const
+		{
+			lock_t lock(_glyph_metrics_mutex);
+
+			return _glyph_metrics_miss;
+		}
+		/**
+		 * Returns a string identifying the type of the renderer and
+		 * its current fonts
+		 *
+		 * Renderers with the same identity measure glyphs alike, and
+		 * can therefore share layouts made at the same font size,
+		 * e.g. through math_text_cache_t.
+		 */
+		std::string font_identity(void) const;
+#ifdef MATHTEXT_STATISTICS
+		/////////////////////////////////////////////////////////////
+		// Statistics
+		/**
+		 * Returns the statistics of all formulae laid out and drawn
+		 * since construction or reset_statistics()
+		 *
+		 * The parse time of a formula is included with each of its
+		 * layouts.
+		 */
+		statistics_t statistics(void) const;
+		/**
+		 * Returns the statistics of the formulae drawn by the last
+		 * call of text(), including their layout
+		 *
+		 * Glyph metrics are attributed to a formula by the change of
+		 * the counters of the shared cache, which is only correct
+		 * if no other formula is laid out concurrently.
+		 */
+		inline const statistics_t &formula_statistics(void) const
+		{
+			return _formula_statistics;
+		}
+		void reset_statistics(void);
+#endif // MATHTEXT_STATISTICS
 		/////////////////////////////////////////////////////////////
 		inline float default_axis_height(
 			const bool display_style = false) const
@@ -20,6 +20,9 @@
 #define MATHTEXT_H_
 
 #include <vector>
+#include <string>
+#include <stdint.h>
+#include <mathtext/statistics.h>
 
 namespace mathtext {
 
@@ -58,6 +61,32 @@ namespace mathtext {
 	 */
 	class math_text_t {
 	private:
+		/**
+		 * Descriptor of a control sequence
+		 *
+		 * Every control sequence known to the parser or the symbol
+		 * encoding is described by a single entry of the generated
+		 * table "table/mathcs.h", so that a token is resolved by one
+		 * hash lookup instead of searching several sorted tables.
+		 *
+		 * @see find_control_sequence(const char *, const size_t)
+		 */
+		class control_sequence_t {
+		public:
+			const char *_name;
+			// tex_token_t::CONTROL_SEQUENCE_*
+			unsigned int _control_sequence;
+			// Takes an optional argument in brackets, e.g. \sqrt[3]
+			bool _bracket;
+			// Symbol, or L'\0'
+			wchar_t _glyph;
+			unsigned int _type;
+			bool _upright;
+			// Font change to math_symbol_t::FAMILY_*, or -1
+			int _family;
+			// Index into the operator table, or -1
+			int _operator;
+		};
 		/**
 		 * Mathematical symbol
 		 *
@@ -133,7 +162,8 @@ namespace mathtext {
 			 */
 			void math_italic_is_italic(void);
 			void encode_character(void);
-			void encode_control_sequence(void);
+			void encode_control_sequence(const control_sequence_t *
+										 control_sequence);
 			void encode_math_blackboard_bold(void);
 			void encode_math_script_italic(void);
 			void encode_math_script_bold_italic(void);
@@ -144,7 +174,7 @@ namespace mathtext {
 			void encode_math_sans_serif_bold(void);
 			void encode_math_sans_serif_bold_italic(void);
 			void encode_math_alpha(void);
-			void encode(void);
+			void encode(const control_sequence_t *control_sequence);
 		public:
 			std::string _code;
 			unsigned int _family;
@@ -165,7 +195,23 @@ namespace mathtext {
 				: _code(code), _family(family), _glyph(0),
 				  _type(atom_t::TYPE_UNKNOWN)
 			{
-				encode();
+				encode(code.size() > 1 && code[0] == '\\' ?
+					   find_control_sequence(code.data() + 1,
+											 code.size() - 1) :
+					   NULL);
+			}
+			/**
+			 * Constructs a symbol from a control sequence that was
+			 * already resolved by the lexer
+			 */
+			inline math_symbol_t(std::string code,
+								 const control_sequence_t *
+								 control_sequence,
+								 const unsigned int family)
+				: _code(code), _family(family), _glyph(0),
+				  _type(atom_t::TYPE_UNKNOWN)
+			{
+				encode(control_sequence);
 			}
 			inline bool is_combining_diacritical(void) const
 			{
@@ -196,8 +242,80 @@ namespace mathtext {
 			{
 			}
 		};
+		/**
+		 * Lexical token of a TeX source string
+		 *
+		 * A token refers to its characters in the source string by
+		 * offset and length. Control sequences are resolved to their
+		 * descriptor once by the lexer, so that they never have to
+		 * be compared as strings.
+		 *
+		 * @see tex_split(const std::string &, const char)
+		 */
+		class tex_token_t {
+		public:
+			enum {
+				KIND_CHARACTER = 0,
+				KIND_CONTROL_SEQUENCE,
+				KIND_BEGIN_GROUP,
+				KIND_END_GROUP,
+				KIND_SUPERSCRIPT,
+				KIND_SUBSCRIPT,
+				// Argument of \hbox or \text, without the braces
+				KIND_BOX,
+				NKIND
+			};
+			enum {
+				CONTROL_SEQUENCE_UNKNOWN = 0,
+				CONTROL_SEQUENCE_NEGATIVE_THIN_SPACE,	// \!
+				CONTROL_SEQUENCE_THIN_SPACE,			// \,
+				CONTROL_SEQUENCE_MEDIUM_SPACE,			// \:
+				CONTROL_SEQUENCE_THICK_SPACE,			// \;
+				CONTROL_SEQUENCE_ATOP,
+				CONTROL_SEQUENCE_HBOX,
+				CONTROL_SEQUENCE_LEFT,
+				CONTROL_SEQUENCE_OF,
+				CONTROL_SEQUENCE_OVER,
+				CONTROL_SEQUENCE_QQUAD,
+				CONTROL_SEQUENCE_QUAD,
+				CONTROL_SEQUENCE_RIGHT,
+				CONTROL_SEQUENCE_ROOT,
+				CONTROL_SEQUENCE_SQRT,
+				CONTROL_SEQUENCE_TEXT,
+				NCONTROL_SEQUENCE
+			};
+			uint32_t _offset;
+			uint32_t _length;
+			uint16_t _kind;
+			// NULL unless a known control sequence
+			const control_sequence_t *_descriptor;
+			inline tex_token_t(const size_t offset,
+							   const size_t length,
+							   const unsigned int kind)
+				: _offset(offset), _length(length), _kind(kind),
+				  _descriptor(NULL)
+			{
+			}
+			inline unsigned int control_sequence(void) const
+			{
+				return _descriptor == NULL ?
+					(unsigned int)CONTROL_SEQUENCE_UNKNOWN :
+					_descriptor->_control_sequence;
+			}
+			/**
+			 * Returns the characters of the token, with the escape
+			 * character of a control sequence replaced by a
+			 * backslash
+			 *
+			 * @param[in] code source string the token refers to
+			 */
+			std::string string(const std::string &code) const;
+		};
+		typedef std::vector<tex_token_t>::const_iterator
+			tex_token_iterator_t;
 		class atom_t;
 		class item_t;
+		class field_pool_t;
 		/**
 		 * Math field
 		 *
@@ -206,19 +324,43 @@ namespace mathtext {
 		 */
 		class field_t {
 		private:
-			void transform_script(void);
+			void transform_script(field_pool_t &pool);
 			void append(const item_t &item);
-			void append(const field_t &field, const bool superscript,
-						const bool subscript);
-			void prepend(const unsigned int type,
+			void append(field_pool_t &pool, const field_t *field,
+						const bool superscript, const bool subscript);
+			void append(field_pool_t &pool, const field_t &field,
+						const bool superscript, const bool subscript);
+			void prepend(field_pool_t &pool, const unsigned int type,
 						 const math_symbol_t &math_symbol);
-			void append(const unsigned int type,
+			void append(field_pool_t &pool, const unsigned int type,
 						const math_symbol_t &math_symbol,
 						const bool superscript,
 						const bool subscript);
 			void parse_math_list(
-				const std::vector<std::string> &str_split,
+				field_pool_t &pool, const std::string &code,
+				const tex_token_iterator_t &token_begin,
+				const tex_token_iterator_t &token_end,
 				const unsigned int default_family);
+			/**
+			 * Allocates a math list from the pool and parses the
+			 * tokens into it in place
+			 */
+			static field_t *
+			new_math_list(field_pool_t &pool, const std::string &code,
+						  const tex_token_iterator_t &token_begin,
+						  const tex_token_iterator_t &token_end,
+						  const unsigned int default_family);
+			/**
+			 * Allocates a math list from the pool that is enclosed
+			 * by the boundary items of the given delimiters
+			 */
+			static field_t *
+			new_math_list(field_pool_t &pool, const std::string &code,
+						  const tex_token_t &token_delimiter_left,
+						  const tex_token_iterator_t &token_begin,
+						  const tex_token_iterator_t &token_end,
+						  const tex_token_t &token_delimiter_right,
+						  const unsigned int default_family);
 		public:
 			enum {
 				// The explicit TYPE_EMPTY in TeX is represented here
@@ -250,11 +392,9 @@ namespace mathtext {
 				: _type(TYPE_MATH_LIST), _math_list(math_list)
 			{
 			}
-			field_t(const std::vector<std::string> &str_split,
-					const unsigned int default_family);
-			field_t(const std::string &str_delimiter_left,
-					const std::vector<std::string> &str_split,
-					const std::string &str_delimiter_right,
+			field_t(field_pool_t &pool, const std::string &code,
+					const tex_token_iterator_t &token_begin,
+					const tex_token_iterator_t &token_end,
 					const unsigned int default_family);
 			inline bool empty(void) const
 			{
@@ -298,37 +438,36 @@ namespace mathtext {
 				NLIMITS
 			};
 			unsigned int _type;
-			// Fields
-			field_t _nucleus;
-			field_t _superscript;
-			field_t _subscript;
+			// Fields, allocated from the field pool of the formula,
+			// or empty_field()
+			const field_t *_nucleus;
+			const field_t *_superscript;
+			const field_t *_subscript;
 			unsigned int _limits;
 			// Index the root with the radicand _nucleus, if _type ==
 			// TYPE_RAD (while TeX uses absolute positioning for the
 			// index, it is not possible to represent it in an font
 			// independent way).
-			field_t _index;
+			const field_t *_index;
 			inline atom_t(const unsigned int type,
-						  const field_t &nucleus)
-				: _type(type), _nucleus(nucleus)
+						  const field_t *nucleus)
+				: _type(type), _nucleus(nucleus),
+				  _superscript(empty_field()),
+				  _subscript(empty_field()), _index(empty_field())
 			{
 			}
 			inline atom_t(const unsigned int type,
-						  const field_t &nucleus,
+						  const field_t *nucleus,
 						  const unsigned int limits)
-				: _type(type), _nucleus(nucleus), _limits(limits)
+				: _type(type), _nucleus(nucleus),
+				  _superscript(empty_field()),
+				  _subscript(empty_field()), _limits(limits),
+				  _index(empty_field())
 			{
 			}
-			inline atom_t(const field_t &nucleus)
-				: _nucleus(nucleus)
-			{
-				classify();
-			}
-			inline atom_t(const field_t &nucleus,
-						  const field_t &superscript,
-						  const field_t &subscript)
-				: _nucleus(nucleus), _superscript(superscript),
-				  _subscript(subscript)
+			inline atom_t(const field_t *nucleus)
+				: _nucleus(nucleus), _superscript(empty_field()),
+				  _subscript(empty_field()), _index(empty_field())
 			{
 				classify();
 			}
@@ -416,7 +555,7 @@ namespace mathtext {
 			unsigned int _boundary;
 			inline item_t(const unsigned int type,
 						  const float length = 0)
-				: _type(type), _atom(field_t()), _length(length)
+				: _type(type), _atom(empty_field()), _length(length)
 			{
 			}
 			inline item_t(const atom_t &atom)
@@ -430,9 +569,72 @@ namespace mathtext {
 			}
 			bool operator==(const item_t &item) const;
 		};
+		/**
+		 * Pool of math fields
+		 *
+		 * Atoms refer to their fields by pointer into the pool of
+		 * the formula they belong to, so that building the math list
+		 * never copies subtrees, and fields are allocated in blocks
+		 * rather than individually. The pool is shared by copies of
+		 * a math_text_t and released with the last of them. The
+		 * reference count is changed atomically, so that copies may
+		 * be made and destroyed on different threads, e.g. by
+		 * concurrent layouts.
+		 */
+		class field_pool_t {
+		private:
+			static const size_t nfield_per_block = 64;
+			std::vector<std::vector<field_t> *> _block;
+			unsigned long _reference_count;
+			// Not copyable
+			field_pool_t(const field_pool_t &);
+			field_pool_t &operator=(const field_pool_t &);
+		public:
+			inline field_pool_t(void)
+				: _reference_count(1)
+			{
+			}
+			~field_pool_t(void);
+			/**
+			 * Returns a copy of the field that remains valid for
+			 * the lifetime of the pool
+			 */
+			field_t *allocate(const field_t &field);
+			inline size_t size(void) const
+			{
+				return _block.empty() ? 0 :
+					(_block.size() - 1) * nfield_per_block +
+					_block.back()->size();
+			}
+			inline void reference(void)
+			{
+#ifdef __GNUC__
+				__sync_fetch_and_add(&_reference_count, 1UL);
+#else // __GNUC__
+				_reference_count++;
+#endif // __GNUC__
+			}
+			inline bool release(void)
+			{
+#ifdef __GNUC__
+				return __sync_sub_and_fetch(&_reference_count,
+											1UL) == 0;
+#else // __GNUC__
+				return --_reference_count == 0;
+#endif // __GNUC__
+			}
+		};
 		std::wstring _code;
 		field_t _math_list;
+		field_pool_t *_field_pool;
 		bool _render_structure;
+#ifdef MATHTEXT_STATISTICS
+		double _parse_time;
+#endif // MATHTEXT_STATISTICS
+		/**
+		 * Returns the shared empty field, the implicit TYPE_EMPTY
+		 */
+		static const field_t *empty_field(void);
 		/////////////////////////////////////////////////////////////
 		void tree_view_prefix(const std::vector<bool> &branch,
 							  const bool final) const;
@@ -446,35 +648,83 @@ namespace mathtext {
 		static std::wstring bad_cast(const std::string string);
 		static std::wstring utf8_cast(const std::string string);
 		/////////////////////////////////////////////////////////////
-		static std::vector<std::string>
-		tex_split(const std::string &raw_code,
+		/**
+		 * Returns the descriptor of a control sequence, or NULL if
+		 * it is unknown
+		 *
+		 * @param[in] name name of the control sequence, without the
+		 * escape character and not necessarily NUL-terminated
+		 * @param[in] length length of the name
+		 */
+		static const control_sequence_t *
+		find_control_sequence(const char *name, const size_t length);
+		static std::vector<tex_token_t>
+		tex_split(const std::string &code,
 				  const char escape_character = '\\');
 		static std::vector<std::string>
 		tex_replace(const std::vector<std::string> &code);
-		field_t build_math_list(const std::vector<std::string> &
+		field_t build_math_list(const std::string &code,
+								const std::vector<tex_token_t> &
 								code_split) const
 		{
-			return field_t(code_split,
+			return field_t(*_field_pool, code, code_split.begin(),
+						   code_split.end(),
 						   math_symbol_t::FAMILY_MATH_ITALIC);
 		}
 	public:
 		math_text_t(void)
-			: _code(), _math_list(), _render_structure(false)
+			: _code(), _math_list(), _field_pool(NULL),
+			  _render_structure(false)
 		{
+#ifdef MATHTEXT_STATISTICS
+			_parse_time = 0;
+#endif // MATHTEXT_STATISTICS
 		}
 		math_text_t(const std::string &code_string)
-			: _code(bad_cast(code_string)), _render_structure(false)
+			: _code(bad_cast(code_string)),
+			  _field_pool(new field_pool_t()),
+			  _render_structure(false)
 		{
-			std::cerr << __FILE__ << ':' << __LINE__ << ": " << std::endl;
-			std::vector<std::string> code_split = tex_split(code_string);
-			_math_list = build_math_list(code_split);
+#ifdef MATHTEXT_STATISTICS
+			_parse_time = 0;
+
+			statistics_t::scoped_timer_t timer(_parse_time);
+#endif // MATHTEXT_STATISTICS
+
+			_math_list = build_math_list(code_string,
+										 tex_split(code_string));
 		}
 		math_text_t(const char code_string[])
-			: _code(bad_cast(code_string)), _render_structure(false)
+			: _code(bad_cast(code_string)),
+			  _field_pool(new field_pool_t()),
+			  _render_structure(false)
+		{
+#ifdef MATHTEXT_STATISTICS
+			_parse_time = 0;
+
+			statistics_t::scoped_timer_t timer(_parse_time);
+#endif // MATHTEXT_STATISTICS
+			const std::string code(code_string);
+
+			_math_list = build_math_list(code, tex_split(code));
+		}
+		inline math_text_t(const math_text_t &math_text)
+			: _code(math_text._code), _math_list(math_text._math_list),
+			  _field_pool(math_text._field_pool),
+			  _render_structure(math_text._render_structure)
 		{
-			std::vector<std::string> code_split = tex_split(code_string);
-			_math_list = build_math_list(code_split);
+			if (_field_pool != NULL)
+				_field_pool->reference();
+#ifdef MATHTEXT_STATISTICS
+			_parse_time = math_text._parse_time;
+#endif // MATHTEXT_STATISTICS
 		}
+		inline ~math_text_t(void)
+		{
+			if (_field_pool != NULL && _field_pool->release())
+				delete _field_pool;
+		}
+		math_text_t &operator=(const math_text_t &math_text);
 		inline std::wstring code(void) const
 		{
 			return _code;
@@ -488,6 +738,24 @@ namespace mathtext {
 			return _render_structure;
 		}
 		bool well_formed(void) const;
+		/**
+		 * Splits a TeX source string into lexical tokens and returns
+		 * their number, i.e. runs only the lexer that precedes the
+		 * parsing of the math list, e.g. to time it separately
+		 *
+		 * @param[in] code TeX source string
+		 * @return number of lexical tokens
+		 */
+		static size_t tex_token_count(const std::string &code);
+#ifdef MATHTEXT_STATISTICS
+		/**
+		 * Returns the time taken to parse the formula, in seconds
+		 */
+		inline double parse_time(void) const
+		{
+			return _parse_time;
+		}
+#endif // MATHTEXT_STATISTICS
 		inline bool empty(void) const
 		{
 			return _math_list.empty();
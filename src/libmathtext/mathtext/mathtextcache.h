@@ -0,0 +1,200 @@
+// -*- mode: c++; -*-
+
+// mathtext - A TeX/LaTeX compatible rendering library. Copyright (C)
+// 2008-2012 Yue Shi Lai <ylai@users.sourceforge.net>
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2.1 of
+// the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// 02110-1301 USA
+
+#ifndef MATHTEXTCACHE_H_
+#define MATHTEXTCACHE_H_
+
+#include <string>
+#include <vector>
+#include <list>
+#include <map>
+#include <mathtext/mathrender.h>
+#include <mathtext/mutex.h>
+
+namespace mathtext {
+
+	/**
+	 * Bounded cache of parsed formulae and their layouts
+	 *
+	 * The class math_text_cache_t maps TeX source strings to parsed
+	 * math_text_t trees, evicting the least recently used formula
+	 * once the capacity is exceeded. For each formula, the layouts
+	 * are kept per font set (math_text_renderer_t::font_identity()),
+	 * font size and display style, so that repeated labels are
+	 * neither parsed nor laid out again, also by different surfaces
+	 * with the same fonts.
+	 *
+	 * All member functions may be called concurrently. Formulae and
+	 * layouts are returned as copies, and laid out without holding
+	 * the lock of the cache.
+	 */
+	class math_text_cache_t {
+	private:
+		typedef math_text_renderer_t::math_layout_t math_layout_t;
+		class layout_entry_t {
+		public:
+			std::string _font_identity;
+			float _size;
+			bool _display_style;
+			math_layout_t _layout;
+		};
+		class entry_t {
+		public:
+			std::wstring _code;
+			math_text_t _math_text;
+			std::vector<layout_entry_t> _layout;
+		};
+		typedef std::list<entry_t> entry_list_t;
+		// Most recently used first
+		entry_list_t _entry;
+		std::map<std::wstring, entry_list_t::iterator> _index;
+		size_t _capacity;
+		unsigned long _hit;
+		unsigned long _miss;
+		unsigned long _eviction;
+		unsigned long _layout_hit;
+		unsigned long _layout_miss;
+		mutable mutex_t _mutex;
+		static const size_t nlayout_per_entry = 4;
+		// The lock has to be held by the callers of the following
+		entry_t *find(const std::wstring &code);
+		entry_t &insert(const std::wstring &code,
+						const math_text_t &math_text);
+		static const layout_entry_t *
+		find_layout(const entry_t &entry,
+					const std::string &font_identity,
+					const float size, const bool display_style);
+		void evict(void);
+		// Lays out a formula that missed the cache and stores the
+		// layout, with the lock not held by the caller
+		math_layout_t insert_layout(const math_text_renderer_t &renderer,
+									const std::wstring &code,
+									const math_text_t &math_text,
+									const std::string &font_identity,
+									const float size,
+									const bool display_style);
+		// Not copyable
+		math_text_cache_t(const math_text_cache_t &);
+		math_text_cache_t &operator=(const math_text_cache_t &);
+	public:
+		/**
+		 * Constructs a cache
+		 *
+		 * @param[in] capacity maximum number of formulae kept, where
+		 * 0 disables caching
+		 */
+		math_text_cache_t(const size_t capacity = 1024);
+		/**
+		 * Returns the parsed formula of a TeX source string
+		 *
+		 * @param[in] code TeX source string
+		 * @return parsed formula
+		 */
+		math_text_t math_text(const std::string &code);
+		/**
+		 * Returns the layout of a TeX source string
+		 *
+		 * @param[in] renderer renderer the formula is laid out for
+		 * @param[in] code TeX source string
+		 * @param[in] display_style true for display style, false for
+		 * text style
+		 * @return layout that can be drawn with
+		 * math_text_renderer_t::text()
+		 */
+		math_layout_t layout(const math_text_renderer_t &renderer,
+							 const std::string &code,
+							 const bool display_style = false);
+		inline math_layout_t layout(const math_text_renderer_t &renderer,
+									const char code[],
+									const bool display_style = false)
+		{
+			return layout(renderer, std::string(code), display_style);
+		}
+		/**
+		 * Returns the layout of a parsed formula, which is cached
+		 * under its source string
+		 *
+		 * Formulae with render_structure() set are laid out, but
+		 * not cached.
+		 *
+		 * @param[in] renderer renderer the formula is laid out for
+		 * @param[in] math_text formula
+		 * @param[in] display_style true for display style, false for
+		 * text style
+		 * @return layout that can be drawn with
+		 * math_text_renderer_t::text()
+		 */
+		math_layout_t layout(const math_text_renderer_t &renderer,
+							 const math_text_t &math_text,
+							 const bool display_style = false);
+		void clear(void);
+		inline size_t size(void) const
+		{
+			lock_t lock(_mutex);
+
+			return _index.size();
+		}
+		inline size_t capacity(void) const
+		{
+			lock_t lock(_mutex);
+
+			return _capacity;
+		}
+		void set_capacity(const size_t capacity);
+		inline unsigned long hit(void) const
+		{
+			lock_t lock(_mutex);
+
+			return _hit;
+		}
+		inline unsigned long miss(void) const
+		{
+			lock_t lock(_mutex);
+
+			return _miss;
+		}
+		inline unsigned long eviction(void) const
+		{
+			lock_t lock(_mutex);
+
+			return _eviction;
+		}
+		inline unsigned long layout_hit(void) const
+		{
+			lock_t lock(_mutex);
+
+			return _layout_hit;
+		}
+		inline unsigned long layout_miss(void) const
+		{
+			lock_t lock(_mutex);
+
+			return _layout_miss;
+		}
+		/**
+		 * Returns the process-wide cache instance, which
+		 * surface_t::text() lays out formulae through
+		 */
+		static math_text_cache_t &global(void);
+	};
+
+}
+
+#endif // MATHTEXTCACHE_H_
@@ -0,0 +1,73 @@
+// -*- mode: c++; -*-
+
+// mathtext - A TeX/LaTeX compatible rendering library. Copyright (C)
+// 2008-2012 Yue Shi Lai <ylai@users.sourceforge.net>
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2.1 of
+// the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// 02110-1301 USA
+
+#ifndef MATHTEXT_MUTEX_H_
+#define MATHTEXT_MUTEX_H_
+
+namespace mathtext {
+
+	/**
+	 * Non-recursive mutual exclusion lock
+	 *
+	 * If the library is built without POSIX threads, locking does
+	 * nothing. The lock is allocated by the library, so that the
+	 * layout of the classes holding a mutex_t does not depend on
+	 * how their users are built. A copy is a new, unlocked mutex,
+	 * so that classes holding a mutex_t remain copyable.
+	 */
+	class mutex_t {
+	private:
+		// NULL without POSIX threads
+		void *_mutex;
+	public:
+		mutex_t(void);
+		mutex_t(const mutex_t &);
+		~mutex_t(void);
+		inline mutex_t &operator=(const mutex_t &)
+		{
+			return *this;
+		}
+		void lock(void);
+		void unlock(void);
+	};
+
+	/**
+	 * Holds a mutex_t locked for the lifetime of the object
+	 */
+	class lock_t {
+	private:
+		mutex_t &_mutex;
+		lock_t(const lock_t &);
+		lock_t &operator=(const lock_t &);
+	public:
+		inline lock_t(mutex_t &mutex)
+			: _mutex(mutex)
+		{
+			_mutex.lock();
+		}
+		inline ~lock_t(void)
+		{
+			_mutex.unlock();
+		}
+	};
+
+}
+
+#endif // MATHTEXT_MUTEX_H_
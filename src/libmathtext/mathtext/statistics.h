@@ -0,0 +1,122 @@
+// mathtext - A TeX/LaTeX compatible rendering library. Copyright (C)
+// 2008-2016 Yue Shi Lai <ylai@users.sourceforge.net>
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2.1 of
+// the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// 02110-1301 USA
+
+#ifndef MATHTEXT_STATISTICS_H_
+#define MATHTEXT_STATISTICS_H_
+
+#include <string>
+
+namespace mathtext {
+
+	/**
+	 * Counters and phase timers of parsing, laying out and drawing
+	 * formulae
+	 *
+	 * Statistics are only gathered if the library and its users are
+	 * built with MATHTEXT_STATISTICS defined, e.g. by statistics=1
+	 * on the SCons command line. Otherwise, nothing is counted or
+	 * timed, and the classes holding statistics do not have the
+	 * members or the functions that return them.
+	 *
+	 * @see math_text_renderer_t::statistics()
+	 * @see math_text_renderer_t::math_layout_t::statistics()
+	 */
+	class statistics_t {
+	public:
+		enum {
+			// Formulae laid out
+			COUNTER_FORMULA = 0,
+			// Glyphs and strings measured by the surface, i.e. glyph
+			// metrics cache misses and boxes
+			COUNTER_BOUNDING_BOX,
+			COUNTER_GLYPH_METRICS_HIT,
+			COUNTER_TEXT_RAW,
+			// Font size set to a different value before drawing
+			COUNTER_FONT_SIZE_CHANGE,
+			COUNTER_GLYPH,
+			COUNTER_GLYPH_RUN,
+			// Invocations of each math_layout() overload
+			COUNTER_LAYOUT_BOX,
+			COUNTER_LAYOUT_MATH_SYMBOL,
+			COUNTER_LAYOUT_EXTENSIBLE,
+			COUNTER_LAYOUT_MATH_LIST,
+			COUNTER_LAYOUT_FIELD,
+			COUNTER_LAYOUT_ATOM,
+			// Repeated pieces of extensible delimiters and radicals
+			COUNTER_EXTENSIBLE_REPEAT,
+			// Page description written by surfaces writing files
+			COUNTER_BYTE_WRITTEN,
+			NCOUNTER
+		};
+		enum {
+			TIMER_PARSE = 0,
+			TIMER_LAYOUT,
+			TIMER_EMIT,
+			NTIMER
+		};
+		/**
+		 * Adds the time from construction to destruction to a timer
+		 */
+		class scoped_timer_t {
+		private:
+			double &_time;
+			double _start;
+			scoped_timer_t(const scoped_timer_t &);
+			scoped_timer_t &operator=(const scoped_timer_t &);
+		public:
+			inline scoped_timer_t(double &time)
+				: _time(time), _start(now())
+			{
+			}
+			inline ~scoped_timer_t(void)
+			{
+				_time += now() - _start;
+			}
+		};
+		unsigned long _counter[NCOUNTER];
+		// In seconds
+		double _time[NTIMER];
+		inline statistics_t(void)
+		{
+			clear();
+		}
+		void clear(void);
+		inline void count(const unsigned int counter,
+						  const unsigned long n = 1)
+		{
+			_counter[counter] += n;
+		}
+		statistics_t &operator+=(const statistics_t &statistics);
+		statistics_t &operator-=(const statistics_t &statistics);
+		/**
+		 * Returns a monotonic time in seconds, for the timers
+		 */
+		static double now(void);
+		static const char *counter_name(const unsigned int counter);
+		static const char *timer_name(const unsigned int timer);
+		/**
+		 * Returns the statistics as a JSON object, with the counters
+		 * and the timers, in seconds, as members named by
+		 * counter_name() and timer_name()
+		 */
+		std::string json(void) const;
+	};
+
+}
+
+#endif // MATHTEXT_STATISTICS_H_
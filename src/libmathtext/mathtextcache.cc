@@ -0,0 +1,266 @@
+// mathtext - A TeX/LaTeX compatible rendering library. Copyright (C)
+// 2008-2012 Yue Shi Lai <ylai@users.sourceforge.net>
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2.1 of
+// the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// 02110-1301 USA
+
+#include <mathtext/mathtextcache.h>
+
+/////////////////////////////////////////////////////////////////////
+
+namespace mathtext {
+
+	namespace {
+
+		// Guards the construction of the global cache
+		mutex_t global_mutex;
+
+	}
+
+	math_text_cache_t::math_text_cache_t(const size_t capacity)
+		: _capacity(capacity), _hit(0), _miss(0), _eviction(0),
+		  _layout_hit(0), _layout_miss(0)
+	{
+	}
+
+	math_text_cache_t::entry_t *
+	math_text_cache_t::find(const std::wstring &code)
+	{
+		const std::map<std::wstring, entry_list_t::iterator>::
+			const_iterator index_iterator = _index.find(code);
+
+		if (index_iterator == _index.end())
+			return NULL;
+		// Move to the front, list iterators remain valid
+		_entry.splice(_entry.begin(), _entry, index_iterator->second);
+
+		return &_entry.front();
+	}
+
+	math_text_cache_t::entry_t &
+	math_text_cache_t::insert(const std::wstring &code,
+							  const math_text_t &math_text)
+	{
+		// Another thread may have inserted the formula meanwhile
+		entry_t *found = find(code);
+
+		if (found != NULL)
+			return *found;
+		_entry.push_front(entry_t());
+
+		entry_t &entry = _entry.front();
+
+		entry._code = code;
+		entry._math_text = math_text;
+		_index[code] = _entry.begin();
+		evict();
+
+		return entry;
+	}
+
+	const math_text_cache_t::layout_entry_t *
+	math_text_cache_t::find_layout(const entry_t &entry,
+								   const std::string &font_identity,
+								   const float size,
+								   const bool display_style)
+	{
+		for (std::vector<layout_entry_t>::const_iterator iterator =
+				entry._layout.begin();
+			iterator != entry._layout.end(); iterator++)
+			if (iterator->_size == size &&
+			   iterator->_display_style == display_style &&
+			   iterator->_font_identity == font_identity)
+				return &*iterator;
+
+		return NULL;
+	}
+
+	void math_text_cache_t::evict(void)
+	{
+		// Entries are only inserted with a nonzero capacity, so the
+		// front entry, which was just used, is never evicted
+		while (_index.size() > _capacity) {
+			_index.erase(_entry.back()._code);
+			_entry.pop_back();
+			_eviction++;
+		}
+	}
+
+	math_text_t math_text_cache_t::math_text(const std::string &code)
+	{
+		// As math_text_t::code() would convert it
+		const std::wstring wide_code(code.begin(), code.end());
+
+		{
+			lock_t lock(_mutex);
+			const entry_t *entry = find(wide_code);
+
+			if (entry != NULL) {
+				_hit++;
+				return entry->_math_text;
+			}
+			_miss++;
+		}
+
+		const math_text_t ret(code);
+		lock_t lock(_mutex);
+
+		if (_capacity > 0)
+			insert(wide_code, ret);
+
+		return ret;
+	}
+
+	math_text_cache_t::math_layout_t
+	math_text_cache_t::layout(const math_text_renderer_t &renderer,
+							  const std::string &code,
+							  const bool display_style)
+	{
+		const std::wstring wide_code(code.begin(), code.end());
+		const std::string font_identity = renderer.font_identity();
+		const float size = renderer.font_size();
+		math_text_t cached_math_text;
+		bool found = false;
+
+		{
+			lock_t lock(_mutex);
+			const entry_t *entry = find(wide_code);
+
+			if (entry != NULL) {
+				_hit++;
+
+				const layout_entry_t *layout_entry =
+					find_layout(*entry, font_identity, size,
+								display_style);
+
+				if (layout_entry != NULL) {
+					_layout_hit++;
+					return layout_entry->_layout;
+				}
+				cached_math_text = entry->_math_text;
+				found = true;
+			}
+			else
+				_miss++;
+			_layout_miss++;
+		}
+
+		// Parsed without holding the lock, as in math_text()
+		return insert_layout(renderer, wide_code,
+							 found ? cached_math_text :
+							 math_text_t(code),
+							 font_identity, size, display_style);
+	}
+
+	math_text_cache_t::math_layout_t
+	math_text_cache_t::layout(const math_text_renderer_t &renderer,
+							  const math_text_t &math_text,
+							  const bool display_style)
+	{
+		// The layout of a formula drawn with its structure differs
+		// from the cached one
+		if (math_text.render_structure())
+			return renderer.layout(math_text, display_style);
+
+		const std::wstring code = math_text.code();
+		const std::string font_identity = renderer.font_identity();
+		const float size = renderer.font_size();
+
+		{
+			lock_t lock(_mutex);
+			const entry_t *entry = find(code);
+
+			if (entry != NULL) {
+				_hit++;
+
+				const layout_entry_t *layout_entry =
+					find_layout(*entry, font_identity, size,
+								display_style);
+
+				if (layout_entry != NULL) {
+					_layout_hit++;
+					return layout_entry->_layout;
+				}
+			}
+			else
+				_miss++;
+			_layout_miss++;
+		}
+
+		return insert_layout(renderer, code, math_text, font_identity,
+							 size, display_style);
+	}
+
+	math_text_cache_t::math_layout_t
+	math_text_cache_t::insert_layout(const math_text_renderer_t &renderer,
+									 const std::wstring &code,
+									 const math_text_t &math_text,
+									 const std::string &font_identity,
+									 const float size,
+									 const bool display_style)
+	{
+		// Laid out without holding the lock, two threads missing the
+		// same layout both lay it out and store it once
+		const math_layout_t ret =
+			renderer.layout(math_text, display_style);
+		lock_t lock(_mutex);
+
+		if (_capacity == 0)
+			return ret;
+
+		entry_t &entry = insert(code, math_text);
+
+		if (find_layout(entry, font_identity, size,
+						display_style) == NULL) {
+			if (entry._layout.size() >= nlayout_per_entry)
+				entry._layout.erase(entry._layout.begin());
+
+			layout_entry_t layout_entry;
+
+			layout_entry._font_identity = font_identity;
+			layout_entry._size = size;
+			layout_entry._display_style = display_style;
+			entry._layout.push_back(layout_entry);
+			entry._layout.back()._layout = ret;
+		}
+
+		return ret;
+	}
+
+	void math_text_cache_t::clear(void)
+	{
+		lock_t lock(_mutex);
+
+		_entry.clear();
+		_index.clear();
+	}
+
+	void math_text_cache_t::set_capacity(const size_t capacity)
+	{
+		lock_t lock(_mutex);
+
+		_capacity = capacity;
+		evict();
+	}
+
+	math_text_cache_t &math_text_cache_t::global(void)
+	{
+		lock_t lock(global_mutex);
+		static math_text_cache_t cache;
+
+		return cache;
+	}
+
+}
@@ -17,6 +17,7 @@
 // 02110-1301 USA
 
 #include <cmath>
+#include <cstring>
 #include <iostream>
 #include <algorithm>
 #include <mathtext/mathtext.h>
@@ -122,24 +123,52 @@ namespace mathtext {
 		}
 	}
 
-	void math_text_t::math_symbol_t::encode_control_sequence(void)
+	// Must agree with hash_control_sequence() in script/gentable.py
+	static inline uint32_t
+	control_sequence_hash(const uint32_t seed, const char *name,
+						  const size_t length)
+	{
+		uint32_t hash = seed == 0 ? 0x01000193U : seed;
+
+		for (size_t i = 0; i < length; i++)
+			hash = (hash * 0x01000193U) ^
+				static_cast<unsigned char>(name[i]);
+
+		return hash;
+	}
+
+	const math_text_t::control_sequence_t *math_text_t::
+	find_control_sequence(const char *name, const size_t length)
+	{
+#include "table/mathcs.h"
+		// Minimal perfect hash, a negative displacement directly
+		// encodes the slot of a key not sharing the first level hash
+		const int displacement = control_sequence_displacement[
+			control_sequence_hash(0, name, length) % ncontrol_sequence];
+		const unsigned long index = displacement < 0 ?
+			-displacement - 1 :
+			control_sequence_hash(displacement, name, length) %
+			ncontrol_sequence;
+		// Skip the escape character
+		const char *entry = control_sequence[index]._name + 1;
+
+		if (strncmp(entry, name, length) == 0 &&
+		   entry[length] == '\0')
+			return control_sequence + index;
+
+		return NULL;
+	}
+
+	void math_text_t::math_symbol_t::
+	encode_control_sequence(const control_sequence_t *control_sequence)
 	{
 		// Character encoding for TeX control sequences
-#include "table/mathglyphstd.h"
-		const char **lower =
-			std::lower_bound(glyph_control_sequence,
-							 glyph_control_sequence + nglyph,
-							 _code);
-
-		if (lower < glyph_control_sequence + nglyph &&
-		   *lower == _code) {
-			const unsigned long index =
-				lower - glyph_control_sequence;
-
-			if (glyph_upright[index])
+		if (control_sequence != NULL &&
+		   control_sequence->_glyph != L'\0') {
+			if (control_sequence->_upright)
 				math_italic_is_upright();
-			_glyph = glyph_code_point[index];
-			_type = glyph_type[index];
+			_glyph = control_sequence->_glyph;
+			_type = control_sequence->_type;
 		}
 	}
 
@@ -383,10 +412,11 @@ namespace mathtext {
 		}
 	}
 
-	void math_text_t::math_symbol_t::encode(void)
+	void math_text_t::math_symbol_t::
+	encode(const control_sequence_t *control_sequence)
 	{
 		encode_character();
-		encode_control_sequence();
+		encode_control_sequence(control_sequence);
 		encode_math_alpha();
 		math_italic_is_italic();
 		if (_family > FAMILY_STIX_SIZE_5_REGULAR) {
@@ -17,6 +17,7 @@
 // 02110-1301 USA
 
 #include <cmath>
+#include <cctype>
 #include <iostream>
 #include <algorithm>
 #include <mathtext/mathtext.h>
@@ -27,19 +28,21 @@ namespace mathtext {
 
 	/////////////////////////////////////////////////////////////////
 
+	std::string math_text_t::tex_token_t::
+	string(const std::string &code) const
+	{
+		if (_kind == KIND_CONTROL_SEQUENCE)
+			return '\\' + code.substr(_offset + 1, _length - 1);
+
+		return code.substr(_offset, _length);
+	}
+
 	void math_text_t::field_t::
-	parse_math_list(const std::vector<std::string> &str_split,
+	parse_math_list(field_pool_t &pool, const std::string &code,
+					const tex_token_iterator_t &token_begin,
+					const tex_token_iterator_t &token_end,
 					const unsigned int default_family)
 	{
-#if 0
-		std::cerr << "parsing [";
-		for (std::vector<std::string>::const_iterator iterator =
-				str_split.begin();
-			iterator != str_split.end(); iterator++)
-			std::cerr << '"' << *iterator << "\", ";
-		std::cerr << ']' << std::endl;
-#endif
-
 		// State of radical parsing
 		enum {
 			RADICAL_STATE_NONE = 0,
@@ -51,86 +54,86 @@ namespace mathtext {
 		unsigned int family = default_family;
 		int level = 0;
 		int delimiter_level = 0;
-		std::vector<std::string> buffer;
-#if 1
+		// The buffer is the range of tokens of the current group
+		tex_token_iterator_t buffer_begin = token_begin;
+		tex_token_iterator_t buffer_end = token_begin;
 		bool superscript = false;
 		bool subscript = false;
 		bool delimiter_right = false;
 		unsigned int radical_state = RADICAL_STATE_NONE;
-		std::vector<std::string> radical_index;
+		tex_token_iterator_t radical_index_begin = token_begin;
+		tex_token_iterator_t radical_index_end = token_begin;
 		bool horizontal_box = false;
 
-		for (std::vector<std::string>::const_iterator iterator =
-				str_split.begin();
-			iterator != str_split.end(); iterator++) {
+		for (tex_token_iterator_t iterator = token_begin;
+			iterator != token_end; iterator++) {
+			const control_sequence_t *descriptor =
+				iterator->_descriptor;
+			const unsigned int control_sequence =
+				iterator->control_sequence();
+
 			// ONLY LEVEL 0 superscript and subscript are interpreted,
 			// and they are ignored afterwards.
 			if (level == 0 && delimiter_level == 0) {
-				if ((*iterator)[0] == '^') {
+				if (iterator->_kind == tex_token_t::KIND_SUPERSCRIPT) {
 					superscript = true;
 					continue;
 				}
-				else if ((*iterator)[0] == '_') {
+				else if (iterator->_kind ==
+						tex_token_t::KIND_SUBSCRIPT) {
 					subscript = true;
 					continue;
 				}
-				else if (*iterator == "\\sqrt") {
+				else if (control_sequence ==
+						tex_token_t::CONTROL_SEQUENCE_SQRT) {
 					radical_state = RADICAL_STATE_RADICAND;
-					radical_index = std::vector<std::string>();
+					radical_index_begin = radical_index_end =
+						token_begin;
 					continue;
 				}
-				else if (iterator->substr(0, 5) == "\\root") {
+				else if (control_sequence ==
+						tex_token_t::CONTROL_SEQUENCE_ROOT) {
 					radical_state = RADICAL_STATE_INDEX;
 					continue;
 				}
 				else if (radical_state == RADICAL_STATE_INDEX &&
-						*iterator == "\\of") {
-					radical_index = buffer;
-					buffer.clear();
+						control_sequence ==
+						tex_token_t::CONTROL_SEQUENCE_OF) {
+					radical_index_begin = buffer_begin;
+					radical_index_end = buffer_end;
+					buffer_begin = buffer_end = iterator + 1;
 					radical_state = RADICAL_STATE_RADICAND;
 					continue;
 				}
-				else if (iterator->substr(0, 5) == "\\hbox" ||
-						iterator->substr(0, 5) == "\\text") {
+				else if (control_sequence ==
+						tex_token_t::CONTROL_SEQUENCE_HBOX ||
+						control_sequence ==
+						tex_token_t::CONTROL_SEQUENCE_TEXT) {
 					horizontal_box = true;
 					continue;
 				}
 
-				const char **lower;
-
-#include "table/mathfontch.h"
-				lower = std::lower_bound(
-					font_change_control_sequence,
-					font_change_control_sequence + nfont_change,
-					*iterator);
-
-				if (lower <
-				   font_change_control_sequence + nfont_change &&
-				   *lower == *iterator) {
-					const unsigned long index =
-						lower - font_change_control_sequence;
-
-					family = font_change_family[index];
+				if (descriptor != NULL && descriptor->_family != -1) {
+					family = descriptor->_family;
 					continue;
 				}
+				if (descriptor != NULL && descriptor->_operator != -1) {
 #include "table/mathopstd.h"
-				lower = std::lower_bound(
-					operator_control_sequence,
-					operator_control_sequence + noperator,
-					*iterator);
-				if (lower <
-				   operator_control_sequence + noperator &&
-				   *lower == *iterator) {
-					const unsigned long index =
-						lower - operator_control_sequence;
+					// The names are only read by script/gentable.py
+					static_cast<void>(operator_control_sequence);
+
+					const unsigned long index = descriptor->_operator;
 
 					if (operator_code_point[index] == L'\0') {
 						// Operator defined with \mathop
-						const field_t operator_math_list(field_t(
-							tex_split(operator_content[index]),
+						const std::string
+							content(operator_content[index]);
+						const std::vector<tex_token_t>
+							content_split = tex_split(content);
+						atom_t atom(atom_t::TYPE_OP, new_math_list(
+							pool, content, content_split.begin(),
+							content_split.end(),
 							math_symbol_t::FAMILY_REGULAR));
-						atom_t atom(atom_t::TYPE_OP, field_t(
-							operator_math_list));
 
 						atom._limits = operator_nolimits[index] ?
 							atom_t::LIMITS_NOLIMITS :
@@ -141,10 +144,10 @@ namespace mathtext {
 						// Operator defined with \mathchardef
 						const field_t operator_math_symbol(
 							math_symbol_t(
-								*iterator,
+								iterator->string(code),
 								operator_code_point[index],
 								math_symbol_t::FAMILY_REGULAR));
-						atom_t atom(atom_t::TYPE_OP, field_t(
+						atom_t atom(atom_t::TYPE_OP, pool.allocate(
 							operator_math_symbol));
 
 						atom._limits = operator_nolimits[index] ?
@@ -156,28 +159,33 @@ namespace mathtext {
 				}
 			}
 
-			if ((*iterator)[0] == '}') {
+			if (iterator->_kind == tex_token_t::KIND_END_GROUP) {
 				level--;
 				// When the level decreases to 0 here, the compound
 				// expression is complete, create a subfield and
 				// append it to the math list.
 				if (level == 0 && delimiter_level == 0) {
 					// Create subfields recursively
-					const field_t subfield(buffer, family);
+					const field_t *subfield = new_math_list(
+						pool, code, buffer_begin, buffer_end, family);
 
 					if (radical_state == RADICAL_STATE_RADICAND) {
 						atom_t atom(atom_t::TYPE_RAD, subfield);
 
-						atom._index = field_t(radical_index, family);
+						atom._index = new_math_list(
+							pool, code, radical_index_begin,
+							radical_index_end, family);
 						append(item_t(atom));
 						radical_state = RADICAL_STATE_NONE;
 					}
 					else
-						append(subfield, superscript, subscript);
-					buffer.clear();
+						append(pool, subfield, superscript,
+							   subscript);
+					buffer_begin = buffer_end = iterator + 1;
 				}
 			}
-			else if (*iterator == "\\right") {
+			else if (control_sequence ==
+					tex_token_t::CONTROL_SEQUENCE_RIGHT) {
 				delimiter_level--;
 				// When the delimtier level decreases to 0 here, the
 				// compound expression is complete, create a subfield
@@ -191,98 +199,113 @@ namespace mathtext {
 
 			/////////////////////////////////////////////////////////
 
-#if 0
-			std::cerr << __FILE__ << ':' << __LINE__
-					  << ": L" << level << ", DL"
-					  << delimiter_level << ", hbox = "
-					  << horizontal_box << ", *iterator = "
-					  << *iterator << std::endl;
-#endif
-
 			if (level > 0 || delimiter_level > 0 ||
 			   radical_state == RADICAL_STATE_INDEX) {
-				buffer.push_back(*iterator);
+				if (buffer_begin == buffer_end)
+					buffer_begin = iterator;
+				buffer_end = iterator + 1;
 			}
 			else if (delimiter_right) {
-				const std::string left = buffer.front();
-
-				buffer.erase(buffer.begin());
+				if (buffer_begin != buffer_end) {
+					const field_t *subfield = new_math_list(
+						pool, code, *buffer_begin, buffer_begin + 1,
+						buffer_end, *iterator, family);
 
-				const field_t subfield(left, buffer, *iterator,
-									   family);
-
-				if (radical_state == RADICAL_STATE_RADICAND) {
-					atom_t atom(atom_t::TYPE_RAD, subfield);
+					if (radical_state == RADICAL_STATE_RADICAND) {
+						atom_t atom(atom_t::TYPE_RAD, subfield);
 
-					atom._index = field_t(radical_index, family);
-					append(item_t(atom));
-					radical_state = RADICAL_STATE_NONE;
+						atom._index = new_math_list(
+							pool, code, radical_index_begin,
+							radical_index_end, family);
+						append(item_t(atom));
+						radical_state = RADICAL_STATE_NONE;
+					}
+					else
+						append(pool, subfield, superscript,
+							   subscript);
 				}
-				else
-					append(subfield, superscript, subscript);
-				buffer.clear();
+				buffer_begin = buffer_end = iterator + 1;
 			}
 			else if (horizontal_box) {
-				box_t box(math_text_t::utf8_cast(*iterator));
+				box_t box(math_text_t::utf8_cast(
+					iterator->string(code)));
 
-				append(field_t(box), superscript, subscript);
+				append(pool, field_t(box), superscript, subscript);
 			}
-			else if ((*iterator)[0] != '{' &&
-					(*iterator)[0] != '}' &&
-					*iterator != "\\left" &&
-					*iterator != "\\right") {
+			else if (iterator->_kind !=
+					tex_token_t::KIND_BEGIN_GROUP &&
+					iterator->_kind != tex_token_t::KIND_END_GROUP &&
+					control_sequence !=
+					tex_token_t::CONTROL_SEQUENCE_LEFT &&
+					control_sequence !=
+					tex_token_t::CONTROL_SEQUENCE_RIGHT) {
 				if (radical_state == RADICAL_STATE_RADICAND) {
-					const field_t subfield(
-						std::vector<std::string>(1, *iterator),
-						family);
-					atom_t atom(atom_t::TYPE_RAD, subfield);
+					atom_t atom(atom_t::TYPE_RAD, new_math_list(
+						pool, code, iterator, iterator + 1, family));
 
-					atom._index = field_t(radical_index, family);
+					atom._index = new_math_list(
+						pool, code, radical_index_begin,
+						radical_index_end, family);
 					append(item_t(atom));
 				}
-				// FIXME: This should be a true table
-				else if (*iterator == "\\over") {
-					append(item_t(item_t::TYPE_GENERALIZED_FRACTION,
-								  1.0F));
-				}
-				else if (*iterator == "\\atop") {
-					append(item_t(item_t::TYPE_GENERALIZED_FRACTION,
-								  0.0F));
-				}
-				// FIXME: This should be a true table
-				else if (*iterator == "\\!") {
-					append(item_t(item_t::TYPE_KERN, -3.0F));
-				}
-				else if (*iterator == "\\,") {
-					append(item_t(item_t::TYPE_KERN, 3.0F));
-				}
-				else if (*iterator == "\\:") {
-					append(item_t(item_t::TYPE_KERN, 4.0F));
-				}
-				else if (*iterator == "\\;") {
-					append(item_t(item_t::TYPE_KERN, 5.0F));
-				}
-				else if (*iterator == "\\quad") {
-					append(item_t(item_t::TYPE_KERN, 18.0F));
-				}
-				else if (*iterator == "\\qquad") {
-					append(item_t(item_t::TYPE_KERN, 36.0F));
-				}
 				else {
-					const math_symbol_t
-						math_symbol(*iterator, family);
-
-					append(item_t::TYPE_ATOM, math_symbol,
-						   superscript, subscript);
+					switch (control_sequence) {
+					// FIXME: This should be a true table
+					case tex_token_t::CONTROL_SEQUENCE_OVER:
+						append(item_t(
+							item_t::TYPE_GENERALIZED_FRACTION, 1.0F));
+						break;
+					case tex_token_t::CONTROL_SEQUENCE_ATOP:
+						append(item_t(
+							item_t::TYPE_GENERALIZED_FRACTION, 0.0F));
+						break;
+					// FIXME: This should be a true table
+					case tex_token_t::
+						CONTROL_SEQUENCE_NEGATIVE_THIN_SPACE:
+						append(item_t(item_t::TYPE_KERN, -3.0F));
+						break;
+					case tex_token_t::CONTROL_SEQUENCE_THIN_SPACE:
+						append(item_t(item_t::TYPE_KERN, 3.0F));
+						break;
+					case tex_token_t::CONTROL_SEQUENCE_MEDIUM_SPACE:
+						append(item_t(item_t::TYPE_KERN, 4.0F));
+						break;
+					case tex_token_t::CONTROL_SEQUENCE_THICK_SPACE:
+						append(item_t(item_t::TYPE_KERN, 5.0F));
+						break;
+					case tex_token_t::CONTROL_SEQUENCE_QUAD:
+						append(item_t(item_t::TYPE_KERN, 18.0F));
+						break;
+					case tex_token_t::CONTROL_SEQUENCE_QQUAD:
+						append(item_t(item_t::TYPE_KERN, 36.0F));
+						break;
+					default:
+						{
+							const math_symbol_t math_symbol(
+								iterator->string(code), descriptor,
+								family);
+
+							append(pool, item_t::TYPE_ATOM,
+								   math_symbol, superscript,
+								   subscript);
+						}
+					}
 				}
 			}
 
-			if ((*iterator)[0] == '{') {
+			if (iterator->_kind == tex_token_t::KIND_BEGIN_GROUP) {
+				if (level == 0 && delimiter_level == 0 &&
+				   radical_state != RADICAL_STATE_INDEX)
+					buffer_begin = buffer_end = iterator + 1;
 				level++;
 			}
-			else if (*iterator == "\\left") {
+			else if (control_sequence ==
+					tex_token_t::CONTROL_SEQUENCE_LEFT) {
 				// Since the actual delimiter follows, it is going to
 				// be appended to the buffer "automatically".
+				if (level == 0 && delimiter_level == 0 &&
+				   radical_state != RADICAL_STATE_INDEX)
+					buffer_begin = buffer_end = iterator + 1;
 				delimiter_level++;
 			}
 			// Reset superscript and subscript flags only for level 0
@@ -297,141 +320,106 @@ namespace mathtext {
 				horizontal_box = false;
 			}
 		}
-#else
-		for (std::vector<std::string>::const_iterator iterator =
-				str_split.begin();
-			iterator != str_split.end(); iterator++) {
-			if ((*iterator)[0] == '}') {
-				level--;
-				
-			}
-			else if (*iterator == "\\right") {
-				delimiter_level--;
-			}
-			if ((*iterator)[0] == '{') {
-				level++;
-			}
-			else if (*iterator == "\\left") {
-				// Since the actual delimiter follows, it is going to
-				// be appended to the buffer "automatically".
-				delimiter_level++;
-			}
-			else if (level == 0 && delimiter_level == 0) {
-#if 1
-				std::cerr << __FILE__ << ':' << __LINE__
-						  << ": L" << level << ", DL"
-						  << delimiter_level << ", *iterator = "
-						  << *iterator << ", buffer = { ";
-				for (std::vector<std::string>::const_iterator
-						buffer_iterator = buffer.begin();
-					buffer_iterator != buffer.end(); buffer_iterator++) {
-					std::cerr << '"' << *buffer_iterator << "\" ";
-				}
-				std::cerr << '}' << std::endl;
-#endif
-				buffer.clear();
-			}
-			else {
-				buffer.push_back(*iterator);
-			}
-		}
-#endif
 	}
 
-	std::vector<std::string> math_text_t::
-	tex_split(const std::string &raw_code, const char escape_character)
+	std::vector<math_text_t::tex_token_t> math_text_t::
+	tex_split(const std::string &code, const char escape_character)
 	{
-		std::string code = raw_code;
-
-		for (std::string::iterator iterator = code.begin();
-			iterator != code.end(); iterator++) {
-			if (*iterator == escape_character) {
-				*iterator = '\\';
-			}
-		}
-
-		std::vector<std::string> ret;
-
-		if (code.size() <= 0) {
-			return ret;
-		}
-
+		std::vector<tex_token_t> ret;
+		const size_t size = code.size();
 		size_t begin = 0;
-		size_t end = 1;
 		bool box = false;
 
-		while (code[begin] == ' ') {
+		while (begin < size && code[begin] == ' ') {
 			begin++;
 		}
-		while (begin < code.size()) {
-			end = begin + 1;
-			if (code[begin] == '\\') {
-				if (isalpha(code[end])) {
-					while (end < code.size() && isalpha(code[end])) {
+		while (begin < size) {
+			size_t end = begin + 1;
+			tex_token_t token(begin, 1, tex_token_t::KIND_CHARACTER);
+
+			if (code[begin] == escape_character) {
+				if (end < size && isalpha(code[end])) {
+					while (end < size && isalpha(code[end])) {
 						end++;
 					}
 				}
-				else if (end < code.size()) {
+				else if (end < size) {
 					end++;
 				}
-
-#include "table/mathbracketcs.h"
-				const char **lower =
-					std::lower_bound(bracket_control_sequence,
-									 bracket_control_sequence +
-									 nbracket_control_sequence,
-									 code.substr(begin,
-												 end - begin));
-
-				if (lower < bracket_control_sequence +
-				   nbracket_control_sequence &&
-				   *lower == code.substr(begin, end - begin) &&
-				   end + 1 < code.size() && code[end] == '[') {
-					while (end < code.size() && code[end] != ']') {
+				token._kind = tex_token_t::KIND_CONTROL_SEQUENCE;
+				token._descriptor =
+					find_control_sequence(code.data() + begin + 1,
+										  end - begin - 1);
+				if (token._descriptor != NULL &&
+				   token._descriptor->_bracket &&
+				   end + 1 < size && code[end] == '[') {
+					while (end < size && code[end] != ']') {
 						end++;
 					}
-					if (end < code.size()) {
+					if (end < size) {
 						end++;
 					}
+					// The optional argument is part of the token,
+					// which is then no longer a known control
+					// sequence
+					token._descriptor = NULL;
+				}
+				token._length = end - begin;
+			}
+			else {
+				switch (code[begin]) {
+				case '{':
+					token._kind = tex_token_t::KIND_BEGIN_GROUP;
+					break;
+				case '}':
+					token._kind = tex_token_t::KIND_END_GROUP;
+					break;
+				case '^':
+					token._kind = tex_token_t::KIND_SUPERSCRIPT;
+					break;
+				case '_':
+					token._kind = tex_token_t::KIND_SUBSCRIPT;
+					break;
 				}
 			}
 
-			std::string code_substr =
-				code.substr(begin, end - begin);
-
-#if 1
-			if (code_substr == "\\hbox" || code_substr == "\\text") {
+			if (token.control_sequence() ==
+			   tex_token_t::CONTROL_SEQUENCE_HBOX ||
+			   token.control_sequence() ==
+			   tex_token_t::CONTROL_SEQUENCE_TEXT) {
 				box = true;
 			}
 			else if (box) {
 				if (code[begin] == '{') {
 					for (unsigned int level = 1;
-						end < code.size() && level > 0; end++) {
-						if (code[end - 1] != '\\') {
+						end < size && level > 0; end++) {
+						if (code[end - 1] != escape_character) {
 							switch (code[end]) {
 							case '{':	level++; break;
 							case '}':	level--; break;
 							}
 						}
 					}
-					code_substr =
-						code.substr(begin + 1, end - begin - 2);
+					token = tex_token_t(
+						begin + 1, end >= begin + 2 ?
+						end - begin - 2 : 0, tex_token_t::KIND_BOX);
 				}
-				else if (code[begin] == '\\' &&
-						begin + 1 < code.size()) {
-					code_substr = code.substr(begin, 2);
+				else if (code[begin] == escape_character &&
+						begin + 1 < size) {
+					token = tex_token_t(begin, 2,
+										tex_token_t::KIND_BOX);
 				}
 				else {
-					code_substr = code.substr(begin, 1);
+					token = tex_token_t(begin, 1,
+										tex_token_t::KIND_BOX);
 				}
 				// FIXME: Proper interpretation of escaped characters
 				box = false;
 			}
-#endif
 
-			ret.push_back(code_substr);
+			ret.push_back(token);
 			begin = end;
-			while (code[begin] == ' ') {
+			while (begin < size && code[begin] == ' ') {
 				begin++;
 			}
 		}
@@ -439,6 +427,11 @@ namespace mathtext {
 		return ret;
 	}
 
+	size_t math_text_t::tex_token_count(const std::string &code)
+	{
+		return tex_split(code).size();
+	}
+
 	std::vector<std::string> math_text_t::
 	tex_replace(const std::vector<std::string> &/*code*/)
 	{
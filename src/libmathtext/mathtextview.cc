@@ -194,37 +194,37 @@ namespace mathtext {
 
 		std::vector<bool> branch_copy = branch;
 
-		if (!atom._nucleus.empty()) {
-			const bool way_final = atom._superscript.empty() &&
-				atom._subscript.empty();
+		if (!atom._nucleus->empty()) {
+			const bool way_final = atom._superscript->empty() &&
+				atom._subscript->empty();
 
 			tree_view_prefix(branch, way_final);
 			std::cerr << "<nucleus>" << std::endl;
 			branch_copy.back() = !way_final;
 			branch_copy.push_back(true);
-			tree_view(atom._nucleus, branch_copy, final);
+			tree_view(*atom._nucleus, branch_copy, final);
 			branch_copy.pop_back();
 			tree_view_prefix(branch_copy, way_final);
 			std::cerr << "</nucleus>" << std::endl;
 		}
-		if (!atom._superscript.empty()) {
-			const bool way_final = atom._subscript.empty();
+		if (!atom._superscript->empty()) {
+			const bool way_final = atom._subscript->empty();
 
 			tree_view_prefix(branch, way_final);
 			std::cerr << "<superscript>" << std::endl;
 			branch_copy.back() = !way_final;
 			branch_copy.push_back(true);
-			tree_view(atom._superscript, branch_copy, final);
+			tree_view(*atom._superscript, branch_copy, final);
 			branch_copy.pop_back();
 			tree_view_prefix(branch_copy, way_final);
 			std::cerr << "</superscript>" << std::endl;
 		}
-		if (!atom._subscript.empty()) {
+		if (!atom._subscript->empty()) {
 			tree_view_prefix(branch, true);
 			std::cerr << "<subscript>" << std::endl;
 			branch_copy.back() = false;
 			branch_copy.push_back(true);
-			tree_view(atom._subscript, branch_copy, final);
+			tree_view(*atom._subscript, branch_copy, final);
 			branch_copy.pop_back();
 			tree_view_prefix(branch_copy, true);
 			std::cerr << "</subscript>" << std::endl;
@@ -0,0 +1,82 @@
+// mathtext - A TeX/LaTeX compatible rendering library. Copyright (C)
+// 2008-2016 Yue Shi Lai <ylai@users.sourceforge.net>
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2.1 of
+// the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// 02110-1301 USA
+
+#include <cstddef>
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif // HAVE_PTHREAD
+#include <mathtext/mutex.h>
+
+namespace mathtext {
+
+	namespace {
+
+		void *new_mutex(void)
+		{
+#ifdef HAVE_PTHREAD
+			pthread_mutex_t *mutex = new pthread_mutex_t;
+
+			pthread_mutex_init(mutex, NULL);
+
+			return mutex;
+#else // HAVE_PTHREAD
+			return NULL;
+#endif // HAVE_PTHREAD
+		}
+
+	}
+
+	mutex_t::mutex_t(void)
+		: _mutex(new_mutex())
+	{
+	}
+
+	mutex_t::mutex_t(const mutex_t &)
+		: _mutex(new_mutex())
+	{
+	}
+
+	mutex_t::~mutex_t(void)
+	{
+#ifdef HAVE_PTHREAD
+		pthread_mutex_t *mutex = static_cast<pthread_mutex_t *>(_mutex);
+
+		pthread_mutex_destroy(mutex);
+		delete mutex;
+#endif // HAVE_PTHREAD
+	}
+
+	// A mutex at namespace scope that is used before its constructor
+	// has run is still NULL, and is not locked
+	void mutex_t::lock(void)
+	{
+#ifdef HAVE_PTHREAD
+		if (_mutex != NULL)
+			pthread_mutex_lock(static_cast<pthread_mutex_t *>(_mutex));
+#endif // HAVE_PTHREAD
+	}
+
+	void mutex_t::unlock(void)
+	{
+#ifdef HAVE_PTHREAD
+		if (_mutex != NULL)
+			pthread_mutex_unlock(static_cast<pthread_mutex_t *>(_mutex));
+#endif // HAVE_PTHREAD
+	}
+
+}
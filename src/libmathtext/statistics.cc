@@ -0,0 +1,122 @@
+// mathtext - A TeX/LaTeX compatible rendering library. Copyright (C)
+// 2008-2016 Yue Shi Lai <ylai@users.sourceforge.net>
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2.1 of
+// the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// 02110-1301 USA
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <sys/time.h>
+#include <mathtext/statistics.h>
+
+namespace mathtext {
+
+	void statistics_t::clear(void)
+	{
+		std::fill(_counter, _counter + NCOUNTER, 0UL);
+		std::fill(_time, _time + NTIMER, 0.0);
+	}
+
+	statistics_t &statistics_t::operator+=(const statistics_t &statistics)
+	{
+		for (unsigned int i = 0; i < NCOUNTER; i++)
+			_counter[i] += statistics._counter[i];
+		for (unsigned int i = 0; i < NTIMER; i++)
+			_time[i] += statistics._time[i];
+
+		return *this;
+	}
+
+	statistics_t &statistics_t::operator-=(const statistics_t &statistics)
+	{
+		for (unsigned int i = 0; i < NCOUNTER; i++)
+			_counter[i] -= statistics._counter[i];
+		for (unsigned int i = 0; i < NTIMER; i++)
+			_time[i] -= statistics._time[i];
+
+		return *this;
+	}
+
+	double statistics_t::now(void)
+	{
+#ifdef CLOCK_MONOTONIC
+		struct timespec ts;
+
+		if (clock_gettime(CLOCK_MONOTONIC, &ts) == 0)
+			return ts.tv_sec + 1e-9 * ts.tv_nsec;
+#endif // CLOCK_MONOTONIC
+
+		struct timeval tv;
+
+		gettimeofday(&tv, NULL);
+
+		return tv.tv_sec + 1e-6 * tv.tv_usec;
+	}
+
+	const char *statistics_t::counter_name(const unsigned int counter)
+	{
+		static const char *name[NCOUNTER] = {
+			"formula",
+			"bounding_box",
+			"glyph_metrics_hit",
+			"text_raw",
+			"font_size_change",
+			"glyph",
+			"glyph_run",
+			"layout_box",
+			"layout_math_symbol",
+			"layout_extensible",
+			"layout_math_list",
+			"layout_field",
+			"layout_atom",
+			"extensible_repeat",
+			"byte_written"
+		};
+
+		return counter < NCOUNTER ? name[counter] : NULL;
+	}
+
+	const char *statistics_t::timer_name(const unsigned int timer)
+	{
+		static const char *name[NTIMER] = {
+			"parse", "layout", "emit"
+		};
+
+		return timer < NTIMER ? name[timer] : NULL;
+	}
+
+	std::string statistics_t::json(void) const
+	{
+		std::string ret = "{ \"counter\": { ";
+		char buffer[64];
+
+		for (unsigned int i = 0; i < NCOUNTER; i++) {
+			snprintf(buffer, 64, "%s\"%s\": %lu", i == 0 ? "" : ", ",
+					 counter_name(i), _counter[i]);
+			ret.append(buffer);
+		}
+		ret.append(" }, \"time\": { ");
+		for (unsigned int i = 0; i < NTIMER; i++) {
+			snprintf(buffer, 64, "%s\"%s\": %.9g", i == 0 ? "" : ", ",
+					 timer_name(i), _time[i]);
+			ret.append(buffer);
+		}
+		ret.append(" } }");
+
+		return ret;
+	}
+
+}
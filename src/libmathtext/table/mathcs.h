@@ -0,0 +1,1884 @@
+// mathtext - A TeX/LaTeX compatible rendering library. Copyright (C)
+// 2008-2012 Yue Shi Lai <ylai@users.sourceforge.net>
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2.1 of
+// the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// 02110-1301 USA
+
+static const unsigned long ncontrol_sequence = 620;
+static const int control_sequence_displacement[ncontrol_sequence] = {
+    3,
+    0,
+    -620,
+    0,
+    3,
+    2,
+    -612,
+    0,
+    -611,
+    1,
+    2,
+    0,
+    2,
+    0,
+    1,
+    1,
+    0,
+    -606,
+    0,
+    0,
+    1,
+    1,
+    0,
+    0,
+    -605,
+    1,
+    1,
+    -603,
+    4,
+    -601,
+    0,
+    1,
+    0,
+    0,
+    2,
+    -598,
+    -597,
+    0,
+    0,
+    0,
+    -594,
+    -591,
+    0,
+    0,
+    -590,
+    3,
+    0,
+    0,
+    0,
+    -588,
+    -585,
+    -584,
+    0,
+    0,
+    -582,
+    -580,
+    1,
+    3,
+    0,
+    -578,
+    0,
+    -577,
+    -576,
+    0,
+    -575,
+    1,
+    -574,
+    0,
+    1,
+    0,
+    5,
+    0,
+    -572,
+    -571,
+    0,
+    -569,
+    -568,
+    1,
+    -564,
+    0,
+    1,
+    0,
+    -557,
+    -556,
+    -546,
+    0,
+    1,
+    0,
+    1,
+    0,
+    -545,
+    1,
+    0,
+    0,
+    0,
+    5,
+    0,
+    -542,
+    1,
+    -540,
+    -539,
+    0,
+    0,
+    0,
+    1,
+    -536,
+    0,
+    1,
+    0,
+    -531,
+    -530,
+    0,
+    0,
+    3,
+    0,
+    1,
+    0,
+    0,
+    0,
+    2,
+    0,
+    1,
+    3,
+    2,
+    0,
+    -526,
+    0,
+    -522,
+    -520,
+    0,
+    0,
+    0,
+    1,
+    -519,
+    7,
+    0,
+    0,
+    0,
+    5,
+    -518,
+    -515,
+    1,
+    0,
+    2,
+    4,
+    -513,
+    0,
+    -510,
+    -509,
+    3,
+    -507,
+    0,
+    1,
+    -506,
+    -503,
+    1,
+    -501,
+    0,
+    0,
+    -498,
+    -496,
+    0,
+    0,
+    -493,
+    0,
+    2,
+    0,
+    -491,
+    0,
+    -489,
+    -488,
+    0,
+    -486,
+    0,
+    0,
+    0,
+    5,
+    -484,
+    3,
+    1,
+    -483,
+    -478,
+    0,
+    1,
+    0,
+    1,
+    -475,
+    -474,
+    0,
+    5,
+    0,
+    -473,
+    -472,
+    1,
+    3,
+    -468,
+    1,
+    0,
+    4,
+    0,
+    0,
+    -462,
+    0,
+    -461,
+    0,
+    -460,
+    0,
+    -456,
+    1,
+    1,
+    1,
+    1,
+    -455,
+    -454,
+    4,
+    0,
+    2,
+    -450,
+    -444,
+    -443,
+    -441,
+    0,
+    0,
+    3,
+    0,
+    0,
+    0,
+    -440,
+    0,
+    -439,
+    0,
+    -438,
+    1,
+    3,
+    1,
+    0,
+    -436,
+    2,
+    -434,
+    0,
+    -432,
+    -430,
+    0,
+    0,
+    0,
+    -428,
+    0,
+    -427,
+    4,
+    5,
+    -423,
+    0,
+    1,
+    0,
+    0,
+    0,
+    -419,
+    0,
+    0,
+    0,
+    -418,
+    0,
+    -414,
+    -411,
+    1,
+    -406,
+    0,
+    -404,
+    -403,
+    0,
+    0,
+    -394,
+    0,
+    -388,
+    0,
+    -385,
+    2,
+    0,
+    1,
+    -384,
+    0,
+    0,
+    0,
+    4,
+    -382,
+    0,
+    -378,
+    0,
+    -366,
+    2,
+    2,
+    0,
+    -365,
+    0,
+    0,
+    0,
+    11,
+    -364,
+    -362,
+    1,
+    -360,
+    1,
+    -357,
+    -353,
+    0,
+    0,
+    0,
+    -351,
+    0,
+    -349,
+    -348,
+    -340,
+    0,
+    0,
+    -334,
+    0,
+    -333,
+    -323,
+    0,
+    -320,
+    0,
+    2,
+    1,
+    3,
+    4,
+    -319,
+    -317,
+    0,
+    0,
+    -309,
+    0,
+    0,
+    1,
+    0,
+    0,
+    0,
+    1,
+    0,
+    0,
+    1,
+    -305,
+    -304,
+    1,
+    0,
+    0,
+    3,
+    1,
+    -303,
+    -300,
+    4,
+    0,
+    -296,
+    0,
+    -292,
+    13,
+    0,
+    0,
+    0,
+    2,
+    1,
+    -291,
+    1,
+    -288,
+    0,
+    -283,
+    -282,
+    -280,
+    5,
+    -270,
+    -268,
+    0,
+    0,
+    0,
+    1,
+    -267,
+    -266,
+    -257,
+    -249,
+    -248,
+    0,
+    0,
+    0,
+    1,
+    1,
+    -245,
+    4,
+    0,
+    -244,
+    1,
+    0,
+    0,
+    2,
+    2,
+    -243,
+    1,
+    0,
+    0,
+    2,
+    -242,
+    -241,
+    0,
+    -237,
+    -235,
+    -225,
+    0,
+    0,
+    2,
+    6,
+    -222,
+    0,
+    -221,
+    -219,
+    1,
+    -217,
+    0,
+    4,
+    6,
+    -215,
+    -210,
+    -204,
+    -201,
+    0,
+    5,
+    0,
+    0,
+    10,
+    0,
+    0,
+    0,
+    5,
+    -200,
+    2,
+    -196,
+    1,
+    1,
+    0,
+    0,
+    0,
+    9,
+    1,
+    -195,
+    -193,
+    0,
+    0,
+    -192,
+    -191,
+    -182,
+    -181,
+    -174,
+    0,
+    0,
+    0,
+    0,
+    3,
+    -172,
+    0,
+    0,
+    -165,
+    -157,
+    1,
+    1,
+    12,
+    0,
+    -152,
+    -151,
+    -150,
+    -147,
+    0,
+    4,
+    15,
+    1,
+    0,
+    -146,
+    0,
+    -144,
+    -143,
+    -141,
+    0,
+    -140,
+    -136,
+    -135,
+    4,
+    -134,
+    2,
+    -133,
+    -132,
+    0,
+    -130,
+    0,
+    0,
+    -129,
+    -126,
+    5,
+    1,
+    0,
+    -125,
+    -123,
+    0,
+    2,
+    -121,
+    -114,
+    2,
+    1,
+    -113,
+    0,
+    -110,
+    0,
+    -108,
+    -105,
+    1,
+    0,
+    0,
+    0,
+    16,
+    3,
+    -103,
+    -97,
+    0,
+    0,
+    -96,
+    -88,
+    -87,
+    0,
+    5,
+    0,
+    -86,
+    3,
+    -84,
+    -81,
+    2,
+    1,
+    0,
+    -79,
+    2,
+    0,
+    3,
+    3,
+    6,
+    -78,
+    0,
+    -76,
+    5,
+    6,
+    2,
+    2,
+    0,
+    -75,
+    6,
+    1,
+    0,
+    1,
+    0,
+    0,
+    -70,
+    14,
+    13,
+    2,
+    -65,
+    1,
+    0,
+    3,
+    0,
+    -62,
+    -60,
+    -57,
+    1,
+    0,
+    0,
+    1,
+    -54,
+    -53,
+    14,
+    1,
+    3,
+    0,
+    -50,
+    0,
+    6,
+    0,
+    0,
+    24,
+    -47,
+    -45,
+    -44,
+    0,
+    -43,
+    0,
+    0,
+    -32,
+    -31,
+    -30,
+    -28,
+    -27,
+    -26,
+    0,
+    0,
+    -24,
+    0,
+    4,
+    4,
+    -23,
+    -21,
+    -20,
+    -19,
+    4,
+    9,
+    0,
+    -18,
+    9,
+    0,
+    17,
+    0,
+    0,
+    7,
+    0,
+    -9,
+    0,
+    -5,
+    0,
+    -2,
+};
+
+static const control_sequence_t control_sequence[ncontrol_sequence] = {
+    { "\\\"", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u00a8', atom_t::TYPE_ACC, true, -1, -1 },
+    { "\\ddagger", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2021', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\lessdot", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22d6', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\cup", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u222a', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\lesssim", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2272', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\dashleftarrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21e0', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\trianglerighteq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22b5', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\left", tex_token_t::CONTROL_SEQUENCE_LEFT, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, -1 },
+    { "\\longmapsto", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u27fc', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\upGamma", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u0393', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\llcorner", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u230e', atom_t::TYPE_OPEN, true, -1, -1 },
+    { "\\lambda", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03bb', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\lfloor", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u230a', atom_t::TYPE_OPEN, true, -1, -1 },
+    { "\\iint", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 36 },
+    { "\\clubsuit", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2663', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\Rightarrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21d2', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\Gamma", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u0393', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\updbar", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u0111', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\tau", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03c4', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\Pi", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03a0', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\upSigma", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03a3', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\rightarrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2192', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\notsucc", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2281', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\ell", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2113', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\Theta", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u0398', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\Pr", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 0 },
+    { "\\lessapprox", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2a85', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\bigstar", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2605', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\vartriangle", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u25b5', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\curlyeqprec", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22de', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\infty", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u221e', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\upeta", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03b7', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\bigcirc", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u20dd', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\ointop", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 55 },
+    { "\\hslash", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u210f', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\subsetneqq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2acb', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\gg", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u226b', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\doublebarwedge", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2a5e', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\sho", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03f8', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\Cap", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22d2', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\upchi", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03c7', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\sharp", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u266f', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\subset", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2282', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\sqsubseteq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2291', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\nrightarrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u219b', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\uprho", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03c1', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\approxeq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u224a', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\diamond", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22c4', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\precsim", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u227e', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\upnu", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03bd', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\eqcolon", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2255', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\oint", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 54 },
+    { "\\bulletdashcirc", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22b7', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\gnsim", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22e7', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\circledcirc", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u229a', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\zeta", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03b6', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\upsho", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03f8', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\dasharrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21e2', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\top", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22a4', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\supset", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2283', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\arcsin", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 2 },
+    { "\\leftharpoonup", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21bc', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\sampi", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03e1', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\neq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2260', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\circlearrowleft", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21ba', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\wp", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2118', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\sum", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 62 },
+    { "\\deg", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 28 },
+    { "\\downuparrows", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21f5', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\sup", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 63 },
+    { "\\tanh", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 65 },
+    { "\\ntriangleleft", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22ea', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\upUpsilon", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03a5', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\bigtriangledown", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u25bd', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\notapprox", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2249', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\doublecap", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22d2', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\upkoppa", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03df', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\succcurlyeq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u227d', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\rightarrowtail", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21a3', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\smallsmile", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2323', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\upvarsigma", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03c2', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\upstigma", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03db', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\upphi", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03d5', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\^", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u02c6', atom_t::TYPE_ACC, true, -1, -1 },
+    { "\\Vvdash", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22aa', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\qquad", tex_token_t::CONTROL_SEQUENCE_QQUAD, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, -1 },
+    { "\\upvarbeta", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03d0', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\backepsilon", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u220b', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\succsim", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u227f', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\varnothing", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2205', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\measuredangle", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2221', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\upPi", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03a0', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\rightharpoonup", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21c0', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\hom", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 33 },
+    { "\\koppa", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03df', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\varpi", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03d6', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\notprec", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2280', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\notasymp", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u226d', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\preceq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2aaf', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\rfloor", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u230b', atom_t::TYPE_CLOSE, true, -1, -1 },
+    { "\\Bumpeq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u224e', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\leadsto", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u219d', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\cdot", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u00b7', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\lesseqgtr", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22da', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\inf", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 38 },
+    { "\\restriction", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21be', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\vdash", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22a2', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\dim", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 30 },
+    { "\\upharpoonright", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21be', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\bigsqcup", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 14 },
+    { "\\upvarphi", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03c6', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\sin", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 58 },
+    { "\\v", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u02c7', atom_t::TYPE_ACC, true, -1, -1 },
+    { "\\u", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u02d8', atom_t::TYPE_ACC, true, -1, -1 },
+    { "\\simarrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2b47', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\sqcap", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2293', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\gneqq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2269', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\Rsh", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21b1', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\gtrapprox", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2a86', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\succapprox", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2ab8', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\gimel", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u05d2', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\ker", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 41 },
+    { "\\div", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u00f7', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\curlyvee", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22ce', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\~", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u02dc', atom_t::TYPE_ACC, true, -1, -1 },
+    { "\\nLeftarrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21cd', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\in", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2208', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\upvarkappa", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03f0', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\{", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\173', atom_t::TYPE_OPEN, true, -1, -1 },
+    { "\\backsim", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u223d', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\backsimeq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22cd', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\leftleftarrows", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21d4', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\sigma", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03c3', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\succnsim", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22e9', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\phi", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03d5', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\upvarepsilon", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03b5', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\oiiintop", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 51 },
+    { "\\lceil", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2308', atom_t::TYPE_OPEN, true, -1, -1 },
+    { "\\circleddash", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u229d', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\upbeta", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03b2', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\gtreqqless", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2a8c', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\gneq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2a88', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\nleq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2270', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\downarrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2193', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\upharpoonleft", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21bf', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\downupharpoons", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u296f', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\upvarkoppa", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03d9', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\Sho", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03f7', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\barwedge", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22bc', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\bigcup", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 10 },
+    { "\\rightharpoondown", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21c1', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\nVdash", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22ae', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\approx", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2248', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\upsampi", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03e1', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\perp", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22a5', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\mapsto", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21a6', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\rightleftarrows", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21c4', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\sqsupset", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2290', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\lesseqqgtr", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2a8b', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\varkoppa", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03d9', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\Uparrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21d1', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\Delta", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u0394', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\updigamma", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03dd', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\mu", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03bc', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\leftarrowtail", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21a2', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\epsilon", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03f5', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\coprod", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2a3f', atom_t::TYPE_OP, true, -1, 18 },
+    { "\\ddots", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22f1', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\nsimeq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2244', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\doteqdot", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2251', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\subseteqq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2ac5', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\parallel", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2225', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\dagger", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2020', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\boxtimes", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22a0', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\}", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\175', atom_t::TYPE_CLOSE, true, -1, -1 },
+    { "\\stigma", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03db', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\upvarpi", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03d6', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\Cup", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22d3', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\awoint", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 5 },
+    { "\\ntrianglerighteq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22ed', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\complement", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2201', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\mathrm", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, math_symbol_t::FAMILY_REGULAR, -1 },
+    { "\\precneqq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2ab5', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\bigwedge", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 17 },
+    { "\\Koppa", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03de', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\nmid", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2224', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\longleftarrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u27f5', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\!", tex_token_t::CONTROL_SEQUENCE_NEGATIVE_THIN_SPACE, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, -1 },
+    { "\\.", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u02d9', atom_t::TYPE_ACC, true, -1, -1 },
+    { "\\bullet", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2022', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\Game", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2141', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\rdbrack", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u27e7', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\circledR", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u00ae', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\coloneq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2254', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\circledS", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u24c8', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\mp", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2213', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\arg", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 4 },
+    { "\\blacktriangle", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u25b4', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\int", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 39 },
+    { "\\circ", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u25e6', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\Lsh", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21b0', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\iiintop", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 35 },
+    { "\\upPsi", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03a8', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\delta", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03b4', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\updownharpoons", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u296e', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\boxdot", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22a1', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\prime", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2032', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\=", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u00af', atom_t::TYPE_ACC, true, -1, -1 },
+    { "\\pitchfork", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22d4', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\upSan", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03fa', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\wwbar", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u0305', atom_t::TYPE_ACC, true, -1, -1 },
+    { "\\sinh", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 59 },
+    { "\\leftthreetimes", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22cb', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\nprec", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2280', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\upkappa", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03ba', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\VarKoppa", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03d8', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\supsetneq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u228b', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\ldots", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2026', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\nleftarrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u219a', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\notsimeq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2244', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\fallingdotseq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2252', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\dotplus", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2214', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\barintop", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 8 },
+    { "\\hbox", tex_token_t::CONTROL_SEQUENCE_HBOX, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, -1 },
+    { "\\Upsilon", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03a5', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\cot", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 21 },
+    { "\\leadsfrom", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u219c', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\backslash", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\134', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\nVDash", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22af', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\frown", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2322', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\curvearrowleft", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u293a', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\dddot", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u20db', atom_t::TYPE_ACC, true, -1, -1 },
+    { "\\mathsf", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, math_symbol_t::FAMILY_MATH_SANS_SERIF_REGULAR, -1 },
+    { "\\varkappa", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03f0', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\updelta", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03b4', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\longleftrightarrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u27f7', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\coth", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 22 },
+    { "\\nLeftrightarrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21ce', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\lneqq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2268', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\bigoplus", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 12 },
+    { "\\ge", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2265', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\Rrightarrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21db', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\bumpeq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u224f', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\nsubseteq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2288', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\rangle", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u27e9', atom_t::TYPE_CLOSE, true, -1, -1 },
+    { "\\dashuparrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21e1', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\propto", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u221d', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\arctan", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 3 },
+    { "\\cap", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2229', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\upvartheta", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03d1', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\eqsim", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2242', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\upzeta", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03b6', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\upDigamma", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03dc', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\nvdash", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22ac', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\triangleq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u225c', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\,", tex_token_t::CONTROL_SEQUENCE_THIN_SPACE, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, -1 },
+    { "\\awointop", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 6 },
+    { "\\slashintop", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 61 },
+    { "\\doublecup", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22d3', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\uparrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2191', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\lnsim", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22e6', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\undercurvearrowright", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u293b', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\t", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2040', atom_t::TYPE_ACC, true, -1, -1 },
+    { "\\bigtriangleup", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u25b3', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\nwarrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2196', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\star", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22c6', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\cdots", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22ef', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\uppi", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03c0', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\ntrianglelefteq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22ec', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\nless", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u226e', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\pi", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03c0', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\ominus", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2296', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\nexists", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2204', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\omega", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03c9', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\notcong", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2247', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\min", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 49 },
+    { "\\nearrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2197', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\supsetneqq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2acc', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\hateq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2259', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\Xi", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u039e', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\defineequal", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u225d', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\aleph", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2135', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\Stigma", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03da', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\spadesuit", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2660', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\Vdash", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22a9', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\to", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2192', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\arccos", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 1 },
+    { "\\ldbrack", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u27e6', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\Sigma", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03a3', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\ltimes", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22c9', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\bigotimes", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 13 },
+    { "\\upPhi", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03a6', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\upSampi", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03e0', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\wedge", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2227', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\circledast", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u229b', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\blacktriangleleft", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u25c4', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\over", tex_token_t::CONTROL_SEQUENCE_OVER, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, -1 },
+    { "\\langle", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u27e8', atom_t::TYPE_OPEN, true, -1, -1 },
+    { "\\P", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u00b6', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\eqcirc", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2256', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\Doteq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2251', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\diagup", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2571', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\hookrightarrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21aa', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\beta", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03b2', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\upTheta", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u0398', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\mho", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2127', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\simeq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2243', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\notgeq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2271', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\sqsupseteq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2292', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\upStigma", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03da', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\circeq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2257', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\uplambda", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03bb', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\longrightarrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u27f6', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\det", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 29 },
+    { "\\llless", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u226a', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\gtreqless", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22db', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\searrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2198', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\subsetneq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u228a', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\upOmega", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03a9', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\nequiv", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2262', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\doteq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2250', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\log", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 47 },
+    { "\\Im", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2111', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\openclubsuit", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2667', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\notsupset", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2285', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\;", tex_token_t::CONTROL_SEQUENCE_THICK_SPACE, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, -1 },
+    { "\\ni", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u220b', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\nsucc", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2281', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\atop", tex_token_t::CONTROL_SEQUENCE_ATOP, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, -1 },
+    { "\\exists", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2203', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\nu", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03bd', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\notni", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u220c', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\notsubset", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2284', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\not", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u0338', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\rightleftharpoons", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21cc', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\xi", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03be', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\upKoppa", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03de', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\lneq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2a87', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\wr", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2240', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\oiintop", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 53 },
+    { "\\lor", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2228', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\nsupseteqq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\ue0bf', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\notleq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2270', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\leqslant", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2a7d', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\boxminus", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u229f', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\upsilon", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03c5', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\varphi", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03c6', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\heartsuit", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2665', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\upomega", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03c9', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\cwoint", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 26 },
+    { "\\odot", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2299', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\rho", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03c1', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\subseteq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2286', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\mathbb", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, math_symbol_t::FAMILY_MATH_BLACKBOARD_BOLD, -1 },
+    { "\\mathtt", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, math_symbol_t::FAMILY_MATH_MONOSPACE, -1 },
+    { "\\eqslantgtr", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2a96', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\upDelta", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u0394', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\prod", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 56 },
+    { "\\ngtr", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u226f', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\swarrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2199', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\imath", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u0131', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\iintop", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 37 },
+    { "\\ntriangleright", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22eb', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\rightthreetimes", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22cc', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\Omega", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03a9', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\land", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2227', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\dbar", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u0111', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\succ", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u227b', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\text", tex_token_t::CONTROL_SEQUENCE_TEXT, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, -1 },
+    { "\\neg", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u00ac', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\openspadesuit", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2664', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\varbeta", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03d0', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\upxi", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03be', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\lightning", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21af', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\multimap", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22b8', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\upXi", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u039e', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\upgamma", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03b3', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\oiint", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 52 },
+    { "\\supseteqq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2ac6', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\Sampi", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03e0', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\twoheadrightarrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21a0', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\exp", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 31 },
+    { "\\notgr", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u226f', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\backprime", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2035', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\root", tex_token_t::CONTROL_SEQUENCE_ROOT, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, -1 },
+    { "\\preccurlyeq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u227c', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\cwint", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 24 },
+    { "\\oslash", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2298', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\upupsilon", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03c5', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\san", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03fb', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\cos", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 19 },
+    { "\\nleqslant", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\ue0af', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\prec", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u227a', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\vDash", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22a8', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\smallfrown", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2322', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\nparallel", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2226', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\dashdownarrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21e3', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\psi", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03c8', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\vartriangleleft", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u25c5', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\upLambda", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u039b', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\quad", tex_token_t::CONTROL_SEQUENCE_QUAD, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, -1 },
+    { "\\circlearrowright", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21bb', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\triangleleft", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u25b9', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\San", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03fa', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\`", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\140', atom_t::TYPE_ACC, true, -1, -1 },
+    { "\\Leftrightarrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21d4', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\succeq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2ab0', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\upsigma", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03c3', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\dashrightarrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21e2', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\leq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2264', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\asymp", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u224d', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\lessgtr", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2276', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\square", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u25a1', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\leftrightharpoons", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21cb', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\hbar", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u0127', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\yen", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u00a5', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\ddddot", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u20dc', atom_t::TYPE_ACC, true, -1, -1 },
+    { "\\otimes", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2297', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\gnapprox", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2a8a', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\intercal", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22ba', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\boxplus", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u229e', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\hookleftarrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21a9', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\diamondsuit", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2666', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\blacksquare", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u25a0', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\Longrightarrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u27f9', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\downharpoonleft", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21c3', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\gcd", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 32 },
+    { "\\smile", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2323', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\sphericalangle", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2222', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\sqsubset", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u228f', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\cosh", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 20 },
+    { "\\lnot", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u00ac', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\therefore", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2234', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\natural", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u266e', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\upvarrho", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03f1', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\rceil", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2309', atom_t::TYPE_CLOSE, true, -1, -1 },
+    { "\\varpropto", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u221d', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\bigodot", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 11 },
+    { "\\Digamma", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03dc', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\dashv", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22a3', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\sim", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u223c', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\Finv", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2132', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\vdots", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22ee', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\curlyeqsucc", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22df', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\vartriangleright", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u25bb', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\:", tex_token_t::CONTROL_SEQUENCE_MEDIUM_SPACE, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, -1 },
+    { "\\ngeqq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\ue08a', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\rightrightarrows", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21d2', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\tan", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 64 },
+    { "\\precapprox", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2ab7', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\leqq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2266', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\twoheadleftarrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u219e', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\'", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u00b4', atom_t::TYPE_ACC, true, -1, -1 },
+    { "\\Psi", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03a8', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\notsupseteq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2289', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\rightsquigarrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21dd', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\leftharpoondown", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21bd', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\oiiint", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 50 },
+    { "\\jmath", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u0237', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\sqrt", tex_token_t::CONTROL_SEQUENCE_SQRT, true,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, -1 },
+    { "\\ll", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u226a', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\ln", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 46 },
+    { "\\gtrdot", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22d7', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\downdownarrows", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21ca', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\S", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u00a7', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\Longleftrightarrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u27fa', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\upVarKoppa", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03d8', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\nasymp", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u226d', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\le", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2264', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\lim", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 43 },
+    { "\\lg", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 42 },
+    { "\\csc", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 23 },
+    { "\\notin", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2209', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\risingdotseq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2253', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\nRightarrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21cf', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\uplus", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u228e', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\Box", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u25a1', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\upiota", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03b9', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\mathfr", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, math_symbol_t::FAMILY_MATH_FRAKTUR_REGULAR, -1 },
+    { "\\sqcup", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2294', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\lrcorner", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u230f', atom_t::TYPE_CLOSE, true, -1, -1 },
+    { "\\upepsilon", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03f5', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\ggg", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u226b', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\lll", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u226a', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\bowtie", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22c8', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\uppsi", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03c8', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\angle", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2220', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\Downarrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21d3', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\eta", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03b7', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\mathscr", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, math_symbol_t::FAMILY_MATH_SCRIPT_ITALIC, -1 },
+    { "\\triangledown", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u25bf', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\bigcap", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 9 },
+    { "\\Leftarrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21d0', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\ne", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2260', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\eqslantless", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2a95', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\iiint", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 34 },
+    { "\\triangleright", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u25c3', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\napprox", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2249', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\smallint", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u222b', atom_t::TYPE_OP, true, -1, -1 },
+    { "\\supseteq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2287', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\geqslant", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2a7e', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\upalpha", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03b1', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\gamma", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03b3', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\Lleftarrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21da', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\vartheta", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03d1', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\nsubset", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2284', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\uptau", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03c4', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\times", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u00d7', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\succneqq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2ab6', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\downdownharpoons", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2965', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\digamma", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03dd', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\|", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2016', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\gtrsim", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2273', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\notsubseteq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2288', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\ncong", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2247', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\Diamond", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u25c7', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\setdif", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2216', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\rtimes", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22ca', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\precnapprox", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2ab9', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\nleqq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\ue088', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\mathit", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, math_symbol_t::FAMILY_ITALIC, -1 },
+    { "\\chi", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03c7', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\alpha", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03b1', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\Phi", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03a6', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\vec", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u20d7', atom_t::TYPE_ACC, true, -1, -1 },
+    { "\\between", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u226c', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\nabla", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2207', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\urcorner", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u230d', atom_t::TYPE_CLOSE, true, -1, -1 },
+    { "\\nsim", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2241', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\updownarrows", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21c5', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\slashint", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 60 },
+    { "\\succnapprox", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2aba', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\trianglelefteq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22b4', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\intop", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 40 },
+    { "\\nsupseteq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2289', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\cwintop", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 25 },
+    { "\\kappa", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03ba', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\limsup", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 45 },
+    { "\\defineeq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u225d', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\Supset", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22d1', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\cwointop", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 27 },
+    { "\\barint", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 7 },
+    { "\\varepsilon", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03b5', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\nleftrightarrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21ae', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\diagdown", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2572', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\Re", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u211c', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\eth", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u00f0', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\iota", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03b9', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\surd", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u221a', atom_t::TYPE_OP, true, -1, -1 },
+    { "\\geq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2265', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\gets", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2190', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\theta", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03b8', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\upsan", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03fb', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\Longleftarrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u27f8', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\ngeqslant", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\ue0b1', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\max", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 48 },
+    { "\\downharpoonright", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21c2', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\nsupset", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2285', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\nsubseteqq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\ue0bd', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\checkmark", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2713', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\Lambda", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u039b', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\Updownarrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21d5', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\biguplus", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 15 },
+    { "\\curlywedge", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22cf', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\blacktriangleright", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u25ba', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\because", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2235', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\veebar", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22bb', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\uptheta", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03b8', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\right", tex_token_t::CONTROL_SEQUENCE_RIGHT, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, -1 },
+    { "\\nvDash", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22ad', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\bigvee", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 16 },
+    { "\\smallsetminus", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2216', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\emptyset", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2205', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\vert", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\174', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\liminf", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 44 },
+    { "\\flat", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u266d', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\mathbf", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, math_symbol_t::FAMILY_BOLD, -1 },
+    { "\\ulcorner", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u230c', atom_t::TYPE_OPEN, true, -1, -1 },
+    { "\\beth", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2136', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\equiv", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2261', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\pm", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u00b1', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\circdashbullet", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22b6', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\of", tex_token_t::CONTROL_SEQUENCE_OF, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, -1 },
+    { "\\updownarrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2195', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\partial", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2202', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\leftarrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2190', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\notequiv", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2262', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\forall", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2200', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\precnsim", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22e8', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\cong", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2245', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\leftrightarrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2194', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\owns", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u220b', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\Vert", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2016', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\leftrightarrows", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21c6', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\centerdot", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2b1d', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\geqq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2267', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\ngeq", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2271', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\varrho", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03f1', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\daleth", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2138', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\Subset", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22d0', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\upuparrows", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21c8', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\gtrless", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2277', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\lozenge", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u25ca', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\notless", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u226e', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\leftsquigarrow", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u21dc', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\lnapprox", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2a89', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\sec", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\0', atom_t::TYPE_UNKNOWN, false, -1, 57 },
+    { "\\aa", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u02da', atom_t::TYPE_ACC, true, -1, -1 },
+    { "\\maltese", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2720', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\varsigma", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03c2', atom_t::TYPE_ORD, false, -1, -1 },
+    { "\\upSho", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03f7', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\gggtr", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u226b', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\comp", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2218', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\upupharpoons", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2963', atom_t::TYPE_REL, true, -1, -1 },
+    { "\\upmu", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u03bc', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\vee", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2228', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\oplus", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u2295', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\divideontimes", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u22c7', atom_t::TYPE_BIN, true, -1, -1 },
+    { "\\blacktriangledown", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u25be', atom_t::TYPE_ORD, true, -1, -1 },
+    { "\\blacklozenge", tex_token_t::CONTROL_SEQUENCE_UNKNOWN, false,
+      L'\u29eb', atom_t::TYPE_ORD, true, -1, -1 },
+};
@@ -0,0 +1,125 @@
+// mathtext - A TeX/LaTeX compatible rendering library. Copyright (C)
+// 2008-2012 Yue Shi Lai <ylai@users.sourceforge.net>
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2.1 of
+// the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// 02110-1301 USA
+
+// Checks the glyphs that control sequences are drawn with, in
+// particular of control sequences defined more than once by the
+// symbol maps in data/table, where the first definition is used
+
+#include <iostream>
+#include <string>
+#include <mathtext/mathtext.h>
+#include <mathtext/mathrender.h>
+
+namespace {
+
+	// Renderer that records the glyphs drawn instead of drawing them
+	class recording_renderer_t : public mathtext::math_text_renderer_t {
+	protected:
+		mathtext::affine_transform_t
+		transform_logical_to_pixel(void) const
+		{
+			return mathtext::affine_transform_t(1, 0, 0, 1, 0, 0);
+		}
+		mathtext::affine_transform_t
+		transform_pixel_to_logical(void) const
+		{
+			return mathtext::affine_transform_t(1, 0, 0, 1, 0, 0);
+		}
+	public:
+		std::wstring _drawn;
+		float font_size(const unsigned int family = FAMILY_PLAIN) const
+		{
+			return 10;
+		}
+		void set_font_size(const float size, const unsigned int family)
+		{
+		}
+		void set_font_size(const float size)
+		{
+		}
+		void reset_font_size(const unsigned int family)
+		{
+		}
+		void point(const float x, const float y)
+		{
+		}
+		void filled_rectangle(
+			const mathtext::bounding_box_t &bounding_box)
+		{
+		}
+		void rectangle(const mathtext::bounding_box_t &bounding_box)
+		{
+		}
+		mathtext::bounding_box_t bounding_box(
+			const std::wstring string,
+			const unsigned int family = FAMILY_PLAIN)
+		{
+			return mathtext::bounding_box_t(
+				0, 0, 5 * string.size(), 7, 5 * string.size(), 0);
+		}
+		void text_raw(const float x, const float y,
+					  const std::wstring string,
+					  const unsigned int family = FAMILY_PLAIN)
+		{
+			_drawn += string;
+		}
+		void text_with_bounding_box(
+			const float x, const float y, const std::wstring string,
+			const unsigned int family = FAMILY_PLAIN)
+		{
+			_drawn += string;
+		}
+	};
+
+	bool check(const std::string &code, const wchar_t glyph)
+	{
+		recording_renderer_t renderer;
+
+		renderer.text(0, 0, mathtext::math_text_t(code));
+		if (renderer._drawn != std::wstring(1, glyph)) {
+			std::cerr << __FILE__ << ':' << __LINE__
+					  << ": error: `" << code << "' drawn as";
+			for (std::wstring::const_iterator iterator =
+					 renderer._drawn.begin();
+				 iterator != renderer._drawn.end(); iterator++) {
+				std::cerr << " U+" << std::hex
+						  << static_cast<unsigned long>(*iterator)
+						  << std::dec;
+			}
+			std::cerr << ", expected U+" << std::hex
+					  << static_cast<unsigned long>(glyph) << std::dec
+					  << std::endl;
+			return false;
+		}
+
+		return true;
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	bool pass = true;
+
+	// Also defined as U+03DC in data/table/lmp2_map.txt
+	pass = check("\\digamma", L'\u03dd') && pass;
+	// Also defined as U+E0C8 in data/table/lmp2_map.txt
+	pass = check("\\triangleleft", L'\u25b9') && pass;
+	pass = check("\\alpha", L'\u03b1') && pass;
+
+	return pass ? 0 : 1;
+}